@@ -0,0 +1,240 @@
+// Statement round trips per operation for the two hottest multi-statement query flows: user
+// hydration and file create. Each runs with the Pipeline batching statements, and with every
+// statement sent on its own; file create also runs the per-ancestor stats walk it used to do.
+// Round trips are counted off the libpq protocol trace (one Sync or simple Query per trip, libpq
+// 14+), so they reflect what actually went over the wire. Prints one JSON object per flow and mode.
+//
+// Runs against the VH_TEST_DB_* database and recreates its schema, like the DB unit tests.
+//
+//   vh_db_roundtrips_bench [--iterations N] [--depth D] [--groups G]
+
+#include "config/Registry.hpp"
+#include "db/Pipeline.hpp"
+#include "db/Transactions.hpp"
+#include "db/query/fs/File.hpp"
+#include "db/query/identities/Group.hpp"
+#include "db/query/identities/User.hpp"
+#include "db/query/identities/helpers.hpp"
+#include "db/query/rbac/role/Admin.hpp"
+#include "fs/model/File.hpp"
+#include "identities/Group.hpp"
+#include "identities/User.hpp"
+#include "log/Registry.hpp"
+#include "rbac/role/Admin.hpp"
+#include "seed/include/init_db_tables.hpp"
+#include "seed/include/seed_db.hpp"
+
+#include <nlohmann/json.hpp>
+#include <paths.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace vh;
+using Mode = db::Pipeline::Mode;
+
+struct Fixture {
+    uint32_t userId{}, vaultId{};
+    std::vector<uint32_t> dirs;   // root first, deepest last
+};
+
+// Counts client->server Sync and Query messages in a libpq trace
+size_t countRoundTrips(const std::string& trace) {
+    size_t trips = 0;
+    std::istringstream lines(trace);
+    for (std::string line; std::getline(lines, line);) {
+        std::vector<std::string> fields;
+        std::istringstream cols(line);
+        for (std::string f; std::getline(cols, f, '\t');) fields.push_back(f);
+
+        for (size_t i = 0; i + 2 < fields.size(); ++i)
+            if (fields[i] == "F" && (fields[i + 2] == "Sync" || fields[i + 2] == "Query")) {
+                ++trips;
+                break;
+            }
+    }
+    return trips;
+}
+
+// Runs op in a rolled-back transaction per iteration, tracing only op itself
+nlohmann::json measure(const std::string& flow, const std::string& mode, const size_t iterations,
+                       const std::function<void(pqxx::work&, size_t)>& op) {
+    auto lease = db::Transactions::dbPool_->lease();
+    auto& conn = lease->get();
+
+    size_t trips = 0;
+    std::chrono::nanoseconds elapsed{0};
+    for (size_t i = 0; i < iterations; ++i) {
+        pqxx::work txn(conn);
+
+        char* buf = nullptr;
+        size_t len = 0;
+        FILE* trace = open_memstream(&buf, &len);
+        conn.trace(trace);
+
+        const auto start = std::chrono::steady_clock::now();
+        op(txn, i);
+        elapsed += std::chrono::steady_clock::now() - start;
+
+        conn.trace(nullptr);
+        std::fclose(trace);
+        trips += countRoundTrips(std::string(buf, len));
+        std::free(buf);
+
+        txn.abort();
+    }
+
+    const auto ms = std::chrono::duration<double, std::milli>(elapsed).count();
+    return {
+        {"flow", flow},
+        {"mode", mode},
+        {"iterations", iterations},
+        {"round_trips_per_op", static_cast<double>(trips) / static_cast<double>(iterations)},
+        {"avg_ms", ms / static_cast<double>(iterations)},
+    };
+}
+
+Fixture seedFixture(const size_t depth, const size_t groups) {
+    db::seed::nuke_and_recreate_schema_public();
+    db::Transactions::dbPool_->initPreparedStatements();
+    seed::initPermissions();
+    seed::initRoles();
+
+    Fixture fx;
+    const auto user = std::make_shared<identities::User>();
+    user->name = "bench_user";
+    user->email = "bench@vaulthalla.test";
+    user->setPasswordHash("hash");
+    user->roles.admin = db::query::rbac::role::Admin::get("super_admin");
+    fx.userId = db::query::identities::User::createUser(user);
+
+    for (size_t g = 0; g < groups; ++g) {
+        const auto group = std::make_shared<identities::Group>();
+        group->name = "bench_group_" + std::to_string(g);
+        db::query::identities::Group::addMemberToGroup(db::query::identities::Group::createGroup(group), fx.userId);
+    }
+
+    db::Transactions::exec("bench::seedFixture", [&](pqxx::work& txn) {
+        fx.vaultId = txn.exec(
+            "INSERT INTO vault (type, name, owner_id, mount_point) VALUES ($1, $2, $3, $4) RETURNING id",
+            pqxx::params{"local", "Round Trip Bench", fx.userId, "BENCH6789ABCDEFGHJKMNPQRSTVWXYZ0"}
+        ).one_field().as<uint32_t>();
+
+        std::optional<uint32_t> parent;
+        std::string path;
+        for (size_t d = 0; d <= depth; ++d) {
+            const auto name = d == 0 ? std::string("/") : "d" + std::to_string(d);
+            path = d == 0 ? name : (d == 1 ? "" : path) + "/" + name;
+            const auto id = txn.exec(
+                "INSERT INTO fs_entry (vault_id, parent_id, name, created_by, path) VALUES ($1, $2, $3, $4, $5) RETURNING id",
+                pqxx::params{fx.vaultId, parent, name, fx.userId, path}
+            ).one_field().as<uint32_t>();
+            txn.exec("INSERT INTO directories (fs_entry_id) VALUES ($1)", pqxx::params{id});
+            fx.dirs.push_back(id);
+            parent = id;
+        }
+    });
+
+    return fx;
+}
+
+std::shared_ptr<fs::model::File> makeFile(const Fixture& fx, const size_t i) {
+    auto file = std::make_shared<fs::model::File>();
+    file->vault_id = static_cast<int32_t>(fx.vaultId);
+    file->parent_id = static_cast<int32_t>(fx.dirs.back());
+    file->name = "bench_" + std::to_string(i) + ".bin";
+    file->created_by = file->last_modified_by = static_cast<int32_t>(fx.userId);
+    file->setPath("/bench/" + file->name);
+    file->inode = static_cast<ino_t>(1'000'000 + i);
+    file->size_bytes = 4096;
+    return file;
+}
+
+// What File::upsertFile did before it batched: one statement per step, two per ancestor
+void upsertFileWalkingAncestors(pqxx::work& txn, const std::shared_ptr<fs::model::File>& file) {
+    const auto exists = txn.exec(pqxx::prepped{"fs_entry_exists_by_inode"}, file->inode).one_field().as<bool>();
+    const auto sizeRes = txn.exec(pqxx::prepped{"get_file_size_by_inode"}, file->inode);
+    const auto existingSize = sizeRes.empty() ? 0 : sizeRes.one_field().as<uintmax_t>();
+    txn.exec(pqxx::prepped{"delete_fs_entry_by_inode"}, file->inode);
+    txn.exec(pqxx::prepped{"upsert_file_full"}, pqxx::params{
+        file->vault_id, file->parent_id, file->name, file->base32_alias, file->created_by,
+        file->last_modified_by, file->path.string(), file->inode, file->mode, file->owner_uid,
+        file->group_gid, file->is_hidden, file->is_system, file->size_bytes, file->mime_type,
+        file->content_hash, file->encryption_iv
+    });
+
+    std::optional<unsigned int> parentId = file->parent_id;
+    while (parentId) {
+        const int64_t delta = static_cast<int64_t>(file->size_bytes) - static_cast<int64_t>(existingSize);
+        txn.exec(pqxx::prepped{"update_dir_stats"}, pqxx::params{parentId, delta, exists ? 0 : 1, 0});
+        const auto res = txn.exec(pqxx::prepped{"get_fs_entry_parent_id"}, parentId);
+        if (res.empty()) break;
+        parentId = res.one_field().as<std::optional<unsigned int>>();
+    }
+}
+
+}
+
+int main(const int argc, char** argv) {
+    size_t iterations = 200, depth = 8, groups = 3;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--iterations" && i + 1 < argc) iterations = std::stoul(argv[++i]);
+        else if (arg == "--depth" && i + 1 < argc) depth = std::stoul(argv[++i]);
+        else if (arg == "--groups" && i + 1 < argc) groups = std::stoul(argv[++i]);
+    }
+
+    for (const auto* var : {"VH_TEST_DB_USER", "VH_TEST_DB_PASS", "VH_TEST_DB_HOST", "VH_TEST_DB_PORT", "VH_TEST_DB_NAME"}) {
+        if (std::getenv(var)) continue;
+        std::cerr << "vh_db_roundtrips_bench: " << var << " is not set; skipping\n";
+        return EXIT_SUCCESS;
+    }
+
+    try {
+        paths::enableTestMode();
+        if (const auto* configPath = std::getenv("VH_PATH_TO_CONFIG")) paths::configPath = configPath;
+        config::Registry::init();
+        log::Registry::init();
+        db::Transactions::init();
+
+        const auto fx = seedFixture(depth, groups);
+
+        const auto userRes = db::Transactions::exec("bench::userRow", [&](pqxx::work& txn) {
+            return txn.exec("SELECT * FROM users WHERE id = $1", pqxx::params{fx.userId});
+        });
+        const auto hydrate = [&](pqxx::work& txn, size_t) {
+            (void)db::query::identities::hydrateUser(txn, userRes.one_row());
+        };
+
+        for (const auto& [mode, name] : {std::pair{Mode::Serial, "serial"}, std::pair{Mode::Batched, "pipelined"}}) {
+            db::Pipeline::setDefaultMode(mode);
+            std::cout << measure("user_hydration", name, iterations, hydrate).dump() << '\n';
+        }
+
+        std::cout << measure("file_create", "ancestor_walk", iterations, [&](pqxx::work& txn, const size_t i) {
+            upsertFileWalkingAncestors(txn, makeFile(fx, i));
+        }).dump() << '\n';
+
+        for (const auto& [mode, name] : {std::pair{Mode::Serial, "serial"}, std::pair{Mode::Batched, "pipelined"}}) {
+            db::Pipeline::setDefaultMode(mode);
+            std::cout << measure("file_create", name, iterations, [&](pqxx::work& txn, const size_t i) {
+                (void)db::query::fs::File::upsertFile(txn, makeFile(fx, i));
+            }).dump() << '\n';
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "vh_db_roundtrips_bench: " << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,498 @@
+// The FUSE data and metadata paths end to end, driven through the kernel like any client would:
+// sequential and random I/O at several block sizes, create/stat/miss/unlink storms, a large
+// readdir and parallel writers. Mounts a throwaway vault the way the integration tests do, with
+// the backing root on tmpfs so disk speed stays out of the numbers. Prints a JSON object
+// describing the run, then one per workload, so results can be diffed across commits.
+//
+// Runs against the VH_TEST_DB_* database and wipes it, like the integration tests. Needs
+// /dev/fuse and user_allow_other in /etc/fuse.conf.
+//
+//   vh_bench [--workloads seq,rand,meta,readdir,parallel] [--block-sizes 4096,65536,1048576]
+//            [--file-mb N] [--ops N] [--files N] [--dir-entries N] [--threads N]
+//            [--backing DIR] [--out FILE]
+
+#include "concurrency/ThreadPoolManager.hpp"
+#include "config/Registry.hpp"
+#include "db/Transactions.hpp"
+#include "fs/Filesystem.hpp"
+#include "fs/model/Path.hpp"
+#include "log/Registry.hpp"
+#include "runtime/Deps.hpp"
+#include "runtime/Manager.hpp"
+#include "seed/include/init_db_tables.hpp"
+#include "seed/include/seed_db.hpp"
+#include "stats/model/Histogram.hpp"
+#include "storage/Manager.hpp"
+
+#include <nlohmann/json.hpp>
+#include <paths.h>
+#include <version.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/statfs.h>
+#include <sys/utsname.h>
+#include <unistd.h>
+
+namespace {
+
+using namespace vh;
+using Clock = std::chrono::steady_clock;
+namespace stdfs = std::filesystem;
+
+constexpr long kFuseSuperMagic = 0x65735546;
+constexpr long kTmpfsMagic = 0x01021994;
+
+struct Options {
+    std::vector<std::string> workloads{"seq", "rand", "meta", "readdir", "parallel"};
+    std::vector<size_t> blockSizes{4096, 65536, 1 << 20};
+    size_t fileMb = 64, ops = 2000, files = 2000, dirEntries = 10000, threads = 4;
+    stdfs::path backing, out;
+
+    [[nodiscard]] bool runs(const std::string& w) const {
+        return std::ranges::find(workloads, w) != workloads.end();
+    }
+};
+
+struct Result {
+    std::string workload;
+    size_t blockSize = 0, threads = 1;
+    uint64_t ops = 0, bytes = 0;
+    std::chrono::nanoseconds elapsed{0};
+    stats::model::HistogramSnapshot latency;
+
+    [[nodiscard]] nlohmann::json json() const {
+        const double secs = std::chrono::duration<double>(elapsed).count();
+        nlohmann::json j = {
+            {"workload", workload},
+            {"threads", threads},
+            {"ops", ops},
+            {"seconds", secs},
+            {"ops_per_sec", secs > 0 ? static_cast<double>(ops) / secs : 0.0},
+            {"latency_us", {
+                {"p50", latency.quantile_us(0.50)},
+                {"p95", latency.quantile_us(0.95)},
+                {"p99", latency.quantile_us(0.99)},
+                {"max", latency.max_us}
+            }}
+        };
+        if (blockSize) j["block_size"] = blockSize;
+        if (bytes) {
+            j["bytes"] = bytes;
+            j["mib_per_sec"] = secs > 0 ? static_cast<double>(bytes) / (1 << 20) / secs : 0.0;
+        }
+        return j;
+    }
+};
+
+std::vector<std::string> split(const std::string& s) {
+    std::vector<std::string> out;
+    std::istringstream in(s);
+    for (std::string item; std::getline(in, item, ',');)
+        if (!item.empty()) out.push_back(item);
+    return out;
+}
+
+long check(const long rc, const std::string& what) {
+    if (rc < 0) throw std::system_error(errno, std::generic_category(), what);
+    return rc;
+}
+
+// Runs op, records its latency, and returns what it returned
+template <typename F>
+auto observed(stats::model::Histogram& h, F&& op) {
+    const auto start = Clock::now();
+    auto rc = op();
+    h.observe_us(static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count()));
+    return rc;
+}
+
+class Runner {
+public:
+    Runner(const Options& opts, stdfs::path dir) : opts_(opts), dir_(std::move(dir)) {}
+
+    void emit(const nlohmann::json& j) {
+        std::cout << j.dump() << std::endl;
+        if (out_) *out_ << j.dump() << '\n';
+    }
+
+    void openOut() {
+        if (!opts_.out.empty()) out_.emplace(opts_.out, std::ios::trunc);
+    }
+
+    void run() {
+        if (opts_.runs("seq") || opts_.runs("rand"))
+            for (const auto bs : opts_.blockSizes) io(bs);
+        if (opts_.runs("meta")) meta();
+        if (opts_.runs("readdir")) readdir();
+        if (opts_.runs("parallel")) parallel();
+    }
+
+private:
+    const Options& opts_;
+    stdfs::path dir_;
+    std::optional<std::ofstream> out_;
+
+    [[nodiscard]] uint64_t fileBytes() const { return static_cast<uint64_t>(opts_.fileMb) << 20; }
+
+    void io(const size_t bs) {
+        const auto file = dir_ / ("io_" + std::to_string(bs) + ".bin");
+        const uint64_t blocks = std::max<uint64_t>(1, fileBytes() / bs);
+        std::vector<char> buf(bs, 'v');
+
+        // The sequential write also lays down the file the other passes use
+        emit(writeFile(file, "seq_write", bs, [&](const uint64_t i) { return i * bs; }, blocks, buf, O_TRUNC));
+
+        if (opts_.runs("seq"))
+            emit(readFile(file, "seq_read", bs, [&](const uint64_t i) { return i * bs; }, blocks, buf));
+
+        if (opts_.runs("rand")) {
+            std::mt19937_64 rng(42);
+            std::uniform_int_distribution<uint64_t> pick(0, blocks - 1);
+            std::vector<uint64_t> offsets(opts_.ops);
+            for (auto& o : offsets) o = pick(rng) * bs;
+
+            emit(readFile(file, "rand_read", bs, [&](const uint64_t i) { return offsets[i]; }, offsets.size(), buf));
+            emit(writeFile(file, "rand_write", bs, [&](const uint64_t i) { return offsets[i]; }, offsets.size(), buf, 0));
+        }
+
+        stdfs::remove(file);
+    }
+
+    template <typename Offset>
+    static Result writeFile(const stdfs::path& file, const std::string& name, const size_t bs, Offset&& offset,
+                            const uint64_t count, const std::vector<char>& buf, const int extraFlags) {
+        stats::model::Histogram h;
+        Result r;
+        r.workload = name;
+        r.blockSize = bs;
+
+        const auto start = Clock::now();
+        const int fd = ::open(file.c_str(), O_CREAT | O_WRONLY | extraFlags, 0644);
+        check(fd, "open " + file.string());
+        for (uint64_t i = 0; i < count; ++i)
+            check(observed(h, [&] { return ::pwrite(fd, buf.data(), bs, static_cast<off_t>(offset(i))); }), "pwrite");
+        check(::fsync(fd), "fsync");
+        ::close(fd);
+        r.elapsed = Clock::now() - start;
+
+        r.ops = count;
+        r.bytes = count * bs;
+        r.latency = h.snapshot();
+        return r;
+    }
+
+    template <typename Offset>
+    static Result readFile(const stdfs::path& file, const std::string& name, const size_t bs, Offset&& offset,
+                           const uint64_t count, std::vector<char>& buf) {
+        stats::model::Histogram h;
+        Result r;
+        r.workload = name;
+        r.blockSize = bs;
+
+        const auto start = Clock::now();
+        const int fd = ::open(file.c_str(), O_RDONLY);
+        check(fd, "open " + file.string());
+        for (uint64_t i = 0; i < count; ++i)
+            r.bytes += static_cast<uint64_t>(
+                check(observed(h, [&] { return ::pread(fd, buf.data(), bs, static_cast<off_t>(offset(i))); }), "pread"));
+        ::close(fd);
+        r.elapsed = Clock::now() - start;
+
+        r.ops = count;
+        r.latency = h.snapshot();
+        return r;
+    }
+
+    // Runs op once per name and reports it as one workload
+    template <typename Op>
+    Result storm(const std::string& name, const std::vector<stdfs::path>& paths, Op&& op) {
+        stats::model::Histogram h;
+        Result r;
+        r.workload = name;
+        r.ops = paths.size();
+
+        const auto start = Clock::now();
+        for (const auto& p : paths) observed(h, [&] { return op(p); });
+        r.elapsed = Clock::now() - start;
+
+        r.latency = h.snapshot();
+        return r;
+    }
+
+    void meta() {
+        const auto dir = dir_ / "meta";
+        check(::mkdir(dir.c_str(), 0755), "mkdir " + dir.string());
+
+        std::vector<stdfs::path> present, missing;
+        for (size_t i = 0; i < opts_.files; ++i) {
+            present.push_back(dir / ("f" + std::to_string(i)));
+            missing.push_back(dir / (".git" + std::to_string(i)) / "HEAD");
+        }
+
+        struct stat st{};
+        emit(storm("meta_create", present, [](const stdfs::path& p) {
+            const int fd = ::open(p.c_str(), O_CREAT | O_EXCL | O_WRONLY, 0644);
+            check(fd, "create " + p.string());
+            return ::close(fd);
+        }).json());
+        emit(storm("meta_stat", present, [&](const stdfs::path& p) {
+            check(::stat(p.c_str(), &st), "stat " + p.string());
+            return 0;
+        }).json());
+
+        // Second pass shows what the negative caches save on repeat probes
+        for (const auto* name : {"meta_stat_missing", "meta_stat_missing_repeat"})
+            emit(storm(name, missing, [&](const stdfs::path& p) { return ::stat(p.c_str(), &st); }).json());
+
+        emit(storm("meta_unlink", present, [](const stdfs::path& p) {
+            check(::unlink(p.c_str()), "unlink " + p.string());
+            return 0;
+        }).json());
+
+        check(::rmdir(dir.c_str()), "rmdir " + dir.string());
+    }
+
+    void readdir() {
+        const auto dir = dir_ / "readdir";
+        check(::mkdir(dir.c_str(), 0755), "mkdir " + dir.string());
+
+        std::vector<stdfs::path> files;
+        for (size_t i = 0; i < opts_.dirEntries; ++i) {
+            files.push_back(dir / ("entry_" + std::to_string(i) + ".txt"));
+            const int fd = ::open(files.back().c_str(), O_CREAT | O_WRONLY, 0644);
+            check(fd, "create " + files.back().string());
+            ::close(fd);
+        }
+
+        constexpr size_t passes = 5;
+        stats::model::Histogram h;
+        Result r;
+        r.workload = "readdir";
+
+        const auto start = Clock::now();
+        for (size_t pass = 0; pass < passes; ++pass) {
+            r.ops += observed(h, [&] {
+                uint64_t n = 0;
+                DIR* d = ::opendir(dir.c_str());
+                if (!d) throw std::system_error(errno, std::generic_category(), "opendir " + dir.string());
+                while (::readdir(d)) ++n;
+                ::closedir(d);
+                return n;
+            });
+        }
+        r.elapsed = Clock::now() - start;
+        r.latency = h.snapshot();
+
+        auto j = r.json();
+        j["entries"] = opts_.dirEntries;
+        j["passes"] = passes;
+        emit(j);
+
+        for (const auto& f : files) ::unlink(f.c_str());
+        check(::rmdir(dir.c_str()), "rmdir " + dir.string());
+    }
+
+    void parallel() {
+        constexpr size_t bs = 1 << 20;
+        const size_t threads = std::max<size_t>(1, opts_.threads);
+        const uint64_t blocksEach = std::max<uint64_t>(1, fileBytes() / bs / threads);
+
+        stats::model::Histogram h;
+        Result r;
+        r.workload = "parallel_write";
+        r.blockSize = bs;
+        r.threads = threads;
+        std::vector<std::exception_ptr> errors(threads);
+
+        const auto start = Clock::now();
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                try {
+                    const std::vector<char> buf(bs, static_cast<char>('a' + t % 26));
+                    const auto file = dir_ / ("parallel_" + std::to_string(t) + ".bin");
+                    const int fd = ::open(file.c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+                    check(fd, "open " + file.string());
+                    for (uint64_t i = 0; i < blocksEach; ++i)
+                        check(observed(h, [&] { return ::pwrite(fd, buf.data(), bs, static_cast<off_t>(i * bs)); }), "pwrite");
+                    check(::fsync(fd), "fsync");
+                    ::close(fd);
+                } catch (...) {
+                    errors[t] = std::current_exception();
+                }
+            });
+        }
+        for (auto& w : workers) w.join();
+        r.elapsed = Clock::now() - start;
+
+        for (const auto& e : errors)
+            if (e) std::rethrow_exception(e);
+
+        r.ops = blocksEach * threads;
+        r.bytes = r.ops * bs;
+        r.latency = h.snapshot();
+        emit(r.json());
+
+        for (size_t t = 0; t < threads; ++t) stdfs::remove(dir_ / ("parallel_" + std::to_string(t) + ".bin"));
+    }
+
+    void emit(const Result& r) { emit(r.json()); }
+};
+
+stdfs::path defaultBacking() {
+    struct statfs fs{};
+    if (::statfs("/dev/shm", &fs) == 0 && static_cast<long>(fs.f_type) == kTmpfsMagic)
+        return "/dev/shm/vh_bench_backing";
+    return stdfs::temp_directory_path() / "vh_bench_backing";
+}
+
+bool waitFor(const std::function<bool()>& ready, const std::chrono::seconds timeout) {
+    const auto deadline = Clock::now() + timeout;
+    while (Clock::now() < deadline) {
+        if (ready()) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    return false;
+}
+
+nlohmann::json describeRun(const Options& opts) {
+    utsname uts{};
+    ::uname(&uts);
+
+    struct statfs fs{};
+    const bool tmpfs = ::statfs(opts.backing.c_str(), &fs) == 0 && static_cast<long>(fs.f_type) == kTmpfsMagic;
+
+    return {{"run", {
+        {"version", VH_VERSION},
+        {"started_at", std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count()},
+        {"kernel", uts.release},
+        {"cpus", std::thread::hardware_concurrency()},
+        {"backing", opts.backing.string()},
+        {"backing_tmpfs", tmpfs},
+        {"workloads", opts.workloads},
+        {"block_sizes", opts.blockSizes},
+        {"file_mb", opts.fileMb},
+        {"ops", opts.ops},
+        {"files", opts.files},
+        {"dir_entries", opts.dirEntries},
+        {"threads", opts.threads}
+    }}};
+}
+
+// Seeds a fresh database whose super admin is this process's uid, then brings up the FUSE
+// service alone, as the integration tests do
+void mountThrowawayVault(const Options& opts) {
+    paths::enableTestMode();
+    if (const auto* configPath = std::getenv("VH_PATH_TO_CONFIG")) paths::configPath = configPath;
+    paths::backingPath = opts.backing;
+
+    stdfs::remove_all(paths::getBackingPath());
+    stdfs::create_directories(paths::getBackingPath());
+    stdfs::create_directories(paths::getRuntimePath());
+    std::ofstream(paths::getRuntimePath() / "superadmin_uid", std::ios::trunc) << ::getuid();
+
+    config::Registry::init();
+    log::Registry::init();
+    concurrency::ThreadPoolManager::instance().init();
+
+    db::Transactions::init();
+    db::seed::wipe_all_data_restart_identity();
+    db::seed::init_tables_if_not_exists();
+    db::Transactions::dbPool_->initPreparedStatements();
+    seed::seed_database();
+
+    runtime::Deps::init();
+    runtime::Deps::setSyncController(runtime::Manager::instance().getSyncController());
+    fs::Filesystem::init(runtime::Deps::get().storageManager);
+    runtime::Deps::get().storageManager->initStorageEngines();
+    runtime::Manager::instance().startTestServices();
+}
+
+}
+
+int main(const int argc, char** argv) {
+    Options opts;
+    opts.backing = defaultBacking();
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const auto next = [&] { return i + 1 < argc ? std::string(argv[++i]) : std::string(); };
+
+        if (arg == "--workloads") opts.workloads = split(next());
+        else if (arg == "--block-sizes") {
+            opts.blockSizes.clear();
+            for (const auto& s : split(next())) opts.blockSizes.push_back(std::stoul(s));
+        }
+        else if (arg == "--file-mb") opts.fileMb = std::stoul(next());
+        else if (arg == "--ops") opts.ops = std::stoul(next());
+        else if (arg == "--files") opts.files = std::stoul(next());
+        else if (arg == "--dir-entries") opts.dirEntries = std::stoul(next());
+        else if (arg == "--threads") opts.threads = std::stoul(next());
+        else if (arg == "--backing") opts.backing = next();
+        else if (arg == "--out") opts.out = next();
+    }
+
+    for (const auto* var : {"VH_TEST_DB_USER", "VH_TEST_DB_PASS", "VH_TEST_DB_HOST", "VH_TEST_DB_PORT", "VH_TEST_DB_NAME"}) {
+        if (std::getenv(var)) continue;
+        std::cerr << "vh_bench: " << var << " is not set; skipping\n";
+        return EXIT_SUCCESS;
+    }
+
+    if (::access("/dev/fuse", R_OK | W_OK) != 0) {
+        std::cerr << "vh_bench: /dev/fuse is not accessible; skipping\n";
+        return EXIT_SUCCESS;
+    }
+
+    int status = EXIT_SUCCESS;
+    try {
+        mountThrowawayVault(opts);
+
+        const auto vaultDir = paths::getMountPath() / fs::model::to_snake_case(std::string(seed::ADMIN_DEFAULT_VAULT_NAME));
+        const bool mounted = waitFor([&] {
+            struct statfs fs{};
+            struct stat st{};
+            return ::statfs(paths::getMountPath().c_str(), &fs) == 0 &&
+                   static_cast<long>(fs.f_type) == kFuseSuperMagic &&
+                   ::stat(vaultDir.c_str(), &st) == 0;
+        }, std::chrono::seconds(15));
+        if (!mounted) throw std::runtime_error("vault did not appear under " + paths::getMountPath().string());
+
+        const auto workDir = vaultDir / "vh_bench";
+        stdfs::remove_all(workDir);
+        check(::mkdir(workDir.c_str(), 0755), "mkdir " + workDir.string());
+
+        Runner runner(opts, workDir);
+        runner.openOut();
+        runner.emit(describeRun(opts));
+        runner.run();
+
+        stdfs::remove_all(workDir);
+    } catch (const std::exception& e) {
+        std::cerr << "vh_bench: " << e.what() << '\n';
+        status = EXIT_FAILURE;
+    }
+
+    // Like the integration tests, skip the service teardown; auto_unmount detaches the mount on exit
+    std::cout.flush();
+    std::_Exit(status);
+}
@@ -0,0 +1,152 @@
+// Override resolution cost for one role carrying many path overrides: the linear scan Evaluator
+// used to run (every override's glob matched on every check) against the compiled OverrideIndex
+// on a cold DecisionCache, then again on a warm one. Prints one JSON object per mode.
+//
+//   vh_rbac_overrides_bench [--overrides N] [--queries Q]
+
+#include "config/Registry.hpp"
+#include "rbac/fs/glob/Matcher.hpp"
+#include "rbac/fs/policy/Evaluator.hpp"
+#include "rbac/fs/policy/OverrideIndex.hpp"
+#include "rbac/permission/OverrideList.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace vh::rbac;
+using permission::Override;
+using permission::OverrideOpt;
+using Action = permission::vault::FilesystemAction;
+
+std::vector<Override> makeOverrides(const size_t n, std::mt19937& rng) {
+    static const std::vector<std::string> perms{
+        "vault.fs.files.download", "vault.fs.files.preview", "vault.fs.files.upload",
+        "vault.fs.directories.list", "vault.fs.directories.download"
+    };
+    static const std::vector<std::string> leaves{"*.pdf", "**", "report-?.txt", "*", "notes.md", "**/*.png"};
+
+    std::vector<Override> overrides;
+    overrides.reserve(n);
+
+    for (size_t i = 0; i < n; ++i) {
+        Override o;
+        o.permission.qualified_name = perms[rng() % perms.size()];
+        o.effect = rng() % 3 ? OverrideOpt::ALLOW : OverrideOpt::DENY;
+        o.pattern = fs::glob::model::Pattern::make(
+            "/team" + std::to_string(rng() % 200) + "/project" + std::to_string(rng() % 50) + "/" +
+            leaves[rng() % leaves.size()]);
+        overrides.push_back(std::move(o));
+    }
+
+    return overrides;
+}
+
+std::vector<std::string> makePaths(const size_t n, std::mt19937& rng) {
+    static const std::vector<std::string> names{"a.pdf", "report-1.txt", "notes.md", "img/x.png", "deep/er/file.bin"};
+
+    std::vector<std::string> paths;
+    paths.reserve(n);
+
+    for (size_t i = 0; i < n; ++i)
+        paths.push_back("/team" + std::to_string(rng() % 200) + "/project" + std::to_string(rng() % 50) + "/" +
+                        std::to_string(i) + "/" + names[rng() % names.size()]);
+
+    return paths;
+}
+
+// The pre-index Evaluator::findBestOverride, kept as the baseline
+const Override* linearBest(const std::vector<Override>& overrides, const std::string& path, const Action action) {
+    const Override* best = nullptr;
+    std::size_t bestScore = 0;
+
+    for (const auto& o : overrides) {
+        if (!o.enabled) continue;
+
+        if (const auto f = permission::vault::fs::Files::resolveFromQualifiedName(o.permission.qualified_name)) {
+            const auto req = fs::policy::Evaluator::filePermissionForAction(action);
+            if (!req || *f != *req) continue;
+        }
+
+        if (const auto d = permission::vault::fs::Directories::resolveFromQualifiedName(o.permission.qualified_name)) {
+            const auto req = fs::policy::Evaluator::directoryPermissionForAction(action);
+            if (!req || *d != *req) continue;
+        }
+
+        if (!fs::glob::Matcher::matches(o.pattern, path)) continue;
+
+        if (const auto score = fs::policy::OverrideIndex::score(o.pattern); !best || score > bestScore) {
+            best = &o;
+            bestScore = score;
+        }
+    }
+
+    return best;
+}
+
+nlohmann::json measure(const std::string& mode, const size_t overrides, const std::vector<std::string>& paths,
+                       const std::function<bool(const std::string&)>& resolve) {
+    size_t matched = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto& path : paths) matched += resolve(path) ? 1 : 0;
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    return {
+        {"mode", mode},
+        {"overrides", overrides},
+        {"queries", paths.size()},
+        {"matched", matched},
+        {"seconds", elapsed},
+        {"us_per_check", elapsed * 1e6 / static_cast<double>(paths.size())}
+    };
+}
+
+}
+
+int main(const int argc, char** argv) {
+    size_t overrideCount = 10000, queries = 20000;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--overrides" && i + 1 < argc) overrideCount = std::stoul(argv[++i]);
+        else if (arg == "--queries" && i + 1 < argc) queries = std::stoul(argv[++i]);
+        else {
+            std::cerr << "usage: vh_rbac_overrides_bench [--overrides N] [--queries Q]\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    vh::config::Registry::init();
+
+    std::mt19937 rng(43);
+    const auto overrides = makeOverrides(overrideCount, rng);
+    const auto paths = makePaths(queries, rng);
+
+    // The linear scan is slow enough that a slice of the queries tells the story
+    const std::vector linearPaths(paths.begin(), paths.begin() + static_cast<std::ptrdiff_t>(std::min<size_t>(paths.size(), 500)));
+    std::cout << measure("linear", overrideCount, linearPaths, [&](const std::string& p) {
+        return linearBest(overrides, p, Action::Read) != nullptr;
+    }).dump() << '\n';
+
+    const permission::OverrideList list(overrides);
+
+    const auto compileStart = std::chrono::steady_clock::now();
+    const auto index = list.index();
+    const auto compile = std::chrono::duration<double>(std::chrono::steady_clock::now() - compileStart).count();
+    std::cout << nlohmann::json{{"mode", "compile"}, {"overrides", overrideCount}, {"seconds", compile}}.dump() << '\n';
+
+    const auto indexed = [&](const std::string& p) { return index->best(p, Action::Read).has_value(); };
+    std::cout << measure("indexed", overrideCount, paths, indexed).dump() << '\n';
+    std::cout << measure("cached", overrideCount, paths, indexed).dump() << '\n';
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,127 @@
+// Thumbnail throughput over a fixed corpus: the single-decode pyramid used by the thumbnail
+// worker against the old one-decode-per-size path. Prints one JSON object per mode.
+//
+//   vh_thumb_bench [--iterations N] [--sizes 128,256,512] [corpus dir]
+
+#include "preview/image.hpp"
+#include "preview/pdf.hpp"
+#include "preview/thumbnail/ops.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Sample {
+    std::string name, mime;
+    std::vector<uint8_t> bytes;
+};
+
+std::optional<std::string> mimeFor(std::filesystem::path path) {
+    auto ext = path.extension().string();
+    std::ranges::transform(ext, ext.begin(), ::tolower);
+    if (ext == ".jpg" || ext == ".jpeg") return "image/jpeg";
+    if (ext == ".png") return "image/png";
+    if (ext == ".pdf") return "application/pdf";
+    return std::nullopt;
+}
+
+std::vector<Sample> loadCorpus(const std::filesystem::path& dir) {
+    std::vector<Sample> corpus;
+    for (const auto& entry : std::filesystem::directory_iterator(dir)) {
+        if (!entry.is_regular_file()) continue;
+        const auto mime = mimeFor(entry.path());
+        if (!mime) continue;
+
+        std::ifstream in(entry.path(), std::ios::binary);
+        corpus.push_back({
+            .name = entry.path().filename().string(),
+            .mime = *mime,
+            .bytes = {std::istreambuf_iterator<char>(in), {}}
+        });
+    }
+    std::ranges::sort(corpus, {}, &Sample::name);
+    return corpus;
+}
+
+std::vector<unsigned int> parseSizes(const std::string& csv) {
+    std::vector<unsigned int> sizes;
+    std::stringstream ss(csv);
+    for (std::string part; std::getline(ss, part, ',');)
+        if (!part.empty()) sizes.push_back(static_cast<unsigned int>(std::stoul(part)));
+    return sizes;
+}
+
+nlohmann::json run(const std::string& mode, const std::vector<Sample>& corpus, const unsigned int iterations,
+                   const std::function<size_t(const Sample&)>& thumbnail) {
+    size_t images = 0, bytesOut = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < iterations; ++i)
+        for (const auto& sample : corpus) {
+            bytesOut += thumbnail(sample);
+            ++images;
+        }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    return {
+        {"bench", "thumbnail"},
+        {"mode", mode},
+        {"images", images},
+        {"seconds", elapsed.count()},
+        {"images_per_sec", elapsed.count() > 0 ? static_cast<double>(images) / elapsed.count() : 0.0},
+        {"bytes_out", bytesOut}
+    };
+}
+
+}
+
+int main(const int argc, char** argv) {
+    unsigned int iterations = 10;
+    std::vector<unsigned int> sizes{128, 256, 512};
+    std::filesystem::path corpusDir = VH_BENCH_CORPUS;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--iterations" && i + 1 < argc) iterations = static_cast<unsigned int>(std::stoul(argv[++i]));
+        else if (arg == "--sizes" && i + 1 < argc) sizes = parseSizes(argv[++i]);
+        else corpusDir = arg;
+    }
+
+    const auto corpus = loadCorpus(corpusDir);
+    if (corpus.empty() || sizes.empty()) {
+        std::cerr << "vh_thumb_bench: no images under " << corpusDir << " or no sizes given\n";
+        return EXIT_FAILURE;
+    }
+
+    using namespace vh::preview;
+
+    const auto pyramid = run("pyramid", corpus, iterations, [&](const Sample& s) {
+        size_t out = 0;
+        for (const auto& jpeg : thumbnail::generate(s.bytes, s.mime, sizes)) out += jpeg.size();
+        return out;
+    });
+
+    const auto perSize = run("per_size", corpus, iterations, [&](const Sample& s) {
+        size_t out = 0;
+        for (const auto size : sizes) {
+            const auto box = std::make_optional(std::to_string(size));
+            out += s.mime == "application/pdf"
+                       ? pdf::resize_and_compress_buffer(s.bytes.data(), s.bytes.size(), std::nullopt, box).size()
+                       : image::resize_and_compress_buffer(s.bytes.data(), s.bytes.size(), std::nullopt, box).size();
+        }
+        return out;
+    });
+
+    std::cout << pyramid.dump() << '\n' << perSize.dump() << '\n';
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,170 @@
+// Download chunk round trips over a loopback WebSocket: base64-in-JSON text frames against
+// binary TransferFrames followed by the same JSON ack. The server side encodes each chunk the
+// way the share download handler does, the client decodes it back to raw bytes. Prints one
+// JSON object per mode.
+//
+//   vh_ws_transfer_bench [--megabytes N] [--chunk-kb K]
+
+#include "protocols/ws/model/TransferFrame.hpp"
+
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/websocket.hpp>
+#include <nlohmann/json.hpp>
+#include <sodium.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+namespace asio = boost::asio;
+namespace beast = boost::beast;
+namespace websocket = beast::websocket;
+using tcp = asio::ip::tcp;
+using vh::protocols::ws::model::TransferFrame;
+
+constexpr auto TRANSFER_ID = "6b0f2a5e-3c1d-4e7f-9a8b-1c2d3e4f5a6b";
+
+std::string base64(const std::vector<uint8_t>& bytes) {
+    std::string out(sodium_base64_ENCODED_LEN(bytes.size(), sodium_base64_VARIANT_ORIGINAL), '\0');
+    sodium_bin2base64(out.data(), out.size(), bytes.data(), bytes.size(), sodium_base64_VARIANT_ORIGINAL);
+    out.resize(std::strlen(out.c_str()));
+    return out;
+}
+
+std::vector<uint8_t> unbase64(const std::string& text) {
+    std::vector<uint8_t> out(text.size() / 4 * 3 + 3);
+    size_t len = 0;
+    if (sodium_base642bin(out.data(), out.size(), text.data(), text.size(), nullptr, &len, nullptr,
+                          sodium_base64_VARIANT_ORIGINAL) != 0)
+        throw std::runtime_error("bad base64");
+    out.resize(len);
+    return out;
+}
+
+// Server: answers each request the way share/Download.cpp does. Both modes send the JSON ack;
+// base64 carries the chunk inside it, binary sends a TransferFrame ahead of it.
+void serve(tcp::acceptor& acceptor, const std::vector<uint8_t>& chunk, const bool binary) {
+    // Like ws::Server; without it the frame-then-ack pair stalls on Nagle and delayed ACKs
+    tcp::socket socket = acceptor.accept();
+    socket.set_option(tcp::no_delay(true));
+    websocket::stream<tcp::socket> ws(std::move(socket));
+    ws.accept();
+
+    beast::flat_buffer request;
+    uint64_t offset = 0;
+    for (;;) {
+        beast::error_code ec;
+        ws.read(request, ec);
+        if (ec) return;
+        request.consume(request.size());
+
+        nlohmann::json data = {
+            {"transfer_id", TRANSFER_ID},
+            {"offset", offset},
+            {"bytes", chunk.size()},
+            {"encoding", binary ? "binary" : "base64"},
+            {"next_offset", offset + chunk.size()},
+            {"complete", false}
+        };
+
+        if (binary) {
+            ws.binary(true);
+            ws.write(asio::buffer(TransferFrame::encode(TRANSFER_ID, offset, TransferFrame::None, chunk)));
+        } else {
+            data["data_base64"] = base64(chunk);
+        }
+
+        const nlohmann::json msg = {
+            {"command", "share.download.chunk"},
+            {"status", "ok"},
+            {"data", std::move(data)}
+        };
+        ws.binary(false);
+        ws.write(asio::buffer(msg.dump()));
+        offset += chunk.size();
+    }
+}
+
+nlohmann::json run(const bool binary, const size_t chunkBytes, const uint64_t totalBytes) {
+    asio::io_context ioc;
+    tcp::acceptor acceptor(ioc, {asio::ip::make_address("127.0.0.1"), 0});
+    const auto port = acceptor.local_endpoint().port();
+
+    const std::vector<uint8_t> chunk(chunkBytes, 0x5a);
+    std::thread server([&] { serve(acceptor, chunk, binary); });
+
+    websocket::stream<tcp::socket> ws(ioc);
+    ws.next_layer().connect({asio::ip::make_address("127.0.0.1"), port});
+    ws.next_layer().set_option(tcp::no_delay(true));
+    ws.handshake("127.0.0.1", "/");
+
+    const std::string request = R"({"command":"share.download.chunk"})";
+    beast::flat_buffer response;
+    uint64_t received = 0, wireBytes = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    while (received < totalBytes) {
+        ws.write(asio::buffer(request));
+
+        if (binary) {
+            ws.read(response);
+            wireBytes += response.size();
+            const auto* data = static_cast<const uint8_t*>(response.data().data());
+            received += TransferFrame::decode({data, response.size()}).payload.size();
+            response.consume(response.size());
+        }
+
+        // The ack is parsed in both modes, since the client has to read it either way
+        ws.read(response);
+        wireBytes += response.size();
+        const auto msg = nlohmann::json::parse(beast::buffers_to_string(response.data()));
+        if (!binary) received += unbase64(msg.at("data").at("data_base64").get<std::string>()).size();
+        response.consume(response.size());
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    ws.close(websocket::close_code::normal);
+    server.join();
+
+    return {
+        {"bench", "ws_transfer"},
+        {"mode", binary ? "binary_frame" : "json_base64"},
+        {"chunk_bytes", chunkBytes},
+        {"payload_bytes", received},
+        {"wire_bytes", wireBytes},
+        {"seconds", elapsed.count()},
+        {"mb_per_sec", elapsed.count() > 0 ? static_cast<double>(received) / (1024.0 * 1024.0) / elapsed.count() : 0.0}
+    };
+}
+
+}
+
+int main(const int argc, char** argv) {
+    uint64_t megabytes = 256;
+    size_t chunkKb = 64;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--megabytes" && i + 1 < argc) megabytes = std::stoull(argv[++i]);
+        else if (arg == "--chunk-kb" && i + 1 < argc) chunkKb = std::stoul(argv[++i]);
+    }
+
+    if (sodium_init() < 0 || chunkKb == 0) {
+        std::cerr << "vh_ws_transfer_bench: libsodium init failed or empty chunk size\n";
+        return EXIT_FAILURE;
+    }
+
+    const auto total = megabytes * 1024 * 1024;
+    std::cout << run(false, chunkKb * 1024, total).dump() << '\n'
+              << run(true, chunkKb * 1024, total).dump() << '\n';
+    return EXIT_SUCCESS;
+}
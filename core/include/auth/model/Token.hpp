@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <string>
 #include <optional>
@@ -23,10 +24,12 @@ struct Token {
     uint32_t userId{};
     std::chrono::system_clock::time_point issuedAt = std::chrono::system_clock::now();
     std::chrono::system_clock::time_point expiresAt = std::chrono::system_clock::now();
-    bool revoked{false};
+    std::atomic<bool> revoked{false};   // revoke() can race with handlers reading it on the ws pool
 
     virtual ~Token() = default;
     Token() = default;
+    Token(const Token& other);
+    Token& operator=(const Token& other);
     explicit Token(std::string rawToken);
     explicit Token(const pqxx::row& row);
 
@@ -34,7 +37,8 @@ struct Token {
     [[nodiscard]] virtual bool isValid() const;
     [[nodiscard]] std::chrono::seconds timeRemaining() const;
 
-    void revoke() { revoked = true; }
+    [[nodiscard]] bool isRevoked() const { return revoked.load(std::memory_order_acquire); }
+    void revoke() { revoked.store(true, std::memory_order_release); }
 
     [[nodiscard]] virtual Type type() const { return Type::Access; }
     virtual void dangerousDivergence(const std::optional<session::TokenClaims>& claims) const;
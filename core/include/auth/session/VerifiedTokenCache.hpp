@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+
+namespace vh::auth::model { struct Token; }
+
+namespace vh::auth::session {
+
+// Remembers the access token a WebSocket session last proved, keyed by a hash of the raw
+// token, so steady-state messages can skip JWT decoding and claim checks. A hit also requires
+// the token object to still be the session's current, unrevoked access token, so rotation
+// and revocation take effect on the very next message.
+class VerifiedTokenCache {
+public:
+    using Clock = std::chrono::system_clock;
+
+    // Upper bound on how long a verification is trusted before the full path runs again.
+    static constexpr std::chrono::seconds MAX_TTL{60};
+
+    [[nodiscard]] bool verified(std::string_view rawToken,
+                                const std::shared_ptr<model::Token>& current,
+                                Clock::time_point now = Clock::now()) const;
+
+    // renewWindow keeps the entry from outliving the point where the token should be reissued.
+    void remember(std::string_view rawToken,
+                  const std::shared_ptr<model::Token>& token,
+                  std::chrono::seconds renewWindow,
+                  Clock::time_point now = Clock::now());
+
+    void clear();
+
+private:
+    using Digest = std::array<uint8_t, 32>;
+
+    struct Entry {
+        Digest digest{};
+        std::weak_ptr<model::Token> token;
+        Clock::time_point until;
+    };
+
+    mutable std::mutex mutex_;
+    std::optional<Entry> entry_;
+
+    static Digest digest(std::string_view rawToken);
+};
+
+}
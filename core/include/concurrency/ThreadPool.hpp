@@ -7,18 +7,22 @@
 #include <memory>
 #include <mutex>
 #include <queue>
+#include <string_view>
 #include <thread>
 #include <vector>
 #include <chrono>
 
+namespace vh::stats::model { class Histogram; }
+
 namespace vh::concurrency {
 
 class ThreadPoolManager; // forward decl
 
 class ThreadPool {
 public:
+    // A named pool reports how long tasks sit in its queue (stats::Metric::PoolQueueWait)
     explicit ThreadPool(const std::shared_ptr<std::atomic<bool>>& interruptFlag,
-               unsigned int nThreads = 0);
+               unsigned int nThreads = 0, std::string_view name = {});
 
     ~ThreadPool();
 
@@ -48,7 +52,12 @@ private:
 
     std::condition_variable cv;
     mutable std::mutex mutex;
-    std::queue<std::shared_ptr<Task>> queue;
+    struct Queued {
+        std::shared_ptr<Task> task;
+        std::chrono::steady_clock::time_point since;
+    };
+    std::queue<Queued> queue;
+    stats::model::Histogram* queueWait_ = nullptr;
 
     std::shared_ptr<std::atomic<bool>> interruptFlag;
     std::atomic<bool> stopFlag{false};
@@ -29,17 +29,20 @@ public:
         const unsigned int base = totalThreads_ / NUM_POOLS;
         const unsigned int rem  = totalThreads_ % NUM_POOLS;
 
+        // The remainder goes to the latency-sensitive pools first, so the pools sum to totalThreads_
         unsigned int fuseN  = base + (rem > 0 ? 1 : 0);
         unsigned int syncN  = base + (rem > 1 ? 1 : 0);
-        unsigned int thumbN = base; // thumb/http get no extra by default
-        unsigned int httpN  = base;
+        unsigned int wsN    = base + (rem > 2 ? 1 : 0);
+        unsigned int httpN  = base + (rem > 3 ? 1 : 0);
+        unsigned int thumbN = base + (rem > 4 ? 1 : 0);
         unsigned int statsN = base;
 
-        fuse_  = std::make_shared<ThreadPool>(nullptr, fuseN);
-        sync_  = std::make_shared<ThreadPool>(nullptr, syncN);
-        thumb_ = std::make_shared<ThreadPool>(nullptr, thumbN);
-        http_  = std::make_shared<ThreadPool>(nullptr, httpN);
-        stats_ = std::make_shared<ThreadPool>(nullptr, statsN);
+        fuse_  = std::make_shared<ThreadPool>(nullptr, fuseN, "fuse");
+        sync_  = std::make_shared<ThreadPool>(nullptr, syncN, "sync");
+        thumb_ = std::make_shared<ThreadPool>(nullptr, thumbN, "thumb");
+        http_  = std::make_shared<ThreadPool>(nullptr, httpN, "http");
+        stats_ = std::make_shared<ThreadPool>(nullptr, statsN, "stats");
+        ws_    = std::make_shared<ThreadPool>(nullptr, wsN, "ws");
 
         stopFlag_.store(false);
 
@@ -63,6 +66,7 @@ public:
         if (thumb_) thumb_->stop();
         if (http_)  http_->stop();
         if (stats_) stats_->stop();
+        if (ws_)    ws_->stop();
 
         running_.store(false);
     }
@@ -72,6 +76,7 @@ public:
     std::shared_ptr<ThreadPool>& thumbPool() { return thumb_; }
     std::shared_ptr<ThreadPool>& httpPool() { return http_; }
     std::shared_ptr<ThreadPool>& statsPool() { return stats_; }
+    std::shared_ptr<ThreadPool>& wsPool() { return ws_; }
 
     void signalPressureChange() {
         {
@@ -100,6 +105,7 @@ private:
             const auto httpQ  = http_->queueDepth();
             const auto thumbQ = thumb_->queueDepth();
             const auto statsQ = stats_->queueDepth();
+            const auto wsQ    = ws_->queueDepth();
 
             // Compare backlog/worker ratios
             const auto fuseRatio  = fuseQ  / std::max(1u, fuse_->workerCount());
@@ -107,10 +113,12 @@ private:
             const auto httpRatio  = httpQ  / std::max(1u, http_->workerCount());
             const auto thumbRatio = thumbQ / std::max(1u, thumb_->workerCount());
             const auto statsRatio = statsQ / std::max(1u, stats_->workerCount());
+            const auto wsRatio    = wsQ    / std::max(1u, ws_->workerCount());
 
             maybeReassign(fuse_, http_, fuseRatio, httpRatio);
             maybeReassign(fuse_, stats_, fuseRatio, statsRatio);
             maybeReassign(sync_, thumb_, syncRatio, thumbRatio);
+            maybeReassign(ws_, stats_, wsRatio, statsRatio);
         }
     }
 
@@ -130,8 +138,8 @@ private:
         }
     }
 
-    static constexpr unsigned int RESERVE_FACTOR = 3, NUM_POOLS = 4;
-    std::shared_ptr<ThreadPool> fuse_, sync_, thumb_, http_, stats_;
+    static constexpr unsigned int RESERVE_FACTOR = 3, NUM_POOLS = 6;
+    std::shared_ptr<ThreadPool> fuse_, sync_, thumb_, http_, stats_, ws_;
     std::atomic<bool> stopFlag_{false};
     std::atomic<bool> running_{false};
     std::thread monitorThread_;
@@ -20,6 +20,8 @@ struct WebsocketConfig {
     uint16_t port = 33369;
     unsigned int max_connections = 1024;
     uintmax_t max_upload_size_bytes = MAX_UPLOAD_SIZE_BYTES;
+    unsigned int io_threads = 0;                 // 0 = derive from hardware concurrency
+    unsigned int max_in_flight_per_session = 16; // queued messages before reads pause
 };
 
 struct HttpPreviewConfig {
@@ -28,6 +30,12 @@ struct HttpPreviewConfig {
     uint16_t port = 33370;
     unsigned int max_connections = 512;
     uintmax_t max_preview_size_bytes = MAX_PREVIEW_SIZE_BYTES;
+    unsigned int io_threads = 0;                    // 0 = derive from hardware concurrency
+    unsigned int header_limit_kb = 16;              // request line + headers
+    unsigned int body_limit_kb = 64;                // request body; previews and downloads are GETs
+    unsigned int keep_alive_timeout_seconds = 30;   // idle time allowed between requests
+    unsigned int max_requests_per_connection = 1000; // 0 = unlimited
+    bool metrics_endpoint = true;                   // GET /metrics (Prometheus text), loopback clients only
 };
 
 struct ThumbnailsConfig {
@@ -38,6 +46,12 @@ struct ThumbnailsConfig {
 
 struct CachingConfig {
     unsigned int max_size_mb = 10240;
+    unsigned int render_cache_mb = 256;
+    unsigned int permission_decision_cache_entries = 65536;   // 0 disables the RBAC override decision cache
+    unsigned int fs_eager_depth = 2;                          // directory levels below / loaded at startup; deeper ones load on first access
+    bool fs_snapshot = true;                                  // warm-start the entry cache from a snapshot written at shutdown
+    unsigned int fs_negative_ttl_ms = 1000;                   // how long a missing path stays known-missing; the kernel gets at most 100ms; 0 disables
+    unsigned int fs_negative_entries = 65536;                 // remembered missing paths and entry ids
     ThumbnailsConfig thumbnails;
 };
 
@@ -46,12 +60,18 @@ struct DatabaseConfig {
     uint16_t port = 5432;
     std::string name = "vaulthalla";
     std::string user = "vaulthalla";
-    int pool_size = 10;
+    int pool_size = 10;                              // max connections; the pool grows to this under load
+    int pool_min_size = 2;                           // connections kept open while idle
+    unsigned int acquire_timeout_ms = 5000;          // wait for a free connection before failing the call
+    unsigned int validate_idle_after_seconds = 30;   // ping connections idle longer than this before reuse
+    unsigned int pool_idle_timeout_seconds = 300;    // close connections above pool_min_size idle this long
 };
 
 struct AuthConfig {
     unsigned int access_token_expiry_minutes = 60;
     unsigned int refresh_token_expiry_days = 7;
+    unsigned int argon2_memory_budget_mb = 1024;    // concurrent Argon2 calls = budget / 256 MB
+    unsigned int argon2_max_queued = 64;            // password checks waiting beyond this are refused
 };
 
 struct SyncConfig {
@@ -77,6 +97,9 @@ struct ServicesConfig {
 struct SharingConfig {
     bool enabled = true;
     bool enable_public_links = true;
+    unsigned int audit_batch_size = 500;           // audit rows per multi-row INSERT flush
+    unsigned int audit_flush_interval_ms = 250;    // oldest pending event waits at most this long
+    unsigned int audit_queue_limit = 10000;        // producers block once this many events are pending
 };
 
 struct AuditLogConfig {
@@ -84,6 +107,8 @@ struct AuditLogConfig {
     uintmax_t rotate_max_size = 50 * 1024 * 1024; // 50MB
     std::chrono::hours rotate_interval = std::chrono::hours(24);
     log::Rotator::Compression compression = log::Rotator::Compression::Zstd;
+    int compression_level = 0; // 0 = codec default (zstd 3, gzip 6)
+    uintmax_t compression_rate_limit = 32 * 1024 * 1024; // bytes/s read by the background compressor, 0 = unthrottled
     uintmax_t max_retained_logs_size = 1024 * 1024 * 1024; // 1GB
     bool strict_retention = false; // If true, retain logs for full retention days minimum, even if over the size limit
 };
@@ -102,6 +127,14 @@ struct AuditConfig {
     FilesTrashedConfig files_trashed;
 };
 
+struct TracingConfig {
+    bool enabled = true;
+    double sample_rate = 0.001;                 // fraction of root operations kept regardless of duration
+    unsigned int slow_threshold_ms = 250;       // always keep traces at least this slow, 0 = off
+    unsigned int buffer_traces = 512;           // recent traces held in memory for `vh trace`
+    unsigned int max_spans_per_trace = 256;     // nested spans past this are counted, not recorded
+};
+
 struct DevConfig {
     bool enabled = false;
     bool init_r2_test_vault = false;
@@ -131,8 +164,16 @@ struct LogLevelsConfig {
     SubsystemLogLevelsConfig subsystem_levels;
 };
 
+struct AsyncLoggingConfig {
+    bool enabled = true;
+    size_t queue_size = 8192;                      // messages buffered ahead of the writer thread
+    unsigned int threads = 1;                      // writer threads draining the queue
+    std::string overflow_policy = "overrun_oldest"; // or "block": stall callers until there is room
+};
+
 struct LoggingConfig {
     LogLevelsConfig levels;
+    AsyncLoggingConfig async;
 };
 
 struct Config {
@@ -145,6 +186,7 @@ struct Config {
     ServicesConfig services;
     SharingConfig sharing;
     AuditConfig auditing;
+    TracingConfig tracing;
     DevConfig dev;
 
     LoggingConfig logging; // internal only
@@ -165,6 +207,8 @@ void to_json(nlohmann::json& j, const SubsystemLogLevelsConfig& c);
 void from_json(const nlohmann::json& j, SubsystemLogLevelsConfig& c);
 void to_json(nlohmann::json& j, const LoggingConfig& c);
 void from_json(const nlohmann::json& j, LoggingConfig& c);
+void to_json(nlohmann::json& j, const AsyncLoggingConfig& c);
+void from_json(const nlohmann::json& j, AsyncLoggingConfig& c);
 void to_json(nlohmann::json& j, const ThumbnailsConfig& c);
 void from_json(const nlohmann::json& j, ThumbnailsConfig& c);
 void to_json(nlohmann::json& j, const CachingConfig& c);
@@ -191,6 +235,8 @@ void to_json(nlohmann::json& j, const FilesTrashedConfig& c);
 void from_json(const nlohmann::json& j, FilesTrashedConfig& c);
 void to_json(nlohmann::json& j, const AuditConfig& c);
 void from_json(const nlohmann::json& j, AuditConfig& c);
+void to_json(nlohmann::json& j, const TracingConfig& c);
+void from_json(const nlohmann::json& j, TracingConfig& c);
 void to_json(nlohmann::json& j, const DevConfig& c);
 void from_json(const nlohmann::json& j, DevConfig& c);
 
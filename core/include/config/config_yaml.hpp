@@ -18,6 +18,8 @@ struct convert<WebsocketConfig> {
         node["port"] = rhs.port;
         node["max_connections"] = rhs.max_connections;
         node["max_upload_size_bytes"] = rhs.max_upload_size_bytes;
+        node["io_threads"] = rhs.io_threads;
+        node["max_in_flight_per_session"] = rhs.max_in_flight_per_session;
         return node;
     }
 
@@ -28,6 +30,8 @@ struct convert<WebsocketConfig> {
         rhs.port = node["port"].as<uint16_t>(8080);
         rhs.max_connections = node["max_connections"].as<unsigned int>(1024);
         rhs.max_upload_size_bytes = node["max_upload_size_mb"].as<uintmax_t>(2048) * 1024 * 1024; // Default 2GB
+        rhs.io_threads = node["io_threads"].as<unsigned int>(0);
+        rhs.max_in_flight_per_session = node["max_in_flight_per_session"].as<unsigned int>(16);
         return true;
     }
 };
@@ -41,6 +45,12 @@ struct convert<HttpPreviewConfig> {
         node["port"] = rhs.port;
         node["max_connections"] = rhs.max_connections;
         node["max_preview_size_bytes"] = rhs.max_preview_size_bytes;
+        node["io_threads"] = rhs.io_threads;
+        node["header_limit_kb"] = rhs.header_limit_kb;
+        node["body_limit_kb"] = rhs.body_limit_kb;
+        node["keep_alive_timeout_seconds"] = rhs.keep_alive_timeout_seconds;
+        node["max_requests_per_connection"] = rhs.max_requests_per_connection;
+        node["metrics_endpoint"] = rhs.metrics_endpoint;
         return node;
     }
 
@@ -51,6 +61,12 @@ struct convert<HttpPreviewConfig> {
         rhs.port = node["port"].as<uint16_t>(8081);
         rhs.max_connections = node["max_connections"].as<unsigned int>(512);
         rhs.max_preview_size_bytes = node["max_preview_size_mb"].as<uintmax_t>(100) * 1024 * 1024; // Default 100MB
+        rhs.io_threads = node["io_threads"].as<unsigned int>(0);
+        rhs.header_limit_kb = node["header_limit_kb"].as<unsigned int>(16);
+        rhs.body_limit_kb = node["body_limit_kb"].as<unsigned int>(64);
+        rhs.keep_alive_timeout_seconds = node["keep_alive_timeout_seconds"].as<unsigned int>(30);
+        rhs.max_requests_per_connection = node["max_requests_per_connection"].as<unsigned int>(1000);
+        rhs.metrics_endpoint = node["metrics_endpoint"].as<bool>(true);
         return true;
     }
 };
@@ -119,18 +135,41 @@ struct convert<LogLevelsConfig> {
     }
 };
 
+template<>
+struct convert<AsyncLoggingConfig> {
+    static Node encode(const AsyncLoggingConfig& rhs) {
+        Node node;
+        node["enabled"] = rhs.enabled;
+        node["queue_size"] = rhs.queue_size;
+        node["threads"] = rhs.threads;
+        node["overflow_policy"] = rhs.overflow_policy;
+        return node;
+    }
+
+    static bool decode(const Node& node, AsyncLoggingConfig& rhs) {
+        if (!node.IsMap()) return false;
+        rhs.enabled = node["enabled"].as<bool>(true);
+        rhs.queue_size = node["queue_size"].as<size_t>(8192);
+        rhs.threads = node["threads"].as<unsigned int>(1);
+        rhs.overflow_policy = node["overflow_policy"].as<std::string>("overrun_oldest");
+        return true;
+    }
+};
+
 // LoggingConfig
 template<>
 struct convert<LoggingConfig> {
     static Node encode(const LoggingConfig& rhs) {
         Node node;
         node["log_levels"] = rhs.levels;
+        node["async"] = rhs.async;
         return node;
     }
 
     static bool decode(const Node& node, LoggingConfig& rhs) {
         if (!node.IsMap()) return false;
         rhs.levels = node["log_levels"].as<LogLevelsConfig>();
+        if (node["async"]) rhs.async = node["async"].as<AsyncLoggingConfig>();
         return true;
     }
 };
@@ -159,6 +198,12 @@ struct convert<CachingConfig> {
     static Node encode(const CachingConfig& rhs) {
         Node node;
         node["max_size_mb"] = rhs.max_size_mb;
+        node["render_cache_mb"] = rhs.render_cache_mb;
+        node["permission_decision_cache_entries"] = rhs.permission_decision_cache_entries;
+        node["fs_eager_depth"] = rhs.fs_eager_depth;
+        node["fs_snapshot"] = rhs.fs_snapshot;
+        node["fs_negative_ttl_ms"] = rhs.fs_negative_ttl_ms;
+        node["fs_negative_entries"] = rhs.fs_negative_entries;
         node["thumbnails"] = rhs.thumbnails;
         return node;
     }
@@ -166,6 +211,12 @@ struct convert<CachingConfig> {
     static bool decode(const Node& node, CachingConfig& rhs) {
         if (!node.IsMap()) return false;
         rhs.max_size_mb = node["max_size_mb"].as<unsigned int>(10240);
+        rhs.render_cache_mb = node["render_cache_mb"].as<unsigned int>(256);
+        rhs.permission_decision_cache_entries = node["permission_decision_cache_entries"].as<unsigned int>(65536);
+        rhs.fs_eager_depth = node["fs_eager_depth"].as<unsigned int>(2);
+        rhs.fs_snapshot = node["fs_snapshot"].as<bool>(true);
+        rhs.fs_negative_ttl_ms = node["fs_negative_ttl_ms"].as<unsigned int>(1000);
+        rhs.fs_negative_entries = node["fs_negative_entries"].as<unsigned int>(65536);
         rhs.thumbnails = node["thumbnails"].as<ThumbnailsConfig>();
         return true;
     }
@@ -180,6 +231,10 @@ struct convert<DatabaseConfig> {
         node["name"] = rhs.name;
         node["user"] = rhs.user;
         node["pool_size"] = rhs.pool_size;
+        node["pool_min_size"] = rhs.pool_min_size;
+        node["acquire_timeout_ms"] = rhs.acquire_timeout_ms;
+        node["validate_idle_after_seconds"] = rhs.validate_idle_after_seconds;
+        node["pool_idle_timeout_seconds"] = rhs.pool_idle_timeout_seconds;
         return node;
     }
 
@@ -190,6 +245,10 @@ struct convert<DatabaseConfig> {
         rhs.name = node["name"].as<std::string>("vaulthalla");
         rhs.user = node["user"].as<std::string>("vaulthalla");
         rhs.pool_size = node["pool_size"].as<int>(10);
+        rhs.pool_min_size = node["pool_min_size"].as<int>(2);
+        rhs.acquire_timeout_ms = node["acquire_timeout_ms"].as<unsigned int>(5000);
+        rhs.validate_idle_after_seconds = node["validate_idle_after_seconds"].as<unsigned int>(30);
+        rhs.pool_idle_timeout_seconds = node["pool_idle_timeout_seconds"].as<unsigned int>(300);
         return true;
     }
 };
@@ -202,6 +261,8 @@ struct convert<AuthConfig> {
         Node node;
         node["token_expiry_minutes"] = rhs.access_token_expiry_minutes;
         node["refresh_token_expiry_days"] = rhs.refresh_token_expiry_days;
+        node["argon2_memory_budget_mb"] = rhs.argon2_memory_budget_mb;
+        node["argon2_max_queued"] = rhs.argon2_max_queued;
         return node;
     }
 
@@ -209,6 +270,8 @@ struct convert<AuthConfig> {
         if (!node.IsMap()) return false;
         rhs.access_token_expiry_minutes = node["token_expiry_minutes"].as<int>(60);
         rhs.refresh_token_expiry_days = node["refresh_token_expiry_days"].as<int>(7);
+        rhs.argon2_memory_budget_mb = node["argon2_memory_budget_mb"].as<unsigned int>(1024);
+        rhs.argon2_max_queued = node["argon2_max_queued"].as<unsigned int>(64);
         return true;
     }
 };
@@ -288,6 +351,9 @@ struct convert<SharingConfig> {
         Node node;
         node["enabled"] = rhs.enabled;
         node["enable_public_links"] = rhs.enable_public_links;
+        node["audit_batch_size"] = rhs.audit_batch_size;
+        node["audit_flush_interval_ms"] = rhs.audit_flush_interval_ms;
+        node["audit_queue_limit"] = rhs.audit_queue_limit;
         return node;
     }
 
@@ -295,6 +361,9 @@ struct convert<SharingConfig> {
         if (!node.IsMap()) return false;
         rhs.enabled = node["enabled"].as<bool>(true);
         rhs.enable_public_links = node["enable_public_links"].as<bool>(true);
+        rhs.audit_batch_size = node["audit_batch_size"].as<unsigned int>(500);
+        rhs.audit_flush_interval_ms = node["audit_flush_interval_ms"].as<unsigned int>(250);
+        rhs.audit_queue_limit = node["audit_queue_limit"].as<unsigned int>(10000);
         return true;
     }
 };
@@ -307,6 +376,8 @@ struct convert<AuditLogConfig> {
         node["rotate_max_size"] = bytesToMbOrGbStr(rhs.rotate_max_size);
         node["rotate_interval"] = hoursToDayOrHourStr(rhs.rotate_interval);
         node["compression"] = compressionToString(rhs.compression);
+        node["compression_level"] = rhs.compression_level;
+        node["compression_rate_limit"] = bytesToMbOrGbStr(rhs.compression_rate_limit);
         node["max_retained_logs_size"] = bytesToMbOrGbStr(rhs.max_retained_logs_size);
         node["strict_retention"] = rhs.strict_retention;
         return node;
@@ -318,6 +389,8 @@ struct convert<AuditLogConfig> {
         rhs.rotate_max_size = parseMbOrGbToByte(node["rotate_max_size"].as<std::string>("50MB"));
         rhs.rotate_interval = parseHoursFromDayOrHour(node["rotate_interval"].as<std::string>("24h"));
         rhs.compression = parseCompression(node["compression"].as<std::string>("zstd"));
+        rhs.compression_level = node["compression_level"].as<int>(0);
+        rhs.compression_rate_limit = parseMbOrGbToByte(node["compression_rate_limit"].as<std::string>("32MB"));
         rhs.max_retained_logs_size = parseMbOrGbToByte(node["max_retained_logs_size"].as<std::string>("1GB"));
         rhs.strict_retention = node["strict_retention"].as<bool>(false);
         return true;
@@ -373,6 +446,29 @@ struct convert<AuditConfig> {
     }
 };
 
+template<>
+struct convert<TracingConfig> {
+    static Node encode(const TracingConfig& rhs) {
+        Node node;
+        node["enabled"] = rhs.enabled;
+        node["sample_rate"] = rhs.sample_rate;
+        node["slow_threshold_ms"] = rhs.slow_threshold_ms;
+        node["buffer_traces"] = rhs.buffer_traces;
+        node["max_spans_per_trace"] = rhs.max_spans_per_trace;
+        return node;
+    }
+
+    static bool decode(const Node& node, TracingConfig& rhs) {
+        if (!node.IsMap()) return false;
+        rhs.enabled = node["enabled"].as<bool>(true);
+        rhs.sample_rate = node["sample_rate"].as<double>(0.001);
+        rhs.slow_threshold_ms = node["slow_threshold_ms"].as<unsigned int>(250);
+        rhs.buffer_traces = node["buffer_traces"].as<unsigned int>(512);
+        rhs.max_spans_per_trace = node["max_spans_per_trace"].as<unsigned int>(256);
+        return true;
+    }
+};
+
 template<>
 struct convert<DevConfig> {
     static Node encode(const DevConfig& rhs) {
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace vh::crypto::password {
+
+// Thrown instead of queueing once the executor is saturated; callers answer "try again later".
+struct Overloaded : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+
+// Runs Argon2id hashing and verification on a fixed set of threads. Every call takes
+// MEMLIMIT bytes of scratch memory, so the thread count comes from a memory budget rather
+// than the core count, and work past a bounded queue is refused rather than left to pile up.
+class Executor {
+public:
+    static const unsigned long long OPSLIMIT;
+    static const size_t MEMLIMIT;
+
+    // Sized from auth.argon2_memory_budget_mb and auth.argon2_max_queued
+    static Executor& instance();
+
+    Executor(size_t memoryBudgetBytes, size_t maxQueued);
+    ~Executor();
+
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+
+    [[nodiscard]] std::future<std::string> hash(std::string password);
+    [[nodiscard]] std::future<bool> verify(std::string password, std::string hash);
+
+    [[nodiscard]] unsigned int concurrency() const { return static_cast<unsigned int>(workers_.size()); }
+    [[nodiscard]] size_t queued() const;
+
+    void stop();
+
+private:
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::function<void()>> jobs_;
+    size_t maxQueued_;
+    bool stopping_ = false;
+    std::vector<std::thread> workers_;
+
+    void submit(std::function<void()> job);
+    void run();
+};
+
+}
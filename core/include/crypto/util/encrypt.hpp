@@ -1,10 +1,14 @@
 #pragma once
 
+#include <array>
 #include <vector>
 #include <cstdint>
+#include <span>
 #include <string>
 #include <filesystem>
 
+typedef struct evp_cipher_ctx_st EVP_CIPHER_CTX;
+
 namespace vh::crypto::util {
 
 constexpr size_t AES_KEY_SIZE = 32;      // 256-bit
@@ -21,6 +25,53 @@ std::vector<uint8_t> decrypt_aes256_gcm(
     const std::vector<uint8_t>& key,
     const std::vector<uint8_t>& iv);
 
+// Incremental AES256-GCM encryption. Produces the same ciphertext || tag layout as
+// encrypt_aes256_gcm, so the result decrypts with decrypt_aes256_gcm.
+class AES256GCMEncryptor {
+public:
+    AES256GCMEncryptor(const std::vector<uint8_t>& key, std::vector<uint8_t>& out_iv);
+    ~AES256GCMEncryptor();
+
+    AES256GCMEncryptor(const AES256GCMEncryptor&) = delete;
+    AES256GCMEncryptor& operator=(const AES256GCMEncryptor&) = delete;
+
+    // Encrypts `in` into `out`, which must hold at least in.size() bytes.
+    void update(std::span<const uint8_t> in, std::span<uint8_t> out);
+
+    // Finalizes the stream and returns the authentication tag to append.
+    [[nodiscard]] std::array<uint8_t, AES_TAG_SIZE> finish();
+
+private:
+    EVP_CIPHER_CTX* ctx_ = nullptr;
+    bool finished_ = false;
+};
+
+// Incremental decryption of the encrypt_aes256_gcm layout. GCM encrypts plaintext block n
+// under the CTR counter IV || be32(n + 2), so a decryptor can start at any plaintext offset.
+// Only a stream that starts at offset 0 and covers the whole ciphertext can be authenticated;
+// mid-file starts run plain CTR and their output is unauthenticated.
+class AES256GCMDecryptor {
+public:
+    AES256GCMDecryptor(const std::vector<uint8_t>& key, const std::vector<uint8_t>& iv, uint64_t offset = 0);
+    ~AES256GCMDecryptor();
+
+    AES256GCMDecryptor(const AES256GCMDecryptor&) = delete;
+    AES256GCMDecryptor& operator=(const AES256GCMDecryptor&) = delete;
+
+    // Decrypts `in` into `out`, which must hold at least in.size() bytes.
+    void update(std::span<const uint8_t> in, std::span<uint8_t> out);
+
+    // Checks the trailing tag once every ciphertext byte has gone through update().
+    [[nodiscard]] bool verify(std::span<const uint8_t, AES_TAG_SIZE> tag);
+
+    [[nodiscard]] bool authenticated() const { return authenticated_; }
+
+private:
+    EVP_CIPHER_CTX* ctx_ = nullptr;
+    bool authenticated_ = false;
+    bool finished_ = false;
+};
+
 std::vector<uint8_t> read_file(const std::filesystem::path& path);
 
 std::string b64_encode(const std::vector<uint8_t>& data);
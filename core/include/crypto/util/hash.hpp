@@ -1,16 +1,37 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
+#include <span>
 #include <string>
 #include <filesystem>
 
+struct crypto_generichash_blake2b_state;
+
 namespace vh::crypto::hash {
 
+// Incremental BLAKE2b. Feeding a file's bytes in order yields the same digest as blake2b(path).
+class Blake2b {
+public:
+    Blake2b();
+    ~Blake2b();
+
+    void update(std::span<const uint8_t> data);
+
+    // Returns the lowercase hex digest; the hasher must not be updated afterwards.
+    [[nodiscard]] std::string finalHex();
+
+private:
+    std::unique_ptr<crypto_generichash_blake2b_state> state_;
+};
+
 std::string blake2b(const std::filesystem::path& filepath);
 
-// Hashes a password with Argon2id using libsodium
+// Hashes a password with Argon2id on the bounded password executor; throws
+// password::Overloaded rather than queueing when it is saturated
 std::string password(const std::string& password);
 
-// Verifies a password against a given Argon2id hash
+// Verifies a password against a given Argon2id hash, under the same admission control
 bool verifyPassword(const std::string& password, const std::string& hash);
 
 std::string generate_secure_password(size_t length = 128);
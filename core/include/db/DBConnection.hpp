@@ -17,6 +17,9 @@ class Connection {
 
     void initPrepared() const;
 
+    // Round trip to the server; false once the connection is gone
+    [[nodiscard]] bool ping() const;
+
   private:
     std::unique_ptr<crypto::secrets::TPMKeyProvider> tpmKeyProvider_;
     std::string DB_CONNECTION_STR;
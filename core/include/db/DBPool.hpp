@@ -1,46 +1,120 @@
 #pragma once
 
 #include "DBConnection.hpp"
+#include "stats/model/Histogram.hpp"
+
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
 #include <memory>
 #include <mutex>
-#include <queue>
+#include <stdexcept>
+
+#include <nlohmann/json_fwd.hpp>
 
 namespace vh::db {
 
+// Thrown when no connection frees up within the acquire deadline
+struct AcquireTimeout : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+
+struct PoolOptions {
+    size_t minSize = 2;
+    size_t maxSize = 10;
+    std::chrono::milliseconds acquireTimeout{5000};
+    std::chrono::seconds validateIdleAfter{30};   // borrowers ping connections idle longer than this
+    std::chrono::seconds idleTimeout{300};        // surplus over minSize is closed after idling this long
+
+    // From the database section of the config
+    static PoolOptions fromConfig();
+};
+
+struct PoolStatsSnapshot {
+    size_t open{}, inUse{}, idle{}, waiting{};
+    uint64_t opened{}, closed{}, reconnects{}, timeouts{};
+    stats::model::HistogramSnapshot wait, held;
+};
+
+void to_json(nlohmann::json& j, const PoolStatsSnapshot& s);
+
+// Elastic pool of Postgres connections. Keeps minSize open, grows to maxSize on demand and
+// trims idle surplus. Connections that sat idle are pinged before they are handed out, and
+// dead ones are replaced with a fresh connection that gets the prepared statements again.
 class DBPool {
-  public:
-    explicit DBPool(const size_t size = 4) {
-        for (size_t i = 0; i < size; ++i) pool_.push(std::make_unique<Connection>());
-    }
-
-    std::unique_ptr<Connection> acquire() {
-        std::unique_lock lock(mtx_);
-        cv_.wait(lock, [&]() { return !pool_.empty(); });
-        auto conn = std::move(pool_.front());
-        pool_.pop();
-        return conn;
-    }
-
-    void release(std::unique_ptr<Connection> conn) {
-        std::lock_guard lock(mtx_);
-        pool_.push(std::move(conn));
-        cv_.notify_one();
-    }
-
-    void initPreparedStatements() {
-        for (size_t i = 0; i < pool_.size(); ++i) {
-            auto conn = std::move(pool_.front());
-            pool_.pop();
-            conn->initPrepared();
-            pool_.push(std::move(conn));
-        }
-    }
-
-  private:
-    std::queue<std::unique_ptr<Connection>> pool_;
-    std::mutex mtx_;
+public:
+    // Hooks around the connection lifecycle; the defaults talk to Postgres
+    struct Hooks {
+        std::function<std::unique_ptr<Connection>()> open;
+        std::function<void(Connection*)> prepare;
+        std::function<bool(Connection*)> validate;
+    };
+
+    // Returns its connection to the pool on destruction; broken ones are dropped instead
+    class Lease {
+    public:
+        Lease(DBPool& pool, std::unique_ptr<Connection> conn);
+        ~Lease();
+
+        Lease(Lease&& other) noexcept;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        Lease& operator=(Lease&&) = delete;
+
+        [[nodiscard]] Connection* operator->() const { return conn_.get(); }
+        [[nodiscard]] Connection* get() const { return conn_.get(); }
+
+        void markBroken() { broken_ = true; }
+
+    private:
+        DBPool* pool_;
+        std::unique_ptr<Connection> conn_;
+        std::chrono::steady_clock::time_point since_;
+        bool broken_ = false, active_ = true;
+    };
+
+    explicit DBPool(PoolOptions options = {});
+    DBPool(PoolOptions options, Hooks hooks);
+
+    // Throws AcquireTimeout once options.acquireTimeout passes without a free connection
+    [[nodiscard]] Lease lease();
+
+    [[nodiscard]] std::unique_ptr<Connection> acquire();
+    void release(std::unique_ptr<Connection> conn, bool broken = false);
+
+    // Prepares every open connection, and every one opened from here on
+    void initPreparedStatements();
+
+    [[nodiscard]] const PoolOptions& options() const { return options_; }
+    [[nodiscard]] PoolStatsSnapshot stats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Idle {
+        std::unique_ptr<Connection> conn;
+        Clock::time_point since;
+    };
+
+    PoolOptions options_;
+    Hooks hooks_;
+
+    mutable std::mutex mutex_;
     std::condition_variable cv_;
+    std::deque<Idle> idle_;          // most recently used at the back
+    size_t open_ = 0, inUse_ = 0, waiting_ = 0;
+    uint64_t opened_ = 0, closed_ = 0, reconnects_ = 0, timeouts_ = 0;
+    bool prepared_ = false;
+
+    stats::model::Histogram wait_, held_;
+
+    [[nodiscard]] std::unique_ptr<Connection> openSlot(Clock::time_point start);
+    void trimIdle(std::deque<Idle>& closing, Clock::time_point now);
+    void recordWait(Clock::time_point start);
 };
 
 }
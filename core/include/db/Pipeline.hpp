@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <optional>
+#include <pqxx/pqxx>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace vh::db {
+
+// Queues prepared statements on a transaction and ships them to the server as one batch, so a
+// flow that needs several independent lookups pays one round trip instead of one per statement.
+// Statements run in the order they were queued; the batch goes out on the first retrieve().
+//
+//   Pipeline pipe(txn);
+//   const auto roles = pipe.prepped("vault_role_assignment_list_by_subject", "user", userId);
+//   const auto groups = pipe.prepped("list_groups_for_user", userId);
+//   const auto rolesRes = pipe.retrieve(roles);   // both statements answered here
+//
+// The transaction can't run anything else while a Pipeline is attached to it, and complete()
+// has to run before it moves on: a failed statement nobody retrieved would otherwise go unnoticed.
+class Pipeline {
+public:
+    using Handle = long;
+
+    // Serial sends every statement on its own as it is queued; the round-trip bench uses it as its baseline
+    enum class Mode { Batched, Serial };
+
+    explicit Pipeline(pqxx::work& txn);
+    Pipeline(pqxx::work& txn, Mode mode);
+
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+
+    template <typename... Args>
+    Handle prepped(const std::string_view statement, const Args&... args) {
+        ++statements_;
+        if (mode_ == Mode::Serial) {
+            ++roundTrips_;
+            results_.push_back(txn_.exec(pqxx::prepped{std::string(statement)}, pqxx::params{args...}));
+            return static_cast<Handle>(results_.size() - 1);
+        }
+        return queue(statement, {txn_.quote(args)...});
+    }
+
+    // Result of a queued statement; rethrows the statement's error. Each handle can be retrieved once.
+    [[nodiscard]] pqxx::result retrieve(Handle handle);
+
+    // Collects whatever is still outstanding and detaches from the transaction
+    void complete();
+
+    [[nodiscard]] size_t statements() const { return statements_; }
+    [[nodiscard]] size_t roundTrips() const { return roundTrips_; }
+
+    static void setDefaultMode(Mode mode) { defaultMode_.store(mode, std::memory_order_relaxed); }
+    [[nodiscard]] static Mode defaultMode() { return defaultMode_.load(std::memory_order_relaxed); }
+
+private:
+    inline static std::atomic<Mode> defaultMode_{Mode::Batched};
+
+    pqxx::work& txn_;
+    Mode mode_;
+    std::optional<pqxx::pipeline> pipe_;
+    std::vector<Handle> queued_;
+    std::unordered_set<Handle> retrieved_;
+    std::vector<pqxx::result> results_;   // Serial only
+    size_t statements_ = 0, roundTrips_ = 0;
+    std::optional<Handle> lastSent_;
+
+    Handle queue(std::string_view statement, const std::vector<std::string>& quotedArgs);
+};
+
+}
@@ -2,6 +2,8 @@
 
 #include "DBPool.hpp"
 #include "log/Registry.hpp"
+#include "stats/Metrics.hpp"
+#include "stats/Trace.hpp"
 
 #include <memory>
 #include <pqxx/pqxx>
@@ -16,7 +18,19 @@ namespace vh::db {
     public:
         static inline std::shared_ptr<DBPool> dbPool_;
 
-        static void init() { dbPool_ = std::make_shared<DBPool>(); }
+        static void init() {
+            dbPool_ = std::make_shared<DBPool>(PoolOptions::fromConfig());
+
+            auto& metrics = stats::Metrics::instance();
+            metrics.bind(stats::Metric::DbAcquire, {}, [pool = std::weak_ptr(dbPool_)] {
+                const auto p = pool.lock();
+                return p ? p->stats().wait : stats::model::HistogramSnapshot{};
+            });
+            metrics.bind(stats::Metric::DbHold, {}, [pool = std::weak_ptr(dbPool_)] {
+                const auto p = pool.lock();
+                return p ? p->stats().held : stats::model::HistogramSnapshot{};
+            });
+        }
 
         template <typename Func>
         static decltype(auto) exec(const std::string& ctx, Func&& func) {
@@ -26,30 +40,36 @@ namespace vh::db {
             if (!dbPool_) throw std::runtime_error("Transactions not initialized!");
 
             log::Registry::db()->trace("[Transactions::exec] Starting transaction: {}", ctx);
+            const stats::trace::Span span("db.tx", ctx);
 
-            auto conn = dbPool_->acquire();
-            pqxx::work txn(conn->get());
+            // Outlives txn, so an aborted transaction rolls back before the connection returns to the pool
+            auto conn = dbPool_->lease();
+
+            static auto& latency = stats::Metrics::instance().histogram(stats::Metric::DbTransaction);
 
             try {
+                const stats::ScopedTimer timer(latency);
+                pqxx::work txn(conn->get());
                 if constexpr (std::is_void_v<ReturnT>) {
                     func(txn);
                     txn.commit();
                     log::Registry::db()->trace("[Transactions::exec] Transaction committed: {}", ctx);
-                    dbPool_->release(std::move(conn));
                     return;
                 } else {
                     ReturnT result = func(txn);
                     txn.commit();
                     log::Registry::db()->trace("[Transactions::exec] Transaction committed: {}", ctx);
-                    dbPool_->release(std::move(conn));
                     return result;
                 }
+            } catch (const pqxx::broken_connection&) {
+                log::Registry::db()->error("[Transactions::exec] Lost database connection in '{}'", ctx);
+                conn.markBroken();
+                throw;
             } catch (...) {
                 log::Registry::db()->error(
                     "[Transactions::exec] Exception in transaction context '{}', rolling back",
                     ctx
                 );
-                dbPool_->release(std::move(conn));
                 throw;
             }
         }
@@ -4,6 +4,7 @@
 #include <memory>
 #include <vector>
 #include <optional>
+#include <string>
 #include <pqxx/result>
 
 namespace fs = std::filesystem;
@@ -31,6 +32,12 @@ public:
 
     [[nodiscard]] static ino_t getNextInode();
 
+    // Bumped by every statement touching fs_entry, files or directories; 0 until the first write
+    [[nodiscard]] static uint64_t getGeneration();
+
+    // Names the database history getGeneration() counts within; changes when a reset or restore rewinds it
+    [[nodiscard]] static std::string getEpoch();
+
     [[nodiscard]] static bool rootExists();
 
     [[nodiscard]] static EntryPtr getRootEntry();
@@ -11,7 +11,7 @@ namespace vh::fs::model {
 struct Entry;
 struct File;
 struct Directory;
-namespace file { struct Trashed; }
+namespace file { struct Trashed; struct TrashedSubtree; }
 namespace stats { struct Extension; }
 }
 
@@ -29,6 +29,9 @@ public:
 
     static unsigned int upsertFile(const FilePtr& file);
 
+    // Same as above on a caller's transaction: two round trips however deep the file sits
+    static unsigned int upsertFile(pqxx::work& txn, const FilePtr& file);
+
     static void updateFile(const FilePtr& file);
 
     static void markTrashedFileDeleted(unsigned int id);
@@ -53,6 +56,10 @@ public:
 
     static void markFileAsTrashed(unsigned int userId, unsigned int fsId, bool isFuseCall = false);
 
+    // Set-based trash: moves root and every descendant into files_trashed in one statement and
+    // applies a single aggregated stats delta to the ancestors of root.
+    static vh::fs::model::file::TrashedSubtree trashSubtree(unsigned int userId, const std::shared_ptr<vh::fs::model::Entry>& root);
+
     static void updateParentStatsAndCleanEmptyDirs(pqxx::work& txn,
                                                std::optional<unsigned int> parentId,
                                                unsigned int sizeBytes,
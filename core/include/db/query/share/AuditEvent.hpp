@@ -12,6 +12,9 @@ namespace vh::db::query::share {
 
 struct AuditEvent {
     static void append(const std::shared_ptr<vh::share::AuditEvent>& event);
+    // One multi-row INSERT per MAX_BATCH_ROWS events, all in a single transaction
+    static void appendBatch(const std::vector<std::shared_ptr<vh::share::AuditEvent>>& events);
+    static constexpr size_t MAX_BATCH_ROWS = 1000;
     static std::vector<std::shared_ptr<vh::share::AuditEvent>> listForShare(const std::string& share_id, const db::model::ListQueryParams& params);
     static std::vector<std::shared_ptr<vh::share::AuditEvent>> listForVault(uint32_t vault_id, const db::model::ListQueryParams& params);
 };
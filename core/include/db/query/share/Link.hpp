@@ -11,6 +11,12 @@ namespace vh::share { struct Link; }
 namespace vh::db::query::share {
 
 struct Link {
+    // Coalesced counter increments for one link, applied in a single UPDATE
+    struct CounterDelta {
+        std::string id;
+        uint64_t accesses = 0, downloads = 0, uploads = 0;
+    };
+
     static std::shared_ptr<vh::share::Link> create(const std::shared_ptr<vh::share::Link>& link);
     static std::shared_ptr<vh::share::Link> get(const std::string& id);
     static std::shared_ptr<vh::share::Link> getByLookupId(const std::string& lookup_id);
@@ -23,6 +29,7 @@ struct Link {
     static void touchAccess(const std::string& id);
     static void incrementDownload(const std::string& id);
     static void incrementUpload(const std::string& id);
+    static void addCounters(const std::vector<CounterDelta>& deltas);
 };
 
 }
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace vh::fs::cache {
+
+// Paths and entry ids the database recently said don't exist, so probe storms on missing files
+// (.git/, lock files, __pycache__) are answered without a query. Every entry expires after the
+// same TTL, which bounds staleness for rows written behind the cache's back; the Registry drops
+// entries as soon as it sees a create or rename land on them. Sharded like the RBAC decision cache.
+class NegativeCache {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    NegativeCache(std::size_t capacity, std::chrono::milliseconds ttl);
+
+    [[nodiscard]] bool enabled() const { return capacity_ && ttl_.count() > 0; }
+    [[nodiscard]] std::chrono::milliseconds ttl() const { return ttl_; }
+
+    [[nodiscard]] bool contains(const std::filesystem::path& path);
+    void insert(const std::filesystem::path& path);
+    void erase(const std::filesystem::path& path);
+    void eraseUnder(const std::filesystem::path& root);   // root and everything below it
+
+    [[nodiscard]] bool containsId(unsigned int id);
+    void insertId(unsigned int id);
+    void eraseId(unsigned int id);
+
+    void clear();
+    [[nodiscard]] std::size_t size() const;
+
+private:
+    static constexpr std::size_t kShards = 16;
+
+    struct Slot {
+        std::string key;
+        Clock::time_point expires;
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::list<Slot> fifo;   // with a fixed TTL, insertion order is expiry order
+        std::unordered_map<std::string, std::list<Slot>::iterator> index;
+    };
+
+    std::size_t capacity_, perShard_;
+    std::chrono::milliseconds ttl_;
+    std::array<Shard, kShards> shards_;
+
+    [[nodiscard]] bool containsKey(const std::string& key);
+    void insertKey(std::string key);
+    void eraseKey(const std::string& key);
+
+    static std::string idKey(unsigned int id);
+    Shard& shardFor(const std::string& key);
+};
+
+}
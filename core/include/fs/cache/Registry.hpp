@@ -2,7 +2,11 @@
 
 #define FUSE_USE_VERSION 35
 
+#include "fs/cache/NegativeCache.hpp"
+
 #include <unordered_map>
+#include <unordered_set>
+#include <cstdint>
 #include <memory>
 #include <shared_mutex>
 #include <filesystem>
@@ -31,16 +35,24 @@ public:
 
     void cacheEntry(const std::shared_ptr<fs::model::Entry>& entry, bool isFirstSeeding = false);
     void updateEntry(const std::shared_ptr<fs::model::Entry>& entry);
-    [[nodiscard]] bool entryExists(const std::filesystem::path& absPath) const;
+    [[nodiscard]] bool entryExists(const std::filesystem::path& absPath);
     std::shared_ptr<fs::model::Entry> getEntryFromInode(fuse_ino_t ino) const;
 
     void evictIno(fuse_ino_t ino);
     void evictPath(const std::filesystem::path& path);
+    size_t evictSubtree(const std::filesystem::path& root);
+    void applyDirStatsDelta(unsigned int dirId, int64_t sizeDelta, int64_t fileDelta, int64_t subdirDelta);
+
+    std::vector<std::shared_ptr<fs::model::Entry>> listDir(unsigned int parentId, bool recursive = false);
 
-    std::vector<std::shared_ptr<fs::model::Entry>> listDir(unsigned int parentId, bool recursive = false) const;
+    // Persist the cached working set so the next start can skip the DB walk
+    void saveSnapshot();
 
     std::shared_ptr<stats::model::CacheStatsSnapshot> stats() const;
 
+    // The negative TTL in seconds, 0 when negative caching is off; lookup() caps what it hands the kernel
+    [[nodiscard]] double negativeEntryTimeout() const;
+
 private:
     mutable std::shared_mutex mutex_;
     std::shared_ptr<stats::model::CacheStats> stats_;
@@ -52,9 +64,22 @@ private:
     std::unordered_map<fuse_ino_t, unsigned int> inodeToId_;
     std::unordered_map<unsigned int, std::shared_ptr<fs::model::Entry>> idToEntry_;
     std::unordered_map<unsigned int, unsigned int> childToParent_;
+    std::unordered_set<unsigned int> loadedDirs_;   // directories whose children are all cached
+    uint64_t evictions_ = 0;                        // lets a loader notice evictions that raced its DB read
+    NegativeCache negative_;
 
     void initRoot();
     void restoreCache();
+    bool loadSnapshot();
+
+    // Caller holds mutex_ exclusively
+    void index(const std::shared_ptr<fs::model::Entry>& entry);
+
+    // Faults a directory's children in from the DB once; later calls are a set lookup
+    void loadChildren(unsigned int dirId);
+
+    // Loads each directory between the deepest cached ancestor and path; nullptr if path doesn't exist
+    std::shared_ptr<fs::model::Entry> faultInPath(const std::filesystem::path& path);
 };
 
 }
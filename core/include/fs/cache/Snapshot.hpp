@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace vh::fs::model { struct Entry; }
+
+namespace vh::fs::cache {
+
+// Flat on-disk image of the inode cache, written at shutdown and mapped back in at startup so a
+// restart comes up warm without re-walking fs_entry. Fixed-size records plus a string blob, all
+// covered by a CRC; the image is stamped with the database epoch and fs_generation it was taken
+// at and refused unless both still match.
+class Snapshot {
+public:
+    static constexpr uint32_t kVersion = 2;
+    static constexpr std::size_t kMaxEpochBytes = 64;
+
+    // Generations only order writes within one epoch; a reset or restore starts a new one
+    struct Stamp {
+        std::string epoch;
+        uint64_t generation{};
+
+        bool operator==(const Stamp&) const = default;
+    };
+
+    struct Contents {
+        Stamp stamp;
+        std::vector<std::shared_ptr<model::Entry>> entries;
+        std::vector<unsigned int> loadedDirs;   // directories whose children are all present
+    };
+
+    // Writes to a sibling temp file and renames it over the old image; throws on I/O failure
+    static void write(const std::filesystem::path& file, const Stamp& stamp,
+                      const std::vector<std::shared_ptr<model::Entry>>& entries,
+                      const std::vector<unsigned int>& loadedDirs);
+
+    // nullopt when the file is missing, from another epoch or generation, truncated or fails its checksum
+    [[nodiscard]] static std::optional<Contents> read(const std::filesystem::path& file, const Stamp& expected);
+};
+
+}
@@ -1,26 +1,50 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <magic.h>
 #include <vector>
 #include <cstdint>
+#include <span>
+#include <optional>
+#include <filesystem>
 
 namespace vh::fs::metadata {
 
+// libmagic cookies are not thread-safe, so every thread gets its own cookie via local().
+// All cookies load from one read-only mapping of magic.mgc that lives for the process.
 class Magic {
 public:
     Magic();
     ~Magic();
 
+    Magic(const Magic&) = delete;
+    Magic& operator=(const Magic&) = delete;
+
     [[nodiscard]] std::string mime_type(const std::string& path) const;
     [[nodiscard]] std::string mime_type_buffer(const std::string& buffer) const;
+    [[nodiscard]] std::string mime_type_buffer(std::span<const uint8_t> buffer) const;
 
     static std::string get_mime_type(const std::string& path);
     static std::string get_mime_type_from_buffer(const std::string& buffer);
     static std::string get_mime_type_from_buffer(const std::vector<uint8_t>& buffer);
 
+    // nameHint is the user-facing file name; its extension only settles plain-text formats.
+    static std::string get_mime_type_from_buffer(std::span<const uint8_t> buffer,
+                                                 const std::filesystem::path& nameHint = {});
+
+    // Cheap checks for the formats we see most; nullopt means libmagic has to decide.
+    static std::optional<std::string_view> sniff(std::span<const uint8_t> head,
+                                                 const std::filesystem::path& nameHint = {});
+
+    // Our cap on how much of a buffer libmagic inspects. Every cookie is set to it via
+    // MAGIC_PARAM_BYTES_MAX, so handing over only the head of a large buffer cannot change a result.
+    static constexpr size_t SNIFF_BYTES = 1024 * 1024;
+
 private:
     magic_t cookie;
+
+    static Magic& local();
 };
 
 }
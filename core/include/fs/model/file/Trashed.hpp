@@ -23,6 +23,19 @@ struct Trashed {
     explicit Trashed(const pqxx::row& row);
 };
 
+// Aggregate outcome of moving a whole subtree into the trash in one statement.
+// The alias and cache path lists drive the deferred on-disk cleanup.
+struct TrashedSubtree {
+    uint64_t size_bytes{};
+    unsigned int file_count{}, dir_count{};
+    std::vector<std::string> file_aliases{};
+    std::vector<std::filesystem::path> cache_paths{};
+
+    TrashedSubtree() = default;
+
+    explicit TrashedSubtree(const pqxx::result& res);
+};
+
 std::vector<std::shared_ptr<Trashed>> trashed_files_from_pq_res(const pqxx::result& res);
 
 }
@@ -2,6 +2,7 @@
 
 #include <filesystem>
 #include <vector>
+#include <span>
 #include <string>
 #include <random>
 #include <memory>
@@ -14,6 +15,10 @@ namespace vh::fs::model {
 struct File;
 }
 
+namespace vh::vault {
+class EncryptionManager;
+}
+
 namespace vh::fs::ops {
 
 std::vector<uint8_t> readFileToVector(const std::filesystem::path& path);
@@ -22,6 +27,19 @@ std::string readFileToString(const std::filesystem::path& path);
 
 void writeFile(const std::filesystem::path& absPath, const std::vector<uint8_t>& ciphertext);
 
+struct IngestResult {
+    std::string content_hash, mime_type;
+    uintmax_t size_bytes{};
+};
+
+// Single pass over the plaintext: sniffs the MIME type, encrypts chunk by chunk straight
+// to absPath and hashes the ciphertext on the way out, so content_hash matches the file
+// on disk without reading it back. Stamps the IV and key version onto f.
+IngestResult encryptAndWrite(std::span<const uint8_t> plaintext,
+                             const std::filesystem::path& absPath,
+                             const vault::EncryptionManager& encryptionManager,
+                             const std::shared_ptr<model::File>& f);
+
 std::string generate_random_suffix(size_t length = 8);
 
 std::filesystem::path decrypt_file_to_temp(unsigned int vault_id,
@@ -31,6 +49,10 @@ std::filesystem::path decrypt_file_to_temp(unsigned int vault_id,
 std::filesystem::path decrypt_file_to_temp(const std::shared_ptr<model::File>& file,
                                            const std::shared_ptr<storage::Engine>& engine);
 
+// Plaintext of file kept in memory, for callers that can decode from a buffer.
+std::vector<uint8_t> decrypt_file_to_buffer(const std::shared_ptr<model::File>& file,
+                                            const std::shared_ptr<storage::Engine>& engine);
+
 bool isProbablyEncrypted(const std::filesystem::path& path);
 
 std::string bytesToSize(uintmax_t bytes);
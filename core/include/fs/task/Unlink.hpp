@@ -0,0 +1,29 @@
+#pragma once
+
+#include "concurrency/Task.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <vector>
+
+namespace vh::fs::task {
+
+// Removes a batch of backing, thumbnail and cache paths off the request path.
+// Entries are already gone from the DB and the in-memory cache by the time this runs,
+// so failures are logged and otherwise ignored.
+class Unlink final : public concurrency::Task {
+public:
+    static constexpr std::size_t BATCH_SIZE = 4096;
+
+    explicit Unlink(std::vector<std::filesystem::path> paths);
+
+    void operator()() override;
+
+    // Splits paths into BATCH_SIZE chunks and submits each to the sync pool.
+    static void enqueue(std::vector<std::filesystem::path> paths);
+
+private:
+    std::vector<std::filesystem::path> paths_;
+};
+
+}
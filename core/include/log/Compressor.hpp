@@ -0,0 +1,71 @@
+#pragma once
+
+#include "log/Rotator.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <string_view>
+#include <thread>
+
+namespace vh::log {
+
+// Streams rotated logs into .gz/.zst siblings in-process (zlib / libzstd), one bounded buffer at
+// a time. The output is written to a .part file, decoded back and checked against the source's
+// CRC32 and length; only then is it renamed into place and the source removed. Queued files are
+// handled by a single worker that runs at idle CPU and I/O priority, optionally rate limited.
+class Compressor {
+public:
+    using Compression = Rotator::Compression;
+
+    struct Options {
+        Compression compression = Compression::Zstd;
+        int level = 0;                                   // 0 = codec default (zstd 3, gzip 6)
+        std::size_t buffer_bytes = 256_KiB;              // size of each read and write buffer
+        std::uint64_t max_bytes_per_sec = 0;             // source bytes per second, 0 = unthrottled
+        bool low_priority = true;                        // nice 19 + idle I/O class for the worker
+        std::function<void(std::string_view)> diag_log = nullptr;
+    };
+
+    explicit Compressor(Options opts);
+    ~Compressor();
+
+    Compressor(const Compressor&) = delete;
+    Compressor& operator=(const Compressor&) = delete;
+
+    // Queue src for the worker; duplicates of a queued or in-flight file are ignored
+    void enqueue(const std::filesystem::path& src);
+
+    // Compress src on the calling thread. True once src.<ext> is verified and src is gone.
+    bool compress(const std::filesystem::path& src) const;
+
+    // Block until everything queued so far has been handled
+    void drain();
+
+    [[nodiscard]] static std::string_view extension(Compression c);
+
+private:
+    Options opts_;
+
+    mutable std::mutex m_;
+    std::condition_variable cv_, idle_;
+    std::deque<std::filesystem::path> queue_;
+    std::set<std::filesystem::path> pending_;
+    bool busy_ = false;
+    std::atomic<bool> stopping_{false};
+    std::thread worker_;
+
+    void run();
+
+    bool encode(std::FILE* in, std::FILE* out, std::uint32_t& crc, std::uint64_t& bytes) const;
+    bool verify(std::FILE* in, std::uint32_t& crc, std::uint64_t& bytes) const;
+    void diag(std::string_view msg) const;
+};
+
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <fmt/format.h>
+
+#include <type_traits>
+#include <utility>
+
+namespace vh::log {
+
+// A log argument that is only computed if the record is actually formatted. spdlog checks the
+// level before formatting, so a disabled debug line never pays for the callable:
+//
+//   Registry::ws()->debug("[Router] Routing message: {}", lazy([&] { return msg.dump(); }));
+template<typename Fn>
+struct Lazy {
+    Fn fn;
+};
+
+template<typename Fn>
+[[nodiscard]] Lazy<std::decay_t<Fn>> lazy(Fn&& fn) { return {std::forward<Fn>(fn)}; }
+
+}
+
+template<typename Fn>
+struct fmt::formatter<vh::log::Lazy<Fn>> : fmt::formatter<std::decay_t<std::invoke_result_t<const Fn&>>> {
+    template<typename FormatContext>
+    auto format(const vh::log::Lazy<Fn>& value, FormatContext& ctx) const {
+        return fmt::formatter<std::decay_t<std::invoke_result_t<const Fn&>>>::format(value.fn(), ctx);
+    }
+};
@@ -1,9 +1,12 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/sink.h>
+#include <spdlog/sinks/dist_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/sinks/rotating_file_sink.h>
 #include <spdlog/sinks/basic_file_sink.h>
@@ -16,26 +19,29 @@ public:
     // Initialize all loggers with sinks/levels.
     static void init();
 
-    // Generic access by name
+    // Drain the async queue and stop its worker; call once on the way out
+    static void shutdown();
+
+    // Generic access by name (registry lookup; prefer the shorthands on hot paths)
     static std::shared_ptr<spdlog::logger> get(const std::string& name);
 
-    // Subsystem shorthands
-    static std::shared_ptr<spdlog::logger> vaulthalla()  { return get("vaulthalla"); }
-    static std::shared_ptr<spdlog::logger> fuse()        { return get("fuse"); }
-    static std::shared_ptr<spdlog::logger> fs()          { return get("filesystem"); }
-    static std::shared_ptr<spdlog::logger> cloud()       { return get("cloud"); }
-    static std::shared_ptr<spdlog::logger> crypto()      { return get("crypto"); }
-    static std::shared_ptr<spdlog::logger> sync()        { return get("sync"); }
-    static std::shared_ptr<spdlog::logger> thumb()       { return get("thumb"); }
-    static std::shared_ptr<spdlog::logger> storage()     { return get("storage"); }
-    static std::shared_ptr<spdlog::logger> auth()        { return get("auth"); }
-    static std::shared_ptr<spdlog::logger> ws()          { return get("ws"); }
-    static std::shared_ptr<spdlog::logger> http()        { return get("http"); }
-    static std::shared_ptr<spdlog::logger> shell()       { return get("shell"); }
-    static std::shared_ptr<spdlog::logger> db()          { return get("db"); }
-    static std::shared_ptr<spdlog::logger> types()       { return get("types"); }
-    static std::shared_ptr<spdlog::logger> audit()       { return get("audit"); }
-    static std::shared_ptr<spdlog::logger> runtime()     { return get("runtime"); }
+    // Subsystem shorthands: handles cached at init(), no lookup or lock per call
+    static const std::shared_ptr<spdlog::logger>& vaulthalla()  { return handle(Subsystem::Vaulthalla); }
+    static const std::shared_ptr<spdlog::logger>& fuse()        { return handle(Subsystem::Fuse); }
+    static const std::shared_ptr<spdlog::logger>& fs()          { return handle(Subsystem::Filesystem); }
+    static const std::shared_ptr<spdlog::logger>& cloud()       { return handle(Subsystem::Cloud); }
+    static const std::shared_ptr<spdlog::logger>& crypto()      { return handle(Subsystem::Crypto); }
+    static const std::shared_ptr<spdlog::logger>& sync()        { return handle(Subsystem::Sync); }
+    static const std::shared_ptr<spdlog::logger>& thumb()       { return handle(Subsystem::Thumb); }
+    static const std::shared_ptr<spdlog::logger>& storage()     { return handle(Subsystem::Storage); }
+    static const std::shared_ptr<spdlog::logger>& auth()        { return handle(Subsystem::Auth); }
+    static const std::shared_ptr<spdlog::logger>& ws()          { return handle(Subsystem::Ws); }
+    static const std::shared_ptr<spdlog::logger>& http()        { return handle(Subsystem::Http); }
+    static const std::shared_ptr<spdlog::logger>& shell()       { return handle(Subsystem::Shell); }
+    static const std::shared_ptr<spdlog::logger>& db()          { return handle(Subsystem::Db); }
+    static const std::shared_ptr<spdlog::logger>& types()       { return handle(Subsystem::Types); }
+    static const std::shared_ptr<spdlog::logger>& audit()       { return handle(Subsystem::Audit); }
+    static const std::shared_ptr<spdlog::logger>& runtime()     { return handle(Subsystem::Runtime); }
 
     [[nodiscard]] static bool isInitialized();
 
@@ -43,27 +49,44 @@ public:
     static void reopenAuditLog();
 
 private:
+    enum class Subsystem : uint8_t {
+        Vaulthalla, Fuse, Filesystem, Cloud, Crypto, Sync, Thumb, Storage,
+        Auth, Ws, Http, Shell, Db, Types, Audit, Runtime, Count
+    };
+
+    static constexpr std::array<const char*, static_cast<size_t>(Subsystem::Count)> NAMES{
+        "vaulthalla", "fuse", "filesystem", "cloud", "crypto", "sync", "thumb", "storage",
+        "auth", "ws", "http", "shell", "db", "types", "audit", "runtime"
+    };
+
     static constexpr const auto* FILE_LOG_FORMAT = "[%Y-%m-%d %H:%M:%S.%e] [%^%l%$] [%n] %v";
     static constexpr const auto* CONSOLE_LOG_FORMAT = "[%^%l%$] [%n] %v";
 
     static inline bool initialized_ = false;
 
+    static inline std::array<std::shared_ptr<spdlog::logger>, static_cast<size_t>(Subsystem::Count)> handles_;
+
     static inline std::filesystem::path log_dir_;
     static inline std::filesystem::path main_log_path_;
     static inline std::filesystem::path audit_log_path_;
 
-    // keep the shared sinks so we can swap them later
+    // Loggers write through these; reopening swaps the file sink inside under the dist sink's
+    // lock, so the async worker never sees a half-replaced sink list
     static inline std::shared_ptr<spdlog::sinks::stdout_color_sink_mt> console_sink_;
-    static inline std::shared_ptr<spdlog::sinks::rotating_file_sink_mt> main_file_sink_;
-    static inline std::shared_ptr<spdlog::sinks::basic_file_sink_mt>    audit_file_sink_;
+    static inline std::shared_ptr<spdlog::sinks::dist_sink_mt> main_sink_;
+    static inline std::shared_ptr<spdlog::sinks::dist_sink_mt> audit_sink_;
 
     // remember main sink params you used in init()
     static inline size_t main_max_bytes_ = 10 * 1024 * 1024; // 10 MiB
     static inline size_t main_max_files_ = 5;
 
-    static void replaceSinkEverywhere_(const std::shared_ptr<spdlog::sinks::sink>& old_sink,
-                                       const std::shared_ptr<spdlog::sinks::sink>& new_sink);
+    static const std::shared_ptr<spdlog::logger>& handle(Subsystem s) {
+        const auto& logger = handles_[static_cast<size_t>(s)];
+        if (!logger) [[unlikely]] throwMissing(NAMES[static_cast<size_t>(s)]);
+        return logger;
+    }
 
+    [[noreturn]] static void throwMissing(const std::string& name);
 };
 
 }
@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <filesystem>
 #include <functional>
+#include <memory>
 #include <optional>
 #include <regex>
 #include <string>
@@ -17,6 +18,8 @@ constexpr std::uint64_t operator"" _KiB(unsigned long long v) { return v * 1024U
 constexpr std::uint64_t operator"" _MiB(unsigned long long v) { return v * 1024ULL * 1024ULL; }
 constexpr std::uint64_t operator"" _GiB(unsigned long long v) { return v * 1024ULL * 1024ULL * 1024ULL; }
 
+class Compressor;
+
 class Rotator {
 public:
     enum class Compression { None, Gzip, Zstd };
@@ -34,9 +37,12 @@ public:
         std::optional<std::uint64_t> max_retained_size;                 // cap total size of rotated files
         bool strict_retention = false;                                   // if true, ignore size cap within retention window
 
-        // Compression (applied to rotated file)
+        // Compression (applied to rotated file, in-process; see Compressor)
         Compression compression = Compression::None;
-        bool ignore_compress_errors = true;
+        int compression_level = 0;                                       // 0 = codec default
+        std::uint64_t compression_rate_limit = 0;                        // source bytes/s, 0 = unthrottled
+        bool compress_in_background = true;                              // hand off to the idle-priority worker
+        bool ignore_compress_errors = true;                              // only honoured when compressing inline
 
         // Hooks
         std::function<void()> on_reopen = nullptr;                       // called after rename of active file
@@ -50,6 +56,7 @@ public:
     };
 
     explicit Rotator(Options opts);
+    ~Rotator();
 
     // Rotation / pruning API
     void maybeRotate() const;
@@ -65,6 +72,7 @@ private:
     std::string ext_;
     std::regex rotated_regex_;
     mutable std::mutex m_;
+    std::unique_ptr<Compressor> compressor_;
 
     // Helpers
     static std::string escapeRx(const std::string& s);
@@ -87,8 +95,8 @@ private:
     };
 
     void rotateImpl(RotateReason why) const;
-    bool compressFile(const std::filesystem::path& src, Compression c) const;
-    static std::string shellQuote(const std::string& s);
+    bool compressFile(const std::filesystem::path& src) const;
+    void compressLeftovers() const;
     void pruneImpl() const;
 
     static const char* reasonStr(RotateReason r);
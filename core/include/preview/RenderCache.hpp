@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace vh::preview {
+
+// Rendered previews (resized images, PDF pages) kept in memory under a byte budget and
+// keyed by the source's content hash, so every user and share link viewing the same bytes
+// reuses one render. Concurrent requests for a render already in progress wait for it
+// instead of decoding the source again.
+class RenderCache {
+public:
+    static constexpr int DEFAULT_QUALITY = 85;
+
+    struct Key {
+        std::string contentHash;
+        unsigned int page = 0;
+        std::string geometry;       // "s<max edge>", "x<scale>" or "full"
+        int quality = DEFAULT_QUALITY;
+
+        [[nodiscard]] std::string str() const;
+        [[nodiscard]] std::string etag() const;
+    };
+
+    using Bytes = std::shared_ptr<const std::vector<uint8_t>>;
+
+    struct Result {
+        Bytes bytes;
+        bool hit = false;           // served without rendering, from the cache or a concurrent render
+    };
+
+    explicit RenderCache(size_t budgetBytes);
+
+    // Process-wide cache sized from caching.render_cache_mb
+    static RenderCache& instance();
+
+    // Returns the cached render for key, or runs render() once for all concurrent callers.
+    // A failed render is rethrown to every waiter and nothing is cached.
+    Result getOrRender(const Key& key, const std::function<std::vector<uint8_t>()>& render);
+
+    void clear();
+
+    [[nodiscard]] size_t sizeBytes() const;
+    [[nodiscard]] size_t entries() const;
+
+private:
+    struct Entry {
+        std::string key;
+        Bytes bytes;
+    };
+
+    mutable std::mutex mutex_;
+    size_t budget_, used_ = 0;
+    std::list<Entry> lru_;
+    std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+    std::unordered_map<std::string, std::shared_future<Bytes>> inFlight_;
+
+    void insertLocked(const std::string& key, const Bytes& bytes);
+};
+
+}
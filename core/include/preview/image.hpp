@@ -7,9 +7,15 @@
 #include <filesystem>
 
 namespace vh::preview::image {
+    // Packed layouts TurboJPEG can encode without a conversion pass; BGRX is what pdfium renders
+    enum class PixelFormat { RGB, BGRX };
+
     void compress_to_jpeg(const uint8_t *rgb_data, int width, int height, std::vector<uint8_t> &out_buf,
                           int quality = 85);
 
+    void compress_to_jpeg(const uint8_t *pixels, int width, int height, int pitch, PixelFormat format,
+                          std::vector<uint8_t> &out_buf, int quality = 85);
+
     std::vector<uint8_t> resize_and_compress(const std::string &path,
                                              const std::optional<std::string> &scale_opt,
                                              const std::optional<std::string> &size_opt);
@@ -18,4 +24,16 @@ namespace vh::preview::image {
         const uint8_t *data, size_t size,
         const std::optional<std::string> &scale,
         const std::optional<std::string> &max_size);
+
+    // One JPEG per bounding box in max_sizes (same order), cascading down from the largest so
+    // the source pixels are only resampled once at full resolution.
+    std::vector<std::vector<uint8_t>> thumbnails_from_pixels(const uint8_t *pixels, int width, int height, int pitch,
+                                                             PixelFormat format,
+                                                             const std::vector<unsigned int> &max_sizes,
+                                                             int quality = 85);
+
+    // As above from an encoded image, decoded once and, for JPEGs, straight at the scale of the largest box
+    std::vector<std::vector<uint8_t>> thumbnails_from_buffer(const uint8_t *data, size_t size,
+                                                             const std::vector<unsigned int> &max_sizes,
+                                                             int quality = 85);
 }
\ No newline at end of file
@@ -7,8 +7,15 @@
 #include <filesystem>
 
 namespace vh::preview::pdf {
+    // Blocking wrappers over Renderer for callers already off the network threads
     std::vector<uint8_t> resize_and_compress_buffer(
         const uint8_t *data, size_t size,
         const std::optional<std::string> &scale,
-        const std::optional<std::string> &max_size);
+        const std::optional<std::string> &max_size,
+        unsigned int page_index = 0);
+
+    // First-page thumbnails, one JPEG per bounding box in max_sizes (same order), from a single rasterization
+    std::vector<std::vector<uint8_t>> thumbnails_from_buffer(
+        const uint8_t *data, size_t size,
+        const std::vector<unsigned int> &max_sizes);
 }
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace vh::preview::pdf {
+
+struct RenderOptions {
+    unsigned int page = 0;
+    std::optional<std::string> scale, size;     // same meaning as the preview query parameters
+    int quality = 85;
+};
+
+// pdfium is neither thread-safe nor re-entrant, so every call into it runs on this one thread,
+// which also owns library init and teardown. The most recently used documents stay open so
+// paging through a PDF or rendering several sizes of it parses the file once.
+class Renderer {
+public:
+    static constexpr size_t MAX_OPEN_DOCUMENTS = 8;
+    static constexpr size_t MAX_OPEN_BYTES = 256ull * 1024 * 1024;
+
+    using Loader = std::function<std::vector<uint8_t>()>;
+
+    static Renderer& instance();
+
+    ~Renderer();
+
+    Renderer(const Renderer&) = delete;
+    Renderer& operator=(const Renderer&) = delete;
+
+    // documentKey names the document bytes (a content hash); empty keeps the document out of
+    // the open-document cache. load() runs on the caller's thread when the document is not
+    // already open, and on the render thread if it was evicted in between, so whatever it
+    // captures has to outlive the returned future.
+    [[nodiscard]] std::future<std::vector<uint8_t>> render(const std::string& documentKey, Loader load,
+                                                           RenderOptions options);
+
+    // First-page thumbnails, one JPEG per bounding box in sizes (same order)
+    [[nodiscard]] std::future<std::vector<std::vector<uint8_t>>> thumbnails(const std::string& documentKey, Loader load,
+                                                                            std::vector<unsigned int> sizes);
+
+    // Drains queued renders, closes every document and shuts pdfium down
+    void stop();
+
+private:
+    struct Document;
+    using Bytes = std::shared_ptr<const std::vector<uint8_t>>;
+
+    Renderer();
+
+    void run();
+    void post(std::function<void()> job);
+    Bytes prefetch(const std::string& key, const Loader& load) const;
+    std::shared_ptr<Document> acquire(const std::string& key, Bytes bytes, const Loader& load);
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::function<void()>> jobs_;
+    std::unordered_set<std::string> openKeys_;
+    bool stopping_ = false;
+
+    // Touched only on the render thread
+    std::list<std::shared_ptr<Document>> documents_;
+    size_t openBytes_ = 0;
+
+    std::thread thread_;
+};
+
+}
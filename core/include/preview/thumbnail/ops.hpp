@@ -5,6 +5,9 @@
 #include <filesystem>
 
 namespace vh::preview::thumbnail {
-    void generateAndStore(const std::vector<uint8_t> &buffer, const std::filesystem::path &outputPath,
-                          const std::string &mime, unsigned int size = 128);
-}
\ No newline at end of file
+    // One JPEG per entry in sizes (same order), all produced from a single decode of the source
+    std::vector<std::vector<uint8_t>> generate(const std::vector<uint8_t> &buffer, const std::string &mime,
+                                               const std::vector<unsigned int> &sizes);
+
+    void store(const std::vector<uint8_t> &jpeg, const std::filesystem::path &outputPath);
+}
@@ -38,6 +38,11 @@ public:
         namespace fs = std::filesystem;
 
         try {
+            if (!file_->mime_type || file_->mime_type->empty()) {
+                log::Registry::thumb()->warn("[ThumbnailTask] No MIME type for file ID {}. Skipping thumbnail generation.", file_->id);
+                return;
+            }
+
             const auto& sizes = config::Registry::get().caching.thumbnails.sizes;
             const auto basePath = engine_->paths->thumbnailRoot / file_->base32_alias;
             auto source = buffer_;
@@ -50,21 +55,14 @@ public:
                 }
             }
 
-            for (const auto& size : sizes) {
-                const auto filename = std::to_string(size) + ".jpg";
-                fs::path cachePath = basePath / filename;
-
-                if (!fs::exists(cachePath.parent_path())) fs::create_directories(cachePath.parent_path());
-
-                if (!file_->mime_type || file_->mime_type->empty()) {
-                    log::Registry::thumb()->warn("[ThumbnailTask] No MIME type for file ID {}. Skipping thumbnail generation.", file_->id);
-                    return;
-                }
+            const auto now = steady_clock::now();
+            const auto jpegs = generate(source, *file_->mime_type, sizes);
+            const auto end = steady_clock::now();
+            runtime::Deps::get().httpCacheStats->record_op_us(duration_cast<microseconds>(end - now).count());
 
-                const auto now = steady_clock::now();
-                generateAndStore(source, cachePath, *file_->mime_type, size);
-                const auto end = steady_clock::now();
-                runtime::Deps::get().httpCacheStats->record_op_us(duration_cast<microseconds>(end - now).count());
+            for (size_t i = 0; i < sizes.size(); ++i) {
+                const fs::path cachePath = basePath / (std::to_string(sizes[i]) + ".jpg");
+                store(jpegs[i], cachePath);
 
                 auto index = std::make_shared<cache::Record>();
                 index->vault_id = engine_->vault->id;
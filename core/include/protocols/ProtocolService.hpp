@@ -4,6 +4,8 @@
 
 #include <atomic>
 #include <memory>
+#include <thread>
+#include <vector>
 #include <boost/asio/ip/tcp.hpp>
 
 namespace boost::asio { class io_context; }
@@ -33,8 +35,8 @@ protected:
     void runLoop() override;
 
 private:
-    std::thread ioThread_;
-    std::shared_ptr<boost::asio::io_context> ioContext_;
+    std::vector<std::thread> ioThreads_, httpThreads_;
+    std::shared_ptr<boost::asio::io_context> ioContext_, httpContext_;
     std::shared_ptr<ws::Server> wsServer_;
     std::shared_ptr<http::Server> httpServer_;
     std::atomic<bool> ioContextInitialized_{false};
@@ -44,6 +46,9 @@ private:
     std::atomic<bool> httpPreviewReady_{false};
 
     void initProtocols();
+    void stopIoThreads();
+    [[nodiscard]] static unsigned int ioThreadCount();
+    [[nodiscard]] static unsigned int httpIoThreadCount();
     void initWebsocketServer();
     void initHttpServer();
     static void initThreatIntelligence();
@@ -33,6 +33,8 @@ namespace vh::protocols::http {
     using string_response = response<string_body>;
     using file_response = response<file_body>;
     using vector_response = response<vector_body>;
+    using download_response = model::download::Response;
+    using shared_response = response<model::preview::SharedBody>;
 
     struct Router {
         using PreviewSessionResolver = std::function<std::shared_ptr<vh::protocols::ws::Session>(const request&)>;
@@ -48,11 +50,20 @@ namespace vh::protocols::http {
 
         static model::preview::Response handleAuthSession(request &&req);
 
+        // Prometheus text exposition of stats::Metrics; Session only routes loopback peers here
+        static model::preview::Response handleMetrics(request &&req);
+
         static model::preview::Response makeResponse(const request &req,
                                                      std::vector<uint8_t> &&data,
                                                      const std::string &mime_type,
                                                      bool cacheHit = false);
 
+        // Serves a shared, immutable buffer (a RenderCache entry) without copying it
+        static model::preview::Response makeResponse(const request &req,
+                                                     model::preview::SharedBody::value_type data,
+                                                     const std::string &mime_type,
+                                                     bool cacheHit = false);
+
         static model::preview::Response makeResponse(const request &req,
                                                      file_body::value_type data,
                                                      const std::string &mime_type,
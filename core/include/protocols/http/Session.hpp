@@ -1,9 +1,14 @@
 #pragma once
 
+#include "protocols/http/model/preview/Response.hpp"
+#include "protocols/http/model/download/Archive.hpp"
+#include "protocols/http/model/download/Body.hpp"
+
 #include <boost/beast/core.hpp>
 #include <boost/beast/http.hpp>
 #include <boost/asio.hpp>
 #include <memory>
+#include <optional>
 
 namespace vh::protocols::http {
 
@@ -20,12 +25,28 @@ public:
 private:
     void do_read();
     void on_read(beast::error_code ec, std::size_t bytes);
+    void dispatch(http::request<http::string_body> req, bool last);
+    void write(model::preview::Response&& res, bool last);
     void on_write(bool close, beast::error_code ec, std::size_t bytes);
+    void send_file(const std::shared_ptr<model::download::Response>& msg);
+
+    // For bodies that produce chunks through fill() on the HTTP pool (archives, file-backed downloads)
+    template<class Body>
+    void write_filled(const std::shared_ptr<http::response<Body>>& msg,
+                      const std::shared_ptr<http::response_serializer<Body>>& sr, bool close);
+    template<class Body>
+    void fill_body(const std::shared_ptr<http::response<Body>>& msg,
+                   const std::shared_ptr<http::response_serializer<Body>>& sr, bool close);
     void do_close();
 
-    tcp::socket socket_;
+    [[nodiscard]] bool isMetricsScrape(const http::request<http::string_body>& req) const;
+
+    // Bound to the connection's strand; every handler above runs there except the routed request
+    beast::tcp_stream stream_;
     beast::flat_buffer buffer_;
-    http::request<http::string_body> req_;
+    std::optional<http::request_parser<http::string_body>> parser_;
+    unsigned int requests_ = 0;
+    bool loopback_ = false;
 };
 
 }
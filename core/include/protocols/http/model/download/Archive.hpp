@@ -0,0 +1,123 @@
+#pragma once
+
+#include "protocols/http/model/download/Body.hpp"
+
+#include <boost/asio/buffer.hpp>
+#include <boost/beast/http/error.hpp>
+#include <boost/beast/http/message.hpp>
+#include <boost/optional.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+typedef struct z_stream_s z_stream;
+
+namespace vh::protocols::http::model::download {
+
+struct ArchiveEntry {
+    std::string name;                 // sanitized archive path; directories end in '/'
+    std::function<Source()> open{};   // opened by fill() when the archive reaches the entry; empty for directories
+    bool deflate = false;
+};
+
+// Streaming ZIP64 writer. Entries are emitted in order with sizes and CRCs trailing
+// their data in descriptors, so the archive goes out as it is produced and only the
+// central directory records are held until the end.
+class Archive {
+public:
+    static constexpr size_t CHUNK_BYTES = Source::CHUNK_BYTES;
+
+    Archive() = default;
+    explicit Archive(std::vector<ArchiveEntry> entries);
+
+    Archive(Archive&& other) noexcept;
+    Archive& operator=(Archive&& other) noexcept;
+    ~Archive();
+
+    [[nodiscard]] bool done() const { return state_ == State::Done; }
+    [[nodiscard]] uint64_t bytesWritten() const { return offset_; }
+
+    // Next slice of archive bytes, empty once the end record is out. Failures opening or
+    // reading an entry surface through ec and leave the archive truncated.
+    [[nodiscard]] std::span<const uint8_t> next(boost::system::error_code& ec);
+
+    // Producer/consumer split for ArchiveBody. fill() runs next() on the HTTP pool and parks
+    // the result; the body writer only takes what is parked, so opening entries (cloud fetches
+    // included), decrypting and deflating never happen on an io thread. The session sequences
+    // the two sides by posting between them.
+    void fill();
+    [[nodiscard]] bool filled() const { return filled_; }
+    [[nodiscard]] std::span<const uint8_t> take(boost::system::error_code& ec);
+
+private:
+    enum class State { Header, Data, Descriptor, Central, Done };
+
+    struct Record {
+        std::string name;
+        uint32_t crc = 0;
+        uint64_t compressed = 0, size = 0, localHeaderOffset = 0;
+        uint16_t method = 0;
+        bool directory = false;
+    };
+
+    std::vector<ArchiveEntry> entries_;
+    std::vector<Record> records_;
+    size_t index_ = 0;
+    State state_ = State::Header;
+
+    Source source_;
+    std::unique_ptr<z_stream> zstream_;
+    Record current_;
+
+    std::vector<uint8_t> out_;
+    uint64_t offset_ = 0;
+
+    std::span<const uint8_t> parked_;
+    boost::system::error_code parkedError_;
+    bool filled_ = false;
+
+    void step(boost::system::error_code& ec);
+    void writeLocalHeader(const Record& record);
+    void writeData(std::span<const uint8_t> chunk, bool finish);
+    void writeCentralDirectory();
+    void endDeflate();
+};
+
+struct ArchiveBody {
+    using value_type = Archive;
+
+    class writer {
+    public:
+        using const_buffers_type = boost::asio::const_buffer;
+
+        template<bool isRequest, class Fields>
+        writer(const boost::beast::http::header<isRequest, Fields>&, value_type& body) : body_(body) {}
+
+        void init(boost::system::error_code& ec) { ec = {}; }
+
+        // need_buffer hands control back to the session, which fills the next chunk off-thread
+        // and resumes the write
+        boost::optional<std::pair<const_buffers_type, bool>> get(boost::system::error_code& ec) {
+            ec = {};
+            if (!body_.filled()) {
+                if (!body_.done()) ec = boost::beast::http::error::need_buffer;
+                return boost::none;
+            }
+            const auto chunk = body_.take(ec);
+            if (ec || chunk.empty()) return boost::none;
+            return {{const_buffers_type(chunk.data(), chunk.size()), !body_.done()}};
+        }
+
+    private:
+        value_type& body_;
+    };
+};
+
+using ArchiveResponse = boost::beast::http::response<ArchiveBody>;
+
+}
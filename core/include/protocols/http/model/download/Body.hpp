@@ -0,0 +1,114 @@
+#pragma once
+
+#include <boost/asio/buffer.hpp>
+#include <boost/beast/http/error.hpp>
+#include <boost/beast/http/message.hpp>
+#include <boost/optional.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace vh::crypto::util { class AES256GCMDecryptor; }
+
+namespace vh::protocols::http::model::download {
+
+// A byte range of a file's backing store, read (and decrypted) one chunk at a time.
+// Beast's serializer only pulls the next chunk after the previous write completed,
+// so a slow client never holds more than CHUNK_BYTES of plaintext in memory.
+class Source {
+public:
+    static constexpr size_t CHUNK_BYTES = 256 * 1024;
+
+    Source();
+
+    // Plaintext backing file; the session may hand it to sendfile instead of reading it.
+    Source(const std::filesystem::path& path, uint64_t offset, uint64_t length);
+
+    // Encrypted backing file laid out as ciphertext || tag. The decryptor must be positioned
+    // at `offset`; the tag is checked at the end when the range covers the whole file.
+    Source(const std::filesystem::path& path, uint64_t offset, uint64_t length,
+           std::unique_ptr<crypto::util::AES256GCMDecryptor> decryptor);
+
+    // Plaintext that had to be fetched whole, e.g. a cloud file with no local copy.
+    explicit Source(std::vector<uint8_t> bytes);
+
+    Source(Source&& other) noexcept;
+    Source& operator=(Source&& other) noexcept;
+    ~Source();
+
+    [[nodiscard]] uint64_t size() const { return length_; }
+    [[nodiscard]] uint64_t remaining() const { return length_ - sent_; }
+    [[nodiscard]] bool encrypted() const { return decryptor_ != nullptr; }
+    [[nodiscard]] bool zeroCopy() const { return fd_ >= 0 && !decryptor_; }
+
+    // Absolute file position of the next unsent byte; only meaningful for zero-copy sources.
+    [[nodiscard]] int fd() const { return fd_; }
+    [[nodiscard]] uint64_t position() const { return offset_ + sent_; }
+    void advance(uint64_t n) { sent_ += n; }
+
+    // Next chunk of plaintext, empty once the range is exhausted. Read errors and
+    // authentication failures are reported through ec.
+    [[nodiscard]] std::span<const uint8_t> next(boost::system::error_code& ec);
+
+    // Producer/consumer split for Body, as in Archive. File-backed chunks cost a pread and
+    // possibly a decrypt, so fill() runs next() on the HTTP pool and parks the result and the
+    // body writer only takes what is parked. In-memory sources are served straight from next().
+    [[nodiscard]] bool fileBacked() const { return fd_ >= 0; }
+    void fill();
+    [[nodiscard]] bool filled() const { return filled_; }
+    [[nodiscard]] std::span<const uint8_t> take(boost::system::error_code& ec);
+
+private:
+    int fd_ = -1;
+    uint64_t offset_ = 0, length_ = 0, sent_ = 0;
+    bool verifyTag_ = false;
+    std::unique_ptr<crypto::util::AES256GCMDecryptor> decryptor_;
+    std::vector<uint8_t> in_, out_;
+
+    std::span<const uint8_t> parked_;
+    boost::system::error_code parkedError_;
+    bool filled_ = false;
+
+    void open(const std::filesystem::path& path, uint64_t payloadOverhead);
+    bool readAt(uint64_t pos, std::span<uint8_t> into, boost::system::error_code& ec) const;
+};
+
+struct Body {
+    using value_type = Source;
+
+    static std::uint64_t size(const value_type& body) { return body.size(); }
+
+    class writer {
+    public:
+        using const_buffers_type = boost::asio::const_buffer;
+
+        template<bool isRequest, class Fields>
+        writer(const boost::beast::http::header<isRequest, Fields>&, value_type& body) : body_(body) {}
+
+        void init(boost::system::error_code& ec) { ec = {}; }
+
+        // need_buffer hands a file-backed body back to the session, which fills the next chunk
+        // off-thread and resumes the write
+        boost::optional<std::pair<const_buffers_type, bool>> get(boost::system::error_code& ec) {
+            ec = {};
+            if (body_.fileBacked() && !body_.filled()) {
+                if (body_.remaining() > 0) ec = boost::beast::http::error::need_buffer;
+                return boost::none;
+            }
+            const auto chunk = body_.fileBacked() ? body_.take(ec) : body_.next(ec);
+            if (ec || chunk.empty()) return boost::none;
+            return {{const_buffers_type(chunk.data(), chunk.size()), body_.remaining() > 0}};
+        }
+
+    private:
+        value_type& body_;
+    };
+};
+
+using Response = boost::beast::http::response<Body>;
+
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "preview/RenderCache.hpp"
+
 #include <filesystem>
 #include <optional>
 #include <unordered_map>
@@ -15,9 +17,13 @@ struct Request {
     std::filesystem::path rel_path;
     std::optional<unsigned int> size;
     std::optional<float> scale;
+    unsigned int page = 0;
     std::shared_ptr<storage::Engine> engine{nullptr};
     std::shared_ptr<fs::model::File> file{nullptr};
 
+    // Set by the router when the output is a render worth caching and the source has a content hash
+    std::optional<vh::preview::RenderCache::Key> renderKey;
+
     explicit Request(const std::unordered_map<std::string, std::string>& params) {
         if (!params.contains("vault_id") || !params.contains("path"))
             throw std::invalid_argument("Missing vault_id or path");
@@ -30,6 +36,8 @@ struct Request {
 
         if (params.contains("scale"))
             if (const float s = std::stof(params.at("scale")); s > 0) scale = s;
+
+        if (params.contains("page")) page = std::stoul(params.at("page"));
     }
 
     [[nodiscard]] std::optional<std::string> sizeStr() const {
@@ -41,6 +49,13 @@ struct Request {
         if (!scale) return std::nullopt;
         return std::to_string(scale.value());
     }
+
+    // Cache geometry for the render this request asks for; scale wins over size as it does when rendering
+    [[nodiscard]] std::string geometry() const {
+        if (scale) return "x" + *scaleStr();
+        if (size) return "s" + *sizeStr();
+        return "full";
+    }
 };
 
 
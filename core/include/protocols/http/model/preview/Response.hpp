@@ -1,6 +1,11 @@
 #pragma once
 
+#include "protocols/http/model/download/Archive.hpp"
+#include "protocols/http/model/download/Body.hpp"
+#include "protocols/http/model/preview/SharedBody.hpp"
+
 #include <boost/beast/http.hpp>
+#include <variant>
 
 namespace vh::protocols::http::model::preview {
 
@@ -9,7 +14,10 @@ namespace http = boost::beast::http;
 using Response = std::variant<
     http::response<http::vector_body<uint8_t>>,
     http::response<http::file_body>,
-    http::response<http::string_body>
+    http::response<http::string_body>,
+    http::response<download::Body>,
+    http::response<download::ArchiveBody>,
+    http::response<SharedBody>
 >;
 
 }
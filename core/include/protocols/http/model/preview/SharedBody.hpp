@@ -0,0 +1,41 @@
+#pragma once
+
+#include <boost/asio/buffer.hpp>
+#include <boost/beast/http/message.hpp>
+#include <boost/optional.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace vh::protocols::http::model::preview {
+
+// An immutable buffer that any number of responses may be sending at once, such as a render
+// held by preview::RenderCache. Each response keeps a reference, so a cache hit costs no copy.
+struct SharedBody {
+    using value_type = std::shared_ptr<const std::vector<uint8_t>>;
+
+    static std::uint64_t size(const value_type& body) { return body ? body->size() : 0; }
+
+    class writer {
+    public:
+        using const_buffers_type = boost::asio::const_buffer;
+
+        template<bool isRequest, class Fields>
+        writer(const boost::beast::http::header<isRequest, Fields>&, const value_type& body) : body_(body) {}
+
+        void init(boost::system::error_code& ec) { ec = {}; }
+
+        boost::optional<std::pair<const_buffers_type, bool>> get(boost::system::error_code& ec) {
+            ec = {};
+            if (!body_ || body_->empty()) return boost::none;
+            return {{const_buffers_type(body_->data(), body_->size()), false}};
+        }
+
+    private:
+        const value_type& body_;
+    };
+};
+
+}
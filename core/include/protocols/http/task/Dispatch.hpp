@@ -0,0 +1,20 @@
+#pragma once
+
+#include "concurrency/Task.hpp"
+
+#include <functional>
+
+namespace vh::protocols::http::task {
+
+// Routes one HTTP request off the io threads; the session posts the response back to its strand.
+struct Dispatch final : concurrency::Task {
+    std::function<void()> job;
+
+    explicit Dispatch(std::function<void()> fn) : job(std::move(fn)) {}
+
+    void operator()() override {
+        job();
+    }
+};
+
+}
@@ -16,5 +16,7 @@ void registerSecretsCommands(const std::shared_ptr<Router>& r);
 void registerSetupCommands(const std::shared_ptr<Router>& r);
 void registerTeardownCommands(const std::shared_ptr<Router>& r);
 void registerStatusCommands(const std::shared_ptr<Router>& r);
+void registerStatsCommands(const std::shared_ptr<Router>& r);
+void registerTraceCommands(const std::shared_ptr<Router>& r);
 
 }
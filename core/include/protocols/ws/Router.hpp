@@ -8,6 +8,8 @@
 #include <unordered_map>
 #include <utility>
 
+namespace vh::stats::model { class Histogram; }
+
 namespace vh::protocols::ws {
 
 class Session;
@@ -197,7 +199,14 @@ class Router {
     }
 
   private:
-    std::unordered_map<std::string, Handler> handlers_;
+    struct Route {
+        Handler handler;
+        stats::model::Histogram* latency;   // stats::Metric::WsHandler{command}
+    };
+
+    std::unordered_map<std::string, Route> handlers_;
+
+    void add(const std::string& cmd, Handler h);
 };
 
 }
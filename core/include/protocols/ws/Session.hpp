@@ -6,9 +6,11 @@
 #include <boost/beast/websocket.hpp>
 
 #include "rbac/Actor.hpp"
+#include "auth/session/VerifiedTokenCache.hpp"
 
 #include <atomic>
 #include <deque>
+#include <functional>
 #include <memory>
 #include <nlohmann/json.hpp>
 #include <string>
@@ -46,6 +48,7 @@ public:
     const std::string uuid{generateUUIDv4()};
     std::shared_ptr<identities::User> user{nullptr};
     std::shared_ptr<auth::model::TokenPair> tokens;
+    auth::session::VerifiedTokenCache verifiedToken;
     std::string userAgent, ipAddress;
     const std::chrono::system_clock::time_point connectionOpenedAt = std::chrono::system_clock::now();
 
@@ -54,6 +57,8 @@ public:
 
     void accept(tcp::socket&& socket);
     void send(json message);
+    // Shares send()'s queue, so a frame pushed by a handler goes out ahead of that handler's response
+    void sendBinary(std::string frame);
     void close();
 
     void setAuthenticatedUser(const std::shared_ptr<identities::User>& u);
@@ -82,6 +87,12 @@ private:
     void doRead();
     void onRead(const beast::error_code& ec, std::size_t bytesRead);
 
+    // ---- message dispatch (strand only); handlers run one at a time on the ws pool
+    void enqueueMessage(std::function<void()> job);
+    void dispatchNext();
+    void onDispatchComplete();
+    void resumeReadIfPaused();
+
     void maybeStartWrite();
     void doWrite();
     void onWrite(const beast::error_code& ec, std::size_t bytesWritten);
@@ -116,8 +127,17 @@ private:
 
     std::atomic_bool closing_{false};
 
+    struct Outgoing {
+        std::string payload;
+        bool binary = false;
+    };
+
     bool writing_ = false;                 // only touched on strand
-    std::deque<std::string> writeQueue_;   // only touched on strand
+    std::deque<Outgoing> writeQueue_;      // only touched on strand
+
+    std::deque<std::function<void()>> pending_; // only touched on strand
+    bool dispatching_ = false;                  // only touched on strand
+    bool readPaused_ = false;                   // only touched on strand
 
     bool sendAccessToken_{false};
 };
@@ -4,6 +4,7 @@
 #include <functional>
 #include <memory>
 #include <nlohmann/json.hpp>
+#include <string>
 #include <vector>
 
 namespace vh::protocols::ws {
@@ -31,6 +32,8 @@ public:
     using ManagerFactory = std::function<std::shared_ptr<vh::share::Manager>()>;
     using ResolverFactory = std::function<std::shared_ptr<vh::share::TargetResolver>()>;
     using ReaderFactory = std::function<std::shared_ptr<DownloadReader>()>;
+    // Where binary-encoded chunks go; Session::sendBinary outside of tests
+    using FrameSink = std::function<void(const std::shared_ptr<Session>&, std::string frame)>;
 
     static json start(const json& payload, const std::shared_ptr<Session>& session);
     static json chunk(const json& payload, const std::shared_ptr<Session>& session);
@@ -45,6 +48,8 @@ public:
     static void resetResolverFactoryForTesting();
     static void setReaderFactoryForTesting(ReaderFactory factory);
     static void resetReaderFactoryForTesting();
+    static void setFrameSinkForTesting(FrameSink sink);
+    static void resetFrameSinkForTesting();
     static void resetTransfersForTesting();
 };
 
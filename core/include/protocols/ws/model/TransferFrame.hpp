@@ -0,0 +1,46 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace vh::protocols::ws::model {
+
+// Binary WebSocket message carrying transfer payload bytes. JSON stays the control channel;
+// the bytes themselves go out raw behind a fixed big-endian header:
+//
+//   0   u8      version (1)
+//   1   u8      flags
+//   2   u16     reserved, zero
+//   4   u8[16]  transfer id (the UUID from *.download.start)
+//   20  u64     byte offset of the payload within the transfer
+//   28  ...     payload
+struct TransferFrame {
+    static constexpr uint8_t VERSION = 1;
+    static constexpr size_t HEADER_BYTES = 28;
+
+    enum Flags : uint8_t {
+        None  = 0,
+        Final = 1u << 0,   // last chunk of the transfer
+    };
+
+    std::array<uint8_t, 16> transferId{};
+    uint64_t offset = 0;
+    uint8_t flags = None;
+    std::span<const uint8_t> payload;
+
+    [[nodiscard]] bool final() const { return flags & Final; }
+    [[nodiscard]] std::string transferIdString() const;
+
+    // Header and payload in one buffer, ready to be written as a single binary message
+    [[nodiscard]] static std::string encode(std::string_view transferId, uint64_t offset, uint8_t flags,
+                                            std::span<const uint8_t> payload);
+
+    // Views into frame; throws std::invalid_argument on a short header or unknown version
+    [[nodiscard]] static TransferFrame decode(std::span<const uint8_t> frame);
+};
+
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "rbac/fs/glob/model/Pattern.hpp"
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace vh::rbac::fs::glob {
+    // A pattern compiled to a small NFA and run as a set of live states over the path in a single
+    // pass. No backtracking: a match costs O(path length x pattern length) however many '*' and
+    // '**' the pattern stacks up.
+    class Automaton {
+    public:
+        Automaton() = default;
+
+        explicit Automaton(const model::Pattern &pattern);
+
+        // path must already be normalized and vault-absolute
+        [[nodiscard]] bool matches(std::string_view path) const;
+
+        [[nodiscard]] std::size_t size() const { return states_.size(); }
+
+    private:
+        enum class Op : uint8_t {
+            Char,       // exactly c
+            Slash,      // '/'
+            OneChar,    // '?' and the first character of '*': any one non-slash
+            SegmentRun, // rest of '*': zero or more non-slash, can be left without consuming
+            AnyRun,     // '**': anything, can be left without consuming
+            Segments    // '**/': zero or more whole segments, left either at once or on a '/'
+        };
+
+        struct State {
+            Op op;
+            char c{};
+        };
+
+        std::vector<State> states_;
+    };
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace vh::rbac::fs::policy {
+    // Bounded LRU of override decisions keyed by (index generation, question, path). A generation
+    // belongs to one compiled OverrideIndex, so editing a role's overrides retires its entries by
+    // construction; they age out instead of needing an explicit purge. Sharded to keep FUSE
+    // threads from serializing on one lock.
+    class DecisionCache {
+    public:
+        explicit DecisionCache(std::size_t capacity);
+
+        // Process-wide cache sized from caching.permission_decision_cache_entries
+        static DecisionCache &instance();
+
+        [[nodiscard]] std::optional<int32_t> get(uint64_t generation, uint16_t question, std::string_view path);
+        void put(uint64_t generation, uint16_t question, std::string_view path, int32_t answer);
+
+        void clear();
+
+        [[nodiscard]] std::size_t size() const;
+        [[nodiscard]] std::size_t capacity() const { return capacity_; }
+
+    private:
+        static constexpr std::size_t kShards = 16;
+
+        struct Entry {
+            std::string key;
+            int32_t answer;
+        };
+
+        struct Shard {
+            mutable std::mutex mutex;
+            std::list<Entry> lru;
+            std::unordered_map<std::string, std::list<Entry>::iterator> index;
+        };
+
+        std::size_t capacity_, perShard_;
+        std::array<Shard, kShards> shards_;
+
+        static std::string key(uint64_t generation, uint16_t question, std::string_view path);
+        Shard &shardFor(const std::string &key);
+    };
+}
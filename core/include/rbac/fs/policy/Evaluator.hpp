@@ -71,7 +71,7 @@ namespace vh::rbac::fs::policy {
 
         [[nodiscard]]
         static StageResult resolveOverrides(
-            const std::vector<permission::Override> &overrides,
+            const permission::OverrideList &overrides,
             std::string_view absolutePath,
             const rbac::permission::vault::FilesystemAction& action
         );
@@ -95,21 +95,9 @@ namespace vh::rbac::fs::policy {
             permission::vault::FilesystemAction action
         );
 
-        [[nodiscard]]
-        static std::optional<permission::OverrideOpt> overrideEffect(const permission::Override &o);
-
         [[nodiscard]] static bool requiresTraversalThrough(
-            const std::vector<permission::Override> &overrides,
+            const permission::OverrideList &overrides,
             const std::filesystem::path& absolutePath
         );
-
-        [[nodiscard]] static const permission::Override *findBestOverride(
-            const std::vector<permission::Override> &overrides,
-            const std::filesystem::path& absolutePath,
-            const rbac::permission::vault::FilesystemAction& action
-        );
-
-        [[nodiscard]]
-        static std::size_t scorePattern(const ::vh::rbac::fs::glob::model::Pattern &pattern);
     };
 }
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "rbac/fs/glob/Automaton.hpp"
+#include "rbac/fs/glob/model/Pattern.hpp"
+#include "rbac/permission/Override.hpp"
+#include "rbac/permission/vault/Filesystem.hpp"
+
+#include <bitset>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace vh::rbac::fs::policy {
+    // One role's overrides compiled for lookup. Enabled overrides hang off a trie of the literal
+    // path segments their pattern starts with, so a check only visits overrides along the path
+    // it is asked about; each keeps a glob::Automaton and the actions its permission applies to.
+    // Immutable once built: OverrideList hands out a new one when the overrides change.
+    class OverrideIndex {
+    public:
+        using Action = permission::vault::FilesystemAction;
+
+        struct Match {
+            std::string pattern;
+            permission::OverrideOpt effect{};
+        };
+
+        explicit OverrideIndex(const std::vector<permission::Override> &overrides);
+
+        // Most specific enabled override covering path for action; earlier overrides win ties.
+        // Answers come from the shared DecisionCache when this index has seen the question before.
+        [[nodiscard]] std::optional<Match> best(std::string_view path, Action action) const;
+
+        // Whether an enabled ALLOW override sits at or below directory, so Lookup must pass through it
+        [[nodiscard]] bool requiresTraversalThrough(std::string_view directory) const;
+
+        // Unique per compiled index; stands in for the role version in decision cache keys
+        [[nodiscard]] uint64_t generation() const { return generation_; }
+        [[nodiscard]] std::size_t size() const { return entries_.size(); }
+
+        // Specificity used to rank overrides that cover the same path: literals count most
+        [[nodiscard]] static std::size_t score(const glob::model::Pattern &pattern);
+
+    private:
+        static constexpr std::size_t kActions = static_cast<std::size_t>(Action::Lookup) + 1;
+
+        struct Entry {
+            uint32_t order{};
+            std::size_t score{};
+            permission::OverrideOpt effect{};
+            std::bitset<kActions> actions;    // actions this override's permission speaks to
+            glob::model::Pattern pattern;
+            glob::Automaton automaton;
+        };
+
+        struct Node {
+            std::unordered_map<std::string, uint32_t> children;
+            std::vector<uint32_t> entries;
+        };
+
+        uint64_t generation_;
+        std::vector<Entry> entries_;
+        std::vector<Node> nodes_{1};    // nodes_[0] is the vault root
+
+        [[nodiscard]] int32_t findBest(const std::string &path, Action action) const;
+        [[nodiscard]] bool findTraversal(const std::string &directory) const;
+        void insert(uint32_t entry);
+    };
+}
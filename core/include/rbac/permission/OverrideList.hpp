@@ -0,0 +1,77 @@
+#pragma once
+
+#include "rbac/permission/Override.hpp"
+
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace vh::rbac::fs::policy { class OverrideIndex; }
+
+namespace vh::rbac::permission {
+    // The overrides a role carries. Reads like the vector it wraps; every mutable access bumps a
+    // version, and index() recompiles the policy::OverrideIndex only when that version moved.
+    class OverrideList {
+    public:
+        using value_type = Override;
+        using size_type = std::vector<Override>::size_type;
+        using iterator = std::vector<Override>::iterator;
+        using const_iterator = std::vector<Override>::const_iterator;
+
+        OverrideList() = default;
+        OverrideList(std::vector<Override> overrides) : items_(std::move(overrides)) {}
+        OverrideList(std::initializer_list<Override> overrides) : items_(overrides) {}
+
+        OverrideList(const OverrideList &other);
+        OverrideList(OverrideList &&other) noexcept;
+        OverrideList &operator=(const OverrideList &other);
+        OverrideList &operator=(OverrideList &&other) noexcept;
+        OverrideList &operator=(std::vector<Override> overrides);
+
+        operator const std::vector<Override> &() const { return items_; }
+        [[nodiscard]] const std::vector<Override> &items() const { return items_; }
+
+        [[nodiscard]] bool empty() const { return items_.empty(); }
+        [[nodiscard]] size_type size() const { return items_.size(); }
+
+        [[nodiscard]] const_iterator begin() const { return items_.begin(); }
+        [[nodiscard]] const_iterator end() const { return items_.end(); }
+        [[nodiscard]] const Override &operator[](const size_type i) const { return items_[i]; }
+        [[nodiscard]] const Override &front() const { return items_.front(); }
+        [[nodiscard]] const Override &back() const { return items_.back(); }
+
+        // Anything that can change an override counts as a change, even if the caller only reads
+        [[nodiscard]] iterator begin() { touch(); return items_.begin(); }
+        [[nodiscard]] iterator end() { touch(); return items_.end(); }
+        [[nodiscard]] Override &operator[](const size_type i) { touch(); return items_[i]; }
+        [[nodiscard]] Override &front() { touch(); return items_.front(); }
+        [[nodiscard]] Override &back() { touch(); return items_.back(); }
+
+        void push_back(Override o) { touch(); items_.push_back(std::move(o)); }
+
+        template<typename... Args>
+        Override &emplace_back(Args &&... args) { touch(); return items_.emplace_back(std::forward<Args>(args)...); }
+
+        void reserve(const size_type n) { items_.reserve(n); }
+        void clear() { touch(); items_.clear(); }
+        iterator erase(const_iterator pos) { touch(); return items_.erase(pos); }
+        iterator erase(const_iterator first, const_iterator last) { touch(); return items_.erase(first, last); }
+
+        [[nodiscard]] uint64_t version() const { return version_; }
+
+        // Compiled form of the current overrides; shared by every copy until one of them changes
+        [[nodiscard]] std::shared_ptr<const fs::policy::OverrideIndex> index() const;
+
+    private:
+        std::vector<Override> items_;
+        uint64_t version_ = 0;
+
+        mutable std::mutex indexMutex_;
+        mutable std::shared_ptr<const fs::policy::OverrideIndex> index_;
+        mutable uint64_t indexVersion_ = 0;
+
+        void touch() { ++version_; }
+    };
+}
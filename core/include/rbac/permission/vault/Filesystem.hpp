@@ -3,6 +3,7 @@
 #include "fs/Directories.hpp"
 #include "fs/Files.hpp"
 #include "rbac/permission/Override.hpp"
+#include "rbac/permission/OverrideList.hpp"
 #include "rbac/permission/template/Traits.hpp"
 
 #include <cstdint>
@@ -116,7 +117,7 @@ namespace vh::rbac::permission {
         struct Filesystem {
             fs::Files files{};
             fs::Directories directories{};
-            std::vector<Override> overrides{};
+            OverrideList overrides{};
 
             Filesystem() = default;
 
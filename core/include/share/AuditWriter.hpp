@@ -0,0 +1,82 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace vh::share {
+
+struct AuditEvent;
+
+// Takes share audit events and link counters off the request path. Events queue up and go
+// out as multi-row INSERTs once a batch fills or the oldest one reaches maxAge; counter
+// bumps are folded per link into one UPDATE per flush. The queue is bounded: producers wait
+// for the writer rather than drop audit records. stop() drains everything still pending.
+class AuditWriter {
+public:
+    struct Options {
+        size_t batchSize = 500;
+        std::chrono::milliseconds maxAge{250};
+        size_t maxQueued = 10000;
+    };
+
+    struct Counters {
+        uint64_t accesses = 0, downloads = 0, uploads = 0;
+    };
+
+    struct Sink {
+        std::function<void(const std::vector<std::shared_ptr<AuditEvent>>&)> events;
+        std::function<void(const std::unordered_map<std::string, Counters>&)> counters;
+        // Used one event at a time when a batch is rejected, so one bad row costs only itself
+        std::function<void(const std::shared_ptr<AuditEvent>&)> event;
+    };
+
+    // Writes through db::query::share, sized from the sharing config
+    static AuditWriter& instance();
+
+    AuditWriter(Options options, Sink sink);
+    ~AuditWriter();
+
+    AuditWriter(const AuditWriter&) = delete;
+    AuditWriter& operator=(const AuditWriter&) = delete;
+
+    void append(std::shared_ptr<AuditEvent> event);
+    void touchAccess(const std::string& linkId);
+    void incrementDownload(const std::string& linkId);
+    void incrementUpload(const std::string& linkId);
+
+    // Blocks until everything queued before the call has been handed to the sink
+    void flush();
+    void stop();
+
+    [[nodiscard]] size_t pending() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Options options_;
+    Sink sink_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_, space_, flushed_;
+    std::vector<std::shared_ptr<AuditEvent>> events_;
+    std::unordered_map<std::string, Counters> counters_;
+    Clock::time_point oldest_{};
+    uint64_t enqueued_ = 0, written_ = 0;
+    bool flushRequested_ = false, stopping_ = false;
+    std::thread worker_;
+
+    void bump(const std::string& linkId, uint64_t Counters::* field);
+    void run();
+    void write(const std::vector<std::shared_ptr<AuditEvent>>& events,
+               const std::unordered_map<std::string, Counters>& counters) const;
+};
+
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "stats/model/Histogram.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace vh::stats {
+
+enum class Metric : uint8_t {
+    FuseOp,          // per FUSE opcode, from entering the op to its reply
+    DbAcquire,       // waiting for a pooled connection
+    DbHold,          // connection leased out
+    DbTransaction,   // Transactions::exec body through commit
+    PoolQueueWait,   // task sat in a ThreadPool queue before a worker picked it up
+    S3Request,       // one curl round trip to the object store, by HTTP method
+    WsHandler,       // WebSocket command handler, by command
+    Count
+};
+
+// Process-wide latency histograms, exported by the HTTP /metrics endpoint and `vh stats`.
+class Metrics {
+public:
+    using Source = std::function<model::HistogramSnapshot()>;
+
+    struct Series {
+        Metric metric;
+        std::string label;
+        model::HistogramSnapshot snapshot;
+    };
+
+    static Metrics& instance();
+
+    // Histogram for metric{label}, created on first use. References stay valid for the life of
+    // the process, so hot paths resolve them once and keep them.
+    model::Histogram& histogram(Metric metric, std::string_view label = {});
+
+    // Export a histogram owned elsewhere (e.g. the DB pool's); replaces any earlier binding
+    void bind(Metric metric, std::string_view label, Source source);
+
+    [[nodiscard]] std::vector<Series> snapshot() const;
+
+    // Prometheus text exposition format, version 0.0.4
+    [[nodiscard]] std::string prometheus() const;
+
+    [[nodiscard]] static std::string_view name(Metric metric);
+    [[nodiscard]] static std::string_view help(Metric metric);
+    [[nodiscard]] static std::string_view labelName(Metric metric);
+
+private:
+    Metrics() = default;
+
+    struct Family {
+        std::map<std::string, std::unique_ptr<model::Histogram>, std::less<>> owned;
+        std::map<std::string, std::shared_ptr<const Source>, std::less<>> bound;
+    };
+
+    mutable std::shared_mutex mutex_;
+    std::array<Family, static_cast<std::size_t>(Metric::Count)> families_;
+};
+
+// Observes the time between construction and destruction
+class ScopedTimer {
+public:
+    explicit ScopedTimer(model::Histogram& histogram)
+        : histogram_(histogram), start_(std::chrono::steady_clock::now()) {}
+
+    ~ScopedTimer() {
+        const auto elapsed = std::chrono::steady_clock::now() - start_;
+        histogram_.observe_us(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    model::Histogram& histogram_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+}
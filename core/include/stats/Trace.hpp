@@ -0,0 +1,94 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <nlohmann/json_fwd.hpp>
+
+namespace vh::stats::trace {
+
+struct SpanRecord {
+    const char* name;       // static storage, e.g. a literal like "fuse.open"
+    std::string detail;     // path, command, method...
+    uint64_t start_ns{};    // steady clock
+    uint64_t dur_ns{};
+    uint16_t depth{};
+};
+
+// One root span and everything opened beneath it on the same thread; spans[0] is the root
+struct Trace {
+    uint64_t id{};
+    uint32_t tid{};
+    bool slow = false;
+    uint32_t dropped{};     // nested spans past max_spans
+    std::vector<SpanRecord> spans;
+
+    [[nodiscard]] uint64_t duration_ns() const { return spans.empty() ? 0 : spans.front().dur_ns; }
+};
+
+// In-process tracer. The outermost Span on a thread starts a trace and nested Spans attach to
+// it; when the root closes, the trace is kept if it was sampled or ran past the slow threshold,
+// otherwise the thread reuses its buffer for the next one.
+class Tracer {
+public:
+    struct Options {
+        bool enabled = true;
+        double sample_rate = 0.001;
+        std::chrono::milliseconds slow_threshold{250};   // 0 disables slow capture
+        std::size_t capacity = 512;                      // kept traces, oldest evicted first
+        std::size_t max_spans = 256;
+    };
+
+    static Tracer& instance();
+
+    explicit Tracer(const Options& opts);
+
+    void configure(const Options& opts);
+
+    // Newest first; limit 0 = everything kept
+    [[nodiscard]] std::vector<Trace> recent(bool slowOnly = false, std::size_t limit = 0) const;
+
+    // Chrome trace event format (chrome://tracing, Perfetto)
+    [[nodiscard]] nlohmann::json chromeJson(bool slowOnly = false, std::size_t limit = 0) const;
+
+    void clear();
+
+private:
+    friend class Span;
+
+    [[nodiscard]] bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+    [[nodiscard]] bool sample() const;
+    void finish(Trace& trace, bool sampled);
+
+    std::atomic<bool> enabled_{true};
+    std::atomic<uint64_t> sampleBelow_{0};   // sample when a random 64-bit draw falls below this
+    std::atomic<uint64_t> slowNs_{0};
+    std::atomic<std::size_t> maxSpans_{0};
+
+    mutable std::mutex mutex_;
+    std::vector<Trace> ring_;
+    std::size_t capacity_{};
+    std::size_t next_{};
+};
+
+// RAII span. Costs two clock reads and a vector slot when tracing is on, one branch when off.
+class Span {
+public:
+    explicit Span(const char* name, std::string_view detail = {});
+    ~Span();
+
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+
+private:
+    static constexpr std::size_t kInactive = static_cast<std::size_t>(-1);
+    std::size_t index_ = kInactive;
+};
+
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <nlohmann/json_fwd.hpp>
+
+namespace vh::stats::model {
+
+// HDR-style log-linear buckets: values below 4us are exact, every power of two above that is
+// split into 4 linear steps (<= 25% relative error). Values of 2^25 us (~33s) and up share the
+// overflow bucket.
+constexpr std::size_t kHistogramSubBucketBits = 2;
+constexpr std::size_t kHistogramSubBuckets = std::size_t{1} << kHistogramSubBucketBits;
+constexpr std::size_t kHistogramOctaves = 25;
+constexpr std::size_t kHistogramBuckets =
+    kHistogramSubBuckets + (kHistogramOctaves - kHistogramSubBucketBits) * kHistogramSubBuckets + 1;
+
+// Writers are striped over this many cache-line aligned shards, one per thread (round robin)
+constexpr std::size_t kHistogramShards = 8;
+
+struct HistogramSnapshot {
+    std::array<uint64_t, kHistogramBuckets> buckets{};
+    uint64_t count{};
+    uint64_t sum_us{};
+    uint64_t max_us{};
+
+    // Bucket holding a value, and the largest value bucket i holds (UINT64_MAX for the overflow bucket)
+    static std::size_t bucket_for(uint64_t us) noexcept;
+    static uint64_t upper_bound_us(std::size_t i) noexcept;
+
+    // True for the last sub-bucket of each power of two; these bounds are 2^k - 1 us
+    static bool is_octave_boundary(std::size_t i) noexcept;
+
+    void merge(const HistogramSnapshot& other) noexcept;
+
+    // Upper bound of the bucket holding the q-th quantile (0 < q <= 1), capped at max_us; 0 when empty
+    [[nodiscard]] uint64_t quantile_us(double q) const noexcept;
+    [[nodiscard]] double avg_ms() const noexcept;
+};
+
+// Lock-free latency histogram. observe_us() touches only the calling thread's shard, so hot
+// paths on many threads don't fight over the same cache lines; snapshot() merges the shards.
+class Histogram {
+public:
+    void observe_us(uint64_t us) noexcept;
+
+    [[nodiscard]] HistogramSnapshot snapshot() const noexcept;
+
+private:
+    struct alignas(64) Shard {
+        std::array<std::atomic<uint64_t>, kHistogramBuckets> buckets{};
+        std::atomic<uint64_t> sum_us{0};
+        std::atomic<uint64_t> max_us{0};
+    };
+
+    std::array<Shard, kHistogramShards> shards_{};
+
+    static std::size_t shardIndex() noexcept;
+};
+
+void to_json(nlohmann::json& j, const HistogramSnapshot& s);
+
+}
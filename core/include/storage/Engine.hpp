@@ -3,7 +3,10 @@
 #include <filesystem>
 #include <vector>
 #include <memory>
+#include <optional>
 #include <shared_mutex>
+#include <string>
+#include <utility>
 
 namespace vh::fs::model {
     struct File;
@@ -29,6 +32,9 @@ namespace vh::sync::model {
 }
 
 namespace vh::crypto {
+    namespace util {
+        class AES256GCMDecryptor;
+    }
 }
 
 namespace vh::storage {
@@ -67,6 +73,21 @@ namespace vh::storage {
         [[nodiscard]] std::vector<uint8_t> decrypt(unsigned int vaultId, const std::filesystem::path &relPath,
                                                    const std::vector<uint8_t> &payload) const;
 
+        // IV and key version of f's backing file as the database records them, or nullopt when
+        // it is stored unencrypted. Callers sizing and decrypting the same file should fetch this
+        // once and use it for both, since the cached File's IV can lag behind the row.
+        using EncryptionContext = std::pair<std::string, unsigned int>;
+        [[nodiscard]] std::optional<EncryptionContext> encryptionContext(
+            const std::shared_ptr<vh::fs::model::File> &f) const;
+
+        // Streaming decryptor for f's backing file positioned at plaintext `offset`,
+        // or nullptr when the file is stored unencrypted.
+        [[nodiscard]] std::unique_ptr<crypto::util::AES256GCMDecryptor> decryptor(
+            const std::shared_ptr<vh::fs::model::File> &f, uint64_t offset = 0) const;
+
+        [[nodiscard]] std::unique_ptr<crypto::util::AES256GCMDecryptor> decryptor(
+            const EncryptionContext &context, uint64_t offset = 0) const;
+
         void mkdir(const fs::path &relPath, unsigned int userId);
 
         void move(const fs::path &from, const fs::path &to, unsigned int userId);
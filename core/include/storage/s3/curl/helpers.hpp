@@ -27,6 +27,9 @@ void trimInPlace(std::string& s);
 
 void ensureCurlGlobalInit();
 
+// curl_easy_perform, timed into stats::Metric::S3Request under the request's HTTP method
+CURLcode perform(CURL* curl);
+
 inline std::string slurp(const std::istream& in) {
     std::ostringstream oss;
     oss << in.rdbuf();          // copy entire buffer
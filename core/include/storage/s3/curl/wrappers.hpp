@@ -62,7 +62,7 @@ static HttpResponse performCurl(SetupFn&& setup) {
     setup(static_cast<CURL*>(h));                      // caller-specific tweaks
 
     HttpResponse r;
-    r.curl = curl_easy_perform(static_cast<CURL*>(h));
+    r.curl = vh::storage::s3::curl::perform(static_cast<CURL*>(h));
     curl_easy_getinfo(static_cast<CURL*>(h), CURLINFO_RESPONSE_CODE, &r.http);
     r.body.swap(bodyBuf);
     r.hdr.swap(hdrBuf);
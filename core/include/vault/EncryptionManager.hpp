@@ -8,6 +8,7 @@
 #include <atomic>
 
 namespace vh::fs::model { struct File; }
+namespace vh::crypto::util { class AES256GCMEncryptor; class AES256GCMDecryptor; }
 
 namespace vh::vault {
 
@@ -28,10 +29,17 @@ public:
     // Populates out_b64_iv with base64-encoded IV.
     [[nodiscard]] std::vector<uint8_t> encrypt(const std::vector<uint8_t>& plaintext, const std::shared_ptr<fs::model::File>& f) const;
 
+    // Streaming counterpart of encrypt(); stamps the fresh IV and key version onto f.
+    [[nodiscard]] std::unique_ptr<crypto::util::AES256GCMEncryptor> encryptor(const std::shared_ptr<fs::model::File>& f) const;
+
     // Decrypt using base64-encoded IV and ciphertext
     [[nodiscard]] std::vector<uint8_t> decrypt(const std::vector<uint8_t>& ciphertext,
                                  const std::string& b64_iv, unsigned int keyVersion) const;
 
+    // Streaming counterpart of decrypt(), positioned at plaintext byte `offset`.
+    [[nodiscard]] std::unique_ptr<crypto::util::AES256GCMDecryptor>
+    decryptor(const std::string& b64_iv, unsigned int keyVersion, uint64_t offset = 0) const;
+
     [[nodiscard]] std::vector<uint8_t> get_key(const std::string& callingFunctionName) const;
 
     [[nodiscard]] unsigned int get_key_version() const;
@@ -43,6 +51,8 @@ private:
     std::atomic<bool> rotation_in_progress_;
     unsigned int vault_id_, version_{};
     std::vector<uint8_t> key_, old_key_;
+
+    [[nodiscard]] const std::vector<uint8_t>& decryption_key(unsigned int keyVersion) const;
 };
 
 }
@@ -10,6 +10,7 @@
 // Storage
 #include "storage/Manager.hpp"
 #include "fs/Filesystem.hpp"
+#include "fs/cache/Registry.hpp"
 
 // Seed
 #include "seed/include/seed_db.hpp"
@@ -19,13 +20,14 @@
 #include "config/Registry.hpp"
 #include "concurrency/ThreadPoolManager.hpp"
 #include "log/Registry.hpp"
+#include "preview/pdf/Renderer.hpp"
+#include "share/AuditWriter.hpp"
 
 // Libraries
 #include <atomic>
 #include <chrono>
 #include <csignal>
 #include <thread>
-#include <pdfium/fpdfview.h>
 
 using namespace vh::config;
 using namespace vh::concurrency;
@@ -48,23 +50,6 @@ void registerSignalHandlers() {
     std::signal(SIGTERM, signalHandler);
 }
 
-// --- External Libs ---
-
-struct PdfiumGuard {
-    PdfiumGuard() {
-        FPDF_LIBRARY_CONFIG config;
-        config.version = 3;
-        config.m_pUserFontPaths = nullptr;
-        config.m_pIsolate = nullptr;
-        config.m_v8EmbedderSlot = 0;
-        FPDF_InitLibraryWithConfig(&config);
-    }
-
-    ~PdfiumGuard() {
-        FPDF_DestroyLibrary();
-    }
-};
-
 // --- Core Init ---
 
 void initDB() {
@@ -130,6 +115,12 @@ void shutdownVaulthalla() {
     stopRuntime();
     ThreadPoolManager::instance().shutdown();
 
+    // Nothing mutates the file index past this point
+    if (const auto& cache = vh::runtime::Deps::get().fsCache) cache->saveSnapshot();
+
+    vh::share::AuditWriter::instance().stop();
+    vh::preview::pdf::Renderer::instance().stop();
+
     log->info("[✓] Vaulthalla services shut down cleanly.");
 }
 }
@@ -139,8 +130,6 @@ int main() {
         Registry::init();
         vh::log::Registry::init();
 
-        PdfiumGuard pdfium;
-
         startVaulthalla();
         registerSignalHandlers();
 
@@ -148,12 +137,14 @@ int main() {
             std::this_thread::sleep_for(std::chrono::seconds(1));
 
         shutdownVaulthalla();
+        vh::log::Registry::shutdown();
         return EXIT_SUCCESS;
 
     } catch (const std::exception& e) {
         vh::log::Registry::vaulthalla()->error(
             "[-] Failed to initialize Vaulthalla: {}", e.what()
         );
+        vh::log::Registry::shutdown();
         return EXIT_FAILURE;
     }
 }
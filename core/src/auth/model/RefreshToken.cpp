@@ -27,7 +27,7 @@ bool RefreshToken::isValid() const {
         return false;
     }
 
-    if (revoked) {
+    if (isRevoked()) {
         log::Registry::auth()->debug("[RefreshToken] Token is revoked");
         return false;
     }
@@ -45,7 +45,7 @@ bool RefreshToken::dangerousDivergence(const std::shared_ptr<RefreshToken>& othe
     return hashedToken == other->hashedToken && (
         jti != other->jti || userAgent != other->userAgent ||
         ipAddress != other->ipAddress || issuedAt != other->issuedAt || expiresAt != other->expiresAt ||
-        lastUsed != other->lastUsed || revoked != other->revoked
+        lastUsed != other->lastUsed || isRevoked() != other->isRevoked()
     );
 }
 
@@ -65,7 +65,7 @@ void RefreshToken::addShareToSession(const std::shared_ptr<protocols::ws::Sessio
 }
 
 bool operator==(const std::shared_ptr<RefreshToken>& lhs, const std::shared_ptr<RefreshToken>& rhs) {
-    return lhs->revoked == rhs->revoked && lhs->jti == rhs->jti && lhs->hashedToken == rhs->hashedToken &&
+    return lhs->isRevoked() == rhs->isRevoked() && lhs->jti == rhs->jti && lhs->hashedToken == rhs->hashedToken &&
            lhs->userAgent == rhs->userAgent && lhs->ipAddress == rhs->ipAddress &&
            lhs->issuedAt == rhs->issuedAt && lhs->expiresAt == rhs->expiresAt;
 }
@@ -18,9 +18,30 @@ Token::Token(const pqxx::row& row)
 
 Token::Token(std::string rawToken) : rawToken(std::move(rawToken)) {}
 
+Token::Token(const Token& other)
+    : rawToken(other.rawToken),
+      jti(other.jti),
+      subject(other.subject),
+      userId(other.userId),
+      issuedAt(other.issuedAt),
+      expiresAt(other.expiresAt),
+      revoked(other.isRevoked()) {}
+
+Token& Token::operator=(const Token& other) {
+    if (this == &other) return *this;
+    rawToken = other.rawToken;
+    jti = other.jti;
+    subject = other.subject;
+    userId = other.userId;
+    issuedAt = other.issuedAt;
+    expiresAt = other.expiresAt;
+    revoked.store(other.isRevoked(), std::memory_order_release);
+    return *this;
+}
+
 bool Token::isExpired() const { return system_clock::now() > expiresAt; }
 bool Token::isValid() const {
-    if (revoked) {
+    if (isRevoked()) {
         log::Registry::auth()->debug("[Token] Token is revoked");
         return false;
     }
@@ -39,7 +60,7 @@ seconds Token::timeRemaining() const {
 
 bool vh::auth::model::operator==(const std::shared_ptr<Token>& lhs, const std::shared_ptr<Token>& rhs) {
     return lhs->rawToken == rhs->rawToken && lhs->userId == rhs->userId && lhs->expiresAt == rhs->expiresAt &&
-           lhs->revoked == rhs->revoked;
+           lhs->isRevoked() == rhs->isRevoked();
 }
 
 void Token::dangerousDivergence(const std::optional<session::TokenClaims>& claims) const {
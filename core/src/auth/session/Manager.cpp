@@ -18,6 +18,8 @@ using namespace vh::identities;
 namespace vh::auth::session {
 
 namespace {
+constexpr std::chrono::seconds ACCESS_TOKEN_RENEW_WINDOW = std::chrono::minutes(5);
+
 [[nodiscard]] std::optional<std::string> humanRefreshJti(const std::shared_ptr<Session>& session) {
     if (!session || !session->tokens || !session->tokens->refreshToken) return std::nullopt;
     if (session->tokens->refreshToken->jti.empty()) return std::nullopt;
@@ -326,8 +328,12 @@ bool Manager::validate(const std::shared_ptr<Session>& session, const std::strin
         if (!session) throw std::invalid_argument("Invalid session for validation");
         if (!session->user) throw std::invalid_argument("Session does not contain user data for validation");
 
+        if (session->tokens && session->verifiedToken.verified(accessToken, session->tokens->accessToken))
+            return true;
+
         if (Validator::validateAccessToken(session, accessToken)) {
-            if (session->tokens->accessToken->timeRemaining() < std::chrono::minutes(5)) Issuer::accessToken(session);
+            if (session->tokens->accessToken->timeRemaining() < ACCESS_TOKEN_RENEW_WINDOW) Issuer::accessToken(session);
+            else session->verifiedToken.remember(accessToken, session->tokens->accessToken, ACCESS_TOKEN_RENEW_WINDOW);
             cache(session);
             return true;
         }
@@ -403,6 +409,7 @@ void Manager::invalidate(const std::shared_ptr<Session>& session) {
     const auto userId =
         session->user ? std::optional<uint32_t>{session->user->id} : std::nullopt;
 
+    session->verifiedToken.clear();
     if (session->tokens)
         session->tokens->invalidate();
 
@@ -0,0 +1,48 @@
+#include "auth/session/VerifiedTokenCache.hpp"
+#include "auth/model/Token.hpp"
+
+#include <sodium.h>
+#include <algorithm>
+
+namespace vh::auth::session {
+
+VerifiedTokenCache::Digest VerifiedTokenCache::digest(const std::string_view rawToken) {
+    Digest out{};
+    crypto_generichash(out.data(), out.size(),
+                       reinterpret_cast<const unsigned char*>(rawToken.data()), rawToken.size(),
+                       nullptr, 0);
+    return out;
+}
+
+bool VerifiedTokenCache::verified(const std::string_view rawToken,
+                                  const std::shared_ptr<model::Token>& current,
+                                  const Clock::time_point now) const {
+    if (rawToken.empty() || !current || current->isRevoked()) return false;
+
+    std::lock_guard lock(mutex_);
+    if (!entry_ || now >= entry_->until) return false;
+    if (entry_->token.lock() != current) return false;
+
+    const auto d = digest(rawToken);
+    return sodium_memcmp(d.data(), entry_->digest.data(), d.size()) == 0;
+}
+
+void VerifiedTokenCache::remember(const std::string_view rawToken,
+                                  const std::shared_ptr<model::Token>& token,
+                                  const std::chrono::seconds renewWindow,
+                                  const Clock::time_point now) {
+    if (rawToken.empty() || !token) return;
+
+    const auto until = std::min(now + MAX_TTL, token->expiresAt - renewWindow);
+    if (until <= now) return;
+
+    std::lock_guard lock(mutex_);
+    entry_ = Entry{ .digest = digest(rawToken), .token = token, .until = until };
+}
+
+void VerifiedTokenCache::clear() {
+    std::lock_guard lock(mutex_);
+    entry_.reset();
+}
+
+}
@@ -1,5 +1,6 @@
 #include "concurrency/ThreadPool.hpp"
 #include "concurrency/ThreadPoolManager.hpp"
+#include "stats/Metrics.hpp"
 
 #include <ranges>
 #include <algorithm>
@@ -7,8 +8,10 @@
 using namespace vh::concurrency;
 
 ThreadPool::ThreadPool(const std::shared_ptr<std::atomic<bool> > &interruptFlag,
-                       unsigned int nThreads)
+                       unsigned int nThreads, const std::string_view name)
     : interruptFlag(interruptFlag), stopFlag(false) {
+    if (!name.empty()) queueWait_ = &stats::Metrics::instance().histogram(stats::Metric::PoolQueueWait, name);
+
     for (unsigned int i = 0; i < nThreads; ++i) {
         spawnWorker();
     }
@@ -20,7 +23,7 @@ ThreadPool::~ThreadPool() {
 
 void ThreadPool::stop(std::chrono::milliseconds gracefulTimeout) { {
         std::scoped_lock lock(mutex);
-        std::queue<std::shared_ptr<Task> > empty;
+        std::queue<Queued> empty;
         std::swap(queue, empty);
     }
 
@@ -54,7 +57,7 @@ void ThreadPool::stop(std::chrono::milliseconds gracefulTimeout) { {
 
 void ThreadPool::submit(std::shared_ptr<Task> task) { {
         std::scoped_lock lock(mutex);
-        queue.push(std::move(task));
+        queue.push({std::move(task), std::chrono::steady_clock::now()});
     }
     cv.notify_one();
 
@@ -116,7 +119,11 @@ void ThreadPool::spawnWorker() {
 
                 if (stopFlag.load() && queue.empty()) break;
 
-                task = std::move(queue.front());
+                auto& next = queue.front();
+                task = std::move(next.task);
+                if (queueWait_)
+                    queueWait_->observe_us(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() - next.since).count()));
                 queue.pop();
             }
 
@@ -28,6 +28,7 @@ namespace vh::config {
         if (auto node = root["services"]) YAML::convert<ServicesConfig>::decode(node, cfg.services);
         if (auto node = root["sharing"]) YAML::convert<SharingConfig>::decode(node, cfg.sharing);
         if (auto node = root["auditing"]) YAML::convert<AuditConfig>::decode(node, cfg.auditing);
+        if (auto node = root["tracing"]) YAML::convert<TracingConfig>::decode(node, cfg.tracing);
         if (auto node = root["dev"]) YAML::convert<DevConfig>::decode(node, cfg.dev);
 
         if (auto node = root["logging"]) YAML::convert<LoggingConfig>::decode(node, cfg.logging);
@@ -67,6 +68,7 @@ namespace vh::config {
             {"services", encode(services)},
             {"sharing", encode(sharing)},
             {"auditing", encode(auditing)},
+            {"tracing", encode(tracing)},
             {"dev", encode(dev)}
         };
 
@@ -100,6 +102,7 @@ namespace vh::config {
             {"services", c.services},
             {"sharing", c.sharing},
             {"auditing", c.auditing},
+            {"tracing", c.tracing},
             {"dev", c.dev}
         };
     }
@@ -114,6 +117,7 @@ namespace vh::config {
         j.at("services").get_to(c.services);
         j.at("sharing").get_to(c.sharing);
         j.at("auditing").get_to(c.auditing);
+        if (j.contains("tracing")) j.at("tracing").get_to(c.tracing);
         j.at("dev").get_to(c.dev);
     }
 
@@ -123,7 +127,9 @@ namespace vh::config {
             {"host", c.host},
             {"port", c.port},
             {"max_connections", c.max_connections},
-            {"max_upload_size_bytes", c.max_upload_size_bytes}
+            {"max_upload_size_bytes", c.max_upload_size_bytes},
+            {"io_threads", c.io_threads},
+            {"max_in_flight_per_session", c.max_in_flight_per_session}
         };
     }
 
@@ -133,13 +139,21 @@ namespace vh::config {
         c.port = j.value("port", 33369);
         c.max_connections = j.value("max_connections", 10000);
         c.max_upload_size_bytes = j.value("max_upload_size_bytes", MAX_UPLOAD_SIZE_BYTES);
+        c.io_threads = j.value("io_threads", 0u);
+        c.max_in_flight_per_session = j.value("max_in_flight_per_session", 16u);
     }
 
     void to_json(nlohmann::json &j, const HttpPreviewConfig &c) {
         j = {
             {"enabled", c.enabled},
             {"host", c.host},
-            {"port", c.port}
+            {"port", c.port},
+            {"io_threads", c.io_threads},
+            {"header_limit_kb", c.header_limit_kb},
+            {"body_limit_kb", c.body_limit_kb},
+            {"keep_alive_timeout_seconds", c.keep_alive_timeout_seconds},
+            {"max_requests_per_connection", c.max_requests_per_connection},
+            {"metrics_endpoint", c.metrics_endpoint}
         };
     }
 
@@ -149,16 +163,40 @@ namespace vh::config {
         c.port = j.value("port", 33370);
         c.max_connections = j.value("max_connections", 512);
         c.max_preview_size_bytes = j.value("max_preview_size_bytes", MAX_PREVIEW_SIZE_BYTES);
+        c.io_threads = j.value("io_threads", 0u);
+        c.header_limit_kb = j.value("header_limit_kb", 16u);
+        c.body_limit_kb = j.value("body_limit_kb", 64u);
+        c.keep_alive_timeout_seconds = j.value("keep_alive_timeout_seconds", 30u);
+        c.max_requests_per_connection = j.value("max_requests_per_connection", 1000u);
+        c.metrics_endpoint = j.value("metrics_endpoint", true);
     }
 
     void to_json(nlohmann::json &j, const LoggingConfig &c) {
         j = {
-            {"levels", c.levels}
+            {"levels", c.levels},
+            {"async", c.async}
         };
     }
 
     void from_json(const nlohmann::json &j, LoggingConfig &c) {
         j.at("levels").get_to(c.levels);
+        if (j.contains("async")) j.at("async").get_to(c.async);
+    }
+
+    void to_json(nlohmann::json &j, const AsyncLoggingConfig &c) {
+        j = {
+            {"enabled", c.enabled},
+            {"queue_size", c.queue_size},
+            {"threads", c.threads},
+            {"overflow_policy", c.overflow_policy}
+        };
+    }
+
+    void from_json(const nlohmann::json &j, AsyncLoggingConfig &c) {
+        c.enabled = j.value("enabled", true);
+        c.queue_size = j.value("queue_size", static_cast<size_t>(8192));
+        c.threads = j.value("threads", 1u);
+        c.overflow_policy = j.value("overflow_policy", std::string("overrun_oldest"));
     }
 
     void to_json(nlohmann::json &j, const LogLevelsConfig &c) {
@@ -228,13 +266,25 @@ namespace vh::config {
     void to_json(nlohmann::json &j, const CachingConfig &c) {
         j = {
             {"thumbnails", c.thumbnails},
-            {"max_size_mb", c.max_size_mb}
+            {"max_size_mb", c.max_size_mb},
+            {"render_cache_mb", c.render_cache_mb},
+            {"permission_decision_cache_entries", c.permission_decision_cache_entries},
+            {"fs_eager_depth", c.fs_eager_depth},
+            {"fs_snapshot", c.fs_snapshot},
+            {"fs_negative_ttl_ms", c.fs_negative_ttl_ms},
+            {"fs_negative_entries", c.fs_negative_entries}
         };
     }
 
     void from_json(const nlohmann::json &j, CachingConfig &c) {
         j.at("thumbnails").get_to(c.thumbnails);
         c.max_size_mb = j.value("max_size_mb", 10240);
+        c.render_cache_mb = j.value("render_cache_mb", 256);
+        c.permission_decision_cache_entries = j.value("permission_decision_cache_entries", 65536);
+        c.fs_eager_depth = j.value("fs_eager_depth", 2u);
+        c.fs_snapshot = j.value("fs_snapshot", true);
+        c.fs_negative_ttl_ms = j.value("fs_negative_ttl_ms", 1000u);
+        c.fs_negative_entries = j.value("fs_negative_entries", 65536u);
     }
 
     void to_json(nlohmann::json &j, const DatabaseConfig &c) {
@@ -243,7 +293,11 @@ namespace vh::config {
             {"port", c.port},
             {"name", c.name},
             {"user", c.user},
-            {"pool_size", c.pool_size}
+            {"pool_size", c.pool_size},
+            {"pool_min_size", c.pool_min_size},
+            {"acquire_timeout_ms", c.acquire_timeout_ms},
+            {"validate_idle_after_seconds", c.validate_idle_after_seconds},
+            {"pool_idle_timeout_seconds", c.pool_idle_timeout_seconds}
         };
     }
 
@@ -253,12 +307,18 @@ namespace vh::config {
         c.name = j.value("name", "vaulthalla");
         c.user = j.value("user", "vaulthalla");
         c.pool_size = j.value("pool_size", 10);
+        c.pool_min_size = j.value("pool_min_size", 2);
+        c.acquire_timeout_ms = j.value("acquire_timeout_ms", 5000u);
+        c.validate_idle_after_seconds = j.value("validate_idle_after_seconds", 30u);
+        c.pool_idle_timeout_seconds = j.value("pool_idle_timeout_seconds", 300u);
     }
 
     void to_json(nlohmann::json &j, const AuthConfig &c) {
         j = {
             {"access_token_expiry_minutes", c.access_token_expiry_minutes},
-            {"refresh_token_expiry_days", c.refresh_token_expiry_days}
+            {"refresh_token_expiry_days", c.refresh_token_expiry_days},
+            {"argon2_memory_budget_mb", c.argon2_memory_budget_mb},
+            {"argon2_max_queued", c.argon2_max_queued}
             // Do not serialize jwt_secret
         };
     }
@@ -266,6 +326,8 @@ namespace vh::config {
     void from_json(const nlohmann::json &j, AuthConfig &c) {
         c.access_token_expiry_minutes = j.value("access_token_expiry_minutes", 60);
         c.refresh_token_expiry_days = j.value("refresh_token_expiry_days", 7);
+        c.argon2_memory_budget_mb = j.value("argon2_memory_budget_mb", 1024u);
+        c.argon2_max_queued = j.value("argon2_max_queued", 64u);
     }
 
     void to_json(nlohmann::json &j, const SyncConfig &c) {
@@ -319,13 +381,19 @@ namespace vh::config {
     void to_json(nlohmann::json &j, const SharingConfig &c) {
         j = {
             {"enabled", c.enabled},
-            {"enable_public_links", c.enable_public_links}
+            {"enable_public_links", c.enable_public_links},
+            {"audit_batch_size", c.audit_batch_size},
+            {"audit_flush_interval_ms", c.audit_flush_interval_ms},
+            {"audit_queue_limit", c.audit_queue_limit}
         };
     }
 
     void from_json(const nlohmann::json &j, SharingConfig &c) {
         c.enabled = j.value("enabled", true);
         c.enable_public_links = j.value("enable_public_links", true);
+        c.audit_batch_size = j.value("audit_batch_size", 500u);
+        c.audit_flush_interval_ms = j.value("audit_flush_interval_ms", 250u);
+        c.audit_queue_limit = j.value("audit_queue_limit", 10000u);
     }
 
     void to_json(nlohmann::json &j, const AuditLogConfig &c) {
@@ -334,6 +402,8 @@ namespace vh::config {
             {"rotate_max_size", bytesToMbOrGbStr(c.rotate_max_size)},
             {"rotate_interval", hoursToDayOrHourStr(c.rotate_interval)},
             {"compression", compressionToString(c.compression)},
+            {"compression_level", c.compression_level},
+            {"compression_rate_limit", bytesToMbOrGbStr(c.compression_rate_limit)},
             {"max_retained_logs_size", bytesToMbOrGbStr(c.max_retained_logs_size)},
             {"strict_retention", c.strict_retention}
         };
@@ -344,6 +414,8 @@ namespace vh::config {
         c.rotate_max_size = parseMbOrGbToByte(j.value("rotate_max_size", "50MB"));
         c.rotate_interval = parseHoursFromDayOrHour(j.value("rotate_interval", "24h"));
         c.compression = parseCompression(j.value("compression", "zstd"));
+        c.compression_level = j.value("compression_level", 0);
+        c.compression_rate_limit = parseMbOrGbToByte(j.value("compression_rate_limit", "32MB"));
         c.max_retained_logs_size = parseMbOrGbToByte(j.value("max_retained_logs_size", "1GB"));
         c.strict_retention = j.value("strict_retention", false);
     }
@@ -382,6 +454,24 @@ namespace vh::config {
         j.at("files_trashed").get_to(c.files_trashed);
     }
 
+    void to_json(nlohmann::json &j, const TracingConfig &c) {
+        j = {
+            {"enabled", c.enabled},
+            {"sample_rate", c.sample_rate},
+            {"slow_threshold_ms", c.slow_threshold_ms},
+            {"buffer_traces", c.buffer_traces},
+            {"max_spans_per_trace", c.max_spans_per_trace}
+        };
+    }
+
+    void from_json(const nlohmann::json &j, TracingConfig &c) {
+        c.enabled = j.value("enabled", true);
+        c.sample_rate = j.value("sample_rate", 0.001);
+        c.slow_threshold_ms = j.value("slow_threshold_ms", 250u);
+        c.buffer_traces = j.value("buffer_traces", 512u);
+        c.max_spans_per_trace = j.value("max_spans_per_trace", 256u);
+    }
+
     void to_json(nlohmann::json &j, const DevConfig &c) {
         j = {
             {"enabled", c.enabled},
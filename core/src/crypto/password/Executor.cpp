@@ -0,0 +1,102 @@
+#include "crypto/password/Executor.hpp"
+#include "config/Registry.hpp"
+#include "log/Registry.hpp"
+
+#include <sodium.h>
+
+#include <algorithm>
+#include <memory>
+
+using namespace vh::crypto::password;
+
+const unsigned long long Executor::OPSLIMIT = crypto_pwhash_OPSLIMIT_MODERATE;
+const size_t Executor::MEMLIMIT = crypto_pwhash_MEMLIMIT_MODERATE;
+
+Executor& Executor::instance() {
+    static Executor executor = [] {
+        const auto& cfg = config::Registry::get().auth;
+        return Executor(static_cast<size_t>(cfg.argon2_memory_budget_mb) * 1024 * 1024, cfg.argon2_max_queued);
+    }();
+    return executor;
+}
+
+Executor::Executor(const size_t memoryBudgetBytes, const size_t maxQueued) : maxQueued_(maxQueued) {
+    const auto n = std::max<size_t>(1, memoryBudgetBytes / MEMLIMIT);
+    workers_.reserve(n);
+    for (size_t i = 0; i < n; ++i) workers_.emplace_back([this] { run(); });
+}
+
+Executor::~Executor() {
+    stop();
+}
+
+void Executor::stop() {
+    {
+        std::lock_guard lock(mutex_);
+        if (stopping_) return;
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    for (auto& t : workers_)
+        if (t.joinable()) t.join();
+}
+
+size_t Executor::queued() const {
+    std::lock_guard lock(mutex_);
+    return jobs_.size();
+}
+
+void Executor::submit(std::function<void()> job) {
+    {
+        std::lock_guard lock(mutex_);
+        if (stopping_) throw std::runtime_error("Password executor is stopped");
+        if (jobs_.size() >= maxQueued_) {
+            log::Registry::auth()->warn("[password::Executor] Rejecting Argon2 work, {} jobs already queued", jobs_.size());
+            throw Overloaded("Too many password checks in progress. Try again later.");
+        }
+        jobs_.push_back(std::move(job));
+    }
+    cv_.notify_one();
+}
+
+void Executor::run() {
+    for (;;) {
+        std::function<void()> job;
+        {
+            std::unique_lock lock(mutex_);
+            cv_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+            if (jobs_.empty()) return;
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+        job();
+    }
+}
+
+std::future<std::string> Executor::hash(std::string password) {
+    auto promise = std::make_shared<std::promise<std::string>>();
+    auto future = promise->get_future();
+
+    submit([promise, password = std::move(password)] {
+        char hashed[crypto_pwhash_STRBYTES];
+        if (crypto_pwhash_str(hashed, password.c_str(), password.size(), OPSLIMIT, MEMLIMIT) != 0) {
+            promise->set_exception(std::make_exception_ptr(
+                std::runtime_error("Password hashing failed (out of memory?)")));
+            return;
+        }
+        promise->set_value(std::string(hashed));
+    });
+
+    return future;
+}
+
+std::future<bool> Executor::verify(std::string password, std::string hash) {
+    auto promise = std::make_shared<std::promise<bool>>();
+    auto future = promise->get_future();
+
+    submit([promise, password = std::move(password), hash = std::move(hash)] {
+        promise->set_value(crypto_pwhash_str_verify(hash.c_str(), password.c_str(), password.size()) == 0);
+    });
+
+    return future;
+}
@@ -3,6 +3,7 @@
 #include "config/Registry.hpp"
 
 #include <sodium.h>
+#include <openssl/evp.h>
 #include <stdexcept>
 #include <fstream>
 #include <cstring>
@@ -212,6 +213,133 @@ std::vector<uint8_t> decrypt_aes256_gcm(
     return decrypted;
 }
 
+AES256GCMEncryptor::AES256GCMEncryptor(const std::vector<uint8_t>& key, std::vector<uint8_t>& out_iv) {
+    if (key.size() != AES_KEY_SIZE) {
+        log::Registry::crypto()->error("[AES256GCMEncryptor] Invalid AES-256 key size: {} bytes", key.size());
+        throw std::invalid_argument("Invalid AES-256 key size");
+    }
+
+    if (!is_aes_gcm_supported())
+        throw std::runtime_error(aes_gcm_unavailable_reason());
+
+    out_iv.resize(AES_IV_SIZE);
+    randombytes_buf(out_iv.data(), AES_IV_SIZE);
+
+    ctx_ = EVP_CIPHER_CTX_new();
+    if (!ctx_) throw std::runtime_error("Failed to allocate AES256-GCM context");
+
+    if (EVP_EncryptInit_ex(ctx_, EVP_aes_256_gcm(), nullptr, nullptr, nullptr) != 1 ||
+        EVP_CIPHER_CTX_ctrl(ctx_, EVP_CTRL_GCM_SET_IVLEN, static_cast<int>(AES_IV_SIZE), nullptr) != 1 ||
+        EVP_EncryptInit_ex(ctx_, nullptr, nullptr, key.data(), out_iv.data()) != 1) {
+        EVP_CIPHER_CTX_free(ctx_);
+        ctx_ = nullptr;
+        throw std::runtime_error("AES256-GCM stream initialization failed");
+    }
+}
+
+AES256GCMEncryptor::~AES256GCMEncryptor() {
+    if (ctx_) EVP_CIPHER_CTX_free(ctx_);
+}
+
+void AES256GCMEncryptor::update(const std::span<const uint8_t> in, const std::span<uint8_t> out) {
+    if (finished_) throw std::logic_error("AES256-GCM stream already finished");
+    if (out.size() < in.size()) throw std::invalid_argument("AES256-GCM output buffer too small");
+    if (in.empty()) return;
+
+    int written = 0;
+    if (EVP_EncryptUpdate(ctx_, out.data(), &written, in.data(), static_cast<int>(in.size())) != 1 ||
+        static_cast<size_t>(written) != in.size())
+        throw std::runtime_error("AES256-GCM encryption failed");
+}
+
+std::array<uint8_t, AES_TAG_SIZE> AES256GCMEncryptor::finish() {
+    if (finished_) throw std::logic_error("AES256-GCM stream already finished");
+    finished_ = true;
+
+    // GCM is a stream mode, so final never emits ciphertext bytes
+    std::array<uint8_t, AES_TAG_SIZE> tag{};
+    int written = 0;
+    if (EVP_EncryptFinal_ex(ctx_, tag.data(), &written) != 1 ||
+        EVP_CIPHER_CTX_ctrl(ctx_, EVP_CTRL_GCM_GET_TAG, static_cast<int>(AES_TAG_SIZE), tag.data()) != 1)
+        throw std::runtime_error("AES256-GCM finalization failed");
+
+    return tag;
+}
+
+AES256GCMDecryptor::AES256GCMDecryptor(const std::vector<uint8_t>& key, const std::vector<uint8_t>& iv,
+                                       const uint64_t offset)
+    : authenticated_(offset == 0) {
+    if (key.size() != AES_KEY_SIZE || iv.size() != AES_IV_SIZE) {
+        log::Registry::crypto()->error("[AES256GCMDecryptor] Invalid key or IV size: "
+                                     "key size = {}, iv size = {}",
+                                     key.size(), iv.size());
+        throw std::invalid_argument("Invalid key or IV size");
+    }
+
+    if (!is_aes_gcm_supported())
+        throw std::runtime_error(aes_gcm_unavailable_reason());
+
+    ctx_ = EVP_CIPHER_CTX_new();
+    if (!ctx_) throw std::runtime_error("Failed to allocate AES256-GCM context");
+
+    bool ok;
+    if (authenticated_) {
+        ok = EVP_DecryptInit_ex(ctx_, EVP_aes_256_gcm(), nullptr, nullptr, nullptr) == 1 &&
+             EVP_CIPHER_CTX_ctrl(ctx_, EVP_CTRL_GCM_SET_IVLEN, static_cast<int>(AES_IV_SIZE), nullptr) == 1 &&
+             EVP_DecryptInit_ex(ctx_, nullptr, nullptr, key.data(), iv.data()) == 1;
+    } else {
+        // OpenSSL's CTR carries into the upper 96 bits where GCM wraps its 32-bit counter,
+        // but the two only diverge past 2^32 blocks, beyond what a GCM message may hold.
+        const uint64_t counter = offset / 16 + 2;
+        std::array<uint8_t, 16> block{};
+        std::memcpy(block.data(), iv.data(), AES_IV_SIZE);
+        for (size_t i = 0; i < 4; ++i)
+            block[15 - i] = static_cast<uint8_t>(counter >> (8 * i));
+
+        ok = EVP_DecryptInit_ex(ctx_, EVP_aes_256_ctr(), nullptr, key.data(), block.data()) == 1;
+
+        // Burn the keystream bytes that precede the offset within its block
+        std::array<uint8_t, 16> skip{};
+        int written = 0;
+        if (ok && offset % 16)
+            ok = EVP_DecryptUpdate(ctx_, skip.data(), &written, skip.data(), static_cast<int>(offset % 16)) == 1;
+    }
+
+    if (!ok) {
+        EVP_CIPHER_CTX_free(ctx_);
+        ctx_ = nullptr;
+        throw std::runtime_error("AES256-GCM stream initialization failed");
+    }
+}
+
+AES256GCMDecryptor::~AES256GCMDecryptor() {
+    if (ctx_) EVP_CIPHER_CTX_free(ctx_);
+}
+
+void AES256GCMDecryptor::update(const std::span<const uint8_t> in, const std::span<uint8_t> out) {
+    if (finished_) throw std::logic_error("AES256-GCM stream already finished");
+    if (out.size() < in.size()) throw std::invalid_argument("AES256-GCM output buffer too small");
+    if (in.empty()) return;
+
+    int written = 0;
+    if (EVP_DecryptUpdate(ctx_, out.data(), &written, in.data(), static_cast<int>(in.size())) != 1 ||
+        static_cast<size_t>(written) != in.size())
+        throw std::runtime_error("AES256-GCM decryption failed");
+}
+
+bool AES256GCMDecryptor::verify(const std::span<const uint8_t, AES_TAG_SIZE> tag) {
+    if (!authenticated_) throw std::logic_error("AES256-GCM stream started mid-file cannot be authenticated");
+    if (finished_) throw std::logic_error("AES256-GCM stream already finished");
+    finished_ = true;
+
+    std::array<uint8_t, AES_TAG_SIZE> expected{};
+    std::memcpy(expected.data(), tag.data(), AES_TAG_SIZE);
+
+    int written = 0;
+    return EVP_CIPHER_CTX_ctrl(ctx_, EVP_CTRL_GCM_SET_TAG, static_cast<int>(AES_TAG_SIZE), expected.data()) == 1 &&
+           EVP_DecryptFinal_ex(ctx_, expected.data(), &written) == 1;
+}
+
 std::vector<uint8_t> read_file(const std::filesystem::path& path) {
     std::ifstream in(path, std::ios::binary);
     if (!in) throw std::runtime_error("Failed to open vault key file: " + path.string());
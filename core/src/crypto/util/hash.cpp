@@ -1,4 +1,5 @@
 #include "crypto/util/hash.hpp"
+#include "crypto/password/Executor.hpp"
 
 #include <sodium.h>
 #include <fstream>
@@ -6,46 +7,56 @@
 #include <iomanip>
 #include <stdexcept>
 
-constexpr std::size_t OPSLIMIT = crypto_pwhash_OPSLIMIT_MODERATE;
-constexpr std::size_t MEMLIMIT = crypto_pwhash_MEMLIMIT_MODERATE;
-
 namespace vh::crypto::hash {
-std::string blake2b(const std::filesystem::path& filepath) {
-    constexpr size_t hash_len = crypto_generichash_BYTES;
-    unsigned char hash[hash_len];
 
+namespace {
+
+std::string toHex(const unsigned char* data, const size_t len) {
+    std::ostringstream result;
+    for (size_t i = 0; i < len; ++i)
+        result << std::hex << std::setw(2) << std::setfill('0') << (int)data[i];
+    return result.str();
+}
+
+}
+
+Blake2b::Blake2b() : state_(std::make_unique<crypto_generichash_state>()) {
+    crypto_generichash_init(state_.get(), nullptr, 0, crypto_generichash_BYTES);
+}
+
+Blake2b::~Blake2b() = default;
+
+void Blake2b::update(const std::span<const uint8_t> data) {
+    crypto_generichash_update(state_.get(), data.data(), data.size());
+}
+
+std::string Blake2b::finalHex() {
+    unsigned char hash[crypto_generichash_BYTES];
+    crypto_generichash_final(state_.get(), hash, sizeof(hash));
+    return toHex(hash, sizeof(hash));
+}
+
+std::string blake2b(const std::filesystem::path& filepath) {
     std::ifstream file(filepath, std::ios::binary);
     if (!file) throw std::runtime_error("Failed to open file for hashing: " + filepath.string());
 
-    crypto_generichash_state state;
-    crypto_generichash_init(&state, nullptr, 0, hash_len);
+    Blake2b hasher;
 
     char buffer[8192];
     while (file.good()) {
         file.read(buffer, sizeof(buffer));
-        crypto_generichash_update(&state, reinterpret_cast<unsigned char*>(buffer), file.gcount());
+        hasher.update({reinterpret_cast<const uint8_t*>(buffer), static_cast<size_t>(file.gcount())});
     }
 
-    crypto_generichash_final(&state, hash, hash_len);
-
-    std::ostringstream result;
-    for (size_t i = 0; i < hash_len; ++i)
-        result << std::hex << std::setw(2) << std::setfill('0') << (int)hash[i];
-
-    return result.str();
+    return hasher.finalHex();
 }
 
 std::string password(const std::string& password) {
-    char hashed[crypto_pwhash_STRBYTES];
-
-    if (crypto_pwhash_str(hashed, password.c_str(), password.size(), OPSLIMIT, MEMLIMIT) != 0)
-        throw std::runtime_error("Password hashing failed (out of memory?)");
-
-    return {hashed};
+    return vh::crypto::password::Executor::instance().hash(password).get();
 }
 
 bool verifyPassword(const std::string& password, const std::string& hash) {
-    return crypto_pwhash_str_verify(hash.c_str(), password.c_str(), password.size()) == 0;
+    return vh::crypto::password::Executor::instance().verify(password, hash).get();
 }
 
 std::string generate_secure_password(const size_t length) {
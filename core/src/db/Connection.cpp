@@ -6,6 +6,7 @@
 #include "log/Registry.hpp"
 
 #include <fstream>
+#include <pqxx/pqxx>
 #include <paths.h>
 
 using namespace vh::crypto;
@@ -102,6 +103,17 @@ Connection::~Connection() { if (conn_ && conn_->is_open()) conn_->close(); }
 
 pqxx::connection& Connection::get() const { return *conn_; }
 
+bool Connection::ping() const {
+    if (!conn_ || !conn_->is_open()) return false;
+    try {
+        pqxx::nontransaction tx(*conn_);
+        tx.exec("SELECT 1");
+        return true;
+    } catch (const pqxx::broken_connection&) {
+        return false;
+    }
+}
+
 void Connection::initPrepared() const {
     if (!conn_ || !conn_->is_open()) throw std::runtime_error("Database connection is not open");
 
@@ -0,0 +1,237 @@
+#include "db/DBPool.hpp"
+#include "config/Registry.hpp"
+#include "log/Registry.hpp"
+#include "stats/Trace.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <utility>
+
+namespace vh::db {
+
+namespace {
+
+uint64_t micros(const std::chrono::steady_clock::duration d) {
+    return static_cast<uint64_t>(std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::microseconds>(d).count()));
+}
+
+DBPool::Hooks defaultHooks() {
+    return {
+        .open = [] { return std::make_unique<Connection>(); },
+        .prepare = [](Connection* conn) { conn->initPrepared(); },
+        .validate = [](Connection* conn) { return conn->ping(); }
+    };
+}
+
+}
+
+PoolOptions PoolOptions::fromConfig() {
+    const auto& db = config::Registry::get().database;
+    PoolOptions o;
+    o.maxSize = static_cast<size_t>(std::max(1, db.pool_size));
+    o.minSize = std::min(o.maxSize, static_cast<size_t>(std::max(0, db.pool_min_size)));
+    o.acquireTimeout = std::chrono::milliseconds(db.acquire_timeout_ms);
+    o.validateIdleAfter = std::chrono::seconds(db.validate_idle_after_seconds);
+    o.idleTimeout = std::chrono::seconds(db.pool_idle_timeout_seconds);
+    return o;
+}
+
+// ---- Lease
+
+DBPool::Lease::Lease(DBPool& pool, std::unique_ptr<Connection> conn)
+    : pool_(&pool), conn_(std::move(conn)), since_(std::chrono::steady_clock::now()) {}
+
+DBPool::Lease::Lease(Lease&& other) noexcept
+    : pool_(other.pool_), conn_(std::move(other.conn_)), since_(other.since_),
+      broken_(other.broken_), active_(std::exchange(other.active_, false)) {}
+
+DBPool::Lease::~Lease() {
+    if (!active_) return;
+    pool_->held_.observe_us(micros(std::chrono::steady_clock::now() - since_));
+    pool_->release(std::move(conn_), broken_);
+}
+
+// ---- Pool
+
+DBPool::DBPool(PoolOptions options) : DBPool(std::move(options), defaultHooks()) {}
+
+DBPool::DBPool(PoolOptions options, Hooks hooks) : options_(std::move(options)), hooks_(std::move(hooks)) {
+    options_.maxSize = std::max<size_t>(1, options_.maxSize);
+    options_.minSize = std::min(options_.minSize, options_.maxSize);
+
+    for (size_t i = 0; i < options_.minSize; ++i) {
+        idle_.push_back({ .conn = hooks_.open(), .since = Clock::now() });
+        ++open_;
+        ++opened_;
+    }
+}
+
+DBPool::Lease DBPool::lease() {
+    return {*this, acquire()};
+}
+
+std::unique_ptr<Connection> DBPool::acquire() {
+    const stats::trace::Span span("db.acquire");
+    const auto start = Clock::now();
+    const auto deadline = start + options_.acquireTimeout;
+
+    std::unique_lock lock(mutex_);
+    for (;;) {
+        if (!idle_.empty()) {
+            auto entry = std::move(idle_.back());
+            idle_.pop_back();
+            ++inUse_;
+            lock.unlock();
+
+            if (start - entry.since < options_.validateIdleAfter) {
+                recordWait(start);
+                return std::move(entry.conn);
+            }
+
+            bool alive = false;
+            try {
+                alive = hooks_.validate(entry.conn.get());
+            } catch (const std::exception& e) {
+                log::Registry::db()->debug("[DBPool] Connection validation threw: {}", e.what());
+            }
+            if (alive) {
+                recordWait(start);
+                return std::move(entry.conn);
+            }
+
+            log::Registry::db()->warn("[DBPool] Idle connection failed validation, reconnecting");
+            entry.conn.reset();
+            lock.lock();
+            --inUse_;
+            --open_;
+            ++closed_;
+            ++reconnects_;
+            continue;
+        }
+
+        if (open_ < options_.maxSize) {
+            ++open_;
+            ++inUse_;
+            lock.unlock();
+            return openSlot(start);
+        }
+
+        ++waiting_;
+        const bool woke = cv_.wait_until(lock, deadline, [this] {
+            return !idle_.empty() || open_ < options_.maxSize;
+        });
+        --waiting_;
+
+        if (!woke) {
+            ++timeouts_;
+            const auto inUse = inUse_;
+            lock.unlock();
+            recordWait(start);
+            log::Registry::db()->warn("[DBPool] No connection free after {}ms ({} of {} in use)",
+                                      options_.acquireTimeout.count(), inUse, options_.maxSize);
+            throw AcquireTimeout("Database is busy: no connection became available within " +
+                                 std::to_string(options_.acquireTimeout.count()) + "ms");
+        }
+    }
+}
+
+std::unique_ptr<Connection> DBPool::openSlot(const Clock::time_point start) {
+    try {
+        auto conn = hooks_.open();
+
+        bool prepare;
+        {
+            std::lock_guard lock(mutex_);
+            prepare = prepared_;
+            ++opened_;
+        }
+        if (prepare) hooks_.prepare(conn.get());
+
+        recordWait(start);
+        return conn;
+    } catch (...) {
+        {
+            std::lock_guard lock(mutex_);
+            --open_;
+            --inUse_;
+        }
+        cv_.notify_one();
+        throw;
+    }
+}
+
+void DBPool::release(std::unique_ptr<Connection> conn, const bool broken) {
+    std::deque<Idle> closing;
+    {
+        std::lock_guard lock(mutex_);
+        --inUse_;
+        const auto now = Clock::now();
+
+        if (broken) {
+            --open_;
+            ++closed_;
+            log::Registry::db()->warn("[DBPool] Dropping broken connection ({} still open)", open_);
+        } else {
+            idle_.push_back({ .conn = std::move(conn), .since = now });
+        }
+
+        trimIdle(closing, now);
+    }
+    cv_.notify_one();
+    // closing and a broken conn are torn down here, outside the lock
+}
+
+void DBPool::trimIdle(std::deque<Idle>& closing, const Clock::time_point now) {
+    // Oldest idle sit at the front; never trim while someone is queued for a connection
+    while (waiting_ == 0 && open_ > options_.minSize && !idle_.empty() &&
+           now - idle_.front().since >= options_.idleTimeout) {
+        closing.push_back(std::move(idle_.front()));
+        idle_.pop_front();
+        --open_;
+        ++closed_;
+    }
+}
+
+void DBPool::initPreparedStatements() {
+    std::lock_guard lock(mutex_);
+    prepared_ = true;
+    for (auto& entry : idle_) hooks_.prepare(entry.conn.get());
+}
+
+void DBPool::recordWait(const Clock::time_point start) {
+    wait_.observe_us(micros(Clock::now() - start));
+}
+
+PoolStatsSnapshot DBPool::stats() const {
+    std::lock_guard lock(mutex_);
+    return {
+        .open = open_,
+        .inUse = inUse_,
+        .idle = idle_.size(),
+        .waiting = waiting_,
+        .opened = opened_,
+        .closed = closed_,
+        .reconnects = reconnects_,
+        .timeouts = timeouts_,
+        .wait = wait_.snapshot(),
+        .held = held_.snapshot()
+    };
+}
+
+void to_json(nlohmann::json& j, const PoolStatsSnapshot& s) {
+    j = nlohmann::json{
+        {"open", s.open},
+        {"in_use", s.inUse},
+        {"idle", s.idle},
+        {"waiting", s.waiting},
+        {"opened", s.opened},
+        {"closed", s.closed},
+        {"reconnects", s.reconnects},
+        {"timeouts", s.timeouts},
+        {"acquire_wait", s.wait},
+        {"held", s.held},
+    };
+}
+
+}
@@ -0,0 +1,62 @@
+#include "db/Pipeline.hpp"
+
+#include <limits>
+#include <stdexcept>
+
+namespace vh::db {
+
+Pipeline::Pipeline(pqxx::work& txn) : Pipeline(txn, defaultMode()) {}
+
+Pipeline::Pipeline(pqxx::work& txn, const Mode mode) : txn_(txn), mode_(mode) {
+    if (mode_ == Mode::Serial) return;
+    pipe_.emplace(txn_);
+    // Hold everything until a result is needed so the whole batch leaves in one write
+    pipe_->retain(std::numeric_limits<int>::max());
+}
+
+Pipeline::Handle Pipeline::queue(const std::string_view statement, const std::vector<std::string>& quotedArgs) {
+    // Prepared statements live in the session, so plain EXECUTE reaches them from the batched query string
+    std::string sql = "EXECUTE " + txn_.quote_name(statement);
+    if (!quotedArgs.empty()) {
+        sql += '(';
+        for (size_t i = 0; i < quotedArgs.size(); ++i) {
+            if (i) sql += ", ";
+            sql += quotedArgs[i];
+        }
+        sql += ')';
+    }
+
+    const auto handle = pipe_->insert(sql);
+    queued_.push_back(handle);
+    return handle;
+}
+
+pqxx::result Pipeline::retrieve(const Handle handle) {
+    if (mode_ == Mode::Serial) {
+        if (handle < 0 || static_cast<size_t>(handle) >= results_.size() || !retrieved_.insert(handle).second)
+            throw std::invalid_argument("[Pipeline] Unknown or already retrieved statement handle");
+        return std::move(results_[static_cast<size_t>(handle)]);
+    }
+
+    if (!retrieved_.insert(handle).second)
+        throw std::invalid_argument("[Pipeline] Statement handle was already retrieved");
+
+    // Asking for anything not yet on the wire sends every statement queued so far
+    if (!lastSent_ || handle > *lastSent_) {
+        ++roundTrips_;
+        lastSent_ = queued_.back();
+    }
+
+    return pipe_->retrieve(handle);
+}
+
+void Pipeline::complete() {
+    if (mode_ == Mode::Serial) return;
+
+    for (const auto handle : queued_)
+        if (!retrieved_.contains(handle)) (void)retrieve(handle);
+
+    pipe_->complete();
+}
+
+}
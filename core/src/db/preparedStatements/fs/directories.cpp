@@ -6,6 +6,16 @@ void vh::db::Connection::initPreparedDirectories() const {
                    "SET size_bytes = size_bytes + $2, file_count = file_count + $3, subdirectory_count = subdirectory_count + $4 "
                    "WHERE fs_entry_id = $1 RETURNING file_count");
 
+    conn_->prepare("update_dir_stats_ancestors",
+                   "WITH RECURSIVE ancestors AS ("
+                   "  SELECT id, parent_id FROM fs_entry WHERE id = $1 "
+                   "  UNION ALL "
+                   "  SELECT fs.id, fs.parent_id FROM fs_entry fs JOIN ancestors a ON fs.id = a.parent_id"
+                   ") "
+                   "UPDATE directories d "
+                   "SET size_bytes = d.size_bytes + $2, file_count = d.file_count + $3, subdirectory_count = d.subdirectory_count + $4 "
+                   "FROM ancestors a WHERE d.fs_entry_id = a.id");
+
     conn_->prepare("get_dir_file_count", "SELECT file_count FROM directories WHERE fs_entry_id = $1");
 
     conn_->prepare("is_dir_empty",
@@ -119,6 +119,51 @@ void vh::db::Connection::initPreparedFiles() const {
         "WHERE id IN (SELECT fs_entry_id FROM target);"
     );
 
+    // Moves an entire subtree (files and directories) into the trash in one round trip.
+    // $1 = subtree root fs_entry id, $2 = user id, $3 = backing path of the root.
+    // Emits one row per trashed file, per removed directory and per cache index entry
+    // so the caller can aggregate the stats delta and schedule the on-disk cleanup.
+    conn_->prepare(
+        "trash_fs_subtree",
+        "WITH RECURSIVE subtree AS ("
+        "  SELECT fs.id, fs.vault_id, fs.path, fs.base32_alias, $3::text AS backing_path "
+        "  FROM fs_entry fs "
+        "  WHERE fs.id = $1 "
+        "  UNION ALL "
+        "  SELECT c.id, c.vault_id, c.path, c.base32_alias, s.backing_path || '/' || c.base32_alias "
+        "  FROM fs_entry c "
+        "  JOIN subtree s ON c.parent_id = s.id"
+        "), moved AS ("
+        "  INSERT INTO files_trashed ("
+        "      vault_id, "
+        "      path, "
+        "      backing_path, "
+        "      base32_alias, "
+        "      size_bytes, "
+        "      trashed_at, "
+        "      trashed_by"
+        "  ) "
+        "  SELECT "
+        "      s.vault_id, "
+        "      s.path, "
+        "      s.backing_path, "
+        "      s.base32_alias, "
+        "      f.size_bytes, "
+        "      NOW(), "
+        "      $2 "
+        "  FROM subtree s "
+        "  JOIN files f ON f.fs_entry_id = s.id "
+        "  RETURNING base32_alias, size_bytes"
+        "), removed AS ("
+        "  DELETE FROM fs_entry WHERE id = $1"
+        ") "
+        "SELECT 'file' AS kind, m.base32_alias::text AS ref, m.size_bytes FROM moved m "
+        "UNION ALL "
+        "SELECT 'dir', s.base32_alias::text, 0 FROM subtree s JOIN directories d ON d.fs_entry_id = s.id "
+        "UNION ALL "
+        "SELECT 'cache', ci.path, ci.size FROM subtree s JOIN cache_index ci ON ci.file_id = s.id"
+    );
+
     conn_->prepare("list_trashed_files",
                    "SELECT * FROM files_trashed WHERE vault_id = $1 AND deleted_at IS NULL");
 
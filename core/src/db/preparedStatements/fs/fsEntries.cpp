@@ -67,6 +67,11 @@ void vh::db::Connection::initPreparedFsEntries() const {
 
     conn_->prepare("get_next_inode", "SELECT MAX(inode) + 1 FROM fs_entry");
 
+    conn_->prepare("get_fs_generation",
+                   "SELECT CASE WHEN is_called THEN last_value ELSE 0 END FROM fs_generation");
+
+    conn_->prepare("get_fs_epoch", "SELECT current_fs_epoch()");
+
     conn_->prepare("get_base32_alias_from_fs_entry", "SELECT base32_alias FROM fs_entry WHERE id = $1");
 
     conn_->prepare("get_fs_entry_inode", "SELECT inode FROM fs_entry WHERE id = $1");
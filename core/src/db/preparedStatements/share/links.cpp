@@ -54,4 +54,12 @@ void vh::db::Connection::initPreparedShareLinks() const {
     conn_->prepare("share_link_touch_access", "UPDATE share_link SET last_accessed_at = CURRENT_TIMESTAMP, access_count = access_count + 1 WHERE id = $1 RETURNING id");
     conn_->prepare("share_link_increment_download", "UPDATE share_link SET download_count = download_count + 1 WHERE id = $1 RETURNING id");
     conn_->prepare("share_link_increment_upload", "UPDATE share_link SET upload_count = upload_count + 1 WHERE id = $1 RETURNING id");
+    conn_->prepare("share_link_add_counters", R"SQL(
+        UPDATE share_link SET
+            access_count = access_count + $2::bigint,
+            download_count = download_count + $3::bigint,
+            upload_count = upload_count + $4::bigint,
+            last_accessed_at = CASE WHEN $2 > 0 THEN CURRENT_TIMESTAMP ELSE last_accessed_at END
+        WHERE id = $1
+    )SQL");
 }
@@ -150,6 +150,18 @@ ino_t Entry::getNextInode() {
     });
 }
 
+uint64_t Entry::getGeneration() {
+    return Transactions::exec("Entry::getGeneration", [&](pqxx::work& txn) {
+        return txn.exec(pqxx::prepped{"get_fs_generation"}).one_field().as<uint64_t>();
+    });
+}
+
+std::string Entry::getEpoch() {
+    return Transactions::exec("Entry::getEpoch", [&](pqxx::work& txn) {
+        return txn.exec(pqxx::prepped{"get_fs_epoch"}).one_field().as<std::string>();
+    });
+}
+
 pqxx::result Entry::collectParentChain(unsigned int parentId) {
     return Transactions::exec("Entry::collectParentChain", [&](pqxx::work& txn) {
         return txn.exec(pqxx::prepped{"collect_parent_chain"}, parentId);
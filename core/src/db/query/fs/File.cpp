@@ -1,5 +1,6 @@
 #include "db/query/fs/File.hpp"
 #include "db/Transactions.hpp"
+#include "db/Pipeline.hpp"
 #include "fs/model/File.hpp"
 #include "fs/model/Directory.hpp"
 #include "fs/model/file/Trashed.hpp"
@@ -16,48 +17,51 @@ namespace vh::db::query::fs {
 using vh::db::encoding::to_utf8_string;
 
 unsigned int File::upsertFile(const FilePtr& file) {
+    return Transactions::exec("File::addFile", [&](pqxx::work& txn) { return upsertFile(txn, file); });
+}
+
+unsigned int File::upsertFile(pqxx::work& txn, const FilePtr& file) {
     if (!file) throw std::invalid_argument("File cannot be null");
     if (!file->path.string().starts_with("/")) file->setPath("/" + to_utf8_string(file->path.u8string()));
 
-    return Transactions::exec("File::addFile", [&](pqxx::work& txn) {
-        const auto exists = txn.exec(pqxx::prepped{"fs_entry_exists_by_inode"}, file->inode).one_field().as<bool>();
-        const auto sizeRes = txn.exec(pqxx::prepped{"get_file_size_by_inode"}, file->inode);
-        const auto existingSize = sizeRes.empty() ? 0 : sizeRes.one_field().as<uintmax_t>();
-        if (file->inode) txn.exec(pqxx::prepped{"delete_fs_entry_by_inode"}, file->inode);
-
-        pqxx::params p;
-        p.append(file->vault_id);
-        p.append(file->parent_id);
-        p.append(file->name);
-        p.append(file->base32_alias);
-        p.append(file->created_by);
-        p.append(file->last_modified_by);
-        p.append(to_utf8_string(file->path.u8string()));
-        p.append(file->inode);
-        p.append(file->mode);
-        p.append(file->owner_uid);
-        p.append(file->group_gid);
-        p.append(file->is_hidden);
-        p.append(file->is_system);
-        p.append(file->size_bytes);
-        p.append(file->mime_type);
-        p.append(file->content_hash);
-        p.append(file->encryption_iv);
-
-        const auto fileId = txn.exec(pqxx::prepped{"upsert_file_full"}, p).one_row()["fs_entry_id"].as<unsigned int>();
-
-        std::optional<unsigned int> parentId = file->parent_id;
-        while (parentId) {
-            int64_t size_delta = static_cast<int64_t>(file->size_bytes) - static_cast<int64_t>(existingSize);
-            pqxx::params stats_params{parentId, size_delta, exists ? 0 : 1, 0}; // Increment size_bytes and file_count
-            txn.exec(pqxx::prepped{"update_dir_stats"}, stats_params);
-            const auto res = txn.exec(pqxx::prepped{"get_fs_entry_parent_id"}, parentId);
-            if (res.empty()) break;
-            parentId = res.one_field().as<std::optional<unsigned int>>();
-        }
+    Pipeline pipe(txn);
+    const auto existsQ = pipe.prepped("fs_entry_exists_by_inode", file->inode);
+    const auto sizeQ = pipe.prepped("get_file_size_by_inode", file->inode);
+    const auto exists = pipe.retrieve(existsQ).one_field().as<bool>();
+    const auto sizeRes = pipe.retrieve(sizeQ);
+    const auto existingSize = sizeRes.empty() ? 0 : sizeRes.one_field().as<uintmax_t>();
+
+    // Replace the entry and push the delta up the whole parent chain in a single batch
+    if (file->inode) pipe.prepped("delete_fs_entry_by_inode", file->inode);
+
+    const auto upsertQ = pipe.prepped("upsert_file_full",
+        file->vault_id,
+        file->parent_id,
+        file->name,
+        file->base32_alias,
+        file->created_by,
+        file->last_modified_by,
+        to_utf8_string(file->path.u8string()),
+        file->inode,
+        file->mode,
+        file->owner_uid,
+        file->group_gid,
+        file->is_hidden,
+        file->is_system,
+        file->size_bytes,
+        file->mime_type,
+        file->content_hash,
+        file->encryption_iv
+    );
+
+    if (file->parent_id) {
+        const int64_t size_delta = static_cast<int64_t>(file->size_bytes) - static_cast<int64_t>(existingSize);
+        pipe.prepped("update_dir_stats_ancestors", *file->parent_id, size_delta, exists ? 0 : 1, 0); // Increment size_bytes and file_count
+    }
 
-        return fileId;
-    });
+    const auto fileId = pipe.retrieve(upsertQ).one_row()["fs_entry_id"].as<unsigned int>();
+    pipe.complete();
+    return fileId;
 }
 
 void File::updateFile(const FilePtr& file) {
@@ -66,28 +70,21 @@ void File::updateFile(const FilePtr& file) {
     if (!file->path.string().starts_with("/")) file->setPath("/" + to_utf8_string(file->path.u8string()));
 
     Transactions::exec("File::updateFile", [&](pqxx::work& txn) {
-        const auto exists = txn.exec(pqxx::prepped{"fs_entry_exists_by_inode"}, file->inode).one_field().as<bool>();
-        const auto sizeRes = txn.exec(pqxx::prepped{"get_file_size_by_inode"}, file->inode);
+        Pipeline pipe(txn);
+        const auto existsQ = pipe.prepped("fs_entry_exists_by_inode", file->inode);
+        const auto sizeQ = pipe.prepped("get_file_size_by_inode", file->inode);
+        const auto exists = pipe.retrieve(existsQ).one_field().as<bool>();
+        const auto sizeRes = pipe.retrieve(sizeQ);
         const auto existingSize = sizeRes.empty() ? 0 : sizeRes.one_field().as<uintmax_t>();
 
-        pqxx::params p;
-        p.append(file->id);
-        p.append(file->size_bytes);
-        p.append(file->mime_type);
-        p.append(file->content_hash);
-        p.append(file->encryption_iv);
+        pipe.prepped("update_file_only", file->id, file->size_bytes, file->mime_type, file->content_hash, file->encryption_iv);
 
-        txn.exec(pqxx::prepped{"update_file_only"}, p);
-
-        std::optional<unsigned int> parentId = file->parent_id;
-        while (parentId) {
-            int64_t size_delta = static_cast<int64_t>(file->size_bytes) - static_cast<int64_t>(existingSize);
-            pqxx::params stats_params{parentId, size_delta, exists ? 0 : 1, 0}; // Increment size_bytes and file_count
-            txn.exec(pqxx::prepped{"update_dir_stats"}, stats_params);
-            const auto res = txn.exec(pqxx::prepped{"get_fs_entry_parent_id"}, parentId);
-            if (res.empty()) break;
-            parentId = res.one_field().as<std::optional<unsigned int>>();
+        if (file->parent_id) {
+            const int64_t size_delta = static_cast<int64_t>(file->size_bytes) - static_cast<int64_t>(existingSize);
+            pipe.prepped("update_dir_stats_ancestors", *file->parent_id, size_delta, exists ? 0 : 1, 0); // Increment size_bytes and file_count
         }
+
+        pipe.complete();
     });
 }
 
@@ -251,6 +248,26 @@ void File::markFileAsTrashed(const unsigned int userId, const unsigned int fsId,
     });
 }
 
+vh::fs::model::file::TrashedSubtree File::trashSubtree(const unsigned int userId, const std::shared_ptr<vh::fs::model::Entry>& root) {
+    if (!root) throw std::invalid_argument("Subtree root cannot be null");
+    if (!root->parent_id) throw std::invalid_argument("Cannot trash an entry without a parent");
+
+    return Transactions::exec("File::trashSubtree", [&](pqxx::work& txn) {
+        pqxx::params p{root->id, userId, to_utf8_string(root->backing_path.u8string())};
+        vh::fs::model::file::TrashedSubtree trashed(txn.exec(pqxx::prepped{"trash_fs_subtree"}, p));
+
+        pqxx::params stats_params{
+            root->parent_id,
+            -static_cast<long long>(trashed.size_bytes),
+            -static_cast<long long>(trashed.file_count),
+            -static_cast<long long>(trashed.dir_count)
+        };
+        txn.exec(pqxx::prepped{"update_dir_stats_ancestors"}, stats_params);
+
+        return trashed;
+    });
+}
+
 void File::updateParentStatsAndCleanEmptyDirs(pqxx::work& txn,
                                                      std::optional<unsigned int> parentId,
                                                      const unsigned int sizeBytes,
@@ -5,37 +5,101 @@
 #include "identities/Group.hpp"
 #include "rbac/permission/admin/VaultGlobals.hpp"
 #include "rbac/role/Admin.hpp"
+#include "db/Pipeline.hpp"
 
 #include <array>
+#include <vector>
 
 namespace vh::db::query::identities {
 
+    namespace {
+        using VaultRoleMap = std::unordered_map<uint32_t, std::shared_ptr<rbac::role::Vault>>;
+
+        // Queues the override lookup for every assignment row, in row order
+        std::vector<Pipeline::Handle> queueOverrides(Pipeline& pipe, const pqxx::result& assignments) {
+            std::vector<Pipeline::Handle> handles;
+            handles.reserve(assignments.size());
+            for (const auto& row : assignments)
+                handles.push_back(pipe.prepped("vault_permission_override_list_by_assignment_id",
+                                               row["assignment_id"].as<uint32_t>()));
+            return handles;
+        }
+
+        VaultRoleMap collectVaultRoles(Pipeline& pipe, const pqxx::result& assignments,
+                                       const std::vector<Pipeline::Handle>& overrides) {
+            VaultRoleMap vaultRoles;
+            for (size_t i = 0; i < overrides.size(); ++i) {
+                const auto row = assignments[i];
+                vaultRoles[row["vault_id"].as<uint32_t>()] =
+                    std::make_shared<rbac::role::Vault>(row, pipe.retrieve(overrides[i]));
+            }
+            return vaultRoles;
+        }
+
+        struct QueuedGroup {
+            Pipeline::Handle members, roles;
+        };
+
+        QueuedGroup queueGroup(Pipeline& pipe, const uint32_t groupId) {
+            return {
+                .members = pipe.prepped("list_group_members", groupId),
+                .roles = pipe.prepped("vault_role_assignment_list_by_subject", "group", groupId)
+            };
+        }
+
+        // Groups arrive in three batches no matter how many there are: the group rows (already in
+        // hand), then members and role assignments for all of them, then every assignment's overrides
+        std::vector<std::shared_ptr<vh::identities::Group>> hydrateGroups(Pipeline& pipe, const pqxx::result& groupRows) {
+            std::vector<QueuedGroup> queued;
+            queued.reserve(groupRows.size());
+            for (const auto& row : groupRows) queued.push_back(queueGroup(pipe, row["id"].as<uint32_t>()));
+
+            std::vector<pqxx::result> members, roles;
+            std::vector<std::vector<Pipeline::Handle>> overrides;
+            for (const auto& q : queued) {
+                members.push_back(pipe.retrieve(q.members));
+                roles.push_back(pipe.retrieve(q.roles));
+            }
+            for (const auto& r : roles) overrides.push_back(queueOverrides(pipe, r));
+
+            std::vector<std::shared_ptr<vh::identities::Group>> groups;
+            groups.reserve(groupRows.size());
+            for (size_t i = 0; i < queued.size(); ++i)
+                groups.push_back(std::make_shared<vh::identities::Group>(
+                    groupRows[i], members[i], collectVaultRoles(pipe, roles[i], overrides[i])));
+            return groups;
+        }
+    }
+
     std::shared_ptr<vh::identities::User> hydrateUser(pqxx::work &txn, const pqxx::row &userRow) {
         const auto userId = userRow["id"].as<unsigned int>();
 
-        // Singular admin-role assignment joined to full admin_role
-        const auto adminRoleRes = txn.exec(
-            pqxx::prepped{"admin_role_assignment_get_by_user_id"},
-            pqxx::params{userId}
-        );
+        // Everything keyed by the user id goes out together, then the lookups that depend on it
+        Pipeline pipe(txn);
+        const auto adminRoleQ = pipe.prepped("admin_role_assignment_get_by_user_id", userId);   // singular, joined to full admin_role
+        const auto globalPoliciesQ = pipe.prepped("user_global_vault_policy_list_by_user", userId); // self / user / admin
+        const auto vaultRolesQ = pipe.prepped("vault_role_assignment_list_by_subject", "user", userId);
+        const auto groupsQ = pipe.prepped("list_groups_for_user", userId);
+
+        const auto adminRoleRes = pipe.retrieve(adminRoleQ);
+        const auto globalPoliciesRes = pipe.retrieve(globalPoliciesQ);
+        const auto vaultRolesRes = pipe.retrieve(vaultRolesQ);
+        const auto groupsRes = pipe.retrieve(groupsQ);
 
         if (adminRoleRes.empty())
             throw std::runtime_error("User " + std::to_string(userId) + " is missing an admin role assignment");
 
-        const auto adminRoleRow = adminRoleRes.one_row();
-
-        // Three global vault policy rows: self / user / admin
-        const auto globalPoliciesRes = txn.exec(
-            pqxx::prepped{"user_global_vault_policy_list_by_user"},
-            pqxx::params{userId}
-        );
+        const auto overrides = queueOverrides(pipe, vaultRolesRes);
+        auto groups = hydrateGroups(pipe, groupsRes);
+        auto vaultRoles = collectVaultRoles(pipe, vaultRolesRes, overrides);
+        pipe.complete();
 
         return std::make_shared<vh::identities::User>(
             userRow,
-            adminRoleRow,
+            adminRoleRes.one_row(),
             globalPoliciesRes,
-            getVaultRoles(txn, "user", userId),
-            getUserGroups(txn, userId)
+            std::move(vaultRoles),
+            std::move(groups)
         );
     }
 
@@ -46,9 +110,13 @@ namespace vh::db::query::identities {
     }
 
     std::shared_ptr<vh::identities::Group> hydrateGroup(pqxx::work &txn, const pqxx::row &groupRow) {
-        const auto groupId = groupRow["id"].as<uint32_t>();
-        const auto members = txn.exec(pqxx::prepped{"list_group_members"}, groupId);
-        return std::make_shared<vh::identities::Group>(groupRow, members, getVaultRoles(txn, "group", groupId));
+        Pipeline pipe(txn);
+        const auto q = queueGroup(pipe, groupRow["id"].as<uint32_t>());
+        const auto members = pipe.retrieve(q.members);
+        const auto roles = pipe.retrieve(q.roles);
+        auto vaultRoles = collectVaultRoles(pipe, roles, queueOverrides(pipe, roles));
+        pipe.complete();
+        return std::make_shared<vh::identities::Group>(groupRow, members, std::move(vaultRoles));
     }
 
     void upsertVaultRoles(pqxx::work& txn, const std::unordered_map<uint32_t, std::shared_ptr<rbac::role::Vault>>& vRoles,
@@ -119,37 +187,27 @@ namespace vh::db::query::identities {
     }
 
     std::unordered_map<uint32_t, std::shared_ptr<rbac::role::Vault>> getVaultRoles(pqxx::work &txn, const std::string& subjectType, uint32_t subjectId) {
-        std::unordered_map<uint32_t, std::shared_ptr<rbac::role::Vault>> vaultRoles;
         const auto res = txn.exec(
             pqxx::prepped{"vault_role_assignment_list_by_subject"},
             pqxx::params{subjectType, subjectId}
         );
 
-        for (const auto &row: res) {
-            const auto vaultId = row["vault_id"].as<uint32_t>();
-            const auto assignmentId = row["assignment_id"].as<uint32_t>();
-
-            const auto overridesRes = txn.exec(
-                pqxx::prepped{"vault_permission_override_list_by_assignment_id"},
-                pqxx::params{assignmentId}
-            );
-
-            vaultRoles[vaultId] = std::make_shared<rbac::role::Vault>(row, overridesRes);
-        }
-
+        // One batch for all the overrides instead of a round trip per assignment
+        Pipeline pipe(txn);
+        auto vaultRoles = collectVaultRoles(pipe, res, queueOverrides(pipe, res));
+        pipe.complete();
         return vaultRoles;
     }
 
     std::vector<std::shared_ptr<vh::identities::Group> > getUserGroups(pqxx::work &txn, uint32_t userId) {
-        std::vector<std::shared_ptr<vh::identities::Group>> groups;
-
         const auto res = txn.exec(
             pqxx::prepped{"list_groups_for_user"},
             pqxx::params{userId}
         );
 
-        for (const auto &row: res) groups.push_back(hydrateGroup(txn, row));
-
+        Pipeline pipe(txn);
+        auto groups = hydrateGroups(pipe, res);
+        pipe.complete();
         return groups;
     }
 }
@@ -7,6 +7,7 @@
 
 #include <pqxx/pqxx>
 
+#include <algorithm>
 #include <regex>
 #include <stdexcept>
 
@@ -27,6 +28,52 @@ std::pair<uint64_t, uint64_t> page(const db::model::ListQueryParams& params) {
     return {limit, (page - 1) * limit};
 }
 
+void validate(const std::shared_ptr<vh::share::AuditEvent>& event) {
+    if (!event) throw std::invalid_argument("Share audit event is required");
+    if (event->share_id) require_uuid(*event->share_id, "share id");
+    if (event->share_session_id) require_uuid(*event->share_session_id, "session id");
+    if (event->event_type.empty()) throw std::invalid_argument("Share audit event type is required");
+}
+
+void append_params(pqxx::params& p, const vh::share::AuditEvent& event) {
+    p.append(event.share_id);
+    p.append(event.share_session_id);
+    p.append(vh::share::to_string(event.actor_type));
+    p.append(event.actor_user_id);
+    p.append(event.event_type);
+    p.append(event.vault_id);
+    p.append(event.target_entry_id);
+    p.append(event.target_path);
+    p.append(vh::share::to_string(event.status));
+    p.append(event.bytes_transferred);
+    p.append(event.error_code);
+    p.append(event.error_message);
+    p.append(event.ip_address);
+    p.append(event.user_agent);
+}
+
+constexpr size_t INSERT_COLUMNS = 14;
+
+std::string batch_insert_sql(const size_t rows) {
+    std::string sql = R"SQL(
+        INSERT INTO share_access_event (
+            share_id, share_session_id, actor_type, actor_user_id, event_type,
+            vault_id, target_entry_id, target_path, status, bytes_transferred,
+            error_code, error_message, ip_address, user_agent
+        ) VALUES )SQL";
+
+    size_t n = 1;
+    for (size_t row = 0; row < rows; ++row) {
+        sql += row ? ", (" : "(";
+        for (size_t col = 0; col < INSERT_COLUMNS; ++col, ++n) {
+            if (col) sql += ", ";
+            sql += "$" + std::to_string(n);
+        }
+        sql += ")";
+    }
+    return sql;
+}
+
 std::vector<std::shared_ptr<vh::share::AuditEvent>> events_from_result(const pqxx::result& res) {
     std::vector<std::shared_ptr<vh::share::AuditEvent>> out;
     out.reserve(res.size());
@@ -36,10 +83,7 @@ std::vector<std::shared_ptr<vh::share::AuditEvent>> events_from_result(const pqx
 }
 
 void AuditEvent::append(const std::shared_ptr<vh::share::AuditEvent>& event) {
-    if (!event) throw std::invalid_argument("Share audit event is required");
-    if (event->share_id) audit_event_query_detail::require_uuid(*event->share_id, "share id");
-    if (event->share_session_id) audit_event_query_detail::require_uuid(*event->share_session_id, "session id");
-    if (event->event_type.empty()) throw std::invalid_argument("Share audit event type is required");
+    audit_event_query_detail::validate(event);
 
     Transactions::exec("share::AuditEvent::append", [&](pqxx::work& txn) {
         txn.exec(pqxx::prepped{"share_access_event_insert"}, pqxx::params{
@@ -61,6 +105,20 @@ void AuditEvent::append(const std::shared_ptr<vh::share::AuditEvent>& event) {
     });
 }
 
+void AuditEvent::appendBatch(const std::vector<std::shared_ptr<vh::share::AuditEvent>>& events) {
+    if (events.empty()) return;
+    for (const auto& event : events) audit_event_query_detail::validate(event);
+
+    Transactions::exec("share::AuditEvent::appendBatch", [&](pqxx::work& txn) {
+        for (size_t begin = 0; begin < events.size(); begin += MAX_BATCH_ROWS) {
+            const auto end = std::min(events.size(), begin + MAX_BATCH_ROWS);
+            pqxx::params p;
+            for (size_t i = begin; i < end; ++i) audit_event_query_detail::append_params(p, *events[i]);
+            txn.exec(audit_event_query_detail::batch_insert_sql(end - begin), p);
+        }
+    });
+}
+
 std::vector<std::shared_ptr<vh::share::AuditEvent>> AuditEvent::listForShare(const std::string& share_id, const db::model::ListQueryParams& params) {
     audit_event_query_detail::require_uuid(share_id, "share id");
     auto [limit, offset] = audit_event_query_detail::page(params);
@@ -232,4 +232,20 @@ void Link::incrementUpload(const std::string& id) {
     });
 }
 
+void Link::addCounters(const std::vector<CounterDelta>& deltas) {
+    if (deltas.empty()) return;
+    for (const auto& d : deltas) link_query_detail::require_uuid(d.id, "id");
+
+    // Links deleted since the increments were recorded just match no row.
+    Transactions::exec("share::Link::addCounters", [&](pqxx::work& txn) {
+        for (const auto& d : deltas)
+            txn.exec(pqxx::prepped{"share_link_add_counters"}, pqxx::params{
+                d.id,
+                static_cast<long long>(d.accesses),
+                static_cast<long long>(d.downloads),
+                static_cast<long long>(d.uploads)
+            });
+    });
+}
+
 }
@@ -161,7 +161,7 @@ uint32_t VaultRole::upsertForShare(
             .vault_role_id = roleId,
             .subject_type = "public",
             .subject_id = 0,
-            .overrides = role ? role->fs.overrides : std::vector<vh::rbac::permission::Override>{}
+            .overrides = role ? role->fs.overrides.items() : std::vector<vh::rbac::permission::Override>{}
         });
         replaceAssignmentOverrides(txn, assignmentId, role->fs.overrides);
         return assignmentId;
@@ -20,7 +20,10 @@
 #include "db/query/vault/Vault.hpp"
 #include "crypto/id/Generator.hpp"
 #include "fs/cache/Registry.hpp"
+#include "fs/task/Unlink.hpp"
+#include "fs/model/file/Trashed.hpp"
 #include "db/encoding/u8.hpp"
+#include "stats/Trace.hpp"
 
 #include <ranges>
 #include <fstream>
@@ -98,6 +101,7 @@ int Filesystem::mkdir(const std::filesystem::path& absPath,
                       const mode_t mode,
                       const std::optional<unsigned int>& userId,
                       std::shared_ptr<Engine> engine) {
+    const stats::trace::Span span("fs.mkdir", absPath.native());
     log::Registry::fs()->debug("Creating directory at: {}", absPath.string());
 
     std::scoped_lock lock(mutex_);
@@ -253,6 +257,7 @@ int Filesystem::copy(const std::filesystem::path& from,
                      const std::filesystem::path& to,
                      const unsigned int userId,
                      std::shared_ptr<Engine> engine) {
+    const stats::trace::Span span("fs.copy", from.native());
     std::scoped_lock lock(mutex_);
 
     try {
@@ -378,29 +383,50 @@ int Filesystem::copy(const std::filesystem::path& from,
 }
 
 void Filesystem::remove(const std::filesystem::path& path, const unsigned int userId) {
+    const stats::trace::Span span("fs.remove", path.native());
     const auto& cache = runtime::Deps::get().fsCache;
     const auto entry = cache->getEntry(path);
     if (!entry) throw std::runtime_error("[Filesystem] Path does not exist in cache: " + path.string());
     if (!entry->vault_id) throw std::runtime_error("[Filesystem] Entry has no associated vault ID: " + path.string());
+    if (!entry->parent_id || entry->path == "/") throw std::runtime_error("[Filesystem] Refusing to remove vault root: " + path.string());
 
     // !!! DO NOT CALL THIS FUNCTION DIRECTLY FROM FUSE CALLBACKS - WEBSOCKET OR INTERNAL ONLY !!!
-    // This function recursively marks files as trashed in the database and deletes their backing paths
+    // This function moves the whole subtree into the trash in the database and deletes its backing paths
     // which is incompatible with how FUSE expects unlink/rmdir to behave.
 
-    if (entry->isDirectory())
-        for (const auto& file : db::query::fs::File::listFilesInDir(*entry->vault_id, entry->path, true)) {
-            db::query::fs::File::markFileAsTrashed(userId, file->id);
-            cache->evictPath(file->fuse_path);
-        }
-    else {
-        db::query::fs::File::markFileAsTrashed(userId, *entry->vault_id, entry->path);
-        cache->evictPath(path);
+    std::vector<std::filesystem::path> doomed;
+
+    {
+        std::scoped_lock lock(mutex_);
+
+        if (!storageManager_) throw std::runtime_error("[Filesystem] StorageManager is not initialized");
+        const auto engine = storageManager_->resolveStorageEngine(path);
+        if (!engine) throw std::runtime_error("[Filesystem] No storage engine found for path: " + path.string());
+
+        const auto trashed = db::query::fs::File::trashSubtree(userId, entry);
+
+        cache->evictSubtree(path);
+        cache->applyDirStatsDelta(*entry->parent_id,
+                                  -static_cast<int64_t>(trashed.size_bytes),
+                                  -static_cast<int64_t>(trashed.file_count),
+                                  -static_cast<int64_t>(trashed.dir_count));
+
+        // Backing paths are alias-derived and the aliases are gone from the DB,
+        // so nothing new can land on these paths while they are unlinked in the background.
+        doomed.reserve(1 + trashed.file_aliases.size() + trashed.cache_paths.size());
+        doomed.push_back(entry->backing_path);
+        for (const auto& alias : trashed.file_aliases) doomed.push_back(engine->paths->thumbnailRoot / alias);
+        for (const auto& p : trashed.cache_paths) doomed.push_back(engine->paths->absPath(p, PathType::CACHE_ROOT));
+
+        log::Registry::fs()->debug("[Filesystem::remove] Trashed {} files and {} directories under {}",
+                                   trashed.file_count, trashed.dir_count, path.string());
     }
 
-    if (std::filesystem::exists(entry->backing_path)) std::filesystem::remove_all(entry->backing_path);
+    task::Unlink::enqueue(std::move(doomed));
 }
 
 std::shared_ptr<File> Filesystem::createFile(const NewFileContext& ctx) {
+    const stats::trace::Span span("fs.create_file", ctx.path.native());
     const auto engine = ctx.engine ? ctx.engine : storageManager_->resolveStorageEngine(ctx.path);
     if (!engine) throw std::runtime_error("[Filesystem] No storage engine found for file creation");
 
@@ -432,14 +458,13 @@ std::shared_ptr<File> Filesystem::createFile(const NewFileContext& ctx) {
 
         const auto f = std::static_pointer_cast<File>(entry);
 
-        f->content_hash = hash::blake2b(entry->backing_path);
-
         if (!ctx.buffer.empty()) {
-            const auto ciphertext = engine->encryptionManager->encrypt(ctx.buffer, f);
-            writeFile(entry->backing_path, ciphertext);
-            f->size_bytes = ctx.buffer.size();
-            f->mime_type = Magic::get_mime_type_from_buffer(ctx.buffer);
+            auto [contentHash, mime, size] = encryptAndWrite(ctx.buffer, entry->backing_path, *engine->encryptionManager, f);
+            f->content_hash = std::move(contentHash);
+            f->mime_type = std::move(mime);
+            f->size_bytes = size;
         } else {
+            f->content_hash = hash::blake2b(entry->backing_path);
             f->size_bytes = std::filesystem::file_size(entry->backing_path);
             f->mime_type = inferMimeTypeFromPath(ctx.path);
         }
@@ -472,18 +497,18 @@ std::shared_ptr<File> Filesystem::createFile(const NewFileContext& ctx) {
     f->is_hidden = ctx.path.filename().string().starts_with('.');
     f->created_by = f->last_modified_by = ctx.userId;
     f->inode = std::make_optional(cache->getOrAssignInode(ctx.fuse_path));
-    f->mime_type = ctx.buffer.empty() ? inferMimeTypeFromPath(ctx.path) : Magic::get_mime_type_from_buffer(ctx.buffer);
     f->size_bytes = ctx.buffer.size();
 
-    if (ctx.buffer.empty()) std::ofstream(f->backing_path).close();
-    else {
-        std::string iv_b64;
-        const auto ciphertext = engine->encryptionManager->encrypt(ctx.buffer, f);
-        writeFile(f->backing_path, ciphertext);
+    if (ctx.buffer.empty()) {
+        std::ofstream(f->backing_path).close();
+        f->mime_type = inferMimeTypeFromPath(ctx.path);
+        f->content_hash = hash::blake2b(f->backing_path);
+    } else {
+        auto [contentHash, mime, size] = encryptAndWrite(ctx.buffer, f->backing_path, *engine->encryptionManager, f);
+        f->content_hash = std::move(contentHash);
+        f->mime_type = std::move(mime);
     }
 
-    f->content_hash = hash::blake2b(f->backing_path);
-
     if (!std::filesystem::exists(f->backing_path))
         throw std::runtime_error("[Filesystem] Failed to create real file at: " + f->backing_path.string());
 
@@ -615,6 +640,7 @@ int Filesystem::rename(const std::filesystem::path& oldPath,
                        const std::filesystem::path& newPath,
                        const std::optional<unsigned int>& userId,
                        std::shared_ptr<Engine> engine) {
+    const stats::trace::Span span("fs.rename", oldPath.native());
     std::scoped_lock lock(mutex_);
 
     try {
@@ -843,19 +869,10 @@ int Filesystem::handleRename(const RenameContext& ctx) {
                     return -EIO;
                 }
             } else {
-                const auto ciphertext = ctx.engine->encryptionManager->encrypt(buffer, f);
-                if (ciphertext.empty()) {
-                    log::Registry::fs()->error(
-                        "[Filesystem::handleRename] Encryption failed for file: {}",
-                        oldBackingPath.string());
-                    return -EIO;
-                }
-
-                writeFile(entry->backing_path, ciphertext);
-
-                f->size_bytes = std::filesystem::file_size(entry->backing_path);
-                f->mime_type = Magic::get_mime_type_from_buffer(buffer);
-                f->content_hash = hash::blake2b(entry->backing_path);
+                auto [contentHash, mime, size] = encryptAndWrite(buffer, entry->backing_path, *ctx.engine->encryptionManager, f);
+                f->content_hash = std::move(contentHash);
+                f->mime_type = std::move(mime);
+                f->size_bytes = size;
 
                 if (f->size_bytes > 0 && f->mime_type && isPreviewable(*f->mime_type))
                     preview::thumbnail::Worker::enqueue(ctx.engine, buffer, f);
@@ -0,0 +1,112 @@
+#include "fs/cache/NegativeCache.hpp"
+
+#include <functional>
+
+namespace vh::fs::cache {
+
+NegativeCache::NegativeCache(const std::size_t capacity, const std::chrono::milliseconds ttl)
+    : capacity_(capacity), perShard_((capacity + kShards - 1) / kShards), ttl_(ttl) {}
+
+// Paths are absolute and never contain NUL, so a leading NUL keeps ids out of their keyspace
+std::string NegativeCache::idKey(const unsigned int id) {
+    return std::string(1, '\0') + std::to_string(id);
+}
+
+NegativeCache::Shard& NegativeCache::shardFor(const std::string& key) {
+    return shards_[std::hash<std::string>{}(key) % kShards];
+}
+
+bool NegativeCache::containsKey(const std::string& key) {
+    if (!enabled()) return false;
+
+    auto& shard = shardFor(key);
+    std::lock_guard lock(shard.mutex);
+
+    const auto it = shard.index.find(key);
+    if (it == shard.index.end()) return false;
+    if (it->second->expires > Clock::now()) return true;
+
+    shard.fifo.erase(it->second);
+    shard.index.erase(it);
+    return false;
+}
+
+void NegativeCache::insertKey(std::string key) {
+    if (!enabled()) return;
+
+    const auto now = Clock::now();
+    auto& shard = shardFor(key);
+    std::lock_guard lock(shard.mutex);
+
+    if (const auto it = shard.index.find(key); it != shard.index.end()) {
+        shard.fifo.erase(it->second);
+        shard.index.erase(it);
+    }
+
+    while (!shard.fifo.empty() && (shard.fifo.front().expires <= now || shard.fifo.size() >= perShard_)) {
+        shard.index.erase(shard.fifo.front().key);
+        shard.fifo.pop_front();
+    }
+
+    shard.fifo.push_back({ .key = key, .expires = now + ttl_ });
+    shard.index.emplace(std::move(key), std::prev(shard.fifo.end()));
+}
+
+void NegativeCache::eraseKey(const std::string& key) {
+    if (!enabled()) return;
+
+    auto& shard = shardFor(key);
+    std::lock_guard lock(shard.mutex);
+
+    if (const auto it = shard.index.find(key); it != shard.index.end()) {
+        shard.fifo.erase(it->second);
+        shard.index.erase(it);
+    }
+}
+
+bool NegativeCache::contains(const std::filesystem::path& path) { return containsKey(path.native()); }
+void NegativeCache::insert(const std::filesystem::path& path) { insertKey(path.native()); }
+void NegativeCache::erase(const std::filesystem::path& path) { eraseKey(path.native()); }
+
+bool NegativeCache::containsId(const unsigned int id) { return containsKey(idKey(id)); }
+void NegativeCache::insertId(const unsigned int id) { insertKey(idKey(id)); }
+void NegativeCache::eraseId(const unsigned int id) { eraseKey(idKey(id)); }
+
+void NegativeCache::eraseUnder(const std::filesystem::path& root) {
+    if (!enabled()) return;
+
+    const auto& prefix = root.native();
+    const auto isUnderRoot = [&](const std::string& s) {
+        if (!s.starts_with(prefix)) return false;
+        return s.size() == prefix.size() || prefix.ends_with('/') || s[prefix.size()] == '/';
+    };
+
+    for (auto& shard : shards_) {
+        std::lock_guard lock(shard.mutex);
+        for (auto it = shard.fifo.begin(); it != shard.fifo.end();) {
+            if (isUnderRoot(it->key)) {
+                shard.index.erase(it->key);
+                it = shard.fifo.erase(it);
+            } else ++it;
+        }
+    }
+}
+
+void NegativeCache::clear() {
+    for (auto& shard : shards_) {
+        std::lock_guard lock(shard.mutex);
+        shard.fifo.clear();
+        shard.index.clear();
+    }
+}
+
+std::size_t NegativeCache::size() const {
+    std::size_t n = 0;
+    for (const auto& shard : shards_) {
+        std::lock_guard lock(shard.mutex);
+        n += shard.fifo.size();
+    }
+    return n;
+}
+
+}
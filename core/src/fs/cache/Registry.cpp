@@ -1,15 +1,21 @@
 #include "fs/cache/Registry.hpp"
+#include "fs/cache/Snapshot.hpp"
 
+#include "config/Registry.hpp"
 #include "fs/model/Entry.hpp"
 #include "fs/model/Directory.hpp"
 #include "db/query/fs/Entry.hpp"
 #include "db/query/fs/Directory.hpp"
 #include "log/Registry.hpp"
+#include "log/Lazy.hpp"
 #include "crypto/id/Generator.hpp"
 #include "stats/model/CacheStats.hpp"
 #include "fs/model/Path.hpp"
 
+#include <paths.h>
+
 #include <unordered_set>
+#include <optional>
 #include <mutex>
 #include <limits>
 #include <chrono>
@@ -39,11 +45,17 @@ uint64_t subClamp(uint64_t a, uint64_t b) noexcept {
     return (a >= b) ? (a - b) : 0;
 }
 
+std::filesystem::path snapshotPath() {
+    return vh::paths::getBackingPath() / ".fs_cache.snapshot";
+}
+
 } // namespace
 
 namespace vh::fs::cache {
 
-Registry::Registry() {
+Registry::Registry()
+    : negative_(config::Registry::get().caching.fs_negative_entries,
+                milliseconds(config::Registry::get().caching.fs_negative_ttl_ms)) {
     stats_ = std::make_shared<CacheStats>();
 
     // Seed hard root mapping for FUSE
@@ -53,7 +65,7 @@ Registry::Registry() {
     nextInode_ = db::query::fs::Entry::getNextInode();
 
     initRoot();
-    restoreCache();
+    if (!config::Registry::get().caching.fs_snapshot || !loadSnapshot()) restoreCache();
 
     log::Registry::storage()->info("[FSCache] Initialized with next inode: {}", nextInode_);
 }
@@ -81,24 +93,153 @@ void Registry::restoreCache() {
     const auto rootEntry = getEntry(FUSE_ROOT_ID);
     if (!rootEntry) throw std::runtime_error("[FSCache] Root entry not found, cannot restore cache");
 
-    for (const auto& entry : db::query::fs::Entry::listDir(rootEntry->id, true)) {
-        if (!entry) {
-            log::Registry::storage()->warn("[FSCache] Null entry found in directory listing for root");
-            continue;
+    // Only the top of the tree is loaded up front; everything below faults in on first access
+    const auto depth = config::Registry::get().caching.fs_eager_depth;
+    std::unordered_set<unsigned int> level{rootEntry->id};
+
+    for (unsigned int d = 0; d < depth && !level.empty(); ++d) {
+        for (const auto id : level) loadChildren(id);
+
+        std::unordered_set<unsigned int> next;
+        std::shared_lock lock(mutex_);
+        for (const auto& [childId, parentId] : childToParent_) {
+            if (!level.contains(parentId)) continue;
+            if (const auto it = idToEntry_.find(childId); it != idToEntry_.end() && it->second && it->second->isDirectory())
+                next.insert(childId);
+        }
+        level = std::move(next);
+    }
+
+    std::shared_lock lock(mutex_);
+    log::Registry::storage()->info("[FSCache] Restored {} entries to depth {}", idToEntry_.size(), depth);
+}
+
+bool Registry::loadSnapshot() {
+    try {
+        const Snapshot::Stamp stamp{
+            .epoch = db::query::fs::Entry::getEpoch(),
+            .generation = db::query::fs::Entry::getGeneration()
+        };
+        const auto snap = Snapshot::read(snapshotPath(), stamp);
+        if (!snap) {
+            log::Registry::storage()->info("[FSCache] No usable snapshot at epoch {} generation {}, restoring from the database",
+                                           stamp.epoch, stamp.generation);
+            return false;
+        }
+
+        std::unique_lock lock(mutex_);
+        uint64_t used = stats_->snapshot().used_bytes;
+
+        for (const auto& entry : snap->entries) {
+            if (!entry->inode || idToEntry_.contains(entry->id)) continue;
+            index(entry);
+            nextInode_ = std::max<fuse_ino_t>(nextInode_, *entry->inode + 1);
+            used = addClamp(used, safeSizeBytes(entry));
+            stats_->record_insert();
         }
 
-        if (entry->inode) cacheEntry(entry, true /*isFirstSeeding*/);
-        else {
-            entry->inode = std::make_optional(getOrAssignInode(entry->fuse_path));
-            db::query::fs::Entry::updateFSEntry(entry);
-            cacheEntry(entry, true /*isFirstSeeding*/);
+        loadedDirs_.insert(snap->loadedDirs.begin(), snap->loadedDirs.end());
+        stats_->set_used(used);
+
+        log::Registry::storage()->info("[FSCache] Restored {} entries from snapshot at epoch {} generation {}",
+                                       snap->entries.size(), stamp.epoch, stamp.generation);
+        return true;
+    } catch (const std::exception& e) {
+        log::Registry::storage()->warn("[FSCache] Failed to load snapshot: {}", e.what());
+        return false;
+    }
+}
+
+void Registry::saveSnapshot() {
+    if (!config::Registry::get().caching.fs_snapshot) return;
+
+    try {
+        // Read the stamp before copying so a write landing in between makes the image stale, not wrong
+        const Snapshot::Stamp stamp{
+            .epoch = db::query::fs::Entry::getEpoch(),
+            .generation = db::query::fs::Entry::getGeneration()
+        };
+
+        std::vector<std::shared_ptr<Entry>> entries;
+        std::vector<unsigned int> dirs;
+        {
+            std::shared_lock lock(mutex_);
+            entries.reserve(idToEntry_.size());
+            for (const auto& [_, entry] : idToEntry_)
+                if (entry && entry->inode) entries.push_back(entry);
+            dirs.assign(loadedDirs_.begin(), loadedDirs_.end());
         }
+
+        Snapshot::write(snapshotPath(), stamp, entries, dirs);
+        log::Registry::storage()->info("[FSCache] Wrote snapshot of {} entries at epoch {} generation {}",
+                                       entries.size(), stamp.epoch, stamp.generation);
+    } catch (const std::exception& e) {
+        log::Registry::storage()->warn("[FSCache] Failed to write snapshot: {}", e.what());
     }
 }
 
+void Registry::loadChildren(const unsigned int dirId) {
+    uint64_t epoch;
+    {
+        std::shared_lock lock(mutex_);
+        if (loadedDirs_.contains(dirId)) return;
+        epoch = evictions_;
+    }
+
+    for (const auto& child : db::query::fs::Entry::listDir(dirId, false)) {
+        if (!child) continue;
+
+        {
+            std::shared_lock lock(mutex_);
+            if (idToEntry_.contains(child->id)) continue;
+        }
+
+        if (!child->inode) {
+            child->inode = std::make_optional(getOrAssignInode(child->fuse_path));
+            db::query::fs::Entry::updateFSEntry(child);
+        }
+        cacheEntry(child, true /*isFirstSeeding*/);
+    }
+
+    // An eviction during the listing may have dropped a child we skipped as cached
+    std::unique_lock lock(mutex_);
+    if (evictions_ == epoch) loadedDirs_.insert(dirId);
+}
+
+std::shared_ptr<Entry> Registry::faultInPath(const std::filesystem::path& path) {
+    std::shared_ptr<Entry> cur;
+    std::filesystem::path curPath = path;
+    {
+        std::shared_lock lock(mutex_);
+        while (true) {
+            if (const auto it = pathToEntry_.find(curPath); it != pathToEntry_.end()) {
+                cur = it->second;
+                break;
+            }
+            if (!curPath.has_relative_path()) return nullptr;
+            curPath = curPath.parent_path();
+        }
+    }
+
+    for (const auto& part : path.lexically_relative(curPath)) {
+        if (part == "." || part.empty()) continue;
+        if (!cur || !cur->isDirectory()) return nullptr;
+
+        loadChildren(cur->id);
+        curPath /= part;
+
+        std::shared_lock lock(mutex_);
+        const auto it = pathToEntry_.find(curPath);
+        if (it == pathToEntry_.end()) return nullptr;
+        cur = it->second;
+    }
+
+    return cur;
+}
+
 std::shared_ptr<Entry> Registry::getEntry(const std::filesystem::path& absPath) {
     const auto path = makeAbsolute(absPath);
-    log::Registry::storage()->debug("[FSCache] Retrieving entry for path: {}", path.string());
+    log::Registry::storage()->debug("[FSCache] Retrieving entry for path: {}", log::lazy([&] { return path.string(); }));
     
     {
         std::shared_lock lock(mutex_);
@@ -108,11 +249,30 @@ std::shared_ptr<Entry> Registry::getEntry(const std::filesystem::path& absPath)
         }
     }
 
+    if (negative_.contains(path)) {
+        stats_->record_hit();
+        return nullptr;
+    }
+
     stats_->record_miss();
     ScopedOpTimer timer(stats_.get());
 
     try {
-        const auto ino = getOrAssignInode(path);
+        if (auto entry = faultInPath(path)) return entry;
+
+        // Linked to an inode but not cached yet, e.g. mid-create
+        fuse_ino_t ino;
+        {
+            std::shared_lock lock(mutex_);
+            const auto it = pathToInode_.find(path);
+            if (it == pathToInode_.end()) {
+                log::Registry::storage()->debug("[FSCache] No entry found for path: {}", path.string());
+                negative_.insert(path);
+                return nullptr;
+            }
+            ino = it->second;
+        }
+
         const auto entry = db::query::fs::Entry::getFSEntryByInode(ino);
 
         if (entry) {
@@ -121,7 +281,10 @@ std::shared_ptr<Entry> Registry::getEntry(const std::filesystem::path& absPath)
                 entry->inode = ino;
                 cacheEntry(entry);
             }
-        } else log::Registry::storage()->debug("[FSCache] No entry found for path: {}", path.string());
+        } else {
+            log::Registry::storage()->debug("[FSCache] No entry found for path: {}", path.string());
+            negative_.insert(path);
+        }
 
         return entry;
     } catch (const std::exception& e) {
@@ -145,8 +308,17 @@ std::shared_ptr<Entry> Registry::getEntry(const fuse_ino_t ino) {
     ScopedOpTimer timer(stats_.get());
 
     auto entry = db::query::fs::Entry::getFSEntryByInode(ino);
-    if (entry) cacheEntry(entry);
-    else log::Registry::storage()->warn("[FSCache] No entry found for inode: {}", ino);
+    if (!entry) {
+        log::Registry::storage()->warn("[FSCache] No entry found for inode: {}", ino);
+        return nullptr;
+    }
+
+    // Ancestors must be cached too; stats deltas and evictions walk up through them
+    if (entry->parent_id) {
+        if (auto cached = faultInPath(entry->fuse_path)) return cached;
+    }
+
+    cacheEntry(entry);
     return entry;
 }
 
@@ -157,12 +329,18 @@ std::shared_ptr<Entry> Registry::getEntryById(unsigned int id) {
         return it->second;
     }
 
+    if (negative_.containsId(id)) {
+        stats_->record_hit();
+        return nullptr;
+    }
+
     stats_->record_miss();
     ScopedOpTimer timer(stats_.get());
 
     std::shared_ptr<Entry> entry = nullptr;
     log::Registry::storage()->warn("[FSCache] No entry found for ID: {}", id);
     entry = db::query::fs::Entry::getFSEntryById(id);
+    if (!entry) negative_.insertId(id);
     return entry;
 }
 
@@ -212,9 +390,13 @@ fuse_ino_t Registry::getOrAssignInode(const std::filesystem::path& path) {
 }
 
 std::filesystem::path Registry::resolvePath(fuse_ino_t ino) {
-    std::shared_lock lock(mutex_);
-    if (!inodeToPath_.contains(ino)) throw std::runtime_error("[FSCache] Inode not found: " + std::to_string(ino));
-    return inodeToPath_.at(ino);
+    {
+        std::shared_lock lock(mutex_);
+        if (const auto it = inodeToPath_.find(ino); it != inodeToPath_.end()) return it->second;
+    }
+
+    if (const auto entry = getEntry(ino)) return entry->fuse_path;
+    throw std::runtime_error("[FSCache] Inode not found: " + std::to_string(ino));
 }
 
 void Registry::linkPath(const std::filesystem::path& absPath, const fuse_ino_t ino) {
@@ -232,9 +414,17 @@ void Registry::decrementInodeRef(const fuse_ino_t ino, const uint64_t nlookup) {
     evictIno(ino);
 }
 
-bool Registry::entryExists(const std::filesystem::path& absPath) const {
-    std::shared_lock lock(mutex_);
-    return pathToEntry_.contains(absPath);
+bool Registry::entryExists(const std::filesystem::path& absPath) {
+    {
+        std::shared_lock lock(mutex_);
+        if (pathToEntry_.contains(absPath)) return true;
+    }
+
+    if (negative_.contains(absPath)) return false;
+    if (faultInPath(absPath)) return true;
+
+    negative_.insert(absPath);
+    return false;
 }
 
 std::shared_ptr<Entry> Registry::getEntryFromInode(const fuse_ino_t ino) const {
@@ -247,7 +437,8 @@ std::shared_ptr<Entry> Registry::getEntryFromInode(const fuse_ino_t ino) const {
 void Registry::cacheEntry(const std::shared_ptr<Entry>& entry, const bool isFirstSeeding) {
     if (!entry || !entry->inode) throw std::invalid_argument("Entry or inode is null");
 
-    log::Registry::storage()->debug("[FSCache] Caching entry: {} with inode {}", entry->fuse_path.string(), *entry->inode);
+    log::Registry::storage()->debug("[FSCache] Caching entry: {} with inode {}",
+                                    log::lazy([&] { return entry->fuse_path.string(); }), *entry->inode);
 
     // Preflight: reconstruct fuse/backing paths when needed
     if (*entry->inode != FUSE_ROOT_ID) {
@@ -298,28 +489,15 @@ void Registry::cacheEntry(const std::shared_ptr<Entry>& entry, const bool isFirs
     }
 
     const uint64_t newSize = safeSizeBytes(entry);
+    const bool pathIsNew = !pathToEntry_.contains(entry->fuse_path);
 
-    auto insert = [&](const std::shared_ptr<Entry>& e) {
-        if (!e) {
-            log::Registry::fs()->error("[FSCache] Attempted to cache a null entry");
-            return;
-        }
-
-        if (!e->inode) {
-            log::Registry::fs()->error("[FSCache] Entry {} has no inode, cannot cache", e->id);
-            throw std::runtime_error("Entry has no inode");
-        }
-
-        inodeToPath_[*e->inode] = e->fuse_path;
-        inodeToEntry_[*e->inode] = e;
-        pathToInode_[e->fuse_path] = *e->inode;
-        pathToEntry_[e->fuse_path] = e;
-        inodeToId_[*e->inode] = e->id;
-        idToEntry_[e->id] = e;
-        if (e->parent_id) childToParent_[e->id] = *e->parent_id;
-    };
+    index(entry);
 
-    insert(entry);
+    // Whatever was missing here isn't any more; a directory created or renamed into place may
+    // also have brought children with it
+    negative_.erase(entry->fuse_path);
+    negative_.eraseId(entry->id);
+    if (!isFirstSeeding && pathIsNew && entry->isDirectory()) negative_.eraseUnder(entry->fuse_path);
 
     // Update upstream directory stats (your existing behavior)
     if (!parentStats.empty()) {
@@ -331,7 +509,7 @@ void Registry::cacheEntry(const std::shared_ptr<Entry>& entry, const bool isFirs
                 dir->file_count = s["file_count"].as<unsigned int>();
                 dir->subdirectory_count = s["subdirectory_count"].as<unsigned int>();
             } else {
-                insert(db::query::fs::Entry::getFSEntryById(id));
+                index(db::query::fs::Entry::getFSEntryById(id));
             }
         }
     }
@@ -353,6 +531,26 @@ void Registry::cacheEntry(const std::shared_ptr<Entry>& entry, const bool isFirs
     log::Registry::fs()->info("[FSCache] Cached entry: {} with inode {}", entry->fuse_path.string(), *entry->inode);
 }
 
+void Registry::index(const std::shared_ptr<Entry>& e) {
+    if (!e) {
+        log::Registry::fs()->error("[FSCache] Attempted to cache a null entry");
+        return;
+    }
+
+    if (!e->inode) {
+        log::Registry::fs()->error("[FSCache] Entry {} has no inode, cannot cache", e->id);
+        throw std::runtime_error("Entry has no inode");
+    }
+
+    inodeToPath_[*e->inode] = e->fuse_path;
+    inodeToEntry_[*e->inode] = e;
+    pathToInode_[e->fuse_path] = *e->inode;
+    pathToEntry_[e->fuse_path] = e;
+    inodeToId_[*e->inode] = e->id;
+    idToEntry_[e->id] = e;
+    if (e->parent_id) childToParent_[e->id] = *e->parent_id;
+}
+
 void Registry::updateEntry(const std::shared_ptr<Entry>& entry) {
     log::Registry::fs()->debug("[FSCache] Updating entry: {} with inode {}",
                              entry->fuse_path.string(), entry->inode ? *entry->inode : 0);
@@ -388,7 +586,13 @@ void Registry::evictIno(fuse_ino_t ino) {
     inodeToId_.erase(ino);
     idToEntry_.erase(id);
 
-    childToParent_.erase(id);
+    // Neither the entry's own listing nor its parent's is complete any more
+    loadedDirs_.erase(id);
+    if (const auto it = childToParent_.find(id); it != childToParent_.end()) {
+        loadedDirs_.erase(it->second);
+        childToParent_.erase(it);
+    }
+    ++evictions_;
 
     // Update used bytes (bounded)
     const uint64_t curUsed = stats_->snapshot().used_bytes;
@@ -413,7 +617,80 @@ void Registry::evictPath(const std::filesystem::path& path) {
     evictIno(ino);
 }
 
-std::vector<std::shared_ptr<Entry>> Registry::listDir(const unsigned int parentId, const bool recursive) const {
+size_t Registry::evictSubtree(const std::filesystem::path& root) {
+    const auto& prefix = root.native();
+    const auto isUnderRoot = [&](const std::filesystem::path& p) {
+        const auto& s = p.native();
+        if (!s.starts_with(prefix)) return false;
+        return s.size() == prefix.size() || prefix.ends_with('/') || s[prefix.size()] == '/';
+    };
+
+    std::unique_lock lock(mutex_);
+
+    std::vector<fuse_ino_t> doomed;
+    for (const auto& [path, ino] : pathToInode_)
+        if (isUnderRoot(path)) doomed.push_back(ino);
+
+    uint64_t removedSize = 0;
+    for (const auto ino : doomed) {
+        if (const auto it = inodeToPath_.find(ino); it != inodeToPath_.end()) {
+            pathToInode_.erase(it->second);
+            pathToEntry_.erase(it->second);
+            inodeToPath_.erase(it);
+        }
+
+        if (const auto it = inodeToEntry_.find(ino); it != inodeToEntry_.end()) {
+            if (it->second) {
+                removedSize = addClamp(removedSize, safeSizeBytes(it->second));
+                idToEntry_.erase(it->second->id);
+                loadedDirs_.erase(it->second->id);
+                if (const auto pit = childToParent_.find(it->second->id); pit != childToParent_.end()) {
+                    loadedDirs_.erase(pit->second);
+                    childToParent_.erase(pit);
+                }
+            }
+            inodeToEntry_.erase(it);
+        }
+
+        inodeToId_.erase(ino);
+        stats_->record_invalidation();
+        stats_->record_eviction();
+    }
+
+    stats_->set_used(subClamp(stats_->snapshot().used_bytes, removedSize));
+    if (!doomed.empty()) ++evictions_;
+
+    log::Registry::fs()->debug("[FSCache] Evicted {} entries under {}", doomed.size(), root.string());
+    return doomed.size();
+}
+
+void Registry::applyDirStatsDelta(const unsigned int dirId, const int64_t sizeDelta, const int64_t fileDelta, const int64_t subdirDelta) {
+    const auto apply = [](auto cur, const int64_t delta) {
+        using T = decltype(cur);
+        const auto next = static_cast<int64_t>(cur) + delta;
+        return next < 0 ? T{0} : static_cast<T>(next);
+    };
+
+    std::unique_lock lock(mutex_);
+
+    std::optional<unsigned int> id = dirId;
+    while (id) {
+        const auto it = idToEntry_.find(*id);
+        if (it == idToEntry_.end() || !it->second || !it->second->isDirectory()) break;
+
+        const auto dir = std::static_pointer_cast<Directory>(it->second);
+        dir->size_bytes = apply(dir->size_bytes, sizeDelta);
+        dir->file_count = apply(dir->file_count, fileDelta);
+        dir->subdirectory_count = apply(dir->subdirectory_count, subdirDelta);
+
+        if (const auto pit = childToParent_.find(*id); pit != childToParent_.end()) id = pit->second;
+        else id.reset();
+    }
+}
+
+std::vector<std::shared_ptr<Entry>> Registry::listDir(const unsigned int parentId, const bool recursive) {
+    if (!recursive) loadChildren(parentId);
+
     const auto parent = db::query::fs::Entry::getFSEntryById(parentId);
     if (!parent->isDirectory()) throw std::runtime_error("Parent ID is not a directory");
 
@@ -469,6 +746,10 @@ std::vector<std::shared_ptr<Entry>> Registry::listDir(const unsigned int parentI
     return entries;
 }
 
+double Registry::negativeEntryTimeout() const {
+    return negative_.enabled() ? duration<double>(negative_.ttl()).count() : 0.0;
+}
+
 std::shared_ptr<CacheStatsSnapshot> Registry::stats() const {
     // Snapshot should be atomics-only; safe without locking FSCache maps.
     return std::make_shared<CacheStatsSnapshot>(stats_->snapshot());
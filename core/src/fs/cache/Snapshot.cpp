@@ -0,0 +1,334 @@
+#include "fs/cache/Snapshot.hpp"
+
+#include "fs/model/Entry.hpp"
+#include "fs/model/File.hpp"
+#include "fs/model/Directory.hpp"
+
+#include <zlib.h>
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace vh::fs::cache {
+
+namespace {
+
+using model::Entry;
+using model::File;
+using model::Directory;
+
+constexpr char kMagic[8] = {'V', 'H', 'F', 'S', 'C', 'A', 'C', 'H'};
+
+struct StrRef {
+    uint64_t off;
+    uint32_t len;
+    uint32_t pad;
+};
+
+enum Flag : uint32_t {
+    IsDirectory     = 1u << 0,
+    IsHidden        = 1u << 1,
+    IsSystem        = 1u << 2,
+    HasParent       = 1u << 3,
+    HasOwner        = 1u << 4,
+    HasGroup        = 1u << 5,
+    HasVault        = 1u << 6,
+    HasCreatedBy    = 1u << 7,
+    HasModifiedBy   = 1u << 8,
+    HasInode        = 1u << 9,
+    HasMode         = 1u << 10,
+    HasMime         = 1u << 11,
+    HasHash         = 1u << 12,
+};
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    char epoch[Snapshot::kMaxEpochBytes];   // NUL-padded
+    uint64_t generation;
+    uint64_t record_count;
+    uint64_t loaded_dir_count;
+    uint64_t blob_size;
+    uint32_t crc;           // everything after the header
+    uint32_t pad;
+};
+
+struct SnapshotRecord {
+    uint32_t id;
+    uint32_t flags;
+    int32_t parent_id, owner_uid, group_gid, vault_id, created_by, last_modified_by;
+    uint64_t inode;
+    uint32_t mode;
+    uint32_t key_version;
+    uint32_t file_count, subdirectory_count;
+    uint64_t size_bytes;
+    int64_t created_at, updated_at;
+    StrRef name, alias, path, fuse_path, backing_path, iv, mime, hash;
+};
+
+static_assert(std::is_trivially_copyable_v<SnapshotHeader> && sizeof(SnapshotHeader) % 8 == 0);
+static_assert(std::is_trivially_copyable_v<SnapshotRecord> && sizeof(SnapshotRecord) % 8 == 0);
+static_assert(sizeof(unsigned int) == sizeof(uint32_t));
+
+class Blob {
+public:
+    StrRef add(const std::string_view s) {
+        const StrRef ref{data_.size(), static_cast<uint32_t>(s.size()), 0};
+        data_.append(s);
+        return ref;
+    }
+
+    [[nodiscard]] const std::string& data() const { return data_; }
+
+private:
+    std::string data_;
+};
+
+template <typename T>
+void setOpt(uint32_t& flags, const Flag flag, T& out, const std::optional<T>& in) {
+    if (!in) return;
+    flags |= flag;
+    out = *in;
+}
+
+template <typename T, typename Stored>
+std::optional<T> getOpt(const uint32_t flags, const Flag flag, const Stored v) {
+    return (flags & flag) ? std::make_optional(static_cast<T>(v)) : std::nullopt;
+}
+
+SnapshotRecord encode(const Entry& e, Blob& blob) {
+    SnapshotRecord r{};
+    r.id = e.id;
+    if (e.isDirectory()) r.flags |= IsDirectory;
+    if (e.is_hidden) r.flags |= IsHidden;
+    if (e.is_system) r.flags |= IsSystem;
+
+    setOpt(r.flags, HasParent, r.parent_id, e.parent_id);
+    setOpt(r.flags, HasOwner, r.owner_uid, e.owner_uid);
+    setOpt(r.flags, HasGroup, r.group_gid, e.group_gid);
+    setOpt(r.flags, HasVault, r.vault_id, e.vault_id);
+    setOpt(r.flags, HasCreatedBy, r.created_by, e.created_by);
+    setOpt(r.flags, HasModifiedBy, r.last_modified_by, e.last_modified_by);
+    if (e.inode) { r.flags |= HasInode; r.inode = *e.inode; }
+    if (e.mode) { r.flags |= HasMode; r.mode = *e.mode; }
+
+    r.size_bytes = e.size_bytes;
+    r.created_at = e.created_at;
+    r.updated_at = e.updated_at;
+
+    r.name = blob.add(e.name);
+    r.alias = blob.add(e.base32_alias);
+    r.path = blob.add(e.path.native());
+    r.fuse_path = blob.add(e.fuse_path.native());
+    r.backing_path = blob.add(e.backing_path.native());
+
+    if (e.isDirectory()) {
+        const auto& d = static_cast<const Directory&>(e);
+        r.file_count = d.file_count;
+        r.subdirectory_count = d.subdirectory_count;
+    } else {
+        const auto& f = static_cast<const File&>(e);
+        r.key_version = f.encrypted_with_key_version;
+        r.iv = blob.add(f.encryption_iv);
+        if (f.mime_type) { r.flags |= HasMime; r.mime = blob.add(*f.mime_type); }
+        if (f.content_hash) { r.flags |= HasHash; r.hash = blob.add(*f.content_hash); }
+    }
+
+    return r;
+}
+
+std::shared_ptr<Entry> decode(const SnapshotRecord& r, const std::string_view blob) {
+    const auto str = [&](const StrRef& ref) -> std::optional<std::string> {
+        if (ref.off > blob.size() || ref.len > blob.size() - ref.off) return std::nullopt;
+        return std::string(blob.substr(ref.off, ref.len));
+    };
+
+    std::shared_ptr<Entry> e;
+    if (r.flags & IsDirectory) {
+        auto d = std::make_shared<Directory>();
+        d->file_count = r.file_count;
+        d->subdirectory_count = r.subdirectory_count;
+        e = std::move(d);
+    } else {
+        auto f = std::make_shared<File>();
+        const auto iv = str(r.iv);
+        if (!iv) return nullptr;
+        f->encryption_iv = *iv;
+        f->encrypted_with_key_version = r.key_version;
+        if (r.flags & HasMime) {
+            if (f->mime_type = str(r.mime); !f->mime_type) return nullptr;
+        }
+        if (r.flags & HasHash) {
+            if (f->content_hash = str(r.hash); !f->content_hash) return nullptr;
+        }
+        e = std::move(f);
+    }
+
+    const auto name = str(r.name), alias = str(r.alias), path = str(r.path),
+               fusePath = str(r.fuse_path), backingPath = str(r.backing_path);
+    if (!name || !alias || !path || !fusePath || !backingPath) return nullptr;
+
+    e->id = r.id;
+    e->name = *name;
+    e->base32_alias = *alias;
+    e->path = *path;
+    e->fuse_path = *fusePath;
+    e->backing_path = *backingPath;
+    e->size_bytes = r.size_bytes;
+    e->is_hidden = r.flags & IsHidden;
+    e->is_system = r.flags & IsSystem;
+    e->created_at = static_cast<std::time_t>(r.created_at);
+    e->updated_at = static_cast<std::time_t>(r.updated_at);
+    e->parent_id = getOpt<int32_t>(r.flags, HasParent, r.parent_id);
+    e->owner_uid = getOpt<int32_t>(r.flags, HasOwner, r.owner_uid);
+    e->group_gid = getOpt<int32_t>(r.flags, HasGroup, r.group_gid);
+    e->vault_id = getOpt<int32_t>(r.flags, HasVault, r.vault_id);
+    e->created_by = getOpt<int32_t>(r.flags, HasCreatedBy, r.created_by);
+    e->last_modified_by = getOpt<int32_t>(r.flags, HasModifiedBy, r.last_modified_by);
+    e->inode = getOpt<ino_t>(r.flags, HasInode, r.inode);
+    e->mode = getOpt<mode_t>(r.flags, HasMode, r.mode);
+    return e;
+}
+
+uint32_t checksum(const uint32_t crc, const void* data, const std::size_t len) {
+    // zlib treats a null buffer as "give me the seed", which an empty vector's data() can be
+    if (!len) return crc;
+    return static_cast<uint32_t>(crc32_z(crc, static_cast<const Bytef*>(data), len));
+}
+
+// Read-only mapping of the whole file, unmapped on scope exit
+class Mapping {
+public:
+    explicit Mapping(const std::filesystem::path& file) {
+        const int fd = ::open(file.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return;
+
+        struct stat st{};
+        if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+            size_ = static_cast<std::size_t>(st.st_size);
+            void* p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                ::madvise(p, size_, MADV_SEQUENTIAL);
+                data_ = static_cast<const char*>(p);
+            }
+        }
+        ::close(fd);
+    }
+
+    ~Mapping() { if (data_) ::munmap(const_cast<char*>(data_), size_); }
+
+    Mapping(const Mapping&) = delete;
+    Mapping& operator=(const Mapping&) = delete;
+
+    [[nodiscard]] const char* data() const { return data_; }
+    [[nodiscard]] std::size_t size() const { return data_ ? size_ : 0; }
+
+private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+}
+
+void Snapshot::write(const std::filesystem::path& file, const Stamp& stamp,
+                     const std::vector<std::shared_ptr<Entry>>& entries,
+                     const std::vector<unsigned int>& loadedDirs) {
+    if (stamp.epoch.empty() || stamp.epoch.size() >= kMaxEpochBytes)
+        throw std::invalid_argument("Cache snapshot epoch must be 1 to " + std::to_string(kMaxEpochBytes - 1) + " bytes");
+
+    Blob blob;
+    std::vector<SnapshotRecord> records;
+    records.reserve(entries.size());
+    for (const auto& e : entries)
+        if (e) records.push_back(encode(*e, blob));
+
+    // Keep the blob 8-byte aligned behind the dir ids
+    std::vector<uint32_t> dirs(loadedDirs.begin(), loadedDirs.end());
+    if (dirs.size() % 2) dirs.push_back(0);
+
+    SnapshotHeader h{};
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version = kVersion;
+    h.record_size = sizeof(SnapshotRecord);
+    std::memcpy(h.epoch, stamp.epoch.data(), stamp.epoch.size());
+    h.generation = stamp.generation;
+    h.record_count = records.size();
+    h.loaded_dir_count = loadedDirs.size();
+    h.blob_size = blob.data().size();
+
+    h.crc = checksum(0, records.data(), records.size() * sizeof(SnapshotRecord));
+    h.crc = checksum(h.crc, dirs.data(), dirs.size() * sizeof(uint32_t));
+    h.crc = checksum(h.crc, blob.data().data(), blob.data().size());
+
+    std::filesystem::create_directories(file.parent_path());
+    auto tmp = file;
+    tmp += ".tmp";
+
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) throw std::runtime_error("Failed to open cache snapshot for writing: " + tmp.string());
+
+        out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        out.write(reinterpret_cast<const char*>(records.data()), static_cast<std::streamsize>(records.size() * sizeof(SnapshotRecord)));
+        out.write(reinterpret_cast<const char*>(dirs.data()), static_cast<std::streamsize>(dirs.size() * sizeof(uint32_t)));
+        out.write(blob.data().data(), static_cast<std::streamsize>(blob.data().size()));
+        out.flush();
+        if (!out) throw std::runtime_error("Failed to write cache snapshot: " + tmp.string());
+    }
+
+    std::filesystem::rename(tmp, file);
+}
+
+std::optional<Snapshot::Contents> Snapshot::read(const std::filesystem::path& file, const Stamp& expected) {
+    const Mapping map(file);
+    if (map.size() < sizeof(SnapshotHeader)) return std::nullopt;
+
+    SnapshotHeader h{};
+    std::memcpy(&h, map.data(), sizeof(h));
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0 || h.version != kVersion ||
+        h.record_size != sizeof(SnapshotRecord)) return std::nullopt;
+
+    const Stamp stamp{ .epoch = std::string(h.epoch, ::strnlen(h.epoch, sizeof(h.epoch))), .generation = h.generation };
+    if (expected.epoch.empty() || stamp != expected) return std::nullopt;
+
+    const std::size_t body = map.size() - sizeof(SnapshotHeader);
+    const auto paddedDirs = h.loaded_dir_count + (h.loaded_dir_count % 2);
+    if (h.record_count > body / sizeof(SnapshotRecord)) return std::nullopt;
+    const std::size_t recordBytes = h.record_count * sizeof(SnapshotRecord);
+    if (paddedDirs > (body - recordBytes) / sizeof(uint32_t)) return std::nullopt;
+    const std::size_t dirBytes = paddedDirs * sizeof(uint32_t);
+    if (h.blob_size != body - recordBytes - dirBytes) return std::nullopt;
+
+    const char* recordsAt = map.data() + sizeof(SnapshotHeader);
+    const char* dirsAt = recordsAt + recordBytes;
+    const std::string_view blob(dirsAt + dirBytes, h.blob_size);
+
+    if (checksum(0, recordsAt, body) != h.crc) return std::nullopt;
+
+    Contents out;
+    out.stamp = stamp;
+    out.entries.reserve(h.record_count);
+    for (std::size_t i = 0; i < h.record_count; ++i) {
+        SnapshotRecord r{};
+        std::memcpy(&r, recordsAt + i * sizeof(SnapshotRecord), sizeof(SnapshotRecord));
+        auto e = decode(r, blob);
+        if (!e) return std::nullopt;
+        out.entries.push_back(std::move(e));
+    }
+
+    out.loadedDirs.resize(h.loaded_dir_count);
+    std::memcpy(out.loadedDirs.data(), dirsAt, h.loaded_dir_count * sizeof(uint32_t));
+    return out;
+}
+
+}
@@ -6,6 +6,11 @@
 #include "runtime/Deps.hpp"
 #include "log/Registry.hpp"
 #include "fs/cache/Registry.hpp"
+#include "fs/metadata/Magic.hpp"
+#include "vault/EncryptionManager.hpp"
+#include "crypto/util/encrypt.hpp"
+#include "crypto/util/hash.hpp"
+#include "stats/Trace.hpp"
 
 #include <fstream>
 #include <filesystem>
@@ -21,6 +26,7 @@ using namespace vh::fs::model;
 namespace vh::fs::ops {
 
 std::vector<uint8_t> readFileToVector(const std::filesystem::path& path) {
+    const stats::trace::Span span("disk.read", path.native());
     std::ifstream in(path, std::ios::binary | std::ios::ate);
     if (!in) throw std::runtime_error("Failed to open file: " + path.string());
 
@@ -51,12 +57,54 @@ std::string readFileToString(const std::filesystem::path& path) {
 }
 
 void writeFile(const std::filesystem::path& absPath, const std::vector<uint8_t>& ciphertext) {
+    const stats::trace::Span span("disk.write", absPath.native());
     std::ofstream out(absPath, std::ios::binary | std::ios::trunc);
     if (!out) throw std::runtime_error("Failed to write encrypted file: " + absPath.string());
     out.write(reinterpret_cast<const char*>(ciphertext.data()), static_cast<long>(ciphertext.size()));
     out.close();
 }
 
+IngestResult encryptAndWrite(const std::span<const uint8_t> plaintext,
+                             const std::filesystem::path& absPath,
+                             const vault::EncryptionManager& encryptionManager,
+                             const std::shared_ptr<File>& f) {
+    static constexpr size_t CHUNK_SIZE = 1024 * 1024;
+
+    if (plaintext.empty()) throw std::invalid_argument("Cannot ingest empty buffer: " + absPath.string());
+
+    // Encryption and the disk write are interleaved chunk by chunk, so they share one span
+    const stats::trace::Span span("disk.encrypt_write", absPath.native());
+
+    IngestResult res;
+    res.size_bytes = plaintext.size();
+    res.mime_type = metadata::Magic::get_mime_type_from_buffer(plaintext, f->name);
+
+    std::ofstream out(absPath, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("Failed to write encrypted file: " + absPath.string());
+
+    const auto encryptor = encryptionManager.encryptor(f);
+    crypto::hash::Blake2b hasher;
+    std::vector<uint8_t> chunk(std::min(plaintext.size(), CHUNK_SIZE));
+
+    for (size_t off = 0; off < plaintext.size(); off += CHUNK_SIZE) {
+        const auto in = plaintext.subspan(off, std::min(CHUNK_SIZE, plaintext.size() - off));
+        const std::span<uint8_t> ct(chunk.data(), in.size());
+        encryptor->update(in, ct);
+        hasher.update(ct);
+        out.write(reinterpret_cast<const char*>(ct.data()), static_cast<long>(ct.size()));
+    }
+
+    const auto tag = encryptor->finish();
+    hasher.update(tag);
+    out.write(reinterpret_cast<const char*>(tag.data()), static_cast<long>(tag.size()));
+
+    out.close();
+    if (!out) throw std::runtime_error("Failed to write encrypted file: " + absPath.string());
+
+    res.content_hash = hasher.finalHex();
+    return res;
+}
+
 std::filesystem::path writePlaintextToTemp(const std::vector<uint8_t>& plaintext) {
     namespace fs = std::filesystem;
 
@@ -104,17 +152,20 @@ std::filesystem::path decrypt_file_to_temp(const unsigned int /*vault_id*/,
 
 std::filesystem::path decrypt_file_to_temp(const std::shared_ptr<File>& file,
                                            const std::shared_ptr<storage::Engine>& engine) {
+    return writePlaintextToTemp(decrypt_file_to_buffer(file, engine));
+}
+
+std::vector<uint8_t> decrypt_file_to_buffer(const std::shared_ptr<File>& file,
+                                            const std::shared_ptr<storage::Engine>& engine) {
     if (!file) throw std::invalid_argument("Cannot decrypt a null file");
     if (!engine) throw std::invalid_argument("Cannot decrypt file without storage engine");
 
-    std::vector<uint8_t> plaintext;
     try {
-        plaintext = engine->decrypt(file);
+        return engine->decrypt(file);
     } catch (...) {
         if (!file->encryption_iv.empty()) throw;
-        plaintext = readFileToVector(file->backing_path);
+        return readFileToVector(file->backing_path);
     }
-    return writePlaintextToTemp(plaintext);
 }
 
 bool isProbablyEncrypted(const std::filesystem::path& path) {
@@ -1,25 +1,124 @@
 #include "fs/metadata/Magic.hpp"
 #include <stdexcept>
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstring>
 #include <magic.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 using namespace vh::fs::metadata;
 
+namespace {
+
+constexpr auto MAGIC_DB_PATH = "/usr/share/misc/magic.mgc";
+
+// Read-only mapping of the compiled magic database, shared by every thread's cookie.
+struct Database {
+    void* data = MAP_FAILED;
+    size_t size = 0;
+
+    Database() {
+        const int fd = ::open(MAGIC_DB_PATH, O_RDONLY | O_CLOEXEC);
+        if (fd < 0) throw std::runtime_error(std::string("Failed to open magic database: ") + std::strerror(errno));
+
+        struct stat st{};
+        if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+            size = static_cast<size_t>(st.st_size);
+            data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        ::close(fd);
+
+        if (data == MAP_FAILED) throw std::runtime_error("Failed to map magic database");
+    }
+
+    ~Database() {
+        if (data != MAP_FAILED) ::munmap(data, size);
+    }
+
+    static Database& get() {
+        static Database db;
+        return db;
+    }
+};
+
+struct Signature {
+    size_t offset;
+    std::string_view bytes;
+    std::string_view mime;
+};
+
+constexpr std::array<Signature, 5> SIGNATURES{{
+    {0, "\xFF\xD8\xFF", "image/jpeg"},
+    {0, "\x89PNG\r\n\x1A\n", "image/png"},
+    {0, "GIF87a", "image/gif"},
+    {0, "GIF89a", "image/gif"},
+    {0, "%PDF-", "application/pdf"},
+}};
+
+constexpr Signature RIFF{0, "RIFF", ""}, WEBP{8, "WEBP", "image/webp"};
+
+struct TextExtension {
+    std::string_view ext;
+    std::string_view mime;
+};
+
+// Extensions whose content libmagic reports as these types once it is known to be text
+constexpr std::array<TextExtension, 5> TEXT_EXTENSIONS{{
+    {".txt", "text/plain"},
+    {".log", "text/plain"},
+    {".md", "text/plain"},
+    {".csv", "text/csv"},
+    {".ini", "text/plain"},
+}};
+
+bool matches(const std::span<const uint8_t> head, const Signature& sig) {
+    if (head.size() < sig.offset + sig.bytes.size()) return false;
+    return std::memcmp(head.data() + sig.offset, sig.bytes.data(), sig.bytes.size()) == 0;
+}
+
+bool looksLikeText(const std::span<const uint8_t> head) {
+    return std::ranges::none_of(head, [](const uint8_t c) {
+        return c < 0x20 && c != '\t' && c != '\n' && c != '\r' && c != '\f' && c != 0x1B;
+    });
+}
+
+}
+
 Magic::Magic() {
     cookie = magic_open(MAGIC_MIME_TYPE);
     if (!cookie) throw std::runtime_error("Failed to create magic cookie");
 
-    // Let libmagic find its own database unless overridden
-    if (magic_load(cookie, "/usr/share/misc/magic.mgc") != 0) {
+    auto& db = Database::get();
+    void* buffers[] = { db.data };
+    size_t sizes[] = { db.size };
+
+    if (magic_load_buffers(cookie, buffers, sizes, 1) != 0) {
         std::string err = magic_error(cookie) ? magic_error(cookie) : "Unknown error";
         magic_close(cookie);
         throw std::runtime_error("Failed to load magic database: " + err);
     }
+
+    // libmagic's own default is larger; pin it so magic_file and magic_buffer agree with SNIFF_BYTES
+    constexpr size_t bytesMax = SNIFF_BYTES;
+    if (magic_setparam(cookie, MAGIC_PARAM_BYTES_MAX, &bytesMax) != 0) {
+        magic_close(cookie);
+        throw std::runtime_error("Failed to set magic bytes_max");
+    }
 }
 
 Magic::~Magic() {
     if (cookie) magic_close(cookie);
 }
 
+Magic& Magic::local() {
+    thread_local Magic instance;
+    return instance;
+}
+
 std::string Magic::mime_type(const std::string& path) const {
     if (path.empty()) throw std::invalid_argument("Cannot detect MIME type of empty path");
 
@@ -42,20 +141,50 @@ std::string Magic::mime_type_buffer(const std::string& buffer) const {
     return {result};
 }
 
+std::string Magic::mime_type_buffer(const std::span<const uint8_t> buffer) const {
+    if (buffer.empty()) throw std::invalid_argument("Cannot detect MIME type from empty buffer");
+
+    const auto head = buffer.first(std::min(buffer.size(), SNIFF_BYTES));
+    const char* result = magic_buffer(cookie, head.data(), head.size());
+    if (!result) {
+        std::string err = magic_error(cookie) ? magic_error(cookie) : "Unknown error";
+        throw std::runtime_error("magic_buffer failed: " + err);
+    }
+    return {result};
+}
+
+std::optional<std::string_view> Magic::sniff(const std::span<const uint8_t> head, const std::filesystem::path& nameHint) {
+    for (const auto& sig : SIGNATURES)
+        if (matches(head, sig)) return sig.mime;
+
+    if (matches(head, RIFF) && matches(head, WEBP)) return WEBP.mime;
+
+    if (nameHint.has_extension()) {
+        auto ext = nameHint.extension().string();
+        std::ranges::transform(ext, ext.begin(), [](const unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        const auto it = std::ranges::find(TEXT_EXTENSIONS, ext, &TextExtension::ext);
+        if (it != TEXT_EXTENSIONS.end() && looksLikeText(head.first(std::min<size_t>(head.size(), 4096))))
+            return it->mime;
+    }
+
+    return std::nullopt;
+}
+
 // Static interface
 std::string Magic::get_mime_type(const std::string& path) {
-    static Magic instance;
-    return instance.mime_type(path);
+    return local().mime_type(path);
 }
 
 std::string Magic::get_mime_type_from_buffer(const std::string& buffer) {
-    static Magic instance;
-    return instance.mime_type_buffer(buffer);
+    return get_mime_type_from_buffer(std::span(reinterpret_cast<const uint8_t*>(buffer.data()), buffer.size()));
 }
 
 std::string Magic::get_mime_type_from_buffer(const std::vector<uint8_t>& buffer) {
-    if (buffer.empty()) throw std::invalid_argument("Cannot detect MIME type from empty buffer");
+    return get_mime_type_from_buffer(std::span<const uint8_t>(buffer));
+}
 
-    static Magic instance;
-    return instance.mime_type_buffer(std::string(buffer.begin(), buffer.end()));
+std::string Magic::get_mime_type_from_buffer(const std::span<const uint8_t> buffer, const std::filesystem::path& nameHint) {
+    if (buffer.empty()) throw std::invalid_argument("Cannot detect MIME type from empty buffer");
+    if (const auto mime = sniff(buffer, nameHint)) return std::string(*mime);
+    return local().mime_type_buffer(buffer);
 }
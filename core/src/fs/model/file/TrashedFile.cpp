@@ -26,3 +26,17 @@ std::vector<std::shared_ptr<Trashed>> vh::fs::model::file::trashed_files_from_pq
     for (const auto& row : res) files.emplace_back(std::make_shared<Trashed>(row));
     return files;
 }
+
+TrashedSubtree::TrashedSubtree(const pqxx::result& res) {
+    file_aliases.reserve(res.size());
+
+    for (const auto& row : res) {
+        const auto kind = row["kind"].as<std::string>();
+        if (kind == "file") {
+            file_aliases.emplace_back(row["ref"].as<std::string>());
+            size_bytes += row["size_bytes"].as<uint64_t>();
+            ++file_count;
+        } else if (kind == "dir") ++dir_count;
+        else if (kind == "cache") cache_paths.emplace_back(row["ref"].as<std::string>());
+    }
+}
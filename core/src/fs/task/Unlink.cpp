@@ -0,0 +1,53 @@
+#include "fs/task/Unlink.hpp"
+#include "concurrency/ThreadPool.hpp"
+#include "concurrency/ThreadPoolManager.hpp"
+#include "log/Registry.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <system_error>
+
+using namespace vh::fs::task;
+using namespace vh::concurrency;
+
+Unlink::Unlink(std::vector<std::filesystem::path> paths)
+    : paths_(std::move(paths)) {}
+
+void Unlink::operator()() {
+    std::size_t failed = 0;
+
+    for (const auto& path : paths_) {
+        std::error_code ec;
+        std::filesystem::remove_all(path, ec);
+        if (ec) {
+            ++failed;
+            log::Registry::fs()->debug("[Unlink] Failed to remove {}: {}", path.string(), ec.message());
+        }
+    }
+
+    if (failed > 0)
+        log::Registry::fs()->warn("[Unlink] {} of {} paths could not be removed", failed, paths_.size());
+    else
+        log::Registry::fs()->debug("[Unlink] Removed {} paths", paths_.size());
+}
+
+void Unlink::enqueue(std::vector<std::filesystem::path> paths) {
+    if (paths.empty()) return;
+
+    try {
+        const auto& pool = ThreadPoolManager::instance().syncPool();
+        if (!pool) {
+            Unlink(std::move(paths))();
+            return;
+        }
+
+        for (auto it = paths.begin(); it != paths.end();) {
+            const auto n = std::min<std::size_t>(BATCH_SIZE, std::distance(it, paths.end()));
+            const auto end = std::next(it, static_cast<std::ptrdiff_t>(n));
+            pool->submit(std::make_shared<Unlink>(std::vector(std::make_move_iterator(it), std::make_move_iterator(end))));
+            it = end;
+        }
+    } catch (const std::exception& e) {
+        log::Registry::fs()->error("[Unlink] Failed to enqueue unlink batch: {}", e.what());
+    }
+}
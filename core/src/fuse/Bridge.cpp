@@ -11,7 +11,10 @@
 #include "log/Registry.hpp"
 #include "fs/cache/Registry.hpp"
 #include "fuse/Resolver.hpp"
+#include "stats/Metrics.hpp"
+#include "stats/Trace.hpp"
 
+#include <algorithm>
 #include <cerrno>
 #include <cstring>
 #include <sys/statvfs.h>
@@ -26,6 +29,13 @@ using namespace vh::rbac;
 
 namespace vh::fuse {
 
+namespace {
+
+// How long the kernel keeps a dentry from lookup() before asking again
+constexpr double kLookupEntryTimeout = 0.1;
+
+}
+
 void getattr(const fuse_req_t req, const fuse_ino_t ino, fuse_file_info* fi) {
     log::Registry::fuse()->debug("[getattr] Called for inode: {}", ino);
     (void)fi;
@@ -44,7 +54,7 @@ void getattr(const fuse_req_t req, const fuse_ino_t ino, fuse_file_info* fi) {
     }
 
     const auto st = statFromEntry(resolved.entry, ino);
-    fuse_reply_attr(req, &st, 0.1); // match attr_timeout from lookup()
+    fuse_reply_attr(req, &st, kLookupEntryTimeout); // match attr_timeout from lookup()
 }
 
 void setattr(const fuse_req_t req, const fuse_ino_t ino,
@@ -168,14 +178,27 @@ void lookup(const fuse_req_t req, const fuse_ino_t parent, const char* name) {
     });
 
     if (!resolved.ok()) {
+        // Reply with a negative entry so the kernel answers repeat probes itself until it expires.
+        // Creates and renames from the web or sync paths never invalidate kernel dentries, so this
+        // is capped at the positive timeout to keep new files from staying hidden any longer.
+        if (resolved.status == resolver::Status::MissingEntry) {
+            if (const auto timeout = runtime::Deps::get().fsCache->negativeEntryTimeout(); timeout > 0) {
+                fuse_entry_param e{};
+                e.ino = 0;
+                e.entry_timeout = std::min(timeout, kLookupEntryTimeout);
+                fuse_reply_entry(req, &e);
+                return;
+            }
+        }
+
         fuse_reply_err(req, resolved.errnum);
         return;
     }
 
     fuse_entry_param e{};
     e.ino = *resolved.ino;
-    e.attr_timeout = 0.1;
-    e.entry_timeout = 0.1;
+    e.attr_timeout = kLookupEntryTimeout;
+    e.entry_timeout = kLookupEntryTimeout;
     e.attr = statFromEntry(resolved.entry, *resolved.ino);
 
     fuse_reply_entry(req, &e);
@@ -585,26 +608,54 @@ void statfs(const fuse_req_t req, const fuse_ino_t ino) {
     fuse_reply_statfs(req, &st);
 }
 
+namespace {
+
+// Every op replies before it returns, so timing the call covers the whole request. Each op is
+// also the root span of a trace that resolve, RBAC, DB, crypto and disk spans nest under.
+template<auto Op>
+struct Timed;
+
+template<typename... Args, void (*Op)(Args...)>
+struct Timed<Op> {
+    static inline stats::model::Histogram* latency = nullptr;
+    static inline std::string spanName;
+
+    static void call(Args... args) {
+        const stats::trace::Span span(spanName.c_str());
+        const stats::ScopedTimer timer(*latency);
+        Op(args...);
+    }
+};
+
+template<auto Op>
+auto timed(const std::string_view name) {
+    Timed<Op>::spanName = "fuse." + std::string(name);
+    Timed<Op>::latency = &stats::Metrics::instance().histogram(stats::Metric::FuseOp, name);
+    return &Timed<Op>::call;
+}
+
+}
+
 fuse_lowlevel_ops getOperations() {
     fuse_lowlevel_ops ops = {};
-    ops.getattr = getattr;
-    ops.setattr = setattr;
-    ops.readdir = readdir;
-    ops.lookup = lookup;
-    ops.open = open;
-    ops.read = read;
-    ops.forget = forget;
-    ops.write = write;
-    ops.create = create;
-    ops.release = release;
-    ops.access = access;
-    ops.mkdir = mkdir;
-    ops.rename = rename;
-    ops.unlink = unlink;
-    ops.rmdir = rmdir;
-    ops.flush = flush;
-    ops.fsync = fsync;
-    ops.statfs = statfs;
+    ops.getattr = timed<getattr>("getattr");
+    ops.setattr = timed<setattr>("setattr");
+    ops.readdir = timed<readdir>("readdir");
+    ops.lookup = timed<lookup>("lookup");
+    ops.open = timed<open>("open");
+    ops.read = timed<read>("read");
+    ops.forget = timed<forget>("forget");
+    ops.write = timed<write>("write");
+    ops.create = timed<create>("create");
+    ops.release = timed<release>("release");
+    ops.access = timed<access>("access");
+    ops.mkdir = timed<mkdir>("mkdir");
+    ops.rename = timed<rename>("rename");
+    ops.unlink = timed<unlink>("unlink");
+    ops.rmdir = timed<rmdir>("rmdir");
+    ops.flush = timed<flush>("flush");
+    ops.fsync = timed<fsync>("fsync");
+    ops.statfs = timed<statfs>("statfs");
     return ops;
 }
 
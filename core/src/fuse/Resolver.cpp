@@ -3,11 +3,13 @@
 #include "db/query/identities/Group.hpp"
 #include "runtime/Deps.hpp"
 #include "log/Registry.hpp"
+#include "log/Lazy.hpp"
 #include "fs/cache/Registry.hpp"
 #include "fs/model/Entry.hpp"
 #include "storage/Manager.hpp"
 #include "rbac/resolver/vault/all.hpp"
 #include "fs/model/Path.hpp"
+#include "stats/Trace.hpp"
 
 namespace vh::fuse {
     using resolver::Request;
@@ -35,6 +37,7 @@ namespace vh::fuse {
     }
 
     Resolved Resolver::resolve(const Request& req) {
+        const stats::trace::Span span("fuse.resolve");
         Resolved res;
 
         if (!req.fuseReq) {
@@ -53,8 +56,8 @@ namespace vh::fuse {
             log::Registry::fuse()->debug(
                 "[{}] Attempting to resolve inode from entry or path: entry: {}, path: {}",
                 req.caller,
-                std::string(entryName(res.entry)),
-                res.path && !res.path->empty() ? res.path->string() : "null"
+                log::lazy([&] { return std::string(entryName(res.entry)); }),
+                log::lazy([&] { return res.path && !res.path->empty() ? res.path->string() : "null"; })
             );
 
             if (res.path)
@@ -100,7 +103,7 @@ namespace vh::fuse {
             if (out.entry) {
                 log::Registry::fuse()->debug(
                     "[{}] Resolved entry from inode {}: {}",
-                    req.caller, *req.ino, out.entry->path.string()
+                    req.caller, *req.ino, log::lazy([&] { return out.entry->path.string(); })
                 );
                 return true;
             }
@@ -123,7 +126,7 @@ namespace vh::fuse {
 
                 log::Registry::fuse()->debug(
                     "[{}] Resolved path from parent/child: {}",
-                    req.caller, out.path->string()
+                    req.caller, log::lazy([&] { return out.path->string(); })
                 );
                 return true;
             } catch (const std::exception& e) {
@@ -138,7 +141,7 @@ namespace vh::fuse {
             out.path = out.entry->path;
             log::Registry::fuse()->debug(
                 "[{}] Resolved path from entry: {}",
-                req.caller, out.path->string()
+                req.caller, log::lazy([&] { return out.path->string(); })
             );
             return true;
         }
@@ -150,7 +153,7 @@ namespace vh::fuse {
 
                 log::Registry::fuse()->debug(
                     "[{}] Resolved path from inode {} via entry: {}",
-                    req.caller, *req.ino, out.path->string()
+                    req.caller, *req.ino, log::lazy([&] { return out.path->string(); })
                 );
                 return true;
             }
@@ -171,9 +174,9 @@ namespace vh::fuse {
         log::Registry::fuse()->debug(
             "[{}] Resolving entry for path: {}, parent inode: {}, child name: {}",
             req.caller,
-            out.path ? out.path->string() : "null",
-            req.parentIno ? std::to_string(*req.parentIno) : "null",
-            req.childName ? *req.childName : "null"
+            log::lazy([&] { return out.path ? out.path->string() : "null"; }),
+            log::lazy([&] { return req.parentIno ? std::to_string(*req.parentIno) : "null"; }),
+            log::lazy([&] { return req.childName ? *req.childName : "null"; })
         );
 
         if (!out.path) {
@@ -225,6 +228,7 @@ namespace vh::fuse {
     }
 
     bool Resolver::enforcePermissions(const Request& req, Resolved& out) {
+        const stats::trace::Span span("rbac.check");
         const bool checkEntry = needsEntry(req);
         const bool checkPath = needsPath(req);
 
@@ -0,0 +1,305 @@
+#include "log/Compressor.hpp"
+
+#include <zlib.h>
+#include <zstd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#ifdef __linux__
+  #include <sys/resource.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
+using namespace vh::log;
+
+namespace {
+
+struct FileCloser { void operator()(std::FILE* f) const { if (f) std::fclose(f); } };
+using File = std::unique_ptr<std::FILE, FileCloser>;
+
+struct CCtxFree { void operator()(ZSTD_CCtx* c) const { ZSTD_freeCCtx(c); } };
+struct DCtxFree { void operator()(ZSTD_DCtx* d) const { ZSTD_freeDCtx(d); } };
+
+// Paces reads to max_bytes_per_sec by sleeping off whatever the chunk finished early
+class Throttle {
+public:
+    explicit Throttle(const std::uint64_t bytesPerSec) : rate_(bytesPerSec) {}
+
+    void consumed(const std::size_t n) {
+        if (!rate_) return;
+        total_ += n;
+        const auto due = start_ + std::chrono::microseconds(total_ * 1'000'000 / rate_);
+        std::this_thread::sleep_until(due);
+    }
+
+private:
+    std::uint64_t rate_;
+    std::uint64_t total_ = 0;
+    std::chrono::steady_clock::time_point start_ = std::chrono::steady_clock::now();
+};
+
+bool writeAll(std::FILE* out, const void* data, const std::size_t n) {
+    return n == 0 || std::fwrite(data, 1, n, out) == n;
+}
+
+// Reads the next chunk; false on I/O error. last is set once the source is exhausted.
+bool readChunk(std::FILE* in, std::vector<unsigned char>& buf, std::size_t& n, bool& last) {
+    n = std::fread(buf.data(), 1, buf.size(), in);
+    if (n < buf.size()) {
+        if (std::ferror(in)) return false;
+        last = true;
+    }
+    return true;
+}
+
+std::uint32_t crc(const std::uint32_t seed, const unsigned char* data, const std::size_t n) {
+    return static_cast<std::uint32_t>(::crc32(seed, data, static_cast<uInt>(n)));
+}
+
+void lowerOwnPriority() {
+#ifdef __linux__
+    // Nice values and I/O priorities are per thread on Linux; only this worker is demoted
+    ::setpriority(PRIO_PROCESS, static_cast<id_t>(::syscall(SYS_gettid)), 19);
+  #ifdef SYS_ioprio_set
+    constexpr int IOPRIO_WHO_PROCESS = 1, IOPRIO_CLASS_IDLE = 3, IOPRIO_CLASS_SHIFT = 13;
+    ::syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0, IOPRIO_CLASS_IDLE << IOPRIO_CLASS_SHIFT);
+  #endif
+#endif
+}
+
+}
+
+Compressor::Compressor(Options opts) : opts_(std::move(opts)) {
+    if (opts_.buffer_bytes < 4_KiB) opts_.buffer_bytes = 4_KiB;
+    worker_ = std::thread([this] { run(); });
+}
+
+Compressor::~Compressor() {
+    {
+        std::scoped_lock lk(m_);
+        stopping_ = true;
+        queue_.clear();
+        pending_.clear();
+    }
+    cv_.notify_all();
+    if (worker_.joinable()) worker_.join();
+}
+
+std::string_view Compressor::extension(const Compression c) {
+    switch (c) {
+        case Compression::Gzip: return ".gz";
+        case Compression::Zstd: return ".zst";
+        case Compression::None: break;
+    }
+    return "";
+}
+
+void Compressor::enqueue(const std::filesystem::path& src) {
+    {
+        std::scoped_lock lk(m_);
+        if (stopping_ || !pending_.insert(src).second) return;
+        queue_.push_back(src);
+    }
+    cv_.notify_one();
+}
+
+void Compressor::drain() {
+    std::unique_lock lk(m_);
+    idle_.wait(lk, [this] { return stopping_ || (queue_.empty() && !busy_); });
+}
+
+void Compressor::run() {
+    if (opts_.low_priority) lowerOwnPriority();
+
+    std::unique_lock lk(m_);
+    while (true) {
+        cv_.wait(lk, [this] { return stopping_ || !queue_.empty(); });
+        if (stopping_) break;
+
+        const auto src = std::move(queue_.front());
+        queue_.pop_front();
+        busy_ = true;
+
+        lk.unlock();
+        compress(src);
+        lk.lock();
+
+        pending_.erase(src);
+        busy_ = false;
+        if (queue_.empty()) idle_.notify_all();
+    }
+    busy_ = false;
+    idle_.notify_all();
+}
+
+bool Compressor::compress(const std::filesystem::path& src) const {
+    const auto ext = extension(opts_.compression);
+    if (ext.empty()) return false;
+
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(src, ec)) return false;
+
+    auto dst = src;
+    dst += ext;
+    auto tmp = dst;
+    tmp += ".part";
+
+    const auto fail = [&](const std::string& why) {
+        std::filesystem::remove(tmp, ec);
+        diag("compress: " + src.filename().string() + ": " + why + ", keeping original");
+        return false;
+    };
+
+    std::uint32_t srcCrc = 0, outCrc = 0;
+    std::uint64_t srcBytes = 0, outBytes = 0;
+    {
+        const File in(std::fopen(src.c_str(), "rb"));
+        if (!in) return fail("open failed");
+        const File out(std::fopen(tmp.c_str(), "wb"));
+        if (!out) return fail("cannot create " + tmp.filename().string());
+
+        if (!encode(in.get(), out.get(), srcCrc, srcBytes)) return fail(stopping_ ? "interrupted" : "encode failed");
+        if (std::fflush(out.get()) != 0) return fail("write failed");
+#ifdef __linux__
+        if (::fsync(::fileno(out.get())) != 0) return fail("fsync failed");
+#endif
+    }
+
+    // Decode what actually landed on disk before the original is allowed to go
+    {
+        const File check(std::fopen(tmp.c_str(), "rb"));
+        if (!check || !verify(check.get(), outCrc, outBytes)) return fail("verification failed");
+    }
+    if (outCrc != srcCrc || outBytes != srcBytes) return fail("checksum mismatch");
+
+    std::filesystem::rename(tmp, dst, ec);
+    if (ec) return fail("rename failed: " + ec.message());
+    std::filesystem::remove(src, ec);
+
+    diag("compress: " + src.filename().string() + " -> " + dst.filename().string()
+         + " (" + std::to_string(srcBytes) + "B -> " + std::to_string(std::filesystem::file_size(dst, ec)) + "B)");
+    return true;
+}
+
+bool Compressor::encode(std::FILE* in, std::FILE* out, std::uint32_t& crcOut, std::uint64_t& bytes) const {
+    std::vector<unsigned char> ibuf(opts_.buffer_bytes), obuf(opts_.buffer_bytes);
+    Throttle throttle(opts_.max_bytes_per_sec);
+    std::uint32_t sum = crc(0, nullptr, 0);
+    std::size_t n = 0;
+    bool last = false;
+
+    if (opts_.compression == Compression::Zstd) {
+        const std::unique_ptr<ZSTD_CCtx, CCtxFree> cctx(ZSTD_createCCtx());
+        if (!cctx) return false;
+        ZSTD_CCtx_setParameter(cctx.get(), ZSTD_c_compressionLevel, opts_.level ? opts_.level : ZSTD_CLEVEL_DEFAULT);
+        ZSTD_CCtx_setParameter(cctx.get(), ZSTD_c_checksumFlag, 1);
+
+        while (!last) {
+            if (stopping_ || !readChunk(in, ibuf, n, last)) return false;
+            sum = crc(sum, ibuf.data(), n);
+            bytes += n;
+
+            ZSTD_inBuffer input{ibuf.data(), n, 0};
+            const auto mode = last ? ZSTD_e_end : ZSTD_e_continue;
+            std::size_t remaining;
+            do {
+                ZSTD_outBuffer output{obuf.data(), obuf.size(), 0};
+                remaining = ZSTD_compressStream2(cctx.get(), &output, &input, mode);
+                if (ZSTD_isError(remaining) || !writeAll(out, obuf.data(), output.pos)) return false;
+            } while (last ? remaining != 0 : input.pos < input.size);
+
+            throttle.consumed(n);
+        }
+    } else {
+        z_stream zs{};
+        const int level = opts_.level ? opts_.level : Z_DEFAULT_COMPRESSION;
+        // windowBits 15 + 16: emit a gzip header/trailer rather than raw zlib
+        if (deflateInit2(&zs, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) return false;
+        const std::unique_ptr<z_stream, decltype(&deflateEnd)> guard(&zs, &deflateEnd);
+
+        while (!last) {
+            if (stopping_ || !readChunk(in, ibuf, n, last)) return false;
+            sum = crc(sum, ibuf.data(), n);
+            bytes += n;
+
+            zs.next_in = ibuf.data();
+            zs.avail_in = static_cast<uInt>(n);
+            const int flush = last ? Z_FINISH : Z_NO_FLUSH;
+            int rc;
+            do {
+                zs.next_out = obuf.data();
+                zs.avail_out = static_cast<uInt>(obuf.size());
+                rc = deflate(&zs, flush);
+                if (rc == Z_STREAM_ERROR) return false;
+                if (!writeAll(out, obuf.data(), obuf.size() - zs.avail_out)) return false;
+            } while (zs.avail_out == 0);
+
+            if (last && rc != Z_STREAM_END) return false;
+            throttle.consumed(n);
+        }
+    }
+
+    crcOut = sum;
+    return true;
+}
+
+bool Compressor::verify(std::FILE* in, std::uint32_t& crcOut, std::uint64_t& bytes) const {
+    std::vector<unsigned char> ibuf(opts_.buffer_bytes), obuf(opts_.buffer_bytes);
+    std::uint32_t sum = crc(0, nullptr, 0);
+    std::size_t n = 0;
+    bool last = false;
+
+    if (opts_.compression == Compression::Zstd) {
+        const std::unique_ptr<ZSTD_DCtx, DCtxFree> dctx(ZSTD_createDCtx());
+        if (!dctx) return false;
+
+        // The frame carries its own content checksum, which libzstd checks at the end of the frame
+        std::size_t rc = 1;
+        while (!last) {
+            if (!readChunk(in, ibuf, n, last)) return false;
+            ZSTD_inBuffer input{ibuf.data(), n, 0};
+            while (input.pos < input.size) {
+                ZSTD_outBuffer output{obuf.data(), obuf.size(), 0};
+                rc = ZSTD_decompressStream(dctx.get(), &output, &input);
+                if (ZSTD_isError(rc)) return false;
+                sum = crc(sum, obuf.data(), output.pos);
+                bytes += output.pos;
+            }
+        }
+        if (rc != 0) return false; // truncated frame
+    } else {
+        z_stream zs{};
+        if (inflateInit2(&zs, 15 + 16) != Z_OK) return false;
+        const std::unique_ptr<z_stream, decltype(&inflateEnd)> guard(&zs, &inflateEnd);
+
+        int rc = Z_OK;
+        while (!last && rc != Z_STREAM_END) {
+            if (!readChunk(in, ibuf, n, last)) return false;
+            zs.next_in = ibuf.data();
+            zs.avail_in = static_cast<uInt>(n);
+            do {
+                zs.next_out = obuf.data();
+                zs.avail_out = static_cast<uInt>(obuf.size());
+                rc = inflate(&zs, Z_NO_FLUSH);
+                if (rc == Z_NEED_DICT || rc == Z_DATA_ERROR || rc == Z_MEM_ERROR || rc == Z_STREAM_ERROR) return false;
+                const auto produced = obuf.size() - zs.avail_out;
+                sum = crc(sum, obuf.data(), produced);
+                bytes += produced;
+            } while (zs.avail_out == 0 && rc != Z_STREAM_END);
+        }
+        if (rc != Z_STREAM_END) return false;
+    }
+
+    crcOut = sum;
+    return true;
+}
+
+void Compressor::diag(const std::string_view msg) const {
+    if (opts_.diag_log) opts_.diag_log(msg);
+}
@@ -1,10 +1,12 @@
 #include "log/Registry.hpp"
 #include "config/Registry.hpp"
 
+#include <spdlog/async.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/sinks/rotating_file_sink.h>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <paths.h>
+#include <algorithm>
 #include <filesystem>
 
 namespace vh::log {
@@ -31,116 +33,117 @@ void Registry::init() {
     console_sink_->set_pattern(CONSOLE_LOG_FORMAT);
 
     // main file sink (rotating)
-    main_file_sink_ = std::make_shared<spdlog::sinks::rotating_file_sink_mt>(
+    const auto mainFile = std::make_shared<spdlog::sinks::rotating_file_sink_mt>(
         main_log_path_.string(), main_max_bytes_, main_max_files_);
-    main_file_sink_->set_level(cnf.levels.file_log_level);
-    main_file_sink_->set_pattern(FILE_LOG_FORMAT);
-
-    auto makeLogger = [&](const std::string& name,
+    mainFile->set_level(cnf.levels.file_log_level);
+    mainFile->set_pattern(FILE_LOG_FORMAT);
+    main_sink_ = std::make_shared<spdlog::sinks::dist_sink_mt>(std::vector<spdlog::sink_ptr>{mainFile});
+
+    // Subsystem loggers hand records to a bounded queue drained by the pool's writer thread(s),
+    // so FUSE and WebSocket threads never wait on console or file I/O
+    const auto& async = cnf.async;
+    const auto overflow = async.overflow_policy == "block"
+                              ? spdlog::async_overflow_policy::block
+                              : spdlog::async_overflow_policy::overrun_oldest;
+    if (async.enabled)
+        spdlog::init_thread_pool(std::max<size_t>(async.queue_size, 1), std::max(async.threads, 1u));
+
+    auto makeLogger = [&](const Subsystem subsystem,
                           const spdlog::level::level_enum lvl = spdlog::level::debug) {
-        const auto logger = std::make_shared<spdlog::logger>(
-            name, spdlog::sinks_init_list{console_sink_, main_file_sink_});
+        const std::string name = NAMES[static_cast<size_t>(subsystem)];
+        const spdlog::sinks_init_list sinks{console_sink_, main_sink_};
+
+        std::shared_ptr<spdlog::logger> logger;
+        if (async.enabled) logger = std::make_shared<spdlog::async_logger>(name, sinks, spdlog::thread_pool(), overflow);
+        else logger = std::make_shared<spdlog::logger>(name, sinks);
+
         logger->set_level(lvl);
         logger->flush_on(spdlog::level::warn);
         spdlog::register_logger(logger);
+        handles_[static_cast<size_t>(subsystem)] = logger;
     };
 
     const auto& sub_levels = cnf.levels.subsystem_levels;
-    makeLogger("vaulthalla", sub_levels.vaulthalla);
-    makeLogger("fuse",       sub_levels.fuse);
-    makeLogger("filesystem", sub_levels.filesystem);
-    makeLogger("cloud",      sub_levels.cloud);
-    makeLogger("crypto",     sub_levels.crypto);
-    makeLogger("auth",       sub_levels.auth);
-    makeLogger("ws",         sub_levels.websocket);
-    makeLogger("http",       sub_levels.http);
-    makeLogger("shell",      sub_levels.shell);
-    makeLogger("db",         sub_levels.db);
-    makeLogger("sync",       sub_levels.sync);
-    makeLogger("thumb",      sub_levels.thumb);
-    makeLogger("storage",    sub_levels.storage);
-    makeLogger("types",      sub_levels.types);
-    makeLogger("runtime",    sub_levels.runtime);
-
-    // audit: file-only sink (append)
+    makeLogger(Subsystem::Vaulthalla, sub_levels.vaulthalla);
+    makeLogger(Subsystem::Fuse,       sub_levels.fuse);
+    makeLogger(Subsystem::Filesystem, sub_levels.filesystem);
+    makeLogger(Subsystem::Cloud,      sub_levels.cloud);
+    makeLogger(Subsystem::Crypto,     sub_levels.crypto);
+    makeLogger(Subsystem::Auth,       sub_levels.auth);
+    makeLogger(Subsystem::Ws,         sub_levels.websocket);
+    makeLogger(Subsystem::Http,       sub_levels.http);
+    makeLogger(Subsystem::Shell,      sub_levels.shell);
+    makeLogger(Subsystem::Db,         sub_levels.db);
+    makeLogger(Subsystem::Sync,       sub_levels.sync);
+    makeLogger(Subsystem::Thumb,      sub_levels.thumb);
+    makeLogger(Subsystem::Storage,    sub_levels.storage);
+    makeLogger(Subsystem::Types,      sub_levels.types);
+    makeLogger(Subsystem::Runtime,    sub_levels.runtime);
+
+    // audit: file-only sink (append). Stays synchronous: an overrun queue must never drop a record.
     {
-        audit_file_sink_ = std::make_shared<spdlog::sinks::basic_file_sink_mt>(
+        const auto auditFile = std::make_shared<spdlog::sinks::basic_file_sink_mt>(
             audit_log_path_.string(), /*truncate=*/false);
-        std::vector<spdlog::sink_ptr> sinks = { audit_file_sink_ };
-        const auto logger = std::make_shared<spdlog::logger>("audit", sinks.begin(), sinks.end());
+        audit_sink_ = std::make_shared<spdlog::sinks::dist_sink_mt>(std::vector<spdlog::sink_ptr>{auditFile});
+        const auto logger = std::make_shared<spdlog::logger>("audit", audit_sink_);
         logger->set_level(spdlog::level::info);
         logger->flush_on(spdlog::level::info);
         spdlog::register_logger(logger);
+        handles_[static_cast<size_t>(Subsystem::Audit)] = logger;
     }
 
     initialized_ = true;
     spdlog::info("[LogRegistry] Initialized");
 }
 
+void Registry::shutdown() {
+    if (!initialized_) return;
+    for (const auto& logger : handles_)
+        if (logger) logger->flush();
+    spdlog::shutdown();
+}
+
 std::shared_ptr<spdlog::logger> Registry::get(const std::string& name) {
     auto logger = spdlog::get(name);
-    if (!logger) {
-        if (!initialized_) throw std::runtime_error("[LogRegistry] LogRegistry not initialized, cannot get logger: " + name);
-        throw std::runtime_error("[LogRegistry] Logger not found: " + name);
-    }
+    if (!logger) throwMissing(name);
     return logger;
 }
 
-bool Registry::isInitialized() { return initialized_; }
-
-// LogRegistry.cpp (add helper)
-void Registry::replaceSinkEverywhere_(
-    const std::shared_ptr<spdlog::sinks::sink>& old_sink,
-    const std::shared_ptr<spdlog::sinks::sink>& new_sink)
-{
-    // Swap on every registered logger that currently uses old_sink.
-    spdlog::apply_all([&](const std::shared_ptr<spdlog::logger>& lg) {
-        // Take a copy of sinks, replace in the copy, then set_sinks() atomically.
-        auto sinks_copy = lg->sinks();
-        bool touched = false;
-        for (auto &s : sinks_copy) {
-            if (s.get() == old_sink.get()) {
-                s = new_sink;
-                touched = true;
-            }
-        }
-        if (touched) {
-            // flush before swap to minimize dangling writes
-            lg->flush();
-            lg->sinks() = std::move(sinks_copy);
-        }
-    });
-
-    // old_sink will be destroyed when last ref goes away → file closed.
+void Registry::throwMissing(const std::string& name) {
+    if (!initialized_) throw std::runtime_error("[LogRegistry] LogRegistry not initialized, cannot get logger: " + name);
+    throw std::runtime_error("[LogRegistry] Logger not found: " + name);
 }
 
+bool Registry::isInitialized() { return initialized_; }
+
 void Registry::reopenMainLog() {
     if (!initialized_) return;
 
     // Build a fresh rotating sink with the same settings.
+    const auto old = main_sink_->sinks().front();
     auto fresh = std::make_shared<spdlog::sinks::rotating_file_sink_mt>(
         main_log_path_.string(), main_max_bytes_, main_max_files_);
 
     // Keep level/pattern identical to the old sink.
-    fresh->set_level(main_file_sink_->level());
+    fresh->set_level(old->level());
     fresh->set_pattern(FILE_LOG_FORMAT);
 
-    replaceSinkEverywhere_(main_file_sink_, fresh);
-    main_file_sink_ = std::move(fresh);
+    // flush before swap to minimize dangling writes; old sink closes when its last ref goes away
+    main_sink_->flush();
+    main_sink_->set_sinks({std::move(fresh)});
 }
 
 void Registry::reopenAuditLog() {
     if (!initialized_) return;
 
-    // Only the "audit" logger uses this sink, but make it symmetric.
+    const auto old = audit_sink_->sinks().front();
     auto fresh = std::make_shared<spdlog::sinks::basic_file_sink_mt>(
         audit_log_path_.string(), /*truncate=*/false);
-    fresh->set_level(audit_file_sink_->level());
+    fresh->set_level(old->level());
     fresh->set_pattern(FILE_LOG_FORMAT);
 
-    // Swap on the audit logger (and any others that might have it)
-    replaceSinkEverywhere_(audit_file_sink_, fresh);
-    audit_file_sink_ = std::move(fresh);
+    audit_sink_->flush();
+    audit_sink_->set_sinks({std::move(fresh)});
 }
 
 }
@@ -18,6 +18,7 @@ RotationService::RotationService()
         .retention_days = std::chrono::days(7),
         .max_retained_size = 100_MiB,
         .compression = Rotator::Compression::Zstd,
+        .compression_rate_limit = config::Registry::get().auditing.audit_log.compression_rate_limit,
         .ignore_compress_errors = true,
         .on_reopen = []() { Registry::reopenMainLog(); },
         .diag_log = [](const std::string_view& msg) { Registry::runtime()->debug("[LogRotator] {}", msg); }
@@ -30,6 +31,8 @@ RotationService::RotationService()
         .max_retained_size = config::Registry::get().auditing.audit_log.max_retained_logs_size,
         .strict_retention = config::Registry::get().auditing.audit_log.strict_retention,
         .compression = config::Registry::get().auditing.audit_log.compression,
+        .compression_level = config::Registry::get().auditing.audit_log.compression_level,
+        .compression_rate_limit = config::Registry::get().auditing.audit_log.compression_rate_limit,
         .ignore_compress_errors = true,
         .on_reopen = []() { Registry::reopenAuditLog(); },
         .diag_log = [](const std::string_view& msg) { Registry::audit()->debug("[AuditLogRotator] {}", msg); }
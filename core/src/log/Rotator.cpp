@@ -1,8 +1,8 @@
 #include "log/Rotator.hpp"
+#include "log/Compressor.hpp"
 
 #include <algorithm>
 #include <cstdio>
-#include <cstdlib>
 #include <iomanip>
 #include <sstream>
 #include <system_error>
@@ -35,11 +35,23 @@ Rotator::Rotator(Options opts)
         };
     }
     if (!opts_.lock_dir) opts_.lock_dir = dir_;
+
+    if (opts_.compression != Compression::None)
+        compressor_ = std::make_unique<Compressor>(Compressor::Options{
+            .compression = opts_.compression,
+            .level = opts_.compression_level,
+            .max_bytes_per_sec = opts_.compression_rate_limit,
+            .low_priority = opts_.compress_in_background,
+            .diag_log = opts_.diag_log
+        });
 }
 
+Rotator::~Rotator() = default;
+
 void Rotator::maybeRotate() const {
     std::scoped_lock lk(m_);
     if (const auto reason = rotationReason(); reason != RotateReason::None) rotateImpl(reason);
+    compressLeftovers();
     pruneImpl();
 }
 
@@ -162,8 +174,8 @@ void Rotator::rotateImpl(const RotateReason why) const {
     }
 
     // Optional compression
-    if (opts_.compression != Compression::None) {
-        const bool ok = compressFile(target, opts_.compression);
+    if (compressor_) {
+        const bool ok = compressFile(target);
         if (!ok && !opts_.ignore_compress_errors) {
             if (opts_.diag_log) opts_.diag_log("rotate: compression failed (fatal).");
             return;
@@ -172,9 +184,8 @@ void Rotator::rotateImpl(const RotateReason why) const {
 
     if (opts_.diag_log) {
         std::ostringstream os;
-        os << "rotate: completed (" << reasonStr(why) << ") -> " << target.filename().string();
-        if (opts_.compression == Compression::Gzip) os << ".gz";
-        if (opts_.compression == Compression::Zstd) os << ".zst";
+        os << "rotate: completed (" << reasonStr(why) << ") -> " << target.filename().string()
+           << Compressor::extension(opts_.compression);
         opts_.diag_log(os.str());
     }
 }
@@ -189,32 +200,25 @@ const char* Rotator::reasonStr(RotateReason r) {
     return "?";
 }
 
-bool Rotator::compressFile(const std::filesystem::path& src, Compression c) const {
-    std::error_code ec;
-    if (!std::filesystem::exists(src, ec)) return false;
-
-    std::string cmd;
-    if (c == Compression::Gzip) {
-        cmd = "gzip -f -- " + shellQuote(src.string());
-    } else if (c == Compression::Zstd) {
-        cmd = "zstd -q -f --rm -- " + shellQuote(src.string());
-    }
-    if (cmd.empty()) return false;
-
-    int rc = std::system(cmd.c_str());
-    return (rc == 0);
+bool Rotator::compressFile(const std::filesystem::path& src) const {
+    if (!compressor_) return false;
+    if (!opts_.compress_in_background) return compressor_->compress(src);
+    compressor_->enqueue(src);
+    return true;
 }
 
-std::string Rotator::shellQuote(const std::string& s) {
-    std::string out;
-    out.reserve(s.size() + 2);
-    out.push_back('\'');
-    for (char ch : s) {
-        if (ch == '\'') out += "'\\''";
-        else out.push_back(ch);
+// Rotated files still in plain form: left behind by a crash or shutdown mid-compression,
+// or written before compression was switched on
+void Rotator::compressLeftovers() const {
+    if (!compressor_ || !opts_.compress_in_background) return;
+
+    std::error_code ec;
+    for (auto& de : std::filesystem::directory_iterator(dir_, ec)) {
+        if (ec) break;
+        if (!de.is_regular_file(ec)) continue;
+        if (de.path() == opts_.active_path || de.path().extension() != ext_) continue;
+        if (opts_.rotated_filter && opts_.rotated_filter(de.path())) compressor_->enqueue(de.path());
     }
-    out.push_back('\'');
-    return out;
 }
 
 void Rotator::pruneImpl() const {
@@ -0,0 +1,89 @@
+#include "preview/RenderCache.hpp"
+#include "config/Registry.hpp"
+
+using namespace vh::preview;
+
+std::string RenderCache::Key::str() const {
+    return contentHash + "/" + std::to_string(page) + "/" + geometry + "/q" + std::to_string(quality);
+}
+
+std::string RenderCache::Key::etag() const {
+    return "\"" + contentHash + "-p" + std::to_string(page) + "-" + geometry + "-q" + std::to_string(quality) + "\"";
+}
+
+RenderCache::RenderCache(const size_t budgetBytes) : budget_(budgetBytes) {}
+
+RenderCache& RenderCache::instance() {
+    static RenderCache cache(static_cast<size_t>(config::Registry::get().caching.render_cache_mb) * 1024 * 1024);
+    return cache;
+}
+
+RenderCache::Result RenderCache::getOrRender(const Key& key, const std::function<std::vector<uint8_t>()>& render) {
+    const auto k = key.str();
+    std::promise<Bytes> promise;
+    std::shared_future<Bytes> pending;
+
+    {
+        std::lock_guard lock(mutex_);
+        if (const auto it = index_.find(k); it != index_.end()) {
+            lru_.splice(lru_.begin(), lru_, it->second);
+            return { .bytes = it->second->bytes, .hit = true };
+        }
+
+        if (const auto it = inFlight_.find(k); it != inFlight_.end()) pending = it->second;
+        else inFlight_.emplace(k, promise.get_future().share());
+    }
+
+    if (pending.valid()) return { .bytes = pending.get(), .hit = true };
+
+    try {
+        auto bytes = std::make_shared<const std::vector<uint8_t>>(render());
+        {
+            std::lock_guard lock(mutex_);
+            inFlight_.erase(k);
+            insertLocked(k, bytes);
+        }
+        promise.set_value(bytes);
+        return { .bytes = std::move(bytes), .hit = false };
+    } catch (...) {
+        {
+            std::lock_guard lock(mutex_);
+            inFlight_.erase(k);
+        }
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+}
+
+void RenderCache::insertLocked(const std::string& key, const Bytes& bytes) {
+    // A single render allowed to take over most of the budget would just churn everything else
+    if (!bytes || bytes->size() > budget_ / 4) return;
+
+    lru_.push_front({ .key = key, .bytes = bytes });
+    index_[key] = lru_.begin();
+    used_ += bytes->size();
+
+    while (used_ > budget_ && !lru_.empty()) {
+        auto& victim = lru_.back();
+        used_ -= victim.bytes->size();
+        index_.erase(victim.key);
+        lru_.pop_back();
+    }
+}
+
+void RenderCache::clear() {
+    std::lock_guard lock(mutex_);
+    lru_.clear();
+    index_.clear();
+    used_ = 0;
+}
+
+size_t RenderCache::sizeBytes() const {
+    std::lock_guard lock(mutex_);
+    return used_;
+}
+
+size_t RenderCache::entries() const {
+    std::lock_guard lock(mutex_);
+    return lru_.size();
+}
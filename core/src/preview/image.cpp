@@ -6,14 +6,118 @@
 #include <stb/stb_image.h>
 #include <stb/stb_image_resize.h>
 #include <turbojpeg.h>
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <numeric>
 #include <stdexcept>
 #include <fstream>
 
+namespace {
+
+// TurboJPEG handles are costly to set up and not thread-safe, so each worker thread keeps its own
+struct TurboHandle {
+    tjhandle handle;
+
+    explicit TurboHandle(const tjhandle h) : handle(h) {
+        if (!handle) throw std::runtime_error("Failed to initialize TurboJPEG handle");
+    }
+
+    ~TurboHandle() { tjDestroy(handle); }
+
+    TurboHandle(const TurboHandle&) = delete;
+    TurboHandle& operator=(const TurboHandle&) = delete;
+};
+
+tjhandle compressor() {
+    thread_local TurboHandle tj(tjInitCompress());
+    return tj.handle;
+}
+
+tjhandle decompressor() {
+    thread_local TurboHandle tj(tjInitDecompress());
+    return tj.handle;
+}
+
+struct Pixels {
+    std::unique_ptr<uint8_t, void (*)(void*)> rgb{nullptr, std::free};
+    int width = 0, height = 0;
+};
+
+bool isJpeg(const uint8_t* data, const size_t size) {
+    return size >= 3 && data[0] == 0xFF && data[1] == 0xD8 && data[2] == 0xFF;
+}
+
+// Lets libjpeg-turbo skip most of the IDCT work by decoding at the smallest 1/8..1 scale whose
+// long edge still covers `cover` pixels; 0 asks for full resolution. Anything it cannot decode
+// falls back to stb.
+std::optional<Pixels> decodeJpegScaled(const uint8_t* data, const size_t size, const unsigned int cover) {
+    const auto tj = decompressor();
+    int width = 0, height = 0, subsamp = 0, colorspace = 0;
+    if (tjDecompressHeader3(tj, data, static_cast<unsigned long>(size), &width, &height, &subsamp, &colorspace) != 0)
+        return std::nullopt;
+
+    int count = 0;
+    const tjscalingfactor* factors = tjGetScalingFactors(&count);
+    tjscalingfactor best{1, 1};
+    for (int i = 0; cover > 0 && factors && i < count; ++i) {
+        const auto& f = factors[i];
+        if (f.num > f.denom) continue;
+        const int w = TJSCALED(width, f), h = TJSCALED(height, f);
+        if (static_cast<unsigned int>(std::max(w, h)) < cover) continue;
+        if (static_cast<long>(w) * h < static_cast<long>(TJSCALED(width, best)) * TJSCALED(height, best)) best = f;
+    }
+
+    Pixels px;
+    px.width = TJSCALED(width, best);
+    px.height = TJSCALED(height, best);
+    px.rgb.reset(static_cast<uint8_t*>(std::malloc(static_cast<size_t>(px.width) * px.height * 3)));
+    if (!px.rgb) throw std::bad_alloc();
+
+    if (tjDecompress2(tj, data, static_cast<unsigned long>(size), px.rgb.get(), px.width, 0, px.height, TJPF_RGB, 0) != 0 &&
+        tjGetErrorCode(tj) != TJERR_WARNING)
+        return std::nullopt;
+
+    return px;
+}
+
+Pixels decode(const uint8_t* data, const size_t size, const unsigned int cover) {
+    if (size < 4) throw std::runtime_error("Buffer too small to be a valid image");
+
+    if (isJpeg(data, size))
+        if (auto px = decodeJpegScaled(data, size, cover)) return std::move(*px);
+
+    Pixels px{ .rgb = {nullptr, stbi_image_free} };
+    int channels = 0;
+    px.rgb.reset(stbi_load_from_memory(data, static_cast<int>(size), &px.width, &px.height, &channels, 3));
+    if (!px.rgb) {
+        const char *reason = stbi_failure_reason();
+        throw std::runtime_error(
+            std::string("Failed to decode image from memory: ") + (reason ? reason : "unknown error"));
+    }
+    return px;
+}
+
+std::pair<int, int> fit(const int width, const int height, const unsigned int max_dim) {
+    const float ratio = std::min(static_cast<float>(max_dim) / static_cast<float>(width),
+                                 static_cast<float>(max_dim) / static_cast<float>(height));
+    return {
+        std::max(1, static_cast<int>(static_cast<float>(width) * ratio)),
+        std::max(1, static_cast<int>(static_cast<float>(height) * ratio))
+    };
+}
+
+}
+
 namespace vh::preview::image {
     void compress_to_jpeg(const uint8_t *rgb_data, const int width, const int height, std::vector<uint8_t> &out_buf,
                           const int quality) {
-        tjhandle tj = tjInitCompress();
-        if (!tj) throw std::runtime_error("Failed to initialize TurboJPEG compressor");
+        compress_to_jpeg(rgb_data, width, height, 0, PixelFormat::RGB, out_buf, quality);
+    }
+
+    void compress_to_jpeg(const uint8_t *pixels, const int width, const int height, const int pitch,
+                          const PixelFormat format, std::vector<uint8_t> &out_buf, const int quality) {
+        const auto tj = compressor();
 
         unsigned char *jpeg_buf = nullptr;
         unsigned long jpeg_size = 0;
@@ -22,24 +126,23 @@ namespace vh::preview::image {
 
         if (tjCompress2(
                 tj,
-                rgb_data,
+                pixels,
                 width,
-                0, // pitch (0 = auto)
+                pitch, // 0 = tightly packed
                 height,
-                TJPF_RGB,
+                format == PixelFormat::BGRX ? TJPF_BGRX : TJPF_RGB,
                 &jpeg_buf,
                 &jpeg_size,
                 TJSAMP_444, // No chroma subsampling, best quality
                 quality,
                 flags) != 0) {
-            const std::string err = tjGetErrorStr();
-            tjDestroy(tj);
+            const std::string err = tjGetErrorStr2(tj);
+            tjFree(jpeg_buf);
             throw std::runtime_error("JPEG compression failed: " + err);
         }
 
         out_buf.assign(jpeg_buf, jpeg_buf + jpeg_size);
         tjFree(jpeg_buf);
-        tjDestroy(tj);
     }
 
     std::vector<uint8_t> resize_and_compress(
@@ -77,17 +180,10 @@ namespace vh::preview::image {
         const uint8_t *data, size_t size,
         const std::optional<std::string> &scale_opt,
         const std::optional<std::string> &size_opt) {
-        if (size < 4) {
-            throw std::runtime_error("Buffer too small to be a valid image");
-        }
-
-        int width = 0, height = 0, channels = 0;
-        unsigned char *decoded = stbi_load_from_memory(data, static_cast<int>(size), &width, &height, &channels, 3);
-        if (!decoded) {
-            const char *reason = stbi_failure_reason();
-            throw std::runtime_error(
-                std::string("Failed to decode image from memory: ") + (reason ? reason : "unknown error"));
-        }
+        // A bounding-box request only needs enough pixels to cover the box; scaling needs them all
+        const unsigned int cover = !scale_opt && size_opt ? static_cast<unsigned int>(std::stoul(*size_opt)) : 0;
+        const auto px = decode(data, size, cover);
+        const int width = px.width, height = px.height;
 
         int new_w = width, new_h = height;
         if (scale_opt) {
@@ -95,19 +191,55 @@ namespace vh::preview::image {
             new_w = static_cast<int>(static_cast<float>(width) * scale);
             new_h = static_cast<int>(static_cast<float>(height) * scale);
         } else if (size_opt) {
-            int max_dim = std::stoi(*size_opt);
-            float ratio = std::min(static_cast<float>(max_dim) / static_cast<float>(width),
-                                   static_cast<float>(max_dim) / static_cast<float>(height));
-            new_w = static_cast<int>(static_cast<float>(width) * ratio);
-            new_h = static_cast<int>(static_cast<float>(height) * ratio);
+            std::tie(new_w, new_h) = fit(width, height, cover);
         }
 
         std::vector<uint8_t> resized(new_w * new_h * 3);
-        stbir_resize_uint8(decoded, width, height, 0, resized.data(), new_w, new_h, 0, 3);
-        stbi_image_free(decoded);
+        stbir_resize_uint8(px.rgb.get(), width, height, 0, resized.data(), new_w, new_h, 0, 3);
 
         std::vector<uint8_t> compressed;
         compress_to_jpeg(resized.data(), new_w, new_h, compressed);
         return compressed;
     }
+
+    std::vector<std::vector<uint8_t>> thumbnails_from_pixels(const uint8_t *pixels, const int width, const int height,
+                                                             const int pitch, const PixelFormat format,
+                                                             const std::vector<unsigned int> &max_sizes,
+                                                             const int quality) {
+        const int channels = format == PixelFormat::BGRX ? 4 : 3;
+
+        std::vector<size_t> order(max_sizes.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::ranges::sort(order, [&](const size_t a, const size_t b) { return max_sizes[a] > max_sizes[b]; });
+
+        std::vector<std::vector<uint8_t>> out(max_sizes.size());
+        std::vector<uint8_t> level;
+        int level_w = 0, level_h = 0;
+
+        for (const auto i : order) {
+            const auto [new_w, new_h] = fit(width, height, max_sizes[i]);
+
+            // Cascade from the previous, larger level unless it was upscaled past the source
+            const bool cascade = !level.empty() && level_w >= new_w && level_h >= new_h && level_w <= width;
+            std::vector<uint8_t> resized(static_cast<size_t>(new_w) * new_h * channels);
+            stbir_resize_uint8(cascade ? level.data() : pixels,
+                               cascade ? level_w : width, cascade ? level_h : height, cascade ? 0 : pitch,
+                               resized.data(), new_w, new_h, 0, channels);
+
+            compress_to_jpeg(resized.data(), new_w, new_h, 0, format, out[i], quality);
+            level = std::move(resized);
+            level_w = new_w;
+            level_h = new_h;
+        }
+
+        return out;
+    }
+
+    std::vector<std::vector<uint8_t>> thumbnails_from_buffer(const uint8_t *data, const size_t size,
+                                                             const std::vector<unsigned int> &max_sizes,
+                                                             const int quality) {
+        if (max_sizes.empty()) return {};
+        const auto px = decode(data, size, std::ranges::max(max_sizes));
+        return thumbnails_from_pixels(px.rgb.get(), px.width, px.height, 0, PixelFormat::RGB, max_sizes, quality);
+    }
 }
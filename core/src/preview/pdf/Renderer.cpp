@@ -0,0 +1,243 @@
+#include "preview/pdf/Renderer.hpp"
+#include "preview/image.hpp"
+
+#include <pdfium/fpdfview.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace vh::preview::pdf;
+using vh::preview::image::PixelFormat;
+
+struct Renderer::Document {
+    std::string key;
+    Bytes bytes;                        // pdfium reads from this for as long as the document is open
+    FPDF_DOCUMENT handle = nullptr;
+
+    Document(std::string k, Bytes b) : key(std::move(k)), bytes(std::move(b)) {
+        handle = FPDF_LoadMemDocument(bytes->data(), static_cast<int>(bytes->size()), nullptr);
+        if (!handle) throw std::runtime_error("Failed to load PDF from memory");
+    }
+
+    ~Document() { FPDF_CloseDocument(handle); }
+
+    Document(const Document&) = delete;
+    Document& operator=(const Document&) = delete;
+};
+
+namespace {
+
+struct Page {
+    FPDF_PAGE handle;
+
+    Page(FPDF_DOCUMENT doc, const unsigned int index) {
+        if (index >= static_cast<unsigned int>(FPDF_GetPageCount(doc)))
+            throw std::out_of_range("PDF page " + std::to_string(index) + " does not exist");
+        handle = FPDF_LoadPage(doc, static_cast<int>(index));
+        if (!handle) throw std::runtime_error("Failed to load page " + std::to_string(index));
+    }
+
+    ~Page() { FPDF_ClosePage(handle); }
+
+    Page(const Page&) = delete;
+    Page& operator=(const Page&) = delete;
+};
+
+// Page rasterized as BGRx, which TurboJPEG and stb take as-is
+struct Bitmap {
+    FPDF_BITMAP handle = nullptr;
+    int width = 0, height = 0;
+
+    Bitmap(const Page& page, const RenderOptions& options) {
+        const int page_w = static_cast<int>(FPDF_GetPageWidth(page.handle));
+        const int page_h = static_cast<int>(FPDF_GetPageHeight(page.handle));
+
+        width = page_w;
+        height = page_h;
+        if (options.scale) {
+            const float scale = std::stof(*options.scale);
+            width = static_cast<int>(static_cast<float>(page_w) * scale);
+            height = static_cast<int>(static_cast<float>(page_h) * scale);
+        } else if (options.size) {
+            const int max_dim = std::stoi(*options.size);
+            const float ratio = std::min(static_cast<float>(max_dim) / static_cast<float>(page_w),
+                                         static_cast<float>(max_dim) / static_cast<float>(page_h));
+            width = static_cast<int>(static_cast<float>(page_w) * ratio);
+            height = static_cast<int>(static_cast<float>(page_h) * ratio);
+        }
+        width = std::max(1, width);
+        height = std::max(1, height);
+
+        handle = FPDFBitmap_Create(width, height, 0); // 0 = BGRx
+        if (!handle) throw std::runtime_error("Failed to allocate PDF bitmap");
+        FPDFBitmap_FillRect(handle, 0, 0, width, height, 0xFFFFFFFF);
+        FPDF_RenderPageBitmap(handle, page.handle, 0, 0, width, height, 0, 0);
+    }
+
+    ~Bitmap() { FPDFBitmap_Destroy(handle); }
+
+    Bitmap(const Bitmap&) = delete;
+    Bitmap& operator=(const Bitmap&) = delete;
+
+    [[nodiscard]] const uint8_t* pixels() const { return static_cast<const uint8_t*>(FPDFBitmap_GetBuffer(handle)); }
+    [[nodiscard]] int pitch() const { return FPDFBitmap_GetStride(handle); }
+};
+
+template<typename T, typename Fn>
+void fulfil(std::promise<T>& promise, Fn&& fn) {
+    try {
+        promise.set_value(fn());
+    } catch (...) {
+        promise.set_exception(std::current_exception());
+    }
+}
+
+}
+
+Renderer& Renderer::instance() {
+    static Renderer renderer;
+    return renderer;
+}
+
+Renderer::Renderer() : thread_([this] { run(); }) {}
+
+Renderer::~Renderer() {
+    stop();
+}
+
+void Renderer::stop() {
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    if (thread_.joinable() && thread_.get_id() != std::this_thread::get_id()) thread_.join();
+}
+
+void Renderer::run() {
+    FPDF_LIBRARY_CONFIG config;
+    config.version = 3;
+    config.m_pUserFontPaths = nullptr;
+    config.m_pIsolate = nullptr;
+    config.m_v8EmbedderSlot = 0;
+    FPDF_InitLibraryWithConfig(&config);
+
+    for (;;) {
+        std::function<void()> job;
+        {
+            std::unique_lock lock(mutex_);
+            cv_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+            if (jobs_.empty()) break;
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+        job();
+    }
+
+    documents_.clear();
+    {
+        std::lock_guard lock(mutex_);
+        openKeys_.clear();
+    }
+    FPDF_DestroyLibrary();
+}
+
+void Renderer::post(std::function<void()> job) {
+    {
+        std::lock_guard lock(mutex_);
+        if (stopping_) throw std::runtime_error("PDF renderer is stopped");
+        jobs_.push_back(std::move(job));
+    }
+    cv_.notify_one();
+}
+
+Renderer::Bytes Renderer::prefetch(const std::string& key, const Loader& load) const {
+    {
+        std::lock_guard lock(mutex_);
+        if (!key.empty() && openKeys_.contains(key)) return nullptr;
+    }
+    return std::make_shared<const std::vector<uint8_t>>(load());
+}
+
+std::shared_ptr<Renderer::Document> Renderer::acquire(const std::string& key, Bytes bytes, const Loader& load) {
+    if (!key.empty()) {
+        const auto it = std::ranges::find(documents_, key, &Document::key);
+        if (it != documents_.end()) {
+            documents_.splice(documents_.begin(), documents_, it);
+            return documents_.front();
+        }
+    }
+
+    if (!bytes) bytes = std::make_shared<const std::vector<uint8_t>>(load());
+    auto doc = std::make_shared<Document>(key, std::move(bytes));
+    if (key.empty()) return doc;
+
+    documents_.push_front(doc);
+    openBytes_ += doc->bytes->size();
+    {
+        std::lock_guard lock(mutex_);
+        openKeys_.insert(key);
+    }
+
+    while (documents_.size() > 1 && (documents_.size() > MAX_OPEN_DOCUMENTS || openBytes_ > MAX_OPEN_BYTES)) {
+        const auto& victim = documents_.back();
+        openBytes_ -= victim->bytes->size();
+        {
+            std::lock_guard lock(mutex_);
+            openKeys_.erase(victim->key);
+        }
+        documents_.pop_back();
+    }
+
+    return doc;
+}
+
+std::future<std::vector<uint8_t>> Renderer::render(const std::string& documentKey, Loader load, RenderOptions options) {
+    auto bytes = prefetch(documentKey, load);
+    auto promise = std::make_shared<std::promise<std::vector<uint8_t>>>();
+    auto future = promise->get_future();
+
+    post([this, key = documentKey, bytes = std::move(bytes), load = std::move(load),
+          options = std::move(options), promise]() mutable {
+        fulfil(*promise, [&] {
+            const auto doc = acquire(key, std::move(bytes), load);
+            const Page page(doc->handle, options.page);
+            const Bitmap bitmap(page, options);
+
+            std::vector<uint8_t> jpeg;
+            image::compress_to_jpeg(bitmap.pixels(), bitmap.width, bitmap.height, bitmap.pitch(),
+                                    PixelFormat::BGRX, jpeg, options.quality);
+            return jpeg;
+        });
+    });
+
+    return future;
+}
+
+std::future<std::vector<std::vector<uint8_t>>> Renderer::thumbnails(const std::string& documentKey, Loader load,
+                                                                    std::vector<unsigned int> sizes) {
+    if (sizes.empty()) {
+        std::promise<std::vector<std::vector<uint8_t>>> none;
+        none.set_value({});
+        return none.get_future();
+    }
+
+    auto bytes = prefetch(documentKey, load);
+    auto promise = std::make_shared<std::promise<std::vector<std::vector<uint8_t>>>>();
+    auto future = promise->get_future();
+
+    post([this, key = documentKey, bytes = std::move(bytes), load = std::move(load),
+          sizes = std::move(sizes), promise]() mutable {
+        fulfil(*promise, [&] {
+            const auto doc = acquire(key, std::move(bytes), load);
+            const Page page(doc->handle, 0);
+
+            // Rasterize once at the largest box and let the smaller ones cascade from it
+            const Bitmap bitmap(page, { .page = 0, .scale = std::nullopt, .size = std::to_string(std::ranges::max(sizes)) });
+            return image::thumbnails_from_pixels(bitmap.pixels(), bitmap.width, bitmap.height, bitmap.pitch(),
+                                                 PixelFormat::BGRX, sizes);
+        });
+    });
+
+    return future;
+}
@@ -8,27 +8,26 @@
 
 namespace vh::preview::thumbnail {
 
-void generateAndStore(const std::vector<uint8_t>& buffer, const std::filesystem::path& outputPath,
-                               const std::string& mime, const unsigned int size) {
-    std::vector<uint8_t> jpeg;
-
-    if (mime.starts_with("image/")) {
-        jpeg = image::resize_and_compress_buffer(
-            buffer.data(), buffer.size(), std::nullopt, std::make_optional(std::to_string(size))
-            );
-    } else if (mime == "application/pdf") {
-        jpeg = pdf::resize_and_compress_buffer(
-            buffer.data(), buffer.size(), std::nullopt, std::make_optional(std::to_string(size))
-            );
-    } else throw std::runtime_error("Unsupported MIME type for thumbnail generation: " + mime);
-
-    if (jpeg.empty()) throw std::runtime_error("Thumbnail JPEG buffer is empty after processing");
+std::vector<std::vector<uint8_t>> generate(const std::vector<uint8_t>& buffer, const std::string& mime,
+                                           const std::vector<unsigned int>& sizes) {
+    std::vector<std::vector<uint8_t>> jpegs;
 
+    if (mime.starts_with("image/")) jpegs = image::thumbnails_from_buffer(buffer.data(), buffer.size(), sizes);
+    else if (mime == "application/pdf") jpegs = pdf::thumbnails_from_buffer(buffer.data(), buffer.size(), sizes);
+    else throw std::runtime_error("Unsupported MIME type for thumbnail generation: " + mime);
+
+    for (const auto& jpeg : jpegs)
+        if (jpeg.empty()) throw std::runtime_error("Thumbnail JPEG buffer is empty after processing");
+
+    return jpegs;
+}
+
+void store(const std::vector<uint8_t>& jpeg, const std::filesystem::path& outputPath) {
     std::filesystem::create_directories(outputPath.parent_path());
     std::ofstream out(outputPath, std::ios::binary);
     if (!out.is_open()) throw std::runtime_error("Failed to open thumbnail output path: " + outputPath.string());
 
-    out.write(reinterpret_cast<const char*>(jpeg.data()), jpeg.size());
+    out.write(reinterpret_cast<const char*>(jpeg.data()), static_cast<std::streamsize>(jpeg.size()));
     if (!out.good()) throw std::runtime_error("Failed to write thumbnail to disk: " + outputPath.string());
 
     out.close();
@@ -7,6 +7,7 @@
 #include "log/Registry.hpp"
 
 #include <boost/asio/io_context.hpp>
+#include <algorithm>
 #include <sodium.h>
 
 namespace vh::protocols {
@@ -32,25 +33,13 @@ void ProtocolService::runLoop() {
 
         while (!shouldStop()) std::this_thread::sleep_for(std::chrono::seconds(1));
 
-        if (ioContext_) ioContext_->stop();
-        if (ioThread_.joinable()) ioThread_.join();
-        websocketReady_.store(false, std::memory_order_release);
-        httpPreviewReady_.store(false, std::memory_order_release);
-        ioContextInitialized_.store(false, std::memory_order_release);
+        stopIoThreads();
     } catch (const std::exception& e) {
         log::Registry::runtime()->error("[ProtocolService] Exception in run loop: {}", e.what());
-        if (ioContext_) ioContext_->stop();
-        if (ioThread_.joinable()) ioThread_.join();
-        websocketReady_.store(false, std::memory_order_release);
-        httpPreviewReady_.store(false, std::memory_order_release);
-        ioContextInitialized_.store(false, std::memory_order_release);
+        stopIoThreads();
     } catch (...) {
         log::Registry::runtime()->error("[ProtocolService] Unknown exception in run loop");
-        if (ioContext_) ioContext_->stop();
-        if (ioThread_.joinable()) ioThread_.join();
-        websocketReady_.store(false, std::memory_order_release);
-        httpPreviewReady_.store(false, std::memory_order_release);
-        ioContextInitialized_.store(false, std::memory_order_release);
+        stopIoThreads();
     }
 }
 
@@ -68,13 +57,54 @@ void ProtocolService::initProtocols() {
         return;
     }
 
+    // HTTP gets its own io_context so large previews and downloads never queue behind WebSocket traffic
+    wsServer_.reset();
+    httpServer_.reset();
     ioContext_ = std::make_shared<asio::io_context>();
+    httpContext_ = std::make_shared<asio::io_context>();
     ioContextInitialized_.store(true, std::memory_order_release);
 
     initWebsocketServer();
     initHttpServer();
 
-    ioThread_ = std::thread([ctx = ioContext_] { ctx->run(); });
+    if (wsServer_) {
+        const auto n = ioThreadCount();
+        ioThreads_.reserve(n);
+        for (unsigned int i = 0; i < n; ++i)
+            ioThreads_.emplace_back([ctx = ioContext_] { ctx->run(); });
+        log::Registry::runtime()->info("[ProtocolService] Running WebSocket io_context on {} threads", n);
+    }
+
+    if (httpServer_) {
+        const auto n = httpIoThreadCount();
+        httpThreads_.reserve(n);
+        for (unsigned int i = 0; i < n; ++i)
+            httpThreads_.emplace_back([ctx = httpContext_] { ctx->run(); });
+        log::Registry::runtime()->info("[ProtocolService] Running HTTP io_context on {} threads", n);
+    }
+}
+
+void ProtocolService::stopIoThreads() {
+    if (ioContext_) ioContext_->stop();
+    if (httpContext_) httpContext_->stop();
+    for (auto* threads : {&ioThreads_, &httpThreads_}) {
+        for (auto& t : *threads)
+            if (t.joinable()) t.join();
+        threads->clear();
+    }
+    websocketReady_.store(false, std::memory_order_release);
+    httpPreviewReady_.store(false, std::memory_order_release);
+    ioContextInitialized_.store(false, std::memory_order_release);
+}
+
+unsigned int ProtocolService::ioThreadCount() {
+    if (const auto configured = vh::config::Registry::get().websocket.io_threads) return configured;
+    return std::max(2u, std::thread::hardware_concurrency() / 2);
+}
+
+unsigned int ProtocolService::httpIoThreadCount() {
+    if (const auto configured = vh::config::Registry::get().http_preview.io_threads) return configured;
+    return std::max(2u, std::thread::hardware_concurrency() / 2);
 }
 
 
@@ -99,7 +129,7 @@ void ProtocolService::initHttpServer() {
     }
 
     const auto endpoint = asio::ip::tcp::endpoint(asio::ip::make_address(cfg.host), cfg.port);
-    httpServer_ = std::make_shared<http::Server>(*ioContext_, endpoint);
+    httpServer_ = std::make_shared<http::Server>(*httpContext_, endpoint);
     httpServer_->run();
     httpPreviewReady_.store(true, std::memory_order_release);
 }
@@ -13,6 +13,7 @@
 #include "fs/model/Path.hpp"
 #include "fs/cache/Registry.hpp"
 #include "stats/model/CacheStats.hpp"
+#include "stats/Metrics.hpp"
 #include "protocols/http/model/preview/Request.hpp"
 #include "log/Registry.hpp"
 #include "protocols/cookie.hpp"
@@ -25,9 +26,11 @@
 #include "storage/CloudEngine.hpp"
 #include "rbac/resolver/Vault.hpp"
 #include "rbac/permission/vault/Filesystem.hpp"
+#include "crypto/util/encrypt.hpp"
+#include "protocols/http/model/download/Archive.hpp"
+#include "preview/RenderCache.hpp"
 
 #include <nlohmann/json.hpp>
-#include <zlib.h>
 #include <algorithm>
 #include <array>
 #include <cctype>
@@ -232,10 +235,7 @@ static std::unique_ptr<vh::protocols::http::model::preview::Request> prepareShar
 }
 
 constexpr uint64_t kMaxHttpDownloadFileBytes = 256ull * 1024ull * 1024ull;
-constexpr uint64_t kMaxArchiveSourceBytes = 256ull * 1024ull * 1024ull;
-constexpr uint64_t kMaxArchiveBytes = 320ull * 1024ull * 1024ull;
 constexpr uint32_t kMaxArchiveEntries = 4096;
-constexpr uint16_t kZipDateJanOne1980 = 33;
 
 [[nodiscard]] bool containsText(const std::string& haystack, const std::string_view needle) {
     return haystack.find(needle) != std::string::npos;
@@ -336,159 +336,279 @@ constexpr uint16_t kZipDateJanOne1980 = 33;
     return out;
 }
 
-void appendU16(std::vector<uint8_t>& out, const uint16_t value) {
-    out.push_back(static_cast<uint8_t>(value & 0xffu));
-    out.push_back(static_cast<uint8_t>((value >> 8u) & 0xffu));
+[[nodiscard]] std::vector<uint8_t> readDownloadFile(
+    const std::shared_ptr<vh::storage::Engine>& engine,
+    const std::shared_ptr<File>& file
+) {
+    if (!engine || !file) throw std::runtime_error("Download file is unavailable");
+    if (file->size_bytes > kMaxHttpDownloadFileBytes)
+        throw std::runtime_error("Download file exceeds maximum size");
+    if (file->size_bytes == 0) return {};
+
+    std::vector<uint8_t> bytes;
+    if (engine->type() == vh::storage::StorageType::Cloud) {
+        const auto cloud = std::dynamic_pointer_cast<vh::storage::CloudEngine>(engine);
+        if (!cloud) throw std::runtime_error("Cloud storage engine is unavailable");
+        bytes = cloud->downloadToBuffer(file->path);
+        if (cloud->remoteFileIsEncrypted(file->path))
+            bytes = cloud->decrypt(engine->vault->id, file->path, bytes);
+    } else {
+        bytes = engine->decrypt(file);
+    }
+
+    if (bytes.size() > kMaxHttpDownloadFileBytes)
+        throw std::runtime_error("Download file exceeds maximum size");
+    return bytes;
 }
 
-void appendU32(std::vector<uint8_t>& out, const uint32_t value) {
-    out.push_back(static_cast<uint8_t>(value & 0xffu));
-    out.push_back(static_cast<uint8_t>((value >> 8u) & 0xffu));
-    out.push_back(static_cast<uint8_t>((value >> 16u) & 0xffu));
-    out.push_back(static_cast<uint8_t>((value >> 24u) & 0xffu));
+struct ByteRange {
+    enum class Kind { Full, Partial, Unsatisfiable };
+
+    Kind kind = Kind::Full;
+    uint64_t offset = 0, length = 0;
+};
+
+[[nodiscard]] std::string_view trimmed(std::string_view value) {
+    while (!value.empty() && std::isspace(static_cast<unsigned char>(value.front()))) value.remove_prefix(1);
+    while (!value.empty() && std::isspace(static_cast<unsigned char>(value.back()))) value.remove_suffix(1);
+    return value;
 }
 
-void appendBytes(std::vector<uint8_t>& out, const std::string& value) {
-    out.insert(out.end(), value.begin(), value.end());
+[[nodiscard]] std::string_view headerValue(const boost::beast::http::fields::value_type& field) {
+    const auto value = field.value();
+    return {value.data(), value.size()};
 }
 
-void appendBytes(std::vector<uint8_t>& out, const std::vector<uint8_t>& value) {
-    out.insert(out.end(), value.begin(), value.end());
+[[nodiscard]] std::optional<uint64_t> parseRangeBound(const std::string_view value) {
+    if (value.empty() || value.size() > 19) return std::nullopt;
+    uint64_t out = 0;
+    for (const char c : value) {
+        if (c < '0' || c > '9') return std::nullopt;
+        out = out * 10 + static_cast<uint64_t>(c - '0');
+    }
+    return out;
 }
 
-struct ZipEntryRecord {
-    std::string name;
-    uint32_t crc{};
-    uint32_t size{};
-    uint32_t localHeaderOffset{};
-    bool directory{};
-};
+// Single "bytes=" ranges only. Multi-range and malformed headers fall back to the full
+// body, which RFC 9110 permits; a well-formed range past the end is unsatisfiable.
+[[nodiscard]] ByteRange parseByteRange(std::string_view header, const uint64_t size) {
+    ByteRange full{ .kind = ByteRange::Kind::Full, .offset = 0, .length = size };
+    header = trimmed(header);
+    if (!header.starts_with("bytes=")) return full;
+    header.remove_prefix(6);
+    if (header.find(',') != std::string_view::npos) return full;
+
+    const auto dash = header.find('-');
+    if (dash == std::string_view::npos) return full;
+    const auto firstStr = trimmed(header.substr(0, dash));
+    const auto lastStr = trimmed(header.substr(dash + 1));
+
+    if (firstStr.empty()) {
+        const auto suffix = parseRangeBound(lastStr);
+        if (!suffix) return full;
+        if (*suffix == 0 || size == 0) return { .kind = ByteRange::Kind::Unsatisfiable };
+        const auto length = std::min(*suffix, size);
+        return { .kind = ByteRange::Kind::Partial, .offset = size - length, .length = length };
+    }
 
-class ZipBuilder {
-public:
-    void addDirectory(const std::string& archivePath) {
-        appendEntry(safeArchivePath(archivePath, true), {}, true);
+    const auto first = parseRangeBound(firstStr);
+    if (!first) return full;
+    uint64_t last = size == 0 ? 0 : size - 1;
+    if (!lastStr.empty()) {
+        const auto parsed = parseRangeBound(lastStr);
+        if (!parsed || *parsed < *first) return full;
+        last = std::min(*parsed, last);
     }
 
-    void addFile(const std::string& archivePath, const std::vector<uint8_t>& data) {
-        appendEntry(safeArchivePath(archivePath, false), data, false);
+    if (*first >= size) return { .kind = ByteRange::Kind::Unsatisfiable };
+    return { .kind = ByteRange::Kind::Partial, .offset = *first, .length = last - *first + 1 };
+}
+
+// Strong validator derived from the BLAKE2b content hash recorded at write time.
+[[nodiscard]] std::optional<std::string> strongETag(const File& file) {
+    if (!file.content_hash || file.content_hash->empty()) return std::nullopt;
+    return "\"" + *file.content_hash + "\"";
+}
+
+// If-None-Match uses weak comparison, so a W/ prefix on the client's copy still matches.
+[[nodiscard]] bool etagListMatches(const std::string_view list, const std::string& etag) {
+    size_t pos = 0;
+    while (pos <= list.size()) {
+        const auto comma = list.find(',', pos);
+        auto candidate = trimmed(list.substr(pos, comma == std::string_view::npos ? std::string_view::npos : comma - pos));
+        if (candidate == "*") return true;
+        if (candidate.starts_with("W/")) candidate.remove_prefix(2);
+        if (candidate == etag) return true;
+        if (comma == std::string_view::npos) break;
+        pos = comma + 1;
     }
+    return false;
+}
+
+// Range is only honoured when an If-Range validator, if sent, still names this exact content.
+[[nodiscard]] ByteRange requestedRange(
+    const vh::protocols::http::request& req,
+    const std::optional<std::string>& etag,
+    const uint64_t size
+) {
+    const auto range = req.find(vh::protocols::http::field::range);
+    if (range == req.end()) return { .kind = ByteRange::Kind::Full, .offset = 0, .length = size };
 
-    [[nodiscard]] std::vector<uint8_t> finish() && {
-        if (data_.size() > std::numeric_limits<uint32_t>::max())
-            throw std::runtime_error("Archive exceeds ZIP32 size limit");
+    if (const auto ifRange = req.find(vh::protocols::http::field::if_range); ifRange != req.end())
+        if (!etag || trimmed(headerValue(*ifRange)) != *etag)
+            return { .kind = ByteRange::Kind::Full, .offset = 0, .length = size };
 
-        const auto centralDirectoryOffset = static_cast<uint32_t>(data_.size());
-        for (const auto& record : records_) appendCentralDirectoryRecord(record);
+    return parseByteRange(headerValue(*range), size);
+}
 
-        if (data_.size() > std::numeric_limits<uint32_t>::max())
-            throw std::runtime_error("Archive exceeds ZIP32 size limit");
-        const auto centralDirectorySize = static_cast<uint32_t>(data_.size() - centralDirectoryOffset);
+template<class Body>
+void setFileDownloadHeaders(
+    vh::protocols::http::response<Body>& res,
+    const std::optional<std::string>& etag
+) {
+    res.set(vh::protocols::http::field::accept_ranges, "bytes");
+    if (!etag) return;
+    res.set(vh::protocols::http::field::etag, *etag);
+    // Clients may keep a private copy as long as they revalidate it against the ETag
+    res.set(vh::protocols::http::field::cache_control, "private, no-cache");
+}
 
-        appendU32(data_, 0x06054b50u);
-        appendU16(data_, 0);
-        appendU16(data_, 0);
-        appendU16(data_, static_cast<uint16_t>(records_.size()));
-        appendU16(data_, static_cast<uint16_t>(records_.size()));
-        appendU32(data_, centralDirectorySize);
-        appendU32(data_, centralDirectoryOffset);
-        appendU16(data_, 0);
+template<class Body>
+void setContentRange(vh::protocols::http::response<Body>& res, const ByteRange& range, const uint64_t size) {
+    if (range.kind != ByteRange::Kind::Partial) return;
+    res.result(vh::protocols::http::status::partial_content);
+    res.set(vh::protocols::http::field::content_range,
+            "bytes " + std::to_string(range.offset) + "-" + std::to_string(range.offset + range.length - 1) +
+            "/" + std::to_string(size));
+}
 
-        ensureArchiveSize();
-        return std::move(data_);
-    }
+// Anything with a local backing file streams from disk. Cloud files that only exist
+// remotely still come down whole, so they keep the buffered size limit.
+[[nodiscard]] bool streamsFromLocalCopy(
+    const std::shared_ptr<vh::storage::Engine>& engine,
+    const std::shared_ptr<File>& file
+) {
+    if (engine->type() != vh::storage::StorageType::Cloud) return true;
+    return !file->backing_path.empty() && std::filesystem::is_regular_file(file->backing_path);
+}
 
-private:
-    void appendEntry(const std::string& name, const std::vector<uint8_t>& data, const bool directory) {
-        if (records_.size() >= kMaxArchiveEntries)
-            throw std::runtime_error("Archive entry count exceeds limit");
-        if (name.size() > std::numeric_limits<uint16_t>::max())
-            throw std::runtime_error("Archive entry name is too long");
-        if (data.size() > std::numeric_limits<uint32_t>::max())
-            throw std::runtime_error("Archive entry exceeds ZIP32 size limit");
-        if (data_.size() > std::numeric_limits<uint32_t>::max())
-            throw std::runtime_error("Archive exceeds ZIP32 size limit");
-
-        const auto crc = static_cast<uint32_t>(crc32(0L, data.data(), static_cast<uInt>(data.size())));
-        const auto size = static_cast<uint32_t>(data.size());
-        const auto localOffset = static_cast<uint32_t>(data_.size());
-
-        appendU32(data_, 0x04034b50u);
-        appendU16(data_, 20);
-        appendU16(data_, 0);
-        appendU16(data_, 0);
-        appendU16(data_, 0);
-        appendU16(data_, kZipDateJanOne1980);
-        appendU32(data_, crc);
-        appendU32(data_, size);
-        appendU32(data_, size);
-        appendU16(data_, static_cast<uint16_t>(name.size()));
-        appendU16(data_, 0);
-        appendBytes(data_, name);
-        appendBytes(data_, data);
-        records_.push_back({
-            .name = name,
-            .crc = crc,
-            .size = size,
-            .localHeaderOffset = localOffset,
-            .directory = directory
-        });
-        ensureArchiveSize();
-    }
+// The local backing copy as the database describes it. Content-Length and the decryptor
+// both follow `encryption`, so a stale cached IV can't advertise one size and send another.
+struct LocalPayload {
+    uint64_t size = 0;
+    std::optional<vh::storage::Engine::EncryptionContext> encryption;
+};
 
-    void appendCentralDirectoryRecord(const ZipEntryRecord& record) {
-        appendU32(data_, 0x02014b50u);
-        appendU16(data_, 20);
-        appendU16(data_, 20);
-        appendU16(data_, 0);
-        appendU16(data_, 0);
-        appendU16(data_, 0);
-        appendU16(data_, kZipDateJanOne1980);
-        appendU32(data_, record.crc);
-        appendU32(data_, record.size);
-        appendU32(data_, record.size);
-        appendU16(data_, static_cast<uint16_t>(record.name.size()));
-        appendU16(data_, 0);
-        appendU16(data_, 0);
-        appendU16(data_, 0);
-        appendU16(data_, 0);
-        appendU32(data_, record.directory ? 0x00100000u : 0);
-        appendU32(data_, record.localHeaderOffset);
-        appendBytes(data_, record.name);
-    }
+// Plaintext size of the local backing copy, which for encrypted files drops the GCM tag.
+[[nodiscard]] LocalPayload localPayload(
+    const std::shared_ptr<vh::storage::Engine>& engine,
+    const std::shared_ptr<File>& file
+) {
+    std::error_code ec;
+    const auto stored = std::filesystem::file_size(file->backing_path, ec);
+    if (ec) throw std::runtime_error("Download file not found: " + file->path.string());
+
+    LocalPayload payload{ .size = stored, .encryption = engine->encryptionContext(file) };
+    if (!payload.encryption) return payload;
+    if (stored < vh::crypto::util::AES_TAG_SIZE)
+        throw std::runtime_error("Download file is truncated: " + file->path.string());
+    payload.size = stored - vh::crypto::util::AES_TAG_SIZE;
+    return payload;
+}
 
-    void ensureArchiveSize() const {
-        if (data_.size() > kMaxArchiveBytes)
-            throw std::runtime_error("Archive output exceeds limit");
-    }
+// Ranges past offset 0 decrypt as plain CTR and cannot be authenticated; whole-file
+// sources verify the GCM tag before their last chunk goes out.
+[[nodiscard]] vh::protocols::http::model::download::Source openLocalSource(
+    const std::shared_ptr<vh::storage::Engine>& engine,
+    const std::shared_ptr<File>& file,
+    const LocalPayload& payload,
+    const uint64_t offset,
+    const uint64_t length
+) {
+    using vh::protocols::http::model::download::Source;
+    if (!payload.encryption) return Source(file->backing_path, offset, length);
+    return Source(file->backing_path, offset, length, engine->decryptor(*payload.encryption, offset));
+}
 
-    std::vector<uint8_t> data_;
-    std::vector<ZipEntryRecord> records_;
+struct FileDownload {
+    vh::protocols::http::model::preview::Response response;
+    uint64_t bytes = 0;
+    bool served = false;
 };
 
-[[nodiscard]] std::vector<uint8_t> readDownloadFile(
+[[nodiscard]] FileDownload serveDownloadFile(
+    const vh::protocols::http::request& req,
     const std::shared_ptr<vh::storage::Engine>& engine,
     const std::shared_ptr<File>& file
 ) {
+    using namespace vh::protocols::http;
+
     if (!engine || !file) throw std::runtime_error("Download file is unavailable");
-    if (file->size_bytes > kMaxHttpDownloadFileBytes)
-        throw std::runtime_error("Download file exceeds maximum size");
-    if (file->size_bytes == 0) return {};
 
-    std::vector<uint8_t> bytes;
-    if (engine->type() == vh::storage::StorageType::Cloud) {
-        const auto cloud = std::dynamic_pointer_cast<vh::storage::CloudEngine>(engine);
-        if (!cloud) throw std::runtime_error("Cloud storage engine is unavailable");
-        bytes = cloud->downloadToBuffer(file->path);
-        if (cloud->remoteFileIsEncrypted(file->path))
-            bytes = cloud->decrypt(engine->vault->id, file->path, bytes);
-    } else {
-        bytes = engine->decrypt(file);
+    const auto mime = file->mime_type ? *file->mime_type : std::string{"application/octet-stream"};
+    const auto etag = strongETag(*file);
+
+    if (etag)
+        if (const auto inm = req.find(field::if_none_match); inm != req.end() && etagListMatches(headerValue(*inm), *etag)) {
+            string_response res{status::not_modified, req.version()};
+            res.set(field::etag, *etag);
+            res.set(field::cache_control, "private, no-cache");
+            res.keep_alive(req.keep_alive());
+            return FileDownload{ .response = std::move(res) };
+        }
+
+    const auto unsatisfiable = [&](const uint64_t size) {
+        auto res = Router::makeErrorResponse(req, "Requested range not satisfiable", status::range_not_satisfiable);
+        std::get<string_response>(res).set(field::content_range, "bytes */" + std::to_string(size));
+        return FileDownload{ .response = std::move(res) };
+    };
+
+    if (file->size_bytes == 0) {
+        auto res = Router::makeDownloadResponse(req, {}, mime, file->name);
+        std::visit([&](auto& r) { setFileDownloadHeaders(r, etag); }, res);
+        return { .response = std::move(res), .served = true };
     }
 
-    if (bytes.size() > kMaxHttpDownloadFileBytes)
-        throw std::runtime_error("Download file exceeds maximum size");
-    return bytes;
+    if (!streamsFromLocalCopy(engine, file)) {
+        auto bytes = readDownloadFile(engine, file);
+        const auto size = static_cast<uint64_t>(bytes.size());
+        const auto range = requestedRange(req, etag, size);
+        if (range.kind == ByteRange::Kind::Unsatisfiable) return unsatisfiable(size);
+
+        if (range.kind == ByteRange::Kind::Partial)
+            bytes = std::vector<uint8_t>(bytes.begin() + static_cast<std::ptrdiff_t>(range.offset),
+                                         bytes.begin() + static_cast<std::ptrdiff_t>(range.offset + range.length));
+
+        auto res = Router::makeDownloadResponse(req, std::move(bytes), mime, file->name);
+        std::visit([&](auto& r) {
+            setFileDownloadHeaders(r, etag);
+            setContentRange(r, range, size);
+        }, res);
+        return { .response = std::move(res), .bytes = range.length, .served = true };
+    }
+
+    const auto payload = localPayload(engine, file);
+    const auto size = payload.size;
+    const auto range = requestedRange(req, etag, size);
+    if (range.kind == ByteRange::Kind::Unsatisfiable) return unsatisfiable(size);
+
+    auto source = openLocalSource(engine, file, payload, range.offset, range.length);
+
+    model::download::Response res{
+        std::piecewise_construct,
+        std::make_tuple(std::move(source)),
+        std::make_tuple(status::ok, req.version())
+    };
+
+    res.set(field::content_type, mime.empty() ? "application/octet-stream" : mime);
+    res.set(field::content_disposition, contentDispositionValue(file->name));
+    res.set(field::cache_control, "no-store");
+    setFileDownloadHeaders(res, etag);
+    setContentRange(res, range, size);
+    res.content_length(range.length);
+    res.keep_alive(req.keep_alive());
+
+    return { .response = std::move(res), .bytes = range.length, .served = true };
 }
 
 void enforceHumanPermission(
@@ -608,25 +728,64 @@ struct ShareDownloadTarget {
     };
 }
 
-void addFileToArchive(
-    ZipBuilder& zip,
-    uint64_t& sourceBytes,
-    const std::shared_ptr<vh::storage::Engine>& engine,
-    const std::shared_ptr<File>& file,
-    const std::string& archivePath
-) {
-    if (!file) throw std::runtime_error("Archive file is unavailable");
-    if (sourceBytes + file->size_bytes > kMaxArchiveSourceBytes)
-        throw std::runtime_error("Archive source bytes exceed limit");
-
-    auto bytes = readDownloadFile(engine, file);
-    sourceBytes += bytes.size();
-    zip.addFile(archivePath, bytes);
+// Formats that are already compressed gain nothing from deflate but still pay for it.
+[[nodiscard]] bool worthDeflating(const std::shared_ptr<File>& file) {
+    if (!file->mime_type) return true;
+    const auto& mime = *file->mime_type;
+    if (mime == "image/svg+xml") return true;
+    if (mime.starts_with("image/") || mime.starts_with("video/") || mime.starts_with("audio/")) return false;
+    static constexpr std::array<std::string_view, 9> compressed{
+        "application/zip", "application/gzip", "application/x-gzip", "application/x-7z-compressed",
+        "application/x-rar-compressed", "application/x-xz", "application/zstd", "application/x-bzip2",
+        "application/pdf"
+    };
+    return std::ranges::find(compressed, mime) == compressed.end();
 }
 
+// Directory downloads are planned up front so permission and scope failures still turn into
+// proper error responses, but only names and handles are kept; file contents are opened
+// and streamed one at a time as the archive reaches them, on the HTTP pool rather than in
+// the body writer, since a cloud-only entry is fetched whole.
+struct ArchivePlan {
+    std::vector<vh::protocols::http::model::download::ArchiveEntry> entries;
+    uint64_t sourceBytes = 0;
+
+    void addDirectory(const std::string& archivePath) {
+        reserveEntry();
+        entries.push_back({ .name = safeArchivePath(archivePath, true) });
+    }
+
+    void addFile(
+        const std::string& archivePath,
+        const std::shared_ptr<vh::storage::Engine>& engine,
+        const std::shared_ptr<File>& file
+    ) {
+        if (!engine || !file) throw std::runtime_error("Archive file is unavailable");
+        reserveEntry();
+        sourceBytes += file->size_bytes;
+
+        entries.push_back({
+            .name = safeArchivePath(archivePath, false),
+            .open = [engine, file] {
+                using vh::protocols::http::model::download::Source;
+                if (file->size_bytes == 0) return Source{};
+                if (!streamsFromLocalCopy(engine, file)) return Source(readDownloadFile(engine, file));
+                const auto payload = localPayload(engine, file);
+                return openLocalSource(engine, file, payload, 0, payload.size);
+            },
+            .deflate = worthDeflating(file)
+        });
+    }
+
+private:
+    void reserveEntry() const {
+        if (entries.size() >= kMaxArchiveEntries)
+            throw std::runtime_error("Archive entry count exceeds limit");
+    }
+};
+
 void addHumanDirectoryToArchive(
-    ZipBuilder& zip,
-    uint64_t& sourceBytes,
+    ArchivePlan& plan,
     const std::shared_ptr<vh::protocols::ws::Session>& session,
     const std::shared_ptr<vh::storage::Engine>& engine,
     const std::shared_ptr<Entry>& directory,
@@ -642,17 +801,16 @@ void addHumanDirectoryToArchive(
         const auto rel = relativeArchivePath(rootVaultPath, child->path.string());
 
         if (child->isDirectory()) {
-            zip.addDirectory(rel);
-            addHumanDirectoryToArchive(zip, sourceBytes, session, engine, child, rootVaultPath);
+            plan.addDirectory(rel);
+            addHumanDirectoryToArchive(plan, session, engine, child, rootVaultPath);
         } else {
-            addFileToArchive(zip, sourceBytes, engine, std::dynamic_pointer_cast<File>(child), rel);
+            plan.addFile(rel, engine, std::dynamic_pointer_cast<File>(child));
         }
     }
 }
 
 void addShareDirectoryToArchive(
-    ZipBuilder& zip,
-    uint64_t& sourceBytes,
+    ArchivePlan& plan,
     const ShareDownloadTarget& download,
     const vh::share::ResolvedTarget& directoryTarget,
     const std::string& rootVaultPath
@@ -681,8 +839,8 @@ void addShareDirectoryToArchive(
                 .path_mode = vh::share::TargetPathMode::ShareRelative,
                 .expected_target_type = vh::share::TargetType::Directory
             });
-            zip.addDirectory(rel);
-            addShareDirectoryToArchive(zip, sourceBytes, download, childTarget, rootVaultPath);
+            plan.addDirectory(rel);
+            addShareDirectoryToArchive(plan, download, childTarget, rootVaultPath);
         } else {
             auto childTarget = download.resolver->resolve(actor, {
                 .path = sharePath,
@@ -690,26 +848,46 @@ void addShareDirectoryToArchive(
                 .path_mode = vh::share::TargetPathMode::ShareRelative,
                 .expected_target_type = vh::share::TargetType::File
             });
-            addFileToArchive(zip, sourceBytes, download.engine, std::dynamic_pointer_cast<File>(childTarget.entry), rel);
+            plan.addFile(rel, download.engine, std::dynamic_pointer_cast<File>(childTarget.entry));
         }
     }
 }
 
-[[nodiscard]] std::vector<uint8_t> buildHumanDirectoryArchive(
+[[nodiscard]] ArchivePlan planHumanDirectoryArchive(
     const HumanDownloadTarget& target,
     const std::shared_ptr<vh::protocols::ws::Session>& session
 ) {
-    ZipBuilder zip;
-    uint64_t sourceBytes = 0;
-    addHumanDirectoryToArchive(zip, sourceBytes, session, target.engine, target.entry, target.entry->path.string());
-    return std::move(zip).finish();
+    ArchivePlan plan;
+    addHumanDirectoryToArchive(plan, session, target.engine, target.entry, target.entry->path.string());
+    return plan;
 }
 
-[[nodiscard]] std::vector<uint8_t> buildShareDirectoryArchive(const ShareDownloadTarget& target) {
-    ZipBuilder zip;
-    uint64_t sourceBytes = 0;
-    addShareDirectoryToArchive(zip, sourceBytes, target, target.target, target.target.vault_path);
-    return std::move(zip).finish();
+[[nodiscard]] ArchivePlan planShareDirectoryArchive(const ShareDownloadTarget& target) {
+    ArchivePlan plan;
+    addShareDirectoryToArchive(plan, target, target.target, target.target.vault_path);
+    return plan;
+}
+
+[[nodiscard]] vh::protocols::http::model::preview::Response makeArchiveResponse(
+    const vh::protocols::http::request& req,
+    ArchivePlan&& plan,
+    const std::string& filename
+) {
+    using namespace vh::protocols::http;
+
+    model::download::ArchiveResponse res{
+        std::piecewise_construct,
+        std::make_tuple(model::download::Archive(std::move(plan.entries))),
+        std::make_tuple(status::ok, req.version())
+    };
+
+    res.set(field::content_type, "application/zip");
+    res.set(field::content_disposition, contentDispositionValue(filename));
+    res.set(field::cache_control, "no-store");
+    // The archive length is only known once it has been written
+    if (req.version() >= 11) res.chunked(true);
+    res.keep_alive(req.version() >= 11 && req.keep_alive());
+    return res;
 }
 
 void recordShareDownloadSuccess(
@@ -767,6 +945,16 @@ Response Router::route(request&& req) {
     return makeErrorResponse(req, "Not found", status::not_found);
 }
 
+Response Router::handleMetrics(request&& req) {
+    string_response res{status::ok, req.version()};
+    res.set(field::content_type, "text/plain; version=0.0.4; charset=utf-8");
+    res.set(field::cache_control, "no-store");
+    res.body() = stats::Metrics::instance().prometheus();
+    res.prepare_payload();
+    res.keep_alive(req.keep_alive());
+    return res;
+}
+
 Response Router::handleAuthSession(request&& req) {
     if (vh::config::Registry::get().dev.enabled) return makeJsonResponse(req, nlohmann::json{{"ok", true}});
 
@@ -874,15 +1062,48 @@ Response Router::handlePreview(request&& req) {
     if (!pr->file->mime_type)
         return makeErrorResponse(req, "File has no mime type.", status::unsupported_media_type);
 
-    if (pr->size)
+    const bool isImage = pr->file->mime_type->starts_with("image/");
+    const bool isPdf = pr->file->mime_type->ends_with("/pdf");
+
+    // Renders are a pure function of the source bytes and the requested geometry, so they are
+    // keyed and validated by content hash; untouched full-size images are served as-is.
+    if (pr->file->content_hash && !pr->file->content_hash->empty() && (isPdf || (isImage && (pr->size || pr->scale))))
+        pr->renderKey = vh::preview::RenderCache::Key{
+            .contentHash = *pr->file->content_hash,
+            .page = isPdf ? pr->page : 0,
+            .geometry = pr->geometry()
+        };
+
+    const auto etag = pr->renderKey ? std::optional(pr->renderKey->etag()) : std::nullopt;
+    const auto withValidators = [&](Response res) {
+        if (etag)
+            std::visit([&](auto& r) {
+                if (r.result() != status::ok) return;
+                r.set(field::etag, *etag);
+                r.set(field::cache_control, "private, no-cache");
+            }, res);
+        return res;
+    };
+
+    if (etag)
+        if (const auto inm = req.find(field::if_none_match); inm != req.end() && etagListMatches(headerValue(*inm), *etag)) {
+            string_response res{status::not_modified, req.version()};
+            res.set(field::etag, *etag);
+            res.set(field::cache_control, "private, no-cache");
+            res.keep_alive(req.keep_alive());
+            return res;
+        }
+
+    // Disk thumbnails only ever hold the first page
+    if (pr->size && pr->page == 0)
         if (auto data = tryCacheRead(pr->file, pr->engine->paths->thumbnailRoot, *pr->size); !data.empty())
-            return makeResponse(req, std::move(data), "image/jpeg", true);
+            return withValidators(makeResponse(req, std::move(data), "image/jpeg", true));
 
-    if (pr->file->mime_type->starts_with("image/") || pr->file->mime_type->ends_with("/pdf")) {
+    if (isImage || isPdf) {
         ScopedOpTimer timer(runtime::Deps::get().httpCacheStats.get());
-        return pr->file->mime_type->starts_with("image/")
+        return withValidators(isImage
                    ? handler::preview::Image::handle(std::move(req), std::move(pr))
-                   : handler::preview::Pdf::handle(std::move(req), std::move(pr));
+                   : handler::preview::Pdf::handle(std::move(req), std::move(pr)));
     }
 
     return makeErrorResponse(
@@ -912,25 +1133,16 @@ Response Router::handleDownload(request&& req) {
             if (!target.target.entry) throw std::runtime_error("Share download target not found");
 
             if (target.target.target_type == vh::share::TargetType::Directory) {
-                auto data = buildShareDirectoryArchive(target);
-                const auto bytes = data.size();
-                auto response = makeDownloadResponse(
-                    req,
-                    std::move(data),
-                    "application/zip",
-                    archiveFilenameFor(target.target.entry->name)
-                );
+                auto plan = planShareDirectoryArchive(target);
+                const auto bytes = plan.sourceBytes;
+                auto response = makeArchiveResponse(req, std::move(plan), archiveFilenameFor(target.target.entry->name));
                 recordShareDownloadSuccess(target, bytes);
                 return response;
             }
 
-            auto file = std::dynamic_pointer_cast<File>(target.target.entry);
-            auto data = readDownloadFile(target.engine, file);
-            const auto bytes = data.size();
-            const auto mime = file && file->mime_type ? *file->mime_type : std::string{"application/octet-stream"};
-            auto response = makeDownloadResponse(req, std::move(data), mime, file ? file->name : "download");
-            recordShareDownloadSuccess(target, bytes);
-            return response;
+            auto download = serveDownloadFile(req, target.engine, std::dynamic_pointer_cast<File>(target.target.entry));
+            if (download.served) recordShareDownloadSuccess(target, download.bytes);
+            return std::move(download.response);
         }
 
         if (!session || !session->user)
@@ -939,20 +1151,10 @@ Response Router::handleDownload(request&& req) {
         auto target = prepareHumanDownloadTarget(params, session);
         if (!target.entry) throw std::runtime_error("Download target not found");
 
-        if (target.entry->isDirectory()) {
-            auto data = buildHumanDirectoryArchive(target, session);
-            return makeDownloadResponse(
-                req,
-                std::move(data),
-                "application/zip",
-                archiveFilenameFor(target.entry->name)
-            );
-        }
+        if (target.entry->isDirectory())
+            return makeArchiveResponse(req, planHumanDirectoryArchive(target, session), archiveFilenameFor(target.entry->name));
 
-        auto file = std::dynamic_pointer_cast<File>(target.entry);
-        auto data = readDownloadFile(target.engine, file);
-        const auto mime = file && file->mime_type ? *file->mime_type : std::string{"application/octet-stream"};
-        return makeDownloadResponse(req, std::move(data), mime, file ? file->name : "download");
+        return serveDownloadFile(req, target.engine, std::dynamic_pointer_cast<File>(target.entry)).response;
     } catch (const std::exception& e) {
         return makeErrorResponse(req, e.what(), downloadErrorStatus(e));
     }
@@ -977,6 +1179,26 @@ Response Router::makeResponse(const request& req, std::vector<uint8_t>&& data,
     return res;
 }
 
+Response Router::makeResponse(const request& req, model::preview::SharedBody::value_type data,
+                                         const std::string& mime_type, const bool cacheHit) {
+    if (!data) throw std::invalid_argument("Shared response body is null");
+    const auto size = data->size();
+
+    shared_response res{
+        std::piecewise_construct,
+        std::make_tuple(std::move(data)),
+        std::make_tuple(status::ok, req.version())
+    };
+
+    res.set(field::content_type, mime_type);
+    res.content_length(size);
+    res.keep_alive(req.keep_alive());
+
+    if (cacheHit) runtime::Deps::get().httpCacheStats->record_hit(size);
+
+    return res;
+}
+
 Response Router::makeResponse(const request& req, file_body::value_type data,
                                          const std::string& mime_type, const bool cacheHit) {
     const auto size = data.size();
@@ -1,61 +1,207 @@
 #include "protocols/http/Session.hpp"
 #include "protocols/http/Router.hpp"
+#include "protocols/http/task/Dispatch.hpp"
+#include "concurrency/ThreadPoolManager.hpp"
+#include "config/Registry.hpp"
 #include "log/Registry.hpp"
+#include "stats/Trace.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <functional>
+#include <sys/sendfile.h>
+
+using namespace vh::concurrency;
 
 namespace vh::protocols::http {
 
-Session::Session(tcp::socket socket) : socket_(std::move(socket)) { buffer_.max_size(8192); }
+namespace net = boost::asio;
+
+namespace {
+
+const config::HttpPreviewConfig& settings() {
+    return config::Registry::get().http_preview;
+}
+
+bool isLoopbackPeer(const tcp::socket& socket) {
+    beast::error_code ec;
+    auto addr = socket.remote_endpoint(ec).address();
+    if (ec) return false;
+    if (addr.is_v6() && addr.to_v6().is_v4_mapped())
+        addr = net::ip::make_address_v4(net::ip::v4_mapped, addr.to_v6());
+    return addr.is_loopback();
+}
+
+// Runs job on the HTTP pool, or inline when there is none (never init()ed, or already torn down)
+void offload(std::function<void()> job) {
+    if (const auto& pool = ThreadPoolManager::instance().httpPool()) pool->submit(std::make_unique<task::Dispatch>(std::move(job)));
+    else job();
+}
+
+}
+
+Session::Session(tcp::socket socket) : stream_(std::move(socket)) {
+    loopback_ = isLoopbackPeer(stream_.socket());
+    const auto& cfg = settings();
+    buffer_.max_size(static_cast<std::size_t>(cfg.header_limit_kb + cfg.body_limit_kb) * 1024);
+}
 
 void Session::run() {
     do_read();
 }
 
 void Session::do_read() {
-    auto self = shared_from_this();
+    const auto& cfg = settings();
+
+    parser_.emplace();
+    parser_->header_limit(cfg.header_limit_kb * 1024);
+    parser_->body_limit(static_cast<std::uint64_t>(cfg.body_limit_kb) * 1024);
 
-    http::async_read(socket_, buffer_, req_,
+    // Doubles as the keep-alive idle timeout once the first response is out
+    stream_.expires_after(std::chrono::seconds(cfg.keep_alive_timeout_seconds));
+
+    auto self = shared_from_this();
+    http::async_read(stream_, buffer_, *parser_,
                      [self](beast::error_code ec, std::size_t bytes) {
                          self->on_read(ec, bytes);
                      });
 }
 
 void Session::on_read(beast::error_code ec, std::size_t bytes) {
-    if (ec == http::error::end_of_stream) return do_close();
+    if (ec == http::error::end_of_stream || ec == beast::error::timeout) return do_close();
+
+    // Over-limit requests are answered before the connection goes, so clients see why
+    if (ec == http::error::header_limit || ec == http::error::body_limit) {
+        const bool header = ec == http::error::header_limit;
+        log::Registry::http()->warn("[Session] Rejecting request: {}", ec.message());
+
+        const unsigned version = parser_ && parser_->is_header_done() ? parser_->get().version() : 11;
+        http::response<http::string_body> res{
+            header ? http::status::request_header_fields_too_large : http::status::payload_too_large, version
+        };
+        res.set(http::field::content_type, "text/plain");
+        res.body() = header ? "Request header fields too large" : "Request body too large";
+        res.prepare_payload();
+        parser_.reset();
+        return write(std::move(res), true);
+    }
 
     if (ec) {
         log::Registry::http()->error("[Session] Read error: {}", ec.message());
-        return;
+        return do_close();
     }
 
-    log::Registry::http()->debug("[Session] Read {} bytes: {}", bytes, req_.target());
+    auto req = parser_->release();
+    parser_.reset();
+    stream_.expires_never();
+
+    log::Registry::http()->debug("[Session] Read {} bytes: {}", bytes, req.target());
+
+    const auto limit = settings().max_requests_per_connection;
+    const bool last = limit != 0 && ++requests_ >= limit;
+
+    dispatch(std::move(req), last);
+}
+
+// Metrics stay on the box: only direct loopback peers, never anything relayed by a proxy
+bool Session::isMetricsScrape(const http::request<http::string_body>& req) const {
+    return loopback_ && settings().metrics_endpoint
+        && req.method() == http::verb::get && req.target() == "/metrics"
+        && req.find("X-Forwarded-For") == req.end() && req.find("X-Real-IP") == req.end();
+}
+
+void Session::dispatch(http::request<http::string_body> req, const bool last) {
+    auto self = shared_from_this();
+    const bool metrics = isMetricsScrape(req);
+
+    // Decrypting and decoding happen in Router::route, so it runs on the HTTP pool and only
+    // the socket work stays on the io threads
+    offload([self, req = std::move(req), last, metrics]() mutable {
+        const auto version = req.version();
+        auto res = std::make_shared<model::preview::Response>();
+        bool failed = false;
+
+        // Query strings can carry share tokens, so only the path goes into the trace
+        const std::string_view target(req.target().data(), req.target().size());
+        const stats::trace::Span span("http.request", target.substr(0, target.find('?')));
+        try {
+            *res = metrics ? Router::handleMetrics(std::move(req)) : Router::route(std::move(req));
+        } catch (const std::exception& e) {
+            log::Registry::http()->error("[Session] Exception during request handling: {}", e.what());
+
+            http::response<http::string_body> err{http::status::internal_server_error, version};
+            err.set(http::field::content_type, "text/plain");
+            err.body() = "Internal server error";
+            err.prepare_payload();
+            *res = std::move(err);
+            failed = true;
+        }
+
+        net::post(self->stream_.get_executor(), [self, res, last = last || failed] {
+            self->write(std::move(*res), last);
+        });
+    });
+}
 
+void Session::write(model::preview::Response&& res, const bool last) {
     auto self = shared_from_this();
 
-    try {
-        auto res = Router::route(std::move(req_));
-
-        std::visit([self](auto&& response) {
-            using T = std::decay_t<decltype(response)>;
-            auto msg = std::make_shared<T>(std::forward<decltype(response)>(response));
-            http::async_write(self->socket_, *msg,
-                              [self, msg](beast::error_code ec, std::size_t bytes) {
-                                  self->on_write(false, ec, bytes);
-                              });
-        }, std::move(res));
-    } catch (const std::exception& e) {
-        log::Registry::http()->error("[Session] Exception during request handling: {}", e.what());
-
-        http::response<http::string_body> err{http::status::internal_server_error, req_.version()};
-        err.set(http::field::content_type, "text/plain");
-        err.body() = "Internal server error";
-        err.prepare_payload();
-
-        auto err_ptr = std::make_shared<decltype(err)>(std::move(err));
-        http::async_write(socket_, *err_ptr,
-            [self, err_ptr](beast::error_code, std::size_t) {
-                self->on_write(true, {}, 0);
-            });
-    }
+    std::visit([self, last](auto&& response) {
+        using T = std::decay_t<decltype(response)>;
+        auto msg = std::make_shared<T>(std::forward<decltype(response)>(response));
+        if (last) msg->keep_alive(false);
+        const bool close = !msg->keep_alive();
+
+        // Plaintext file bodies skip userspace: write the header, then sendfile the range
+        if constexpr (std::is_same_v<T, model::download::Response>) {
+            if (msg->body().zeroCopy()) {
+                auto sr = std::make_shared<http::response_serializer<model::download::Body>>(*msg);
+                http::async_write_header(self->stream_, *sr,
+                                         [self, msg, sr, close](beast::error_code ec, std::size_t bytes) {
+                                             if (ec) return self->on_write(close, ec, bytes);
+                                             self->send_file(msg);
+                                         });
+                return;
+            }
+        }
+
+        // Archives and encrypted files are produced a chunk at a time on the HTTP pool; the
+        // serializer only drains
+        if constexpr (std::is_same_v<T, model::download::ArchiveResponse> ||
+                      std::is_same_v<T, model::download::Response>) {
+            using Body = typename T::body_type;
+            self->write_filled(msg, std::make_shared<http::response_serializer<Body>>(*msg), close);
+            return;
+        }
+
+        http::async_write(self->stream_, *msg,
+                          [self, msg, close](beast::error_code ec, std::size_t bytes) {
+                              self->on_write(close, ec, bytes);
+                          });
+    }, std::move(res));
+}
+
+template<class Body>
+void Session::write_filled(const std::shared_ptr<http::response<Body>>& msg,
+                           const std::shared_ptr<http::response_serializer<Body>>& sr, const bool close) {
+    auto self = shared_from_this();
+    http::async_write(stream_, *sr, [self, msg, sr, close](beast::error_code ec, std::size_t bytes) {
+        if (ec == http::error::need_buffer) return self->fill_body(msg, sr, close);
+        self->on_write(close, ec, bytes);
+    });
+}
+
+// Filling can mean a whole cloud object download or a decrypt, so it never runs on an io thread
+template<class Body>
+void Session::fill_body(const std::shared_ptr<http::response<Body>>& msg,
+                        const std::shared_ptr<http::response_serializer<Body>>& sr, const bool close) {
+    auto self = shared_from_this();
+    offload([self, msg, sr, close] {
+        msg->body().fill();
+        net::post(self->stream_.get_executor(), [self, msg, sr, close] {
+            self->write_filled(msg, sr, close);
+        });
+    });
 }
 
 void Session::on_write(const bool close, beast::error_code ec, const std::size_t bytes) {
@@ -63,7 +209,7 @@ void Session::on_write(const bool close, beast::error_code ec, const std::size_t
 
     if (ec) {
         log::Registry::http()->error("[Session] Write error: {}", ec.message());
-        return;
+        return do_close();
     }
 
     if (close) {
@@ -71,14 +217,48 @@ void Session::on_write(const bool close, beast::error_code ec, const std::size_t
         return;
     }
 
-    // Clear buffer and start next request
-    req_ = {};
+    // Any pipelined bytes stay in buffer_ for the next parser
     do_read();
 }
 
+void Session::send_file(const std::shared_ptr<model::download::Response>& msg) {
+    auto& body = msg->body();
+    auto& socket_ = stream_.socket();
+    beast::error_code ec;
+    if (!socket_.native_non_blocking()) socket_.native_non_blocking(true, ec);
+    if (ec) return on_write(false, ec, 0);
+
+    while (body.remaining() > 0) {
+        auto offset = static_cast<off_t>(body.position());
+        const auto chunk = std::min<uint64_t>(body.remaining(), model::download::Source::CHUNK_BYTES);
+        const auto n = ::sendfile(socket_.native_handle(), body.fd(), &offset, chunk);
+
+        if (n > 0) {
+            body.advance(static_cast<uint64_t>(n));
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            auto self = shared_from_this();
+            socket_.async_wait(tcp::socket::wait_write, [self, msg](beast::error_code waitEc) {
+                if (waitEc) return self->on_write(false, waitEc, 0);
+                self->send_file(msg);
+            });
+            return;
+        }
+
+        // A zero return means the file shrank underneath us; the peer gets a short body
+        if (n == 0) ec = http::error::partial_message;
+        else ec.assign(errno, boost::system::system_category());
+        return on_write(false, ec, 0);
+    }
+
+    on_write(!msg->keep_alive(), {}, 0);
+}
+
 void Session::do_close() {
     beast::error_code ec;
-    socket_.shutdown(tcp::socket::shutdown_send, ec);
+    stream_.socket().shutdown(tcp::socket::shutdown_send, ec);
     // ignore errors on shutdown
 }
 
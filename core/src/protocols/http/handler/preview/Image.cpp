@@ -1,38 +1,72 @@
 #include "protocols/http/handler/preview/Image.hpp"
 #include "preview/image.hpp"
+#include "preview/RenderCache.hpp"
 #include "fs/ops/file.hpp"
+#include "fs/model/File.hpp"
 #include "log/Registry.hpp"
 #include "protocols/http/model/preview/Request.hpp"
 #include "protocols/http/Router.hpp"
 
-#include <boost/beast/http/file_body.hpp>
+#include <algorithm>
+#include <array>
+#include <string_view>
 
 using namespace vh::storage;
 using namespace vh::fs::ops;
 using namespace vh::preview;
 
 namespace vh::protocols::http::handler::preview {
-    model::preview::Response handler::preview::Image::handle(request &&req,
-                                                             const std::unique_ptr<model::preview::Request> &&pr) {
-        try {
-            const auto tmpPath = decrypt_file_to_temp(pr->file, pr->engine);
+    namespace {
+        // Raster types browsers only ever render as pixels; SVG would run as script on our origin
+        constexpr std::array<std::string_view, 4> kPassthroughImageTypes{
+            "image/jpeg", "image/png", "image/gif", "image/webp"
+        };
 
+        // Stored bytes are user content, so nothing here may be sniffed or run as a document
+        model::preview::Response hardenImageResponse(model::preview::Response res) {
+            std::visit([](auto &r) {
+                r.set("X-Content-Type-Options", "nosniff");
+                r.set("Content-Security-Policy", "sandbox");
+            }, res);
+            return res;
+        }
+
+        model::preview::Response serveImage(const request &req, const std::unique_ptr<model::preview::Request> &pr) {
             if (pr->size || pr->scale) {
-                std::vector<uint8_t> resized = image::resize_and_compress(tmpPath, pr->scaleStr(), pr->sizeStr());
-                return Router::makeResponse(req, std::move(resized), "image/jpeg");
+                const auto render = [&] {
+                    // Decoded straight from memory; plaintext never touches the disk
+                    const auto plaintext = decrypt_file_to_buffer(pr->file, pr->engine);
+                    return image::resize_and_compress_buffer(plaintext.data(), plaintext.size(),
+                                                             pr->scaleStr(), pr->sizeStr());
+                };
+
+                if (!pr->renderKey) return Router::makeResponse(req, render(), "image/jpeg");
+
+                const auto [bytes, hit] = RenderCache::instance().getOrRender(*pr->renderKey, render);
+                return Router::makeResponse(req, bytes, "image/jpeg", hit);
             }
 
-            boost::beast::error_code ec;
-            http::file_body::value_type body;
-            body.open(tmpPath.c_str(), boost::beast::file_mode::scan, ec);
-            if (ec) return Router::makeErrorResponse(req, "File not found.", http::status::not_found);
+            auto plaintext = decrypt_file_to_buffer(pr->file, pr->engine);
+            const auto &mime = pr->file->mime_type;
+            if (mime && std::ranges::find(kPassthroughImageTypes, *mime) != kPassthroughImageTypes.end())
+                return Router::makeResponse(req, std::move(plaintext), *mime);
 
-            return Router::makeResponse(req, std::move(body), "image/jpeg");
+            // Everything else goes out as a full-size JPEG; SVG and other formats stb cannot decode throw
+            return Router::makeResponse(req, image::resize_and_compress_buffer(plaintext.data(), plaintext.size(),
+                                                                               std::nullopt, std::nullopt),
+                                        "image/jpeg");
+        }
+    }
+
+    model::preview::Response handler::preview::Image::handle(request &&req,
+                                                             const std::unique_ptr<model::preview::Request> &&pr) {
+        try {
+            return hardenImageResponse(serveImage(req, pr));
         } catch (const std::exception &e) {
             log::Registry::http()->error("[ImagePreviewHandler] Error handling image preview for {}: {}",
                                          pr->rel_path.string(), e.what());
-            return Router::makeErrorResponse(req, "Failed to load image: " + std::string(e.what()),
-                                             http::status::unsupported_media_type);
+            return hardenImageResponse(Router::makeErrorResponse(req, "Failed to load image: " + std::string(e.what()),
+                                                                 http::status::unsupported_media_type));
         }
     }
 }
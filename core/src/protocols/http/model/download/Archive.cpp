@@ -0,0 +1,319 @@
+#include "protocols/http/model/download/Archive.hpp"
+#include "log/Registry.hpp"
+
+#include <zlib.h>
+
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+using namespace vh::protocols::http::model::download;
+
+namespace {
+
+constexpr uint16_t kZipVersion = 45;              // ZIP64; high byte 0 makes the host MS-DOS
+constexpr uint32_t kDosDirectory = 0x10;          // FILE_ATTRIBUTE_DIRECTORY, the external attribute for that host
+constexpr uint16_t kFlagDataDescriptor = 1u << 3;
+constexpr uint16_t kFlagUtf8 = 1u << 11;
+constexpr uint16_t kMethodStored = 0, kMethodDeflate = 8;
+constexpr uint16_t kZipDateJanOne1980 = 33;
+constexpr uint32_t kMax32 = std::numeric_limits<uint32_t>::max();
+constexpr uint16_t kMax16 = std::numeric_limits<uint16_t>::max();
+
+void putU16(std::vector<uint8_t>& out, const uint16_t value) {
+    out.push_back(static_cast<uint8_t>(value & 0xffu));
+    out.push_back(static_cast<uint8_t>((value >> 8u) & 0xffu));
+}
+
+void putU32(std::vector<uint8_t>& out, const uint32_t value) {
+    putU16(out, static_cast<uint16_t>(value & 0xffffu));
+    putU16(out, static_cast<uint16_t>(value >> 16u));
+}
+
+void putU64(std::vector<uint8_t>& out, const uint64_t value) {
+    putU32(out, static_cast<uint32_t>(value & 0xffffffffu));
+    putU32(out, static_cast<uint32_t>(value >> 32u));
+}
+
+void putBytes(std::vector<uint8_t>& out, const std::string& value) {
+    out.insert(out.end(), value.begin(), value.end());
+}
+
+uint32_t clamp32(const uint64_t value) {
+    return value >= kMax32 ? kMax32 : static_cast<uint32_t>(value);
+}
+
+}
+
+Archive::Archive(std::vector<ArchiveEntry> entries) : entries_(std::move(entries)) {
+    for (const auto& entry : entries_)
+        if (entry.name.size() > kMax16) throw std::runtime_error("Archive entry name is too long");
+    records_.reserve(entries_.size());
+}
+
+Archive::Archive(Archive&& other) noexcept
+    : entries_(std::move(other.entries_)),
+      records_(std::move(other.records_)),
+      index_(other.index_),
+      state_(other.state_),
+      source_(std::move(other.source_)),
+      zstream_(std::move(other.zstream_)),
+      current_(std::move(other.current_)),
+      out_(std::move(other.out_)),
+      offset_(other.offset_),
+      parked_(std::exchange(other.parked_, {})),
+      parkedError_(other.parkedError_),
+      filled_(std::exchange(other.filled_, false)) {}
+
+Archive& Archive::operator=(Archive&& other) noexcept {
+    if (this != &other) {
+        endDeflate();
+        entries_ = std::move(other.entries_);
+        records_ = std::move(other.records_);
+        index_ = other.index_;
+        state_ = other.state_;
+        source_ = std::move(other.source_);
+        zstream_ = std::move(other.zstream_);
+        current_ = std::move(other.current_);
+        out_ = std::move(other.out_);
+        offset_ = other.offset_;
+        parked_ = std::exchange(other.parked_, {});
+        parkedError_ = other.parkedError_;
+        filled_ = std::exchange(other.filled_, false);
+    }
+    return *this;
+}
+
+Archive::~Archive() {
+    endDeflate();
+}
+
+void Archive::endDeflate() {
+    if (!zstream_) return;
+    deflateEnd(zstream_.get());
+    zstream_.reset();
+}
+
+std::span<const uint8_t> Archive::next(boost::system::error_code& ec) {
+    ec = {};
+    out_.clear();
+
+    try {
+        while (out_.size() < CHUNK_BYTES && state_ != State::Done && !ec) step(ec);
+    } catch (const std::exception& e) {
+        log::Registry::http()->error("[download::Archive] Failed to stream entry {}: {}",
+                                     index_ < entries_.size() ? entries_[index_].name : std::string{}, e.what());
+        ec = boost::system::errc::make_error_code(boost::system::errc::io_error);
+    }
+
+    if (ec) return {};
+    offset_ += out_.size();
+    return out_;
+}
+
+void Archive::fill() {
+    parked_ = next(parkedError_);
+    filled_ = true;
+}
+
+std::span<const uint8_t> Archive::take(boost::system::error_code& ec) {
+    filled_ = false;
+    ec = parkedError_;
+    return std::exchange(parked_, {});
+}
+
+void Archive::step(boost::system::error_code& ec) {
+    switch (state_) {
+    case State::Header: {
+        if (index_ == entries_.size()) {
+            state_ = State::Central;
+            return;
+        }
+
+        const auto& entry = entries_[index_];
+        current_ = Record{
+            .name = entry.name,
+            .localHeaderOffset = offset_ + out_.size(),
+            .method = entry.open && entry.deflate ? kMethodDeflate : kMethodStored,
+            .directory = !entry.open
+        };
+        writeLocalHeader(current_);
+
+        if (current_.directory) {
+            records_.push_back(std::move(current_));
+            ++index_;
+            return;
+        }
+
+        source_ = entry.open();
+        if (current_.method == kMethodDeflate) {
+            zstream_ = std::make_unique<z_stream>();
+            if (deflateInit2(zstream_.get(), Z_BEST_SPEED, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+                zstream_.reset();
+                throw std::runtime_error("Failed to initialize deflate stream");
+            }
+        }
+        state_ = State::Data;
+        return;
+    }
+
+    case State::Data: {
+        const auto chunk = source_.next(ec);
+        if (ec) return;
+
+        const bool last = chunk.empty();
+        if (!last) {
+            current_.crc = static_cast<uint32_t>(crc32(current_.crc, chunk.data(), static_cast<uInt>(chunk.size())));
+            current_.size += chunk.size();
+        }
+        writeData(chunk, last);
+        if (last) state_ = State::Descriptor;
+        return;
+    }
+
+    case State::Descriptor:
+        endDeflate();
+        source_ = Source{};
+
+        putU32(out_, 0x08074b50u);
+        putU32(out_, current_.crc);
+        putU64(out_, current_.compressed);
+        putU64(out_, current_.size);
+
+        records_.push_back(std::move(current_));
+        ++index_;
+        state_ = State::Header;
+        return;
+
+    case State::Central:
+        writeCentralDirectory();
+        state_ = State::Done;
+        return;
+
+    case State::Done:
+        return;
+    }
+}
+
+void Archive::writeLocalHeader(const Record& record) {
+    putU32(out_, 0x04034b50u);
+    putU16(out_, kZipVersion);
+    putU16(out_, kFlagUtf8 | (record.directory ? 0 : kFlagDataDescriptor));
+    putU16(out_, record.method);
+    putU16(out_, 0);
+    putU16(out_, kZipDateJanOne1980);
+    putU32(out_, 0);
+
+    // Sizes are unknown up front. The ZIP64 extra tells readers the descriptor
+    // carries 8-byte sizes, whatever they turn out to be.
+    putU32(out_, record.directory ? 0 : kMax32);
+    putU32(out_, record.directory ? 0 : kMax32);
+    putU16(out_, static_cast<uint16_t>(record.name.size()));
+    putU16(out_, record.directory ? 0 : 20);
+    putBytes(out_, record.name);
+
+    if (!record.directory) {
+        putU16(out_, 0x0001);
+        putU16(out_, 16);
+        putU64(out_, 0);
+        putU64(out_, 0);
+    }
+}
+
+void Archive::writeData(const std::span<const uint8_t> chunk, const bool finish) {
+    if (current_.method == kMethodStored) {
+        out_.insert(out_.end(), chunk.begin(), chunk.end());
+        current_.compressed += chunk.size();
+        return;
+    }
+
+    auto& z = *zstream_;
+    z.next_in = const_cast<Bytef*>(chunk.data());
+    z.avail_in = static_cast<uInt>(chunk.size());
+
+    int rc;
+    do {
+        const auto before = out_.size();
+        const auto room = deflateBound(&z, z.avail_in) + 64;
+        out_.resize(before + room);
+        z.next_out = out_.data() + before;
+        z.avail_out = static_cast<uInt>(room);
+
+        rc = deflate(&z, finish ? Z_FINISH : Z_NO_FLUSH);
+        if (rc == Z_STREAM_ERROR) throw std::runtime_error("Deflate stream error");
+
+        const auto produced = room - z.avail_out;
+        out_.resize(before + produced);
+        current_.compressed += produced;
+    } while (z.avail_in > 0 || (finish && rc != Z_STREAM_END));
+}
+
+void Archive::writeCentralDirectory() {
+    const auto centralOffset = offset_ + out_.size();
+
+    for (const auto& record : records_) {
+        std::vector<uint8_t> extra;
+        if (!record.directory) {
+            if (record.size >= kMax32) putU64(extra, record.size);
+            if (record.compressed >= kMax32) putU64(extra, record.compressed);
+        }
+        if (record.localHeaderOffset >= kMax32) putU64(extra, record.localHeaderOffset);
+
+        putU32(out_, 0x02014b50u);
+        putU16(out_, kZipVersion);
+        putU16(out_, kZipVersion);
+        putU16(out_, kFlagUtf8 | (record.directory ? 0 : kFlagDataDescriptor));
+        putU16(out_, record.method);
+        putU16(out_, 0);
+        putU16(out_, kZipDateJanOne1980);
+        putU32(out_, record.crc);
+        putU32(out_, clamp32(record.compressed));
+        putU32(out_, clamp32(record.size));
+        putU16(out_, static_cast<uint16_t>(record.name.size()));
+        putU16(out_, static_cast<uint16_t>(extra.empty() ? 0 : extra.size() + 4));
+        putU16(out_, 0);
+        putU16(out_, 0);
+        putU16(out_, 0);
+        putU32(out_, record.directory ? kDosDirectory : 0);
+        putU32(out_, clamp32(record.localHeaderOffset));
+        putBytes(out_, record.name);
+
+        if (!extra.empty()) {
+            putU16(out_, 0x0001);
+            putU16(out_, static_cast<uint16_t>(extra.size()));
+            out_.insert(out_.end(), extra.begin(), extra.end());
+        }
+    }
+
+    const auto centralSize = offset_ + out_.size() - centralOffset;
+    const auto count = static_cast<uint64_t>(records_.size());
+
+    if (count >= kMax16 || centralOffset >= kMax32 || centralSize >= kMax32) {
+        const auto zip64EndOffset = offset_ + out_.size();
+
+        putU32(out_, 0x06064b50u);
+        putU64(out_, 44);
+        putU16(out_, kZipVersion);
+        putU16(out_, kZipVersion);
+        putU32(out_, 0);
+        putU32(out_, 0);
+        putU64(out_, count);
+        putU64(out_, count);
+        putU64(out_, centralSize);
+        putU64(out_, centralOffset);
+
+        putU32(out_, 0x07064b50u);
+        putU32(out_, 0);
+        putU64(out_, zip64EndOffset);
+        putU32(out_, 1);
+    }
+
+    putU32(out_, 0x06054b50u);
+    putU16(out_, 0);
+    putU16(out_, 0);
+    putU16(out_, count >= kMax16 ? kMax16 : static_cast<uint16_t>(count));
+    putU16(out_, count >= kMax16 ? kMax16 : static_cast<uint16_t>(count));
+    putU32(out_, clamp32(centralSize));
+    putU32(out_, clamp32(centralOffset));
+    putU16(out_, 0);
+}
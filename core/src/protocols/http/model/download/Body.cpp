@@ -0,0 +1,160 @@
+#include "protocols/http/model/download/Body.hpp"
+#include "crypto/util/encrypt.hpp"
+
+#include <boost/beast/http/error.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+using namespace vh::protocols::http::model::download;
+using namespace vh::crypto::util;
+
+Source::Source() = default;
+
+Source::Source(const std::filesystem::path& path, const uint64_t offset, const uint64_t length)
+    : offset_(offset), length_(length) {
+    open(path, 0);
+}
+
+Source::Source(const std::filesystem::path& path, const uint64_t offset, const uint64_t length,
+               std::unique_ptr<AES256GCMDecryptor> decryptor)
+    : offset_(offset), length_(length), decryptor_(std::move(decryptor)) {
+    if (!decryptor_) throw std::invalid_argument("Encrypted download source requires a decryptor");
+    open(path, AES_TAG_SIZE);
+}
+
+Source::Source(std::vector<uint8_t> bytes)
+    : length_(bytes.size()), in_(std::move(bytes)) {}
+
+Source::Source(Source&& other) noexcept
+    : fd_(std::exchange(other.fd_, -1)),
+      offset_(other.offset_), length_(other.length_), sent_(other.sent_),
+      verifyTag_(other.verifyTag_),
+      decryptor_(std::move(other.decryptor_)),
+      in_(std::move(other.in_)), out_(std::move(other.out_)),
+      parked_(std::exchange(other.parked_, {})),
+      parkedError_(other.parkedError_),
+      filled_(std::exchange(other.filled_, false)) {}
+
+Source& Source::operator=(Source&& other) noexcept {
+    if (this != &other) {
+        if (fd_ >= 0) ::close(fd_);
+        fd_ = std::exchange(other.fd_, -1);
+        offset_ = other.offset_;
+        length_ = other.length_;
+        sent_ = other.sent_;
+        verifyTag_ = other.verifyTag_;
+        decryptor_ = std::move(other.decryptor_);
+        in_ = std::move(other.in_);
+        out_ = std::move(other.out_);
+        parked_ = std::exchange(other.parked_, {});
+        parkedError_ = other.parkedError_;
+        filled_ = std::exchange(other.filled_, false);
+    }
+    return *this;
+}
+
+Source::~Source() {
+    if (fd_ >= 0) ::close(fd_);
+}
+
+void Source::open(const std::filesystem::path& path, const uint64_t payloadOverhead) {
+    // Only handed to fd_ once it checks out; a throw from here leaves no destructor to close it
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        if (errno == ENOENT) throw std::runtime_error("Download file not found: " + path.string());
+        throw std::runtime_error("Failed to open download file: " + std::string(std::strerror(errno)));
+    }
+
+    struct stat st{};
+    if (::fstat(fd, &st) != 0) {
+        const auto err = std::string(std::strerror(errno));
+        ::close(fd);
+        throw std::runtime_error("Failed to stat download file: " + err);
+    }
+
+    const auto fileSize = static_cast<uint64_t>(st.st_size);
+    if (fileSize < payloadOverhead || offset_ + length_ > fileSize - payloadOverhead) {
+        ::close(fd);
+        throw std::runtime_error("Stored download file is shorter than the requested range");
+    }
+
+    fd_ = fd;
+    verifyTag_ = decryptor_ && decryptor_->authenticated() && offset_ == 0 && length_ == fileSize - payloadOverhead;
+}
+
+bool Source::readAt(uint64_t pos, std::span<uint8_t> into, boost::system::error_code& ec) const {
+    while (!into.empty()) {
+        const auto n = ::pread(fd_, into.data(), into.size(), static_cast<off_t>(pos));
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) {
+            ec.assign(errno, boost::system::system_category());
+            return false;
+        }
+        if (n == 0) {
+            ec = boost::beast::http::error::partial_message;
+            return false;
+        }
+        into = into.subspan(static_cast<size_t>(n));
+        pos += static_cast<uint64_t>(n);
+    }
+    return true;
+}
+
+std::span<const uint8_t> Source::next(boost::system::error_code& ec) {
+    ec = {};
+    if (remaining() == 0) return {};
+
+    const auto n = static_cast<size_t>(std::min<uint64_t>(remaining(), CHUNK_BYTES));
+
+    if (fd_ < 0) {
+        const std::span<const uint8_t> chunk(in_.data() + sent_, n);
+        sent_ += n;
+        return chunk;
+    }
+
+    in_.resize(n);
+    if (!readAt(position(), in_, ec)) return {};
+
+    if (decryptor_) {
+        out_.resize(n);
+        try {
+            decryptor_->update(in_, out_);
+        } catch (const std::exception&) {
+            ec = boost::system::errc::make_error_code(boost::system::errc::io_error);
+            return {};
+        }
+    }
+    sent_ += n;
+
+    // The last chunk of a whole-file stream is only released once the tag checks out,
+    // so a tampered file ends in a truncated response rather than a complete one.
+    if (verifyTag_ && remaining() == 0) {
+        std::array<uint8_t, AES_TAG_SIZE> tag{};
+        if (!readAt(offset_ + length_, tag, ec)) return {};
+        if (!decryptor_->verify(tag)) {
+            ec = boost::system::errc::make_error_code(boost::system::errc::bad_message);
+            return {};
+        }
+    }
+
+    return decryptor_ ? std::span<const uint8_t>(out_) : std::span<const uint8_t>(in_);
+}
+
+void Source::fill() {
+    parked_ = next(parkedError_);
+    filled_ = true;
+}
+
+std::span<const uint8_t> Source::take(boost::system::error_code& ec) {
+    filled_ = false;
+    ec = parkedError_;
+    return std::exchange(parked_, {});
+}
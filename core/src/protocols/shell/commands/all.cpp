@@ -15,4 +15,6 @@ void vh::protocols::shell::commands::registerAllCommands(const std::shared_ptr<R
     registerSetupCommands(r);
     registerTeardownCommands(r);
     registerStatusCommands(r);
+    registerStatsCommands(r);
+    registerTraceCommands(r);
 }
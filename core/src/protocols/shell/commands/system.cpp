@@ -1,13 +1,22 @@
 #include "protocols/shell/commands/all.hpp"
+#include "protocols/shell/commands/helpers.hpp"
 #include "protocols/shell/Router.hpp"
+#include "protocols/shell/Table.hpp"
 #include "protocols/shell/Server.hpp"
 #include "protocols/shell/util/argsHelpers.hpp"
+#include "protocols/shell/util/lineHelpers.hpp"
 #include "protocols/ProtocolService.hpp"
 #include "runtime/Manager.hpp"
 #include "runtime/Deps.hpp"
+#include "identities/User.hpp"
+#include "stats/Metrics.hpp"
+#include "stats/Trace.hpp"
 #include "usage/include/UsageManager.hpp"
+#include "CommandUsage.hpp"
 
 #include <version.h>
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
 
 #include <algorithm>
 #include <array>
@@ -100,6 +109,92 @@ CommandResult handleStatus(const CommandCall& call) {
     return ok(out.str());
 }
 
+std::string formatMicros(const uint64_t us) {
+    if (us < 1000) return fmt::format("{}us", us);
+    if (us < 1000000) return fmt::format("{:.1f}ms", static_cast<double>(us) / 1e3);
+    return fmt::format("{:.2f}s", static_cast<double>(us) / 1e6);
+}
+
+CommandResult handleStats(const CommandCall& call) {
+    if (hasKey(call, "help") || hasKey(call, "h"))
+        return usage(call.constructFullArgs());
+
+    if (!call.user->isAdmin()) return invalid("stats: only admins can view runtime metrics");
+
+    const auto usage = resolveUsage({"stats"});
+    auto series = stats::Metrics::instance().snapshot();
+    std::erase_if(series, [](const auto& s) { return s.snapshot.count == 0; });
+
+    if (hasFlag(call, usage->resolveFlag("json")->aliases)) {
+        auto out = nlohmann::json::array();
+        for (const auto& s : series) {
+            nlohmann::json j = s.snapshot;
+            j["metric"] = stats::Metrics::name(s.metric);
+            j["label"] = s.label;
+            out.push_back(std::move(j));
+        }
+        auto dumped = out.dump(4);
+        dumped.push_back('\n');
+        return ok(dumped);
+    }
+
+    if (series.empty()) return ok("No latency samples recorded yet");
+
+    Table tbl({
+        {"Metric", Align::Left, 16, 40, false, true},
+        {"Label", Align::Left, 6, 24, false, true},
+        {"Count", Align::Right, 5, 12, false, false},
+        {"p50", Align::Right, 6, 10, false, false},
+        {"p95", Align::Right, 6, 10, false, false},
+        {"p99", Align::Right, 6, 10, false, false},
+        {"Max", Align::Right, 6, 10, false, false},
+        {"Avg", Align::Right, 6, 10, false, false}
+    }, term_width());
+
+    for (const auto& s : series) {
+        const auto& h = s.snapshot;
+        tbl.add_row({
+            std::string(stats::Metrics::name(s.metric)),
+            s.label.empty() ? "-" : s.label,
+            std::to_string(h.count),
+            formatMicros(h.quantile_us(0.50)),
+            formatMicros(h.quantile_us(0.95)),
+            formatMicros(h.quantile_us(0.99)),
+            formatMicros(h.max_us),
+            formatMicros(h.sum_us / h.count)
+        });
+    }
+
+    return ok(tbl.render());
+}
+
+CommandResult handleTrace(const CommandCall& call) {
+    if (hasKey(call, "help") || hasKey(call, "h"))
+        return usage(call.constructFullArgs());
+
+    if (!call.user->isAdmin()) return invalid("trace: only admins can view request traces");
+
+    const auto usage = resolveUsage({"trace"});
+    auto& tracer = stats::trace::Tracer::instance();
+
+    if (hasFlag(call, usage->resolveFlag("clear")->aliases)) {
+        tracer.clear();
+        return ok("Trace buffer cleared");
+    }
+
+    unsigned int limit = 0;
+    if (const auto limitOpt = optVal(call, usage->resolveOptional("limit")->option_tokens)) {
+        const auto parsed = parseUInt(*limitOpt);
+        if (!parsed) return invalid("trace: --limit must be a non-negative integer");
+        limit = *parsed;
+    }
+
+    const bool slowOnly = hasFlag(call, usage->resolveFlag("slow")->aliases);
+    auto out = tracer.chromeJson(slowOnly, limit).dump();
+    out.push_back('\n');
+    return ok(out);
+}
+
 }
 
 void registerSystemCommands(const std::shared_ptr<Router>& r) {
@@ -113,4 +208,14 @@ void registerStatusCommands(const std::shared_ptr<Router>& r) {
     r->registerCommand(usageManager->resolve("status"), handleStatus);
 }
 
+void registerStatsCommands(const std::shared_ptr<Router>& r) {
+    const auto usageManager = runtime::Deps::get().shellUsageManager;
+    r->registerCommand(usageManager->resolve("stats"), handleStats);
+}
+
+void registerTraceCommands(const std::shared_ptr<Router>& r) {
+    const auto usageManager = runtime::Deps::get().shellUsageManager;
+    r->registerCommand(usageManager->resolve("trace"), handleTrace);
+}
+
 }
@@ -2,10 +2,13 @@
 
 #include "auth/session/Manager.hpp"
 #include "log/Registry.hpp"
+#include "log/Lazy.hpp"
 #include "protocols/ws/Session.hpp"
 #include "protocols/ws/ShareRateLimit.hpp"
 #include "protocols/ws/core/handler_templates.hpp"
 #include "runtime/Deps.hpp"
+#include "stats/Metrics.hpp"
+#include "stats/Trace.hpp"
 
 #include <algorithm>
 #include <array>
@@ -31,31 +34,35 @@ ShareRateLimit& shareRateLimit() {
 }
 
 void Router::registerWs(const std::string& cmd, RawWsHandler fn) {
-    handlers_[cmd] = makeWsHandler(cmd, std::move(fn));
+    add(cmd, makeWsHandler(cmd, std::move(fn)));
 }
 
 void Router::registerPayload(const std::string& cmd, RawPayloadHandler fn) {
-    handlers_[cmd] = makePayloadHandler(cmd, std::move(fn));
+    add(cmd, makePayloadHandler(cmd, std::move(fn)));
 }
 
 void Router::registerPayloadOnly(const std::string &cmd, RawPayloadHandlerOnly fn) {
-    handlers_[cmd] = makePayloadOnlyHandler(cmd, std::move(fn));
+    add(cmd, makePayloadOnlyHandler(cmd, std::move(fn)));
 }
 
 void Router::registerHandlerWithToken(const std::string& cmd, RawHandlerWithToken fn) {
-    handlers_[cmd] = makeHandlerWithToken(cmd, std::move(fn));
+    add(cmd, makeHandlerWithToken(cmd, std::move(fn)));
 }
 
 void Router::registerSessionOnlyHandler(const std::string& cmd, RawSessionOnly fn) {
-    handlers_[cmd] = makeSessionOnlyHandler(cmd, std::move(fn));
+    add(cmd, makeSessionOnlyHandler(cmd, std::move(fn)));
 }
 
 void Router::registerEmptyHandler(const std::string& cmd, RawEmpty fn) {
-    handlers_[cmd] = makeEmptyHandler(cmd, std::move(fn));
+    add(cmd, makeEmptyHandler(cmd, std::move(fn)));
 }
 
 void Router::registerHandler(const std::string& cmd, Handler h) {
-    handlers_[cmd] = std::move(h);
+    add(cmd, std::move(h));
+}
+
+void Router::add(const std::string& cmd, Handler h) {
+    handlers_[cmd] = {std::move(h), &stats::Metrics::instance().histogram(stats::Metric::WsHandler, cmd)};
 }
 
 bool Router::isPublicShareCommand(const std::string_view command) {
@@ -182,7 +189,7 @@ void Router::routeMessage(json&& msg, const SessionPtr& session) {
             return;
         }
 
-        log::Registry::ws()->debug("[Router] Routing message: {}", msg.dump());
+        log::Registry::ws()->debug("[Router] Routing message: {}", log::lazy([&] { return msg.dump(); }));
 
         auto command = msg.at("command").get<std::string>();
         const std::string accessToken = msg.value("token", "");
@@ -209,12 +216,18 @@ void Router::routeMessage(json&& msg, const SessionPtr& session) {
                 command,
                 session->ipAddress.empty() ? "unknown" : session->ipAddress
             );
-            Response::ERROR(std::move(command), std::move(msg), "Share command rate limit exceeded. Try again later.")(session);
+            const auto reason = command.starts_with("auth.") ? "Too many attempts. Try again later."
+                                                             : "Share command rate limit exceeded. Try again later.";
+            Response::ERROR(std::move(command), std::move(msg), reason)(session);
             return;
         }
 
-        if (handlers_.contains(command)) handlers_[command](std::move(msg), session);
-        else {
+        // Handlers run concurrently across sessions, so only ever read the table here
+        if (const auto it = handlers_.find(command); it != handlers_.end()) {
+            const stats::trace::Span span("ws.handler", command);
+            const stats::ScopedTimer timer(*it->second.latency);
+            it->second.handler(std::move(msg), session);
+        } else {
             log::Registry::ws()->warn("[Router] Unknown command: {}", command);
             Response::ERROR(std::move(command), std::move(msg), "Unknown command")(session);
         }
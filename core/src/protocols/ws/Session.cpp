@@ -6,6 +6,8 @@
 #include "log/Registry.hpp"
 #include "protocols/ws/Router.hpp"
 #include "protocols/ws/handler/fs/Upload.hpp"
+#include "protocols/ws/task/Dispatch.hpp"
+#include "concurrency/ThreadPoolManager.hpp"
 #include "runtime/Deps.hpp"
 #include "identities/User.hpp"
 #include "protocols/cookie.hpp"
@@ -17,6 +19,7 @@
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
 #include <boost/asio.hpp>
+#include <algorithm>
 #include <cstddef>
 #include <string_view>
 
@@ -30,6 +33,10 @@ namespace asio       = boost::asio;
 
 constexpr std::size_t kWebSocketReadBufferMaxBytes = 1024u * 1024u;
 
+unsigned int maxInFlightPerSession() {
+    return std::max(1u, vh::config::Registry::get().websocket.max_in_flight_per_session);
+}
+
 bool isShareHandshakeTarget(const std::string_view target) {
     constexpr std::string_view sharePath{"/ws/share"};
     return target == sharePath ||
@@ -69,6 +76,7 @@ std::string Session::getUserAgent() const {
 
 void Session::setAuthenticatedUser(const std::shared_ptr<User>& u) {
     clearShareSession();
+    verifiedToken.clear();
     user = u;
     mode_ = SessionMode::Human;
     if (!tokens->refreshToken) throw std::runtime_error("Cannot set authenticated user without a refresh token in session");
@@ -280,7 +288,15 @@ void Session::send(json message) {
     auto self = shared_from_this();
 
     asio::post(strand_, [self, payload = std::move(payload)]() mutable {
-        self->writeQueue_.push_back(std::move(payload));
+        self->writeQueue_.push_back({ .payload = std::move(payload), .binary = false });
+        self->maybeStartWrite();
+    });
+}
+
+void Session::sendBinary(std::string frame) {
+    // ws_ is only read on the strand; doWrite drops the queue once close() has reset it
+    asio::post(strand_, [self = shared_from_this(), frame = std::move(frame)]() mutable {
+        self->writeQueue_.push_back({ .payload = std::move(frame), .binary = true });
         self->maybeStartWrite();
     });
 }
@@ -298,8 +314,9 @@ void Session::doWrite() {
         return;
     }
 
+    ws_->binary(writeQueue_.front().binary);
     ws_->async_write(
-        asio::buffer(writeQueue_.front()),
+        asio::buffer(writeQueue_.front().payload),
         asio::bind_executor(
             strand_,
             [self = shared_from_this()](const beast::error_code& ec, std::size_t bytesWritten) {
@@ -365,31 +382,80 @@ void Session::onRead(const beast::error_code& ec, std::size_t) {
         return close();
     }
 
+    auto self = shared_from_this();
+
     if (ws_->got_binary()) {
-        try {
-            uploadHandler_->handleBinaryFrame(buffer_);
-        } catch (const std::exception& ex) {
-            log::Registry::ws()->debug("[ws::Session] Error processing binary upload frame: {}", ex.what());
-            sendInternalError();
-        } catch (...) {
-            log::Registry::ws()->debug("[ws::Session] Unknown error while processing binary upload frame");
-            sendInternalError();
-        }
+        // Hand the frame to the job and start the next read on a fresh buffer
+        auto frame = std::make_shared<beast::flat_buffer>(std::move(buffer_));
+        buffer_ = beast::flat_buffer{};
+        buffer_.max_size(kWebSocketReadBufferMaxBytes);
+
+        enqueueMessage([self, frame] {
+            try {
+                self->uploadHandler_->handleBinaryFrame(*frame);
+            } catch (const std::exception& ex) {
+                log::Registry::ws()->debug("[ws::Session] Error processing binary upload frame: {}", ex.what());
+                self->sendInternalError();
+            } catch (...) {
+                log::Registry::ws()->debug("[ws::Session] Unknown error while processing binary upload frame");
+                self->sendInternalError();
+            }
+        });
     } else {
-        try {
-            const auto text = beast::buffers_to_string(buffer_.data());
-            router_->routeMessage(json::parse(text), shared_from_this());
-        } catch (const std::exception& ex) {
-            log::Registry::ws()->debug("[ws::Session] Error parsing message: {}", ex.what());
-            sendParseError(std::string("Failed to parse message: ") + ex.what());
-            // NOTE: we still continue reading (keeps session alive after a bad frame)
-        } catch (...) {
-            log::Registry::ws()->debug("[ws::Session] Unknown error while processing message");
-            sendInternalError();
-        }
+        auto text = beast::buffers_to_string(buffer_.data());
+        buffer_.consume(buffer_.size());
+
+        enqueueMessage([self, text = std::move(text)] {
+            try {
+                self->router_->routeMessage(json::parse(text), self);
+            } catch (const std::exception& ex) {
+                log::Registry::ws()->debug("[ws::Session] Error parsing message: {}", ex.what());
+                self->sendParseError(std::string("Failed to parse message: ") + ex.what());
+                // NOTE: we still continue reading (keeps session alive after a bad frame)
+            } catch (...) {
+                log::Registry::ws()->debug("[ws::Session] Unknown error while processing message");
+                self->sendInternalError();
+            }
+        });
     }
 
-    buffer_.consume(buffer_.size());
+    // Backpressure: stop pulling frames off the socket while this client has too much queued
+    if (pending_.size() + (dispatching_ ? 1 : 0) >= maxInFlightPerSession()) readPaused_ = true;
+    else doRead();
+}
+
+void Session::enqueueMessage(std::function<void()> job) {
+    pending_.push_back(std::move(job));
+    dispatchNext();
+}
+
+void Session::dispatchNext() {
+    if (dispatching_ || pending_.empty()) return;
+    dispatching_ = true;
+
+    auto job = std::move(pending_.front());
+    pending_.pop_front();
+
+    auto run = [self = shared_from_this(), job = std::move(job)] {
+        try { job(); }
+        catch (...) { log::Registry::ws()->debug("[ws::Session] Unhandled exception escaped message dispatch"); }
+        asio::post(self->strand_, [self] { self->onDispatchComplete(); });
+    };
+
+    if (const auto& pool = concurrency::ThreadPoolManager::instance().wsPool()) pool->submit(std::make_shared<task::Dispatch>(std::move(run)));
+    else run();
+}
+
+void Session::onDispatchComplete() {
+    dispatching_ = false;
+    resumeReadIfPaused();
+    dispatchNext();
+}
+
+void Session::resumeReadIfPaused() {
+    if (!readPaused_ || closing_.load()) return;
+    if (pending_.size() + (dispatching_ ? 1 : 0) >= maxInFlightPerSession()) return;
+    readPaused_ = false;
     doRead();
 }
 
@@ -1,6 +1,7 @@
 #include "protocols/ws/ShareRateLimit.hpp"
 
 #include "protocols/ws/Session.hpp"
+#include "identities/User.hpp"
 #include "share/Principal.hpp"
 #include "share/Token.hpp"
 
@@ -16,6 +17,9 @@ using vh::share::TokenKind;
 [[nodiscard]] std::optional<RateLimitPolicy> policyFor(const std::string_view command) {
     using namespace std::chrono_literals;
 
+    // Each attempt costs an Argon2 verification, so refuse them before they reach the executor
+    if (command == "auth.login" || command == "auth.user.change_password")
+        return RateLimitPolicy{.max_attempts = 10, .window = 5min};
     if (command == "share.session.open")
         return RateLimitPolicy{.max_attempts = 12, .window = 5min};
     if (command == "share.email.challenge.start")
@@ -90,6 +94,16 @@ using vh::share::TokenKind;
     const auto& payload = payloadOf(message);
     const auto ip = clientIp(session);
 
+    if (command == "auth.login") {
+        const auto name = optionalString(payload, "name");
+        return std::format("{}|ip:{}|user:{}", command, ip, name.empty() ? "none" : name);
+    }
+
+    // Keyed on the authenticated account, so one user's guesses never spend another's budget
+    if (command == "auth.user.change_password") {
+        return std::format("{}|ip:{}|user:{}", command, ip, session.user ? std::to_string(session.user->id) : "none");
+    }
+
     if (command == "share.session.open") {
         return std::format("{}|ip:{}|{}", command, ip, tokenLookupKey(payload, "public_token", TokenKind::PublicShare));
     }
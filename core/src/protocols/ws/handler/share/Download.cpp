@@ -2,6 +2,7 @@
 
 #include "fs/model/File.hpp"
 #include "protocols/ws/Session.hpp"
+#include "protocols/ws/model/TransferFrame.hpp"
 #include "runtime/Deps.hpp"
 #include "share/Manager.hpp"
 #include "share/Principal.hpp"
@@ -97,6 +98,10 @@ std::unordered_map<std::string, TransferContext>& transfers() {
     return std::make_shared<DefaultDownloadReader>();
 }
 
+void defaultFrameSink(const std::shared_ptr<Session>& session, std::string frame) {
+    session->sendBinary(std::move(frame));
+}
+
 [[nodiscard]] Download::ManagerFactory& managerFactory() {
     static Download::ManagerFactory factory = defaultManager;
     return factory;
@@ -112,6 +117,11 @@ std::unordered_map<std::string, TransferContext>& transfers() {
     return factory;
 }
 
+[[nodiscard]] Download::FrameSink& frameSink() {
+    static Download::FrameSink sink = defaultFrameSink;
+    return sink;
+}
+
 [[nodiscard]] std::shared_ptr<vh::share::Manager> manager() {
     auto instance = managerFactory()();
     if (!instance) throw std::runtime_error("Share manager is unavailable");
@@ -416,6 +426,9 @@ void revalidateTransferTarget(
     const auto transferId = body.at("transfer_id").get<std::string>();
     const auto offset = body.at("offset").get<uint64_t>();
     const auto length = body.value("length", kDefaultChunkSize);
+    const auto encoding = body.value("encoding", std::string("base64"));
+    if (encoding != "base64" && encoding != "binary")
+        throw std::invalid_argument("Share download chunk encoding must be base64 or binary");
 
     auto mgr = manager();
     auto resolver = share_download_handler_detail::resolver();
@@ -433,14 +446,23 @@ void revalidateTransferTarget(
                         vh::share::AuditStatus::Success, chunk.bytes_sent);
         }
 
-        return {
+        json response = {
             {"transfer_id", transferId},
             {"offset", offset},
             {"bytes", chunk.bytes.size()},
-            {"data_base64", base64Encode(chunk.bytes)},
+            {"encoding", encoding},
             {"next_offset", chunk.next_offset},
             {"complete", chunk.complete}
         };
+
+        // Binary chunks travel as a TransferFrame ahead of this response, which stays as the ack
+        if (encoding == "binary")
+            frameSink()(session, model::TransferFrame::encode(
+                transferId, offset, chunk.complete ? model::TransferFrame::Final : model::TransferFrame::None, chunk.bytes));
+        else
+            response["data_base64"] = base64Encode(chunk.bytes);
+
+        return response;
     } catch (const std::exception& e) {
         eraseTransfer(transferId);
         appendAudit(*mgr, transfer.principal_snapshot, "share.download.fail", auditTarget(transfer),
@@ -520,6 +542,15 @@ void Download::resetReaderFactoryForTesting() {
     dl_detail::readerFactory() = dl_detail::defaultReader;
 }
 
+void Download::setFrameSinkForTesting(FrameSink sink) {
+    if (!sink) throw std::invalid_argument("Share download frame sink is required");
+    dl_detail::frameSink() = std::move(sink);
+}
+
+void Download::resetFrameSinkForTesting() {
+    dl_detail::frameSink() = dl_detail::defaultFrameSink;
+}
+
 void Download::resetTransfersForTesting() {
     std::scoped_lock lock(dl_detail::transferMutex());
     dl_detail::transfers().clear();
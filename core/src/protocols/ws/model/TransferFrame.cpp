@@ -0,0 +1,61 @@
+#include "protocols/ws/model/TransferFrame.hpp"
+
+#include <boost/uuid/string_generator.hpp>
+#include <boost/uuid/uuid.hpp>
+#include <boost/uuid/uuid_io.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+using namespace vh::protocols::ws::model;
+
+namespace {
+
+void putU64(char* out, const uint64_t value) {
+    for (int i = 0; i < 8; ++i) out[i] = static_cast<char>((value >> (56 - 8 * i)) & 0xffu);
+}
+
+uint64_t getU64(const uint8_t* in) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) value = (value << 8u) | in[i];
+    return value;
+}
+
+}
+
+std::string TransferFrame::encode(const std::string_view transferId, const uint64_t offset, const uint8_t flags,
+                                  const std::span<const uint8_t> payload) {
+    boost::uuids::uuid id;
+    try {
+        id = boost::uuids::string_generator()(transferId.begin(), transferId.end());
+    } catch (const std::exception&) {
+        throw std::invalid_argument("Transfer frame id must be a UUID");
+    }
+
+    std::string frame(HEADER_BYTES + payload.size(), '\0');
+    frame[0] = static_cast<char>(VERSION);
+    frame[1] = static_cast<char>(flags);
+    std::memcpy(frame.data() + 4, id.data, id.size());
+    putU64(frame.data() + 20, offset);
+    if (!payload.empty()) std::memcpy(frame.data() + HEADER_BYTES, payload.data(), payload.size());
+    return frame;
+}
+
+TransferFrame TransferFrame::decode(const std::span<const uint8_t> frame) {
+    if (frame.size() < HEADER_BYTES) throw std::invalid_argument("Transfer frame is shorter than its header");
+    if (frame[0] != VERSION) throw std::invalid_argument("Unsupported transfer frame version");
+
+    TransferFrame out;
+    out.flags = frame[1];
+    std::copy_n(frame.begin() + 4, out.transferId.size(), out.transferId.begin());
+    out.offset = getU64(frame.data() + 20);
+    out.payload = frame.subspan(HEADER_BYTES);
+    return out;
+}
+
+std::string TransferFrame::transferIdString() const {
+    boost::uuids::uuid id;
+    std::copy(transferId.begin(), transferId.end(), id.begin());
+    return boost::uuids::to_string(id);
+}
@@ -0,0 +1,109 @@
+#include "rbac/fs/glob/Automaton.hpp"
+#include "rbac/fs/glob/model/Token.hpp"
+
+#include <algorithm>
+
+namespace vh::rbac::fs::glob {
+    namespace {
+        using Token = model::Token;
+    }
+
+    Automaton::Automaton(const model::Pattern &pattern) {
+        const auto &tokens = pattern.tokens;
+
+        for (std::size_t i = 0; i < tokens.size(); ++i) {
+            switch (const auto &token = tokens[i]; token.type) {
+                case Token::Type::Literal:
+                    for (const char c : token.value) states_.push_back({Op::Char, c});
+                    break;
+
+                case Token::Type::Slash:
+                    states_.push_back({Op::Slash});
+                    break;
+
+                case Token::Type::Question:
+                    states_.push_back({Op::OneChar});
+                    break;
+
+                case Token::Type::Star:
+                    states_.push_back({Op::OneChar});
+                    states_.push_back({Op::SegmentRun});
+                    break;
+
+                case Token::Type::DoubleStar:
+                    // '**/' swallows its slash: zero segments, or anything up to and including a '/'
+                    if (i + 1 < tokens.size() && tokens[i + 1].type == Token::Type::Slash) {
+                        states_.push_back({Op::Segments});
+                        ++i;
+                    } else {
+                        states_.push_back({Op::AnyRun});
+                    }
+                    break;
+            }
+        }
+    }
+
+    bool Automaton::matches(const std::string_view path) const {
+        constexpr uint8_t Waiting = 1, Entered = 2;
+        const std::size_t accept = states_.size();
+
+        // live[i] != 0: a partial match waits at state i; Entered marks one that got there on this
+        // step rather than by looping. live[accept] set means the whole pattern matched.
+        std::vector<uint8_t> live(accept + 1, 0), next(accept + 1, 0);
+
+        // Runs can be left at any point; '**/' only right after entering it, otherwise it has to
+        // finish on a '/'. Both edges point forward, so one ascending pass closes the set.
+        const auto close = [&](std::vector<uint8_t> &set) {
+            for (std::size_t i = 0; i < accept; ++i) {
+                const auto op = states_[i].op;
+                if ((set[i] && (op == Op::SegmentRun || op == Op::AnyRun)) ||
+                    (set[i] == Entered && op == Op::Segments))
+                    set[i + 1] = Entered;
+            }
+        };
+
+        live[0] = Entered;
+        close(live);
+
+        for (const char ch : path) {
+            std::fill(next.begin(), next.end(), 0);
+            bool any = false;
+
+            const auto enter = [&](const std::size_t i) { next[i] = Entered; any = true; };
+            const auto stay = [&](const std::size_t i) { next[i] = std::max(next[i], Waiting); any = true; };
+
+            for (std::size_t i = 0; i < accept; ++i) {
+                if (!live[i]) continue;
+
+                const auto &s = states_[i];
+                switch (s.op) {
+                    case Op::Char:
+                        if (ch == s.c) enter(i + 1);
+                        break;
+                    case Op::Slash:
+                        if (ch == '/') enter(i + 1);
+                        break;
+                    case Op::OneChar:
+                        if (ch != '/') enter(i + 1);
+                        break;
+                    case Op::SegmentRun:
+                        if (ch != '/') stay(i);
+                        break;
+                    case Op::AnyRun:
+                        stay(i);
+                        break;
+                    case Op::Segments:
+                        stay(i);
+                        if (ch == '/') enter(i + 1);
+                        break;
+                }
+            }
+
+            if (!any) return false;
+            close(next);
+            live.swap(next);
+        }
+
+        return live[accept] != 0;
+    }
+}
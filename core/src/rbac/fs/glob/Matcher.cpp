@@ -1,4 +1,5 @@
 #include "rbac/fs/glob/Matcher.hpp"
+#include "rbac/fs/glob/Automaton.hpp"
 #include "rbac/fs/glob/Tokenizer.hpp"
 #include "rbac/fs/glob/model/Token.hpp"
 
@@ -7,78 +8,6 @@ namespace vh::rbac::fs::glob {
         using Token = model::Token;
         using Pattern = model::Pattern;
 
-        [[nodiscard]] bool matchRecursive(
-            const std::vector<Token> &tokens,
-            const std::string_view path,
-            const std::size_t tokenIndex,
-            const std::size_t pathIndex
-        ) {
-            if (tokenIndex == tokens.size() && pathIndex == path.size()) return true;
-            if (tokenIndex == tokens.size()) return false;
-
-            const Token &token = tokens[tokenIndex];
-
-            switch (token.type) {
-                case Token::Type::Literal: {
-                    if (pathIndex + token.value.size() > path.size()) return false;
-                    if (path.substr(pathIndex, token.value.size()) != token.value) return false;
-                    return matchRecursive(tokens, path, tokenIndex + 1, pathIndex + token.value.size());
-                }
-
-                case Token::Type::Slash: {
-                    if (pathIndex >= path.size() || path[pathIndex] != '/') return false;
-                    return matchRecursive(tokens, path, tokenIndex + 1, pathIndex + 1);
-                }
-
-                case Token::Type::Question: {
-                    if (pathIndex >= path.size()) return false;
-                    if (path[pathIndex] == '/') return false;
-                    return matchRecursive(tokens, path, tokenIndex + 1, pathIndex + 1);
-                }
-
-                case Token::Type::Star: {
-                    std::size_t i = pathIndex;
-
-                    // '*' must consume at least one non-slash character.
-                    if (i >= path.size() || path[i] == '/') return false;
-
-                    while (i < path.size() && path[i] != '/') {
-                        ++i;
-                        if (matchRecursive(tokens, path, tokenIndex + 1, i)) return true;
-                    }
-
-                    return false;
-                }
-
-                case Token::Type::DoubleStar: {
-                    const bool nextIsSlash = tokenIndex + 1 < tokens.size() &&
-                                             tokens[tokenIndex + 1].type == Token::Type::Slash;
-
-                    // '**/' = zero or more whole path segments.
-                    if (nextIsSlash) {
-                        // Zero segments.
-                        if (matchRecursive(tokens, path, tokenIndex + 2, pathIndex)) return true;
-
-                        // One or more segments.
-                        for (std::size_t i = pathIndex; i < path.size(); ++i)
-                            if (path[i] == '/' && matchRecursive(tokens, path, tokenIndex + 2, i + 1))
-                                return true;
-
-                        return false;
-                    }
-
-                    // Generic '**' = any sequence, including empty.
-                    for (std::size_t i = pathIndex; i <= path.size(); ++i)
-                        if (matchRecursive(tokens, path, tokenIndex + 1, i))
-                            return true;
-
-                    return false;
-                }
-            }
-
-            return false;
-        }
-
         [[nodiscard]] bool isWildcardToken(const Token &token) {
             return token.type == Token::Type::Star ||
                    token.type == Token::Type::DoubleStar ||
@@ -177,7 +106,7 @@ namespace vh::rbac::fs::glob {
     bool Matcher::matches(const model::Pattern &pattern, const Path &path) {
         const std::string normalized = normalizePath(path);
         if (normalized.empty() || normalized.front() != '/') return false;
-        return matchRecursive(pattern.tokens, normalized, 0, 0);
+        return Automaton(pattern).matches(normalized);
     }
 
     bool Matcher::matches(std::string_view pattern, const Path &path) {
@@ -0,0 +1,80 @@
+#include "rbac/fs/policy/DecisionCache.hpp"
+#include "config/Registry.hpp"
+
+#include <cstring>
+#include <functional>
+
+namespace vh::rbac::fs::policy {
+    DecisionCache::DecisionCache(const std::size_t capacity)
+        : capacity_(capacity), perShard_((capacity + kShards - 1) / kShards) {}
+
+    DecisionCache &DecisionCache::instance() {
+        static DecisionCache cache(config::Registry::get().caching.permission_decision_cache_entries);
+        return cache;
+    }
+
+    std::string DecisionCache::key(const uint64_t generation, const uint16_t question, const std::string_view path) {
+        std::string k(sizeof generation + sizeof question, '\0');
+        std::memcpy(k.data(), &generation, sizeof generation);
+        std::memcpy(k.data() + sizeof generation, &question, sizeof question);
+        k.append(path);
+        return k;
+    }
+
+    DecisionCache::Shard &DecisionCache::shardFor(const std::string &key) {
+        return shards_[std::hash<std::string>{}(key) % kShards];
+    }
+
+    std::optional<int32_t> DecisionCache::get(const uint64_t generation, const uint16_t question, const std::string_view path) {
+        if (!capacity_) return std::nullopt;
+
+        const auto k = key(generation, question, path);
+        auto &shard = shardFor(k);
+
+        std::lock_guard lock(shard.mutex);
+        const auto it = shard.index.find(k);
+        if (it == shard.index.end()) return std::nullopt;
+
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        return it->second->answer;
+    }
+
+    void DecisionCache::put(const uint64_t generation, const uint16_t question, const std::string_view path, const int32_t answer) {
+        if (!capacity_) return;
+
+        auto k = key(generation, question, path);
+        auto &shard = shardFor(k);
+
+        std::lock_guard lock(shard.mutex);
+        if (const auto it = shard.index.find(k); it != shard.index.end()) {
+            it->second->answer = answer;
+            shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+            return;
+        }
+
+        shard.lru.push_front({ .key = k, .answer = answer });
+        shard.index.emplace(std::move(k), shard.lru.begin());
+
+        while (shard.lru.size() > perShard_) {
+            shard.index.erase(shard.lru.back().key);
+            shard.lru.pop_back();
+        }
+    }
+
+    void DecisionCache::clear() {
+        for (auto &shard : shards_) {
+            std::lock_guard lock(shard.mutex);
+            shard.lru.clear();
+            shard.index.clear();
+        }
+    }
+
+    std::size_t DecisionCache::size() const {
+        std::size_t n = 0;
+        for (const auto &shard : shards_) {
+            std::lock_guard lock(shard.mutex);
+            n += shard.lru.size();
+        }
+        return n;
+    }
+}
@@ -4,7 +4,7 @@
 #include "fs/model/Entry.hpp"
 #include "identities/Group.hpp"
 #include "identities/User.hpp"
-#include "rbac/fs/glob/Matcher.hpp"
+#include "rbac/fs/policy/OverrideIndex.hpp"
 #include "rbac/permission/Override.hpp"
 #include "rbac/permission/vault/Filesystem.hpp"
 #include "rbac/role/Admin.hpp"
@@ -96,13 +96,13 @@ Decision Evaluator::evaluate(const Request &req) {
     }
 
     // 3) Global vault filesystem policy: last resort
-    std::array vGlobals{
-        user->roles.admin->vGlobals.self,
-        user->roles.admin->vGlobals.admin,
-        user->roles.admin->vGlobals.user
+    const std::array vGlobals{
+        &user->roles.admin->vGlobals.self,
+        &user->roles.admin->vGlobals.admin,
+        &user->roles.admin->vGlobals.user
     };
-    for (const auto &global: vGlobals) {
-        const auto stage = resolveStage(global.fs, target, req.action);
+    for (const auto *global: vGlobals) {
+        const auto stage = resolveStage(global->fs, target, req.action);
         if (stage.matched && stage.allowed.has_value())
             return {
                 .allowed = *stage.allowed,
@@ -341,34 +341,23 @@ Evaluator::StageResult Evaluator::resolveStage(
 }
 
 Evaluator::StageResult Evaluator::resolveOverrides(
-    const std::vector<permission::Override> &overrides,
+    const permission::OverrideList &overrides,
     const std::string_view absolutePath,
     const permission::vault::FilesystemAction& action
 ) {
-    const auto *best = findBestOverride(overrides, absolutePath, action);
-    if (best) {
-        if (const auto effect = overrideEffect(*best); effect.has_value()) {
-            if (*effect == OverrideOpt::ALLOW)
-                return {
-                    .matched = true,
-                    .allowed = true,
-                    .reason = Decision::Reason::AllowedByOverride,
-                    .matchedOverride = best->pattern.source,
-                    .overrideEffect = effect
-                };
+    if (overrides.empty()) return {};
 
-            if (*effect == OverrideOpt::DENY)
-                return {
-                    .matched = true,
-                    .allowed = false,
-                    .reason = Decision::Reason::DeniedByOverride,
-                    .matchedOverride = best->pattern.source,
-                    .overrideEffect = effect
-                };
-        }
-    }
+    const auto best = overrides.index()->best(absolutePath, action);
+    if (!best) return {};
 
-    return {};
+    const bool allowed = best->effect == OverrideOpt::ALLOW;
+    return {
+        .matched = true,
+        .allowed = allowed,
+        .reason = allowed ? Decision::Reason::AllowedByOverride : Decision::Reason::DeniedByOverride,
+        .matchedOverride = best->pattern,
+        .overrideEffect = best->effect
+    };
 }
 
 bool Evaluator::requiresExistingEntry(const permission::vault::FilesystemAction action) {
@@ -514,81 +503,10 @@ bool Evaluator::allowedByBase(
     return false;
 }
 
-std::optional<vh::rbac::permission::OverrideOpt> Evaluator::overrideEffect(
-    const permission::Override &o
-) {
-    if (!o.enabled) return std::nullopt;
-    return o.effect;
-}
-
 bool Evaluator::requiresTraversalThrough(
-    const std::vector<permission::Override> &overrides,
+    const permission::OverrideList &overrides,
     const std::filesystem::path &absolutePath
 ) {
-    return std::ranges::any_of(overrides, [&](const permission::Override &o) {
-        return o.enabled &&
-               o.effect == permission::OverrideOpt::ALLOW &&
-               glob::Matcher::requiresTraversalThrough(o.pattern, absolutePath);
-    });
-}
-
-const vh::rbac::permission::Override *Evaluator::findBestOverride(
-    const std::vector<permission::Override> &overrides,
-    const std::filesystem::path &absolutePath,
-    const rbac::permission::vault::FilesystemAction &action
-) {
-    const permission::Override *best = nullptr;
-    std::size_t bestScore = 0;
-
-    for (const auto &o : overrides) {
-        if (!o.enabled) continue;
-
-        if (const auto fPerm = permission::vault::fs::Files::resolveFromQualifiedName(o.permission.qualified_name); fPerm.has_value()) {
-            const auto reqPerm = filePermissionForAction(action);
-            if (!reqPerm.has_value() || *fPerm != *reqPerm) continue;
-        }
-
-        if (const auto dPerm = permission::vault::fs::Directories::resolveFromQualifiedName(o.permission.qualified_name); dPerm.has_value()) {
-            const auto reqPerm = directoryPermissionForAction(action);
-            if (!reqPerm.has_value() || *dPerm != *reqPerm) continue;
-        }
-
-        if (!glob::Matcher::matches(o.pattern, absolutePath)) continue;
-
-        const auto score = scorePattern(o.pattern);
-        if (!best || score > bestScore) {
-            best = &o;
-            bestScore = score;
-        }
-    }
-
-    return best;
-}
-
-std::size_t Evaluator::scorePattern(const glob::model::Pattern &pattern) {
-    using T = glob::model::Token::Type;
-
-    std::size_t score = 0;
-
-    for (const auto &token: pattern.tokens) {
-        switch (token.type) {
-            case T::Literal:
-                score += 10 + token.value.size();
-                break;
-
-            case T::Slash:
-                score += 1;
-                break;
-
-            case T::Question:
-                score += 2;
-                break;
-
-            case T::Star:
-            case T::DoubleStar:
-                break;
-        }
-    }
-
-    return score;
+    if (overrides.empty()) return false;
+    return overrides.index()->requiresTraversalThrough(absolutePath.string());
 }
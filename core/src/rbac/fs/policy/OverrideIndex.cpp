@@ -0,0 +1,253 @@
+#include "rbac/fs/policy/OverrideIndex.hpp"
+#include "rbac/fs/policy/DecisionCache.hpp"
+#include "rbac/fs/policy/Evaluator.hpp"
+#include "rbac/fs/glob/Matcher.hpp"
+#include "rbac/fs/glob/model/Token.hpp"
+
+#include <atomic>
+#include <filesystem>
+
+namespace vh::rbac::fs::policy {
+    namespace {
+        using Token = glob::model::Token;
+
+        constexpr uint16_t kTraversalQuestion = 0xFFFF;
+        constexpr int32_t kNoMatch = -1;
+
+        std::atomic<uint64_t> nextGeneration{1};
+
+        [[nodiscard]] std::string normalize(const std::string_view path) {
+            return std::filesystem::path(path).lexically_normal().generic_string();
+        }
+
+        // The whole literal segments a pattern opens with. Stops at the first segment that holds
+        // a wildcard, so every path the pattern can match walks through the node they lead to.
+        [[nodiscard]] std::vector<std::string> literalSegments(const glob::model::Pattern &pattern) {
+            std::vector<std::string> segments;
+            const auto &tokens = pattern.tokens;
+
+            if (tokens.empty() || tokens.front().type != Token::Type::Slash) return segments;
+
+            for (std::size_t i = 1; i < tokens.size(); i += 2) {
+                if (tokens[i].type != Token::Type::Literal) break;
+                if (i + 1 < tokens.size() && tokens[i + 1].type != Token::Type::Slash) break;
+                segments.push_back(tokens[i].value);
+            }
+
+            return segments;
+        }
+
+        // Calls fn with each segment of a normalized, vault-absolute path until it returns false
+        template<typename Fn>
+        void forEachSegment(const std::string_view path, Fn &&fn) {
+            std::size_t start = 1;
+            while (start < path.size()) {
+                const auto end = std::min(path.find('/', start), path.size());
+                if (end > start && !fn(path.substr(start, end - start))) return;
+                start = end + 1;
+            }
+        }
+    }
+
+    OverrideIndex::OverrideIndex(const std::vector<permission::Override> &overrides)
+        : generation_(nextGeneration.fetch_add(1, std::memory_order_relaxed)) {
+        using permission::vault::fs::Directories;
+        using permission::vault::fs::Files;
+
+        for (uint32_t order = 0; order < overrides.size(); ++order) {
+            const auto &o = overrides[order];
+            if (!o.enabled) continue;
+
+            Entry e{
+                .order = order,
+                .score = score(o.pattern),
+                .effect = o.effect,
+                .actions = {},
+                .pattern = o.pattern,
+                .automaton = glob::Automaton(o.pattern)
+            };
+
+            const auto fPerm = Files::resolveFromQualifiedName(o.permission.qualified_name);
+            const auto dPerm = Directories::resolveFromQualifiedName(o.permission.qualified_name);
+
+            for (std::size_t a = 0; a < kActions; ++a) {
+                const auto action = static_cast<Action>(a);
+
+                if (fPerm) {
+                    const auto required = Evaluator::filePermissionForAction(action);
+                    if (!required || *fPerm != *required) continue;
+                }
+
+                if (dPerm) {
+                    const auto required = Evaluator::directoryPermissionForAction(action);
+                    if (!required || *dPerm != *required) continue;
+                }
+
+                e.actions.set(a);
+            }
+
+            entries_.push_back(std::move(e));
+            insert(static_cast<uint32_t>(entries_.size() - 1));
+        }
+    }
+
+    void OverrideIndex::insert(const uint32_t entry) {
+        uint32_t node = 0;
+
+        for (auto &segment : literalSegments(entries_[entry].pattern)) {
+            if (const auto it = nodes_[node].children.find(segment); it != nodes_[node].children.end()) {
+                node = it->second;
+                continue;
+            }
+
+            const auto child = static_cast<uint32_t>(nodes_.size());
+            nodes_[node].children.emplace(std::move(segment), child);
+            nodes_.emplace_back();
+            node = child;
+        }
+
+        nodes_[node].entries.push_back(entry);
+    }
+
+    std::optional<OverrideIndex::Match> OverrideIndex::best(const std::string_view path, const Action action) const {
+        if (entries_.empty()) return std::nullopt;
+
+        const auto normalized = normalize(path);
+        if (normalized.empty() || normalized.front() != '/') return std::nullopt;
+
+        auto &cache = DecisionCache::instance();
+        const auto question = static_cast<uint16_t>(action);
+
+        auto answer = cache.get(generation_, question, normalized);
+        if (!answer) {
+            answer = findBest(normalized, action);
+            cache.put(generation_, question, normalized, *answer);
+        }
+
+        if (*answer == kNoMatch) return std::nullopt;
+
+        const auto &e = entries_[*answer];
+        return Match{ .pattern = e.pattern.source, .effect = e.effect };
+    }
+
+    int32_t OverrideIndex::findBest(const std::string &path, const Action action) const {
+        const auto a = static_cast<std::size_t>(action);
+        int32_t best = kNoMatch;
+
+        const auto consider = [&](const Node &node) {
+            for (const auto i : node.entries) {
+                const auto &e = entries_[i];
+                if (!e.actions.test(a)) continue;
+
+                // Only run the automaton when this entry would beat the current best
+                if (best != kNoMatch) {
+                    const auto &b = entries_[best];
+                    if (e.score < b.score || (e.score == b.score && e.order > b.order)) continue;
+                }
+
+                if (e.automaton.matches(path)) best = static_cast<int32_t>(i);
+            }
+        };
+
+        uint32_t node = 0;
+        consider(nodes_[0]);
+
+        forEachSegment(path, [&](const std::string_view segment) {
+            const auto &children = nodes_[node].children;
+            const auto it = children.find(std::string(segment));
+            if (it == children.end()) return false;
+            node = it->second;
+            consider(nodes_[node]);
+            return true;
+        });
+
+        return best;
+    }
+
+    bool OverrideIndex::requiresTraversalThrough(const std::string_view directory) const {
+        if (entries_.empty()) return false;
+
+        const auto normalized = normalize(directory);
+        if (normalized.empty() || normalized.front() != '/') return false;
+
+        auto &cache = DecisionCache::instance();
+
+        if (const auto answer = cache.get(generation_, kTraversalQuestion, normalized))
+            return *answer != 0;
+
+        const bool required = findTraversal(normalized);
+        cache.put(generation_, kTraversalQuestion, normalized, required ? 1 : 0);
+        return required;
+    }
+
+    bool OverrideIndex::findTraversal(const std::string &directory) const {
+        const auto allows = [&](const Node &node) {
+            for (const auto i : node.entries) {
+                const auto &e = entries_[i];
+                if (e.effect == permission::OverrideOpt::ALLOW &&
+                    glob::Matcher::requiresTraversalThrough(e.pattern, directory))
+                    return true;
+            }
+            return false;
+        };
+
+        // Overrides on the way down may still continue past the directory through a wildcard
+        if (allows(nodes_[0])) return true;
+
+        uint32_t node = 0;
+        bool reached = true, found = false;
+
+        forEachSegment(directory, [&](const std::string_view segment) {
+            const auto &children = nodes_[node].children;
+            const auto it = children.find(std::string(segment));
+            if (it == children.end()) return reached = false;
+            node = it->second;
+            found = allows(nodes_[node]);
+            return !found;
+        });
+
+        if (found) return true;
+        if (!reached) return false;
+
+        // Everything hanging below the directory leads through it
+        std::vector<uint32_t> stack;
+        for (const auto &[_, child] : nodes_[node].children) stack.push_back(child);
+
+        while (!stack.empty()) {
+            const auto n = stack.back();
+            stack.pop_back();
+            if (allows(nodes_[n])) return true;
+            for (const auto &[_, child] : nodes_[n].children) stack.push_back(child);
+        }
+
+        return false;
+    }
+
+    std::size_t OverrideIndex::score(const glob::model::Pattern &pattern) {
+        using T = Token::Type;
+
+        std::size_t score = 0;
+
+        for (const auto &token : pattern.tokens) {
+            switch (token.type) {
+                case T::Literal:
+                    score += 10 + token.value.size();
+                    break;
+
+                case T::Slash:
+                    score += 1;
+                    break;
+
+                case T::Question:
+                    score += 2;
+                    break;
+
+                case T::Star:
+                case T::DoubleStar:
+                    break;
+            }
+        }
+
+        return score;
+    }
+}
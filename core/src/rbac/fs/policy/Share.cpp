@@ -38,7 +38,7 @@ using FilePermission = permission::vault::fs::FilePermissions;
 }
 
 void addOverrides(
-    std::vector<permission::Override>& out,
+    permission::OverrideList& out,
     const std::vector<std::string>& patterns,
     const permission::Permission& permission
 ) {
@@ -53,7 +53,7 @@ void addOverrides(
 }
 
 void addFileOverrides(
-    std::vector<permission::Override>& out,
+    permission::OverrideList& out,
     const std::vector<std::string>& patterns,
     const FilePermission filePermission
 ) {
@@ -64,7 +64,7 @@ void addFileOverrides(
 }
 
 void addDirectoryOverrides(
-    std::vector<permission::Override>& out,
+    permission::OverrideList& out,
     const std::vector<std::string>& patterns,
     const DirectoryPermission directoryPermission
 ) {
@@ -86,7 +86,7 @@ void addDirectoryOverrides(
 }
 
 void addOverridesForAction(
-    std::vector<permission::Override>& overrides,
+    permission::OverrideList& overrides,
     const std::vector<std::string>& patterns,
     const Action action,
     const vh::share::TargetType targetType
@@ -0,0 +1,55 @@
+#include "rbac/permission/OverrideList.hpp"
+#include "rbac/fs/policy/OverrideIndex.hpp"
+
+namespace vh::rbac::permission {
+    OverrideList::OverrideList(const OverrideList &other) : items_(other.items_), version_(other.version_) {
+        std::lock_guard lock(other.indexMutex_);
+        index_ = other.index_;
+        indexVersion_ = other.indexVersion_;
+    }
+
+    OverrideList::OverrideList(OverrideList &&other) noexcept
+        : items_(std::move(other.items_)), version_(other.version_) {
+        std::lock_guard lock(other.indexMutex_);
+        index_ = std::move(other.index_);
+        indexVersion_ = other.indexVersion_;
+    }
+
+    OverrideList &OverrideList::operator=(const OverrideList &other) {
+        if (this == &other) return *this;
+        std::scoped_lock lock(indexMutex_, other.indexMutex_);
+        const bool current = other.index_ && other.indexVersion_ == other.version_;
+        items_ = other.items_;
+        touch();
+        index_ = current ? other.index_ : nullptr;
+        indexVersion_ = version_;
+        return *this;
+    }
+
+    OverrideList &OverrideList::operator=(OverrideList &&other) noexcept {
+        if (this == &other) return *this;
+        std::scoped_lock lock(indexMutex_, other.indexMutex_);
+        const bool current = other.index_ && other.indexVersion_ == other.version_;
+        items_ = std::move(other.items_);
+        touch();
+        index_ = current ? std::move(other.index_) : nullptr;
+        indexVersion_ = version_;
+        other.index_.reset();
+        return *this;
+    }
+
+    OverrideList &OverrideList::operator=(std::vector<Override> overrides) {
+        touch();
+        items_ = std::move(overrides);
+        return *this;
+    }
+
+    std::shared_ptr<const fs::policy::OverrideIndex> OverrideList::index() const {
+        std::lock_guard lock(indexMutex_);
+        if (!index_ || indexVersion_ != version_) {
+            index_ = std::make_shared<const fs::policy::OverrideIndex>(items_);
+            indexVersion_ = version_;
+        }
+        return index_;
+    }
+}
@@ -0,0 +1,172 @@
+#include "share/AuditWriter.hpp"
+#include "config/Registry.hpp"
+#include "db/query/share/AuditEvent.hpp"
+#include "db/query/share/Link.hpp"
+#include "log/Registry.hpp"
+#include "share/AuditEvent.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+using namespace vh::share;
+
+AuditWriter& AuditWriter::instance() {
+    static AuditWriter writer = [] {
+        const auto& cfg = config::Registry::get().sharing;
+        return AuditWriter(
+            Options{
+                .batchSize = std::max<size_t>(1, cfg.audit_batch_size),
+                .maxAge = std::chrono::milliseconds(cfg.audit_flush_interval_ms),
+                .maxQueued = std::max<size_t>(1, cfg.audit_queue_limit)
+            },
+            Sink{
+                .events = [](const auto& events) { db::query::share::AuditEvent::appendBatch(events); },
+                .counters = [](const auto& counters) {
+                    std::vector<db::query::share::Link::CounterDelta> deltas;
+                    deltas.reserve(counters.size());
+                    for (const auto& [id, c] : counters)
+                        deltas.push_back({ .id = id, .accesses = c.accesses, .downloads = c.downloads, .uploads = c.uploads });
+                    db::query::share::Link::addCounters(deltas);
+                },
+                .event = [](const auto& event) { db::query::share::AuditEvent::append(event); }
+            });
+    }();
+    return writer;
+}
+
+AuditWriter::AuditWriter(Options options, Sink sink)
+    : options_(std::move(options)), sink_(std::move(sink)) {
+    events_.reserve(options_.batchSize);
+    worker_ = std::thread([this] { run(); });
+}
+
+AuditWriter::~AuditWriter() {
+    stop();
+}
+
+void AuditWriter::stop() {
+    {
+        std::lock_guard lock(mutex_);
+        if (stopping_) return;
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    space_.notify_all();
+    if (worker_.joinable()) worker_.join();
+}
+
+size_t AuditWriter::pending() const {
+    std::lock_guard lock(mutex_);
+    return events_.size() + counters_.size();
+}
+
+void AuditWriter::append(std::shared_ptr<AuditEvent> event) {
+    if (!event) throw std::invalid_argument("Share audit event is required");
+    if (event->event_type.empty()) throw std::invalid_argument("Share audit event type is required");
+
+    {
+        std::unique_lock lock(mutex_);
+        space_.wait(lock, [this] { return stopping_ || events_.size() < options_.maxQueued; });
+
+        if (!stopping_) {
+            if (events_.empty() && counters_.empty()) oldest_ = Clock::now();
+            events_.push_back(std::move(event));
+            ++enqueued_;
+            if (events_.size() >= options_.batchSize) wake_.notify_one();
+            return;
+        }
+    }
+
+    // Past shutdown there is no writer thread left to hand this to
+    write({std::move(event)}, {});
+}
+
+void AuditWriter::touchAccess(const std::string& linkId) { bump(linkId, &Counters::accesses); }
+void AuditWriter::incrementDownload(const std::string& linkId) { bump(linkId, &Counters::downloads); }
+void AuditWriter::incrementUpload(const std::string& linkId) { bump(linkId, &Counters::uploads); }
+
+void AuditWriter::bump(const std::string& linkId, uint64_t Counters::* field) {
+    {
+        std::lock_guard lock(mutex_);
+        if (!stopping_) {
+            if (events_.empty() && counters_.empty()) oldest_ = Clock::now();
+            ++(counters_[linkId].*field);
+            ++enqueued_;
+            return;
+        }
+    }
+
+    std::unordered_map<std::string, Counters> counters;
+    ++(counters[linkId].*field);
+    write({}, counters);
+}
+
+void AuditWriter::flush() {
+    std::unique_lock lock(mutex_);
+    const auto target = enqueued_;
+    if (written_ >= target) return;
+    flushRequested_ = true;
+    wake_.notify_one();
+    flushed_.wait(lock, [&] { return written_ >= target; });
+}
+
+void AuditWriter::run() {
+    std::unique_lock lock(mutex_);
+    for (;;) {
+        const auto hasPending = [this] { return !events_.empty() || !counters_.empty(); };
+
+        if (!hasPending()) {
+            if (stopping_) return;
+            wake_.wait(lock, [&] { return stopping_ || hasPending(); });
+            continue;
+        }
+
+        wake_.wait_until(lock, oldest_ + options_.maxAge, [this] {
+            return stopping_ || flushRequested_ || events_.size() >= options_.batchSize;
+        });
+
+        auto events = std::exchange(events_, {});
+        auto counters = std::exchange(counters_, {});
+        const auto batchEnd = enqueued_;
+        flushRequested_ = false;
+        events_.reserve(options_.batchSize);
+
+        lock.unlock();
+        space_.notify_all();
+        write(events, counters);
+        lock.lock();
+
+        written_ = batchEnd;
+        flushed_.notify_all();
+    }
+}
+
+void AuditWriter::write(const std::vector<std::shared_ptr<AuditEvent>>& events,
+                        const std::unordered_map<std::string, Counters>& counters) const {
+    if (!events.empty()) {
+        try {
+            sink_.events(events);
+        } catch (const std::exception& e) {
+            log::Registry::audit()->warn("[share::AuditWriter] Batch of {} audit events rejected, retrying singly: {}",
+                                         events.size(), e.what());
+            for (const auto& event : events) {
+                try {
+                    sink_.event(event);
+                } catch (const std::exception& inner) {
+                    log::Registry::audit()->error("[share::AuditWriter] Dropping {} audit event: {}",
+                                                  event->event_type, inner.what());
+                }
+            }
+        }
+    }
+
+    if (!counters.empty()) {
+        try {
+            sink_.counters(counters);
+        } catch (const std::exception& e) {
+            log::Registry::audit()->error("[share::AuditWriter] Failed to apply counters for {} share links: {}",
+                                          counters.size(), e.what());
+        }
+    }
+}
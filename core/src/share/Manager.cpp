@@ -1,6 +1,5 @@
 #include "share/Manager.hpp"
 
-#include "db/query/share/AuditEvent.hpp"
 #include "db/query/share/EmailChallenge.hpp"
 #include "db/query/share/Link.hpp"
 #include "db/query/share/Session.hpp"
@@ -12,6 +11,7 @@
 #include "rbac/permission/vault/Filesystem.hpp"
 #include "rbac/resolver/vault/all.hpp"
 #include "share/AuditEvent.hpp"
+#include "share/AuditWriter.hpp"
 #include "share/EmailChallenge.hpp"
 #include "share/PrincipalResolver.hpp"
 #include "share/Token.hpp"
@@ -81,11 +81,12 @@ public:
         db::query::share::Link::rotateToken(id, lookupId, tokenHash, updatedBy);
     }
 
-    void touchLinkAccess(const std::string& id) override { db::query::share::Link::touchAccess(id); }
+    // Access bookkeeping and audit rows are batched by AuditWriter rather than written inline
+    void touchLinkAccess(const std::string& id) override { AuditWriter::instance().touchAccess(id); }
 
-    void incrementDownload(const std::string& id) override { db::query::share::Link::incrementDownload(id); }
+    void incrementDownload(const std::string& id) override { AuditWriter::instance().incrementDownload(id); }
 
-    void incrementUpload(const std::string& id) override { db::query::share::Link::incrementUpload(id); }
+    void incrementUpload(const std::string& id) override { AuditWriter::instance().incrementUpload(id); }
 
     void upsertVaultRoleForShare(
         const std::string& shareId,
@@ -217,7 +218,7 @@ public:
     }
 
     void appendAuditEvent(const std::shared_ptr<AuditEvent>& event) override {
-        db::query::share::AuditEvent::append(event);
+        AuditWriter::instance().append(event);
     }
 
     std::shared_ptr<Upload> createUpload(const std::shared_ptr<Upload>& upload) override {
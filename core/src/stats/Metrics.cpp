@@ -0,0 +1,132 @@
+#include "stats/Metrics.hpp"
+
+#include <fmt/format.h>
+
+#include <iterator>
+#include <mutex>
+
+using namespace vh::stats;
+using namespace vh::stats::model;
+
+namespace {
+
+struct Info {
+    std::string_view name, help, label;
+};
+
+constexpr std::array<Info, static_cast<std::size_t>(Metric::Count)> INFO{{
+    {"vh_fuse_op_duration_seconds", "Time spent handling a FUSE request, by operation.", "op"},
+    {"vh_db_acquire_wait_seconds", "Time spent waiting for a pooled database connection.", ""},
+    {"vh_db_connection_hold_seconds", "Time a database connection stayed leased out.", ""},
+    {"vh_db_transaction_duration_seconds", "Time from opening a database transaction to its commit.", ""},
+    {"vh_threadpool_queue_wait_seconds", "Time a task waited in a thread pool queue, by pool.", "pool"},
+    {"vh_s3_request_duration_seconds", "Duration of one S3 HTTP request, by method.", "method"},
+    {"vh_ws_handler_duration_seconds", "Time spent in a WebSocket command handler, by command.", "command"},
+}};
+
+const Info& info(const Metric metric) { return INFO[static_cast<std::size_t>(metric)]; }
+
+std::string escapeLabel(const std::string_view v) {
+    std::string out;
+    out.reserve(v.size());
+    for (const char c : v) {
+        if (c == '\\') out += "\\\\";
+        else if (c == '"') out += "\\\"";
+        else if (c == '\n') out += "\\n";
+        else out += c;
+    }
+    return out;
+}
+
+double seconds(const uint64_t us) { return static_cast<double>(us) / 1e6; }
+
+}
+
+Metrics& Metrics::instance() {
+    static Metrics metrics;
+    return metrics;
+}
+
+std::string_view Metrics::name(const Metric metric) { return info(metric).name; }
+std::string_view Metrics::help(const Metric metric) { return info(metric).help; }
+std::string_view Metrics::labelName(const Metric metric) { return info(metric).label; }
+
+Histogram& Metrics::histogram(const Metric metric, const std::string_view label) {
+    auto& family = families_[static_cast<std::size_t>(metric)];
+    {
+        std::shared_lock lk(mutex_);
+        if (const auto it = family.owned.find(label); it != family.owned.end()) return *it->second;
+    }
+
+    std::unique_lock lk(mutex_);
+    auto& slot = family.owned[std::string(label)];
+    if (!slot) slot = std::make_unique<Histogram>();
+    return *slot;
+}
+
+void Metrics::bind(const Metric metric, const std::string_view label, Source source) {
+    std::unique_lock lk(mutex_);
+    families_[static_cast<std::size_t>(metric)].bound[std::string(label)] =
+        std::make_shared<const Source>(std::move(source));
+}
+
+std::vector<Metrics::Series> Metrics::snapshot() const {
+    std::vector<std::pair<Series, std::shared_ptr<const Source>>> pending;
+    {
+        std::shared_lock lk(mutex_);
+        for (std::size_t m = 0; m < families_.size(); ++m) {
+            const auto metric = static_cast<Metric>(m);
+            for (const auto& [label, h] : families_[m].owned)
+                pending.push_back({{metric, label, h->snapshot()}, nullptr});
+            for (const auto& [label, source] : families_[m].bound)
+                pending.push_back({{metric, label, {}}, source});
+        }
+    }
+
+    // Bound sources take their owner's lock, so call them outside ours
+    std::vector<Series> out;
+    out.reserve(pending.size());
+    for (auto& [series, source] : pending) {
+        if (source) series.snapshot = (*source)();
+        out.push_back(std::move(series));
+    }
+    return out;
+}
+
+std::string Metrics::prometheus() const {
+    const auto all = snapshot();
+
+    std::string out;
+    auto it = std::back_inserter(out);
+    for (std::size_t m = 0; m < static_cast<std::size_t>(Metric::Count); ++m) {
+        const auto metric = static_cast<Metric>(m);
+        const auto& [name, help, labelKey] = info(metric);
+
+        fmt::format_to(it, "# HELP {} {}\n# TYPE {} histogram\n", name, help, name);
+
+        for (const auto& s : all) {
+            if (s.metric != metric) continue;
+
+            // {op="lookup"} for sum/count, {op="lookup",le="..."} for buckets
+            const auto label = labelKey.empty() || s.label.empty()
+                                   ? std::string{}
+                                   : fmt::format("{}=\"{}\"", labelKey, escapeLabel(s.label));
+            const auto sep = label.empty() ? "" : ",";
+
+            // Only power-of-two bounds go out: they stay put across versions and keep scrapes small
+            uint64_t cumulative = 0;
+            for (std::size_t i = 0; i + 1 < kHistogramBuckets; ++i) {
+                cumulative += s.snapshot.buckets[i];
+                if (!HistogramSnapshot::is_octave_boundary(i)) continue;
+                fmt::format_to(it, "{}_bucket{{{}{}le=\"{}\"}} {}\n",
+                               name, label, sep, seconds(HistogramSnapshot::upper_bound_us(i)), cumulative);
+            }
+            fmt::format_to(it, "{}_bucket{{{}{}le=\"+Inf\"}} {}\n", name, label, sep, s.snapshot.count);
+
+            const auto braces = label.empty() ? std::string{} : "{" + label + "}";
+            fmt::format_to(it, "{}_sum{} {}\n", name, braces, seconds(s.snapshot.sum_us));
+            fmt::format_to(it, "{}_count{} {}\n", name, braces, s.snapshot.count);
+        }
+    }
+    return out;
+}
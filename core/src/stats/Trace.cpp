@@ -0,0 +1,187 @@
+#include "stats/Trace.hpp"
+#include "config/Registry.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+using namespace vh::stats::trace;
+
+namespace {
+
+uint64_t nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+std::atomic<uint64_t> nextTraceId{1};
+
+struct ThreadTrace {
+    Trace trace;
+    uint16_t depth = 0;
+    bool active = false;
+    bool sampled = false;
+};
+
+ThreadTrace& local() {
+    thread_local ThreadTrace t = [] {
+        ThreadTrace init;
+        init.trace.tid = static_cast<uint32_t>(::syscall(SYS_gettid));
+        return init;
+    }();
+    return t;
+}
+
+uint64_t draw() {
+    thread_local std::mt19937_64 rng{std::random_device{}()};
+    return rng();
+}
+
+Tracer::Options fromConfig(const vh::config::TracingConfig& c) {
+    return {
+        .enabled = c.enabled,
+        .sample_rate = c.sample_rate,
+        .slow_threshold = std::chrono::milliseconds(c.slow_threshold_ms),
+        .capacity = c.buffer_traces,
+        .max_spans = c.max_spans_per_trace
+    };
+}
+
+}
+
+Tracer& Tracer::instance() {
+    static Tracer tracer(fromConfig(config::Registry::get().tracing));
+    return tracer;
+}
+
+Tracer::Tracer(const Options& opts) { configure(opts); }
+
+void Tracer::configure(const Options& opts) {
+    const double rate = std::clamp(opts.sample_rate, 0.0, 1.0);
+    sampleBelow_.store(rate >= 1.0 ? std::numeric_limits<uint64_t>::max()
+                                   : static_cast<uint64_t>(std::ldexp(rate, 64)), std::memory_order_relaxed);
+    slowNs_.store(static_cast<uint64_t>(std::chrono::nanoseconds(opts.slow_threshold).count()), std::memory_order_relaxed);
+    maxSpans_.store(std::max<std::size_t>(1, opts.max_spans), std::memory_order_relaxed);
+
+    {
+        std::scoped_lock lk(mutex_);
+        capacity_ = opts.capacity;
+        ring_.clear();
+        ring_.reserve(capacity_);
+        next_ = 0;
+    }
+
+    enabled_.store(opts.enabled && opts.capacity > 0, std::memory_order_relaxed);
+}
+
+bool Tracer::sample() const {
+    const auto below = sampleBelow_.load(std::memory_order_relaxed);
+    return below && draw() < below;
+}
+
+void Tracer::finish(Trace& trace, const bool sampled) {
+    const auto slowNs = slowNs_.load(std::memory_order_relaxed);
+    trace.slow = slowNs && trace.duration_ns() >= slowNs;
+    if (!sampled && !trace.slow) return;
+
+    Trace kept = std::move(trace);
+    trace = Trace{};
+    trace.tid = kept.tid;
+
+    std::scoped_lock lk(mutex_);
+    if (!capacity_) return;
+    if (ring_.size() < capacity_) ring_.push_back(std::move(kept));
+    else ring_[next_] = std::move(kept);
+    next_ = (next_ + 1) % capacity_;
+}
+
+std::vector<Trace> Tracer::recent(const bool slowOnly, const std::size_t limit) const {
+    std::vector<Trace> out;
+    std::scoped_lock lk(mutex_);
+    out.reserve(ring_.size());
+
+    // next_ is the oldest slot once the ring has wrapped; walk back from the newest
+    for (std::size_t n = 0; n < ring_.size(); ++n) {
+        const auto& t = ring_[(next_ + ring_.size() - 1 - n) % ring_.size()];
+        if (slowOnly && !t.slow) continue;
+        out.push_back(t);
+        if (limit && out.size() == limit) break;
+    }
+    return out;
+}
+
+nlohmann::json Tracer::chromeJson(const bool slowOnly, const std::size_t limit) const {
+    const auto pid = static_cast<int>(::getpid());
+    auto events = nlohmann::json::array();
+
+    for (const auto& t : recent(slowOnly, limit)) {
+        for (const auto& s : t.spans) {
+            nlohmann::json args = {{"trace_id", t.id}, {"depth", s.depth}};
+            if (!s.detail.empty()) args["detail"] = s.detail;
+            if (&s == &t.spans.front()) {
+                args["slow"] = t.slow;
+                if (t.dropped) args["dropped_spans"] = t.dropped;
+            }
+
+            events.push_back({
+                {"name", s.name},
+                {"cat", "vh"},
+                {"ph", "X"},
+                {"ts", static_cast<double>(s.start_ns) / 1e3},
+                {"dur", static_cast<double>(s.dur_ns) / 1e3},
+                {"pid", pid},
+                {"tid", t.tid},
+                {"args", std::move(args)}
+            });
+        }
+    }
+
+    return {{"traceEvents", std::move(events)}, {"displayTimeUnit", "ms"}};
+}
+
+void Tracer::clear() {
+    std::scoped_lock lk(mutex_);
+    ring_.clear();
+    next_ = 0;
+}
+
+Span::Span(const char* name, const std::string_view detail) {
+    auto& t = local();
+
+    if (!t.active) {
+        auto& tracer = Tracer::instance();
+        if (!tracer.enabled()) return;
+        t.active = true;
+        t.sampled = tracer.sample();
+        t.depth = 0;
+        t.trace.id = nextTraceId.fetch_add(1, std::memory_order_relaxed);
+        t.trace.dropped = 0;
+        t.trace.spans.clear();
+    } else if (t.trace.spans.size() >= Tracer::instance().maxSpans_.load(std::memory_order_relaxed)) {
+        ++t.trace.dropped;
+        return;
+    }
+
+    index_ = t.trace.spans.size();
+    t.trace.spans.push_back({name, std::string(detail), nowNs(), 0, t.depth++});
+}
+
+Span::~Span() {
+    if (index_ == kInactive) return;
+
+    auto& t = local();
+    auto& rec = t.trace.spans[index_];
+    rec.dur_ns = nowNs() - rec.start_ns;
+    --t.depth;
+
+    if (index_ == 0) {
+        t.active = false;
+        Tracer::instance().finish(t.trace, t.sampled);
+    }
+}
@@ -0,0 +1,105 @@
+#include "stats/model/Histogram.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <nlohmann/json.hpp>
+
+using namespace vh::stats::model;
+
+namespace {
+constexpr std::size_t kOverflow = kHistogramBuckets - 1;
+constexpr uint64_t kOverflowFrom = uint64_t{1} << kHistogramOctaves;
+}
+
+std::size_t HistogramSnapshot::bucket_for(const uint64_t us) noexcept {
+    if (us < kHistogramSubBuckets) return static_cast<std::size_t>(us);
+    if (us >= kOverflowFrom) return kOverflow;
+
+    // e = index of the top bit; the next kHistogramSubBucketBits bits pick the linear step
+    const auto e = static_cast<std::size_t>(std::bit_width(us)) - 1;
+    const auto step = static_cast<std::size_t>(us >> (e - kHistogramSubBucketBits)) & (kHistogramSubBuckets - 1);
+    return kHistogramSubBuckets + (e - kHistogramSubBucketBits) * kHistogramSubBuckets + step;
+}
+
+uint64_t HistogramSnapshot::upper_bound_us(const std::size_t i) noexcept {
+    if (i < kHistogramSubBuckets) return i;
+    if (i >= kOverflow) return std::numeric_limits<uint64_t>::max();
+
+    const auto k = i - kHistogramSubBuckets;
+    const auto shift = k / kHistogramSubBuckets;
+    const auto step = k % kHistogramSubBuckets;
+    return ((kHistogramSubBuckets + step + 1) << shift) - 1;
+}
+
+bool HistogramSnapshot::is_octave_boundary(const std::size_t i) noexcept {
+    return i >= kHistogramSubBuckets && i < kOverflow
+        && (i - kHistogramSubBuckets) % kHistogramSubBuckets == kHistogramSubBuckets - 1;
+}
+
+void HistogramSnapshot::merge(const HistogramSnapshot& other) noexcept {
+    for (std::size_t i = 0; i < kHistogramBuckets; ++i) buckets[i] += other.buckets[i];
+    count += other.count;
+    sum_us += other.sum_us;
+    max_us = std::max(max_us, other.max_us);
+}
+
+uint64_t HistogramSnapshot::quantile_us(const double q) const noexcept {
+    if (count == 0) return 0;
+
+    const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * static_cast<double>(count))));
+    uint64_t seen = 0;
+    for (std::size_t i = 0; i < kHistogramBuckets; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) return std::min(upper_bound_us(i), max_us);
+    }
+    return max_us;
+}
+
+double HistogramSnapshot::avg_ms() const noexcept {
+    return count ? (static_cast<double>(sum_us) / 1000.0) / static_cast<double>(count) : 0.0;
+}
+
+std::size_t Histogram::shardIndex() noexcept {
+    static std::atomic<std::size_t> next{0};
+    thread_local const std::size_t index = next.fetch_add(1, std::memory_order_relaxed) % kHistogramShards;
+    return index;
+}
+
+void Histogram::observe_us(const uint64_t us) noexcept {
+    auto& shard = shards_[shardIndex()];
+    shard.buckets[HistogramSnapshot::bucket_for(us)].fetch_add(1, std::memory_order_relaxed);
+    shard.sum_us.fetch_add(us, std::memory_order_relaxed);
+
+    uint64_t cur = shard.max_us.load(std::memory_order_relaxed);
+    while (us > cur && !shard.max_us.compare_exchange_weak(cur, us, std::memory_order_relaxed)) {
+        // cur updated by compare_exchange_weak
+    }
+}
+
+HistogramSnapshot Histogram::snapshot() const noexcept {
+    HistogramSnapshot s;
+    for (const auto& shard : shards_) {
+        for (std::size_t i = 0; i < kHistogramBuckets; ++i) {
+            const auto n = shard.buckets[i].load(std::memory_order_relaxed);
+            s.buckets[i] += n;
+            s.count += n;
+        }
+        s.sum_us += shard.sum_us.load(std::memory_order_relaxed);
+        s.max_us = std::max(s.max_us, shard.max_us.load(std::memory_order_relaxed));
+    }
+    return s;
+}
+
+void vh::stats::model::to_json(nlohmann::json& j, const HistogramSnapshot& s) {
+    j = nlohmann::json{
+        {"count", s.count},
+        {"sum_us", s.sum_us},
+        {"max_us", s.max_us},
+        {"avg_ms", s.avg_ms()},
+        {"p50_us", s.quantile_us(0.50)},
+        {"p95_us", s.quantile_us(0.95)},
+        {"p99_us", s.quantile_us(0.99)},
+    };
+}
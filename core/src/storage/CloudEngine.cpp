@@ -16,6 +16,7 @@
 #include "vault/APIKeyManager.hpp"
 #include "config/Registry.hpp"
 #include "sync/model/RemotePolicy.hpp"
+#include "stats/Trace.hpp"
 
 using namespace vh::fs;
 using namespace vh::fs::model;
@@ -54,6 +55,7 @@ CloudEngine::CloudEngine(const std::shared_ptr<S3Vault>& vault)
       s3Provider_(std::make_shared<s3::Controller>(key_, vault->bucket)) {}
 
 void CloudEngine::upload(const std::shared_ptr<File>& f) const {
+    const stats::trace::Span span("cloud.upload", f->path.native());
     if (!fs::exists(f->backing_path) || !fs::is_regular_file(f->backing_path))
         throw std::runtime_error("[CloudStorageEngine] Invalid file: " + f->path.string());
 
@@ -100,6 +102,7 @@ std::vector<uint8_t> CloudEngine::downloadToBuffer(const fs::path& rel_path) con
 }
 
 std::shared_ptr<File> CloudEngine::downloadFile(const fs::path& rel_path) {
+    const stats::trace::Span span("cloud.download", rel_path.native());
     auto buffer = downloadToBuffer(rel_path);
     const auto s3Key = stripLeadingSlash(rel_path);
 
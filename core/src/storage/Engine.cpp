@@ -17,6 +17,7 @@
 #include "sync/model/Event.hpp"
 #include "fs/model/file/Trashed.hpp"
 #include "fs/model/File.hpp"
+#include "crypto/util/encrypt.hpp"
 
 using namespace vh::fs::model;
 using namespace vh::fs;
@@ -97,6 +98,26 @@ namespace vh::storage {
         return encryptionManager->decrypt(payload, iv_b64, key_version);
     }
 
+    std::optional<Engine::EncryptionContext> Engine::encryptionContext(const std::shared_ptr<File> &f) const {
+        if (!f) throw std::invalid_argument("Invalid file for decryption");
+        auto context = db::query::fs::File::getEncryptionIVAndVersion(vault->id, f->path);
+        if (!context || context->first.empty()) {
+            if (!f->encryption_iv.empty()) throw std::runtime_error("No encryption IV found for file: " + f->path.string());
+            return std::nullopt;
+        }
+        return context;
+    }
+
+    std::unique_ptr<crypto::util::AES256GCMDecryptor> Engine::decryptor(const std::shared_ptr<File> &f, const uint64_t offset) const {
+        const auto context = encryptionContext(f);
+        return context ? decryptor(*context, offset) : nullptr;
+    }
+
+    std::unique_ptr<crypto::util::AES256GCMDecryptor> Engine::decryptor(const EncryptionContext &context, const uint64_t offset) const {
+        const auto &[iv_b64, key_version] = context;
+        return encryptionManager->decryptor(iv_b64, key_version, offset);
+    }
+
     uintmax_t Engine::getDirectorySize(const fs::path &path) {
         uintmax_t total = 0;
         for (auto &p: fs::recursive_directory_iterator(path, fs::directory_options::skip_permission_denied))
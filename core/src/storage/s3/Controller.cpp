@@ -84,7 +84,7 @@ namespace vh::storage::s3 {
             curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeToString);
             curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
 
-            const CURLcode res = curl_easy_perform(curl);
+            const CURLcode res = perform(curl);
             curl_easy_cleanup(curl);
 
             if (res != CURLE_OK) {
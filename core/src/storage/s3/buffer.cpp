@@ -145,7 +145,7 @@ void Controller::downloadToBuffer(const std::filesystem::path& key, std::vector<
     });
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, &outBuffer);
 
-    const CURLcode res = curl_easy_perform(curl);
+    const CURLcode res = perform(curl);
     curl_easy_cleanup(curl);
 
     if (res != CURLE_OK)
@@ -2,6 +2,8 @@
 #include "db/encoding/u8.hpp"
 #include "db/encoding/timestamp.hpp"
 #include "vault/model/APIKey.hpp"
+#include "stats/Metrics.hpp"
+#include "stats/Trace.hpp"
 
 #include <openssl/hmac.h>
 #include <openssl/sha.h>
@@ -20,6 +22,22 @@ namespace vh::storage::s3::curl {
         std::call_once(once, [] { curl_global_init(CURL_GLOBAL_DEFAULT); });
     }
 
+    CURLcode perform(CURL* curl) {
+        const stats::trace::Span span("s3.request");
+        const auto start = std::chrono::steady_clock::now();
+        const CURLcode res = curl_easy_perform(curl);
+        const auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+        const char* method = nullptr;
+#if LIBCURL_VERSION_NUM >= 0x074800
+        curl_easy_getinfo(curl, CURLINFO_EFFECTIVE_METHOD, &method);
+#endif
+        stats::Metrics::instance()
+            .histogram(stats::Metric::S3Request, method ? method : "unknown")
+            .observe_us(static_cast<uint64_t>(us.count()));
+        return res;
+    }
+
     std::string sha256Hex(const std::string &data) {
         unsigned char hash[SHA256_DIGEST_LENGTH];
         SHA256(reinterpret_cast<const unsigned char *>(data.data()), data.size(), hash);
@@ -125,7 +125,7 @@ void Controller::downloadObject(const std::filesystem::path& key,
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeFn);
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, &file);
 
-    const CURLcode res = curl_easy_perform(curl);
+    const CURLcode res = perform(curl);
     curl_easy_cleanup(curl);
     file.close();
 
@@ -30,7 +30,7 @@ std::string Controller::initiateMultipartUpload(const std::filesystem::path& key
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeToString);
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
 
-    CURLcode res = curl_easy_perform(curl);
+    CURLcode res = perform(curl);
     long httpCode = 0;
     curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpCode);
     curl_easy_cleanup(curl);
@@ -77,7 +77,7 @@ void Controller::uploadPart(const std::filesystem::path& key, const std::string&
     curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, writeToString);
     curl_easy_setopt(curl, CURLOPT_HEADERDATA, &respHdr);
 
-    const CURLcode res = curl_easy_perform(curl);
+    const CURLcode res = perform(curl);
     long httpCode = 0;
     curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpCode);
     curl_easy_cleanup(curl);
@@ -119,7 +119,7 @@ void Controller::completeMultipartUpload(const std::filesystem::path& key, const
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeToString);
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
 
-    CURLcode res = curl_easy_perform(curl);
+    CURLcode res = perform(curl);
     long httpCode = 0;
     curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpCode);
     curl_easy_cleanup(curl);
@@ -152,7 +152,7 @@ void Controller::abortMultipartUpload(const std::filesystem::path& key, const st
     curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "DELETE");
     curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers.list);
 
-    const CURLcode res = curl_easy_perform(curl);
+    const CURLcode res = perform(curl);
     curl_easy_cleanup(curl);
 
     if (res != CURLE_OK)
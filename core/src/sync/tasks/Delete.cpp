@@ -5,6 +5,7 @@
 #include "fs/model/File.hpp"
 #include "fs/model/file/Trashed.hpp"
 #include "sync/model/ScopedOp.hpp"
+#include "stats/Trace.hpp"
 
 #include <stdexcept>
 #include <utility>
@@ -54,6 +55,8 @@ void Delete::operator()() {
         }, t);
     };
 
+    const stats::trace::Span span("sync.delete", getPathString(target));
+
     try {
         op.start(getSizeBytes(target));
 
@@ -3,6 +3,7 @@
 #include "fs/model/File.hpp"
 #include "log/Registry.hpp"
 #include "sync/model/ScopedOp.hpp"
+#include "stats/Trace.hpp"
 
 using namespace vh::sync::tasks;
 using namespace vh::storage;
@@ -15,6 +16,7 @@ Download::Download(std::shared_ptr<CloudEngine> eng,
     : engine(std::move(eng)), file(std::move(f)), op(op), freeAfterDownload(freeAfter) {}
 
 void Download::operator()() {
+    const stats::trace::Span span("sync.download", file->path.native());
     try {
         op.start(file->size_bytes);
         if (freeAfterDownload) engine->indexAndDeleteFile(file->path);
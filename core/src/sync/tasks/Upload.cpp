@@ -3,6 +3,7 @@
 #include "fs/model/File.hpp"
 #include "log/Registry.hpp"
 #include "sync/model/ScopedOp.hpp"
+#include "stats/Trace.hpp"
 
 using namespace vh::sync::tasks;
 using namespace vh::storage;
@@ -12,6 +13,7 @@ Upload::Upload(std::shared_ptr<CloudEngine> eng, std::shared_ptr<File> f, model:
     : engine(std::move(eng)), file(std::move(f)), op(op) {}
 
 void Upload::operator()() {
+    const stats::trace::Span span("sync.upload", file->path.native());
     try {
         op.start(file->size_bytes);
         engine->upload(file);
@@ -4,6 +4,7 @@
 #include "db/query/vault/Key.hpp"
 #include "vault/model/Key.hpp"
 #include "fs/model/File.hpp"
+#include "stats/Trace.hpp"
 
 #include <sodium.h>
 #include <stdexcept>
@@ -167,6 +168,7 @@ std::vector<uint8_t> EncryptionManager::rotateDecryptEncrypt(const std::vector<u
 }
 
 std::vector<uint8_t> EncryptionManager::encrypt(const std::vector<uint8_t>& plaintext, const std::shared_ptr<File>& f) const {
+    const stats::trace::Span span("crypto.encrypt");
     std::vector<uint8_t> iv;
 
     auto ciphertext = encrypt_aes256_gcm(plaintext, key_, iv);
@@ -175,12 +177,31 @@ std::vector<uint8_t> EncryptionManager::encrypt(const std::vector<uint8_t>& plai
     return ciphertext;
 }
 
+std::unique_ptr<AES256GCMEncryptor> EncryptionManager::encryptor(const std::shared_ptr<File>& f) const {
+    std::vector<uint8_t> iv;
+
+    auto enc = std::make_unique<AES256GCMEncryptor>(key_, iv);
+    f->encryption_iv = b64_encode(iv);
+    f->encrypted_with_key_version = version_;
+    return enc;
+}
+
 std::vector<uint8_t> EncryptionManager::decrypt(const std::vector<uint8_t>& ciphertext, const std::string& b64_iv, const unsigned int keyVersion) const {
+    const stats::trace::Span span("crypto.decrypt");
+    return decrypt_aes256_gcm(ciphertext, decryption_key(keyVersion), b64_decode(b64_iv));
+}
+
+std::unique_ptr<AES256GCMDecryptor> EncryptionManager::decryptor(const std::string& b64_iv, const unsigned int keyVersion,
+                                                                 const uint64_t offset) const {
+    return std::make_unique<AES256GCMDecryptor>(decryption_key(keyVersion), b64_decode(b64_iv), offset);
+}
+
+const std::vector<uint8_t>& EncryptionManager::decryption_key(const unsigned int keyVersion) const {
     if (rotation_in_progress_.load()) {
         if (key_.empty() || old_key_.empty()) throw std::runtime_error("Key rotation in progress but keys are not set");
 
-        if (keyVersion == version_) return decrypt_aes256_gcm(ciphertext, key_, b64_decode(b64_iv));
-        if (keyVersion == version_ - 1) return decrypt_aes256_gcm(ciphertext, old_key_, b64_decode(b64_iv));
+        if (keyVersion == version_) return key_;
+        if (keyVersion == version_ - 1) return old_key_;
 
         if (keyVersion < version_ - 1)
             log::Registry::crypto()->warn("[VaultEncryptionManager] Key version {} is too old for vault {}, using new key",
@@ -189,7 +210,7 @@ std::vector<uint8_t> EncryptionManager::decrypt(const std::vector<uint8_t>& ciph
             log::Registry::crypto()->warn("[VaultEncryptionManager] Key version {} is newer than current version {} for vault {}, using new key",
                                         keyVersion, version_, vault_id_);
 
-        return decrypt_aes256_gcm(ciphertext, key_, b64_decode(b64_iv));
+        return key_;
     }
 
     if (keyVersion != version_) {
@@ -198,7 +219,7 @@ std::vector<uint8_t> EncryptionManager::decrypt(const std::vector<uint8_t>& ciph
         throw std::runtime_error("Key version mismatch");
     }
 
-    return decrypt_aes256_gcm(ciphertext, key_, b64_decode(b64_iv));
+    return key_;
 }
 
 std::vector<uint8_t> EncryptionManager::get_key(const std::string& callingFunctionName) const {
@@ -24,5 +24,7 @@ int main(int argc, char** argv) {
         return 1;
     }
 
-    return RUN_ALL_TESTS();
+    const int rc = RUN_ALL_TESTS();
+    vh::log::Registry::shutdown();
+    return rc;
 }
@@ -8,7 +8,6 @@
 #include <fstream>
 #include <gtest/gtest.h>
 #include <algorithm>
-#include <pdfium/fpdfview.h>
 
 using namespace vh::storage::s3;
 using namespace vh::vault::model;
@@ -48,18 +47,10 @@ protected:
         bucket_ = std::getenv("VAULTHALLA_TEST_R2_BUCKET");
 
         s3Provider_ = std::make_shared<Controller>(apiKey_, bucket_);
-
-        FPDF_LIBRARY_CONFIG config;
-        config.version = 3;
-        config.m_pUserFontPaths = nullptr;
-        config.m_pIsolate = nullptr;
-        config.m_v8EmbedderSlot = 0;
-        FPDF_InitLibraryWithConfig(&config);
     }
 
     static void TearDownTestSuite() {
         std::filesystem::remove_all(test_dir);
-        FPDF_DestroyLibrary();
     }
 
     static void writeTextFile(const std::filesystem::path &path, const std::string &content) {
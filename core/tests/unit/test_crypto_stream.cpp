@@ -0,0 +1,100 @@
+#include "crypto/util/encrypt.hpp"
+#include "crypto/util/hash.hpp"
+
+#include <gtest/gtest.h>
+#include <sodium.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+
+using namespace vh::crypto;
+using namespace vh::crypto::util;
+
+namespace {
+
+std::vector<uint8_t> patterned(const size_t n) {
+    std::vector<uint8_t> v(n);
+    std::iota(v.begin(), v.end(), static_cast<uint8_t>(7));
+    return v;
+}
+
+}
+
+TEST(CryptoStreamTest, Blake2bStreamingMatchesFileDigest) {
+    const auto data = patterned(3 * 8192 + 123);
+    const auto tmp = std::filesystem::temp_directory_path() / "vh_blake2b_stream_test.bin";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(data.data()), static_cast<long>(data.size()));
+    }
+
+    hash::Blake2b hasher;
+    const std::span<const uint8_t> all(data);
+    hasher.update(all.first(1000));
+    hasher.update(all.subspan(1000));
+
+    EXPECT_EQ(hasher.finalHex(), hash::blake2b(tmp));
+    std::filesystem::remove(tmp);
+}
+
+TEST(CryptoStreamTest, StreamingEncryptRoundTripsThroughOneShotDecrypt) {
+    ASSERT_GE(sodium_init(), 0);
+    if (!crypto_aead_aes256gcm_is_available()) GTEST_SKIP() << "AES256-GCM unavailable on this CPU";
+
+    const std::vector<uint8_t> key(AES_KEY_SIZE, 0x5a);
+    const auto plaintext = patterned(70000);
+
+    std::vector<uint8_t> iv;
+    AES256GCMEncryptor enc(key, iv);
+    ASSERT_EQ(iv.size(), AES_IV_SIZE);
+
+    std::vector<uint8_t> ciphertext(plaintext.size());
+    const std::span<const uint8_t> in(plaintext);
+    const std::span<uint8_t> out(ciphertext);
+    for (size_t off = 0; off < in.size(); off += 4096) {
+        const auto n = std::min<size_t>(4096, in.size() - off);
+        enc.update(in.subspan(off, n), out.subspan(off, n));
+    }
+
+    const auto tag = enc.finish();
+    ciphertext.insert(ciphertext.end(), tag.begin(), tag.end());
+
+    EXPECT_EQ(decrypt_aes256_gcm(ciphertext, key, iv), plaintext);
+}
+
+TEST(CryptoStreamTest, DecryptorServesRangesAndVerifiesWholeStreams) {
+    ASSERT_GE(sodium_init(), 0);
+    if (!crypto_aead_aes256gcm_is_available()) GTEST_SKIP() << "AES256-GCM unavailable on this CPU";
+
+    const std::vector<uint8_t> key(AES_KEY_SIZE, 0x3c);
+    const auto plaintext = patterned(50000);
+    std::vector<uint8_t> iv;
+    auto ciphertext = encrypt_aes256_gcm(plaintext, key, iv);
+    const std::span<const uint8_t> body(ciphertext.data(), plaintext.size());
+    const std::span<const uint8_t, AES_TAG_SIZE> tag(ciphertext.data() + plaintext.size(), AES_TAG_SIZE);
+
+    for (const size_t offset : {size_t{1}, size_t{15}, size_t{16}, size_t{4097}, plaintext.size() - 1}) {
+        AES256GCMDecryptor dec(key, iv, offset);
+        EXPECT_FALSE(dec.authenticated());
+        std::vector<uint8_t> out(plaintext.size() - offset);
+        dec.update(body.subspan(offset), out);
+        EXPECT_TRUE(std::equal(out.begin(), out.end(), plaintext.begin() + static_cast<long>(offset))) << offset;
+    }
+
+    AES256GCMDecryptor whole(key, iv);
+    ASSERT_TRUE(whole.authenticated());
+    std::vector<uint8_t> out(plaintext.size());
+    for (size_t off = 0; off < body.size(); off += 8192) {
+        const auto n = std::min<size_t>(8192, body.size() - off);
+        whole.update(body.subspan(off, n), std::span(out).subspan(off, n));
+    }
+    EXPECT_TRUE(whole.verify(tag));
+    EXPECT_EQ(out, plaintext);
+
+    ciphertext[100] ^= 0x01;
+    AES256GCMDecryptor tampered(key, iv);
+    tampered.update(body, out);
+    EXPECT_FALSE(tampered.verify(tag));
+}
@@ -0,0 +1,165 @@
+#include "db/Pipeline.hpp"
+#include "db/Transactions.hpp"
+#include "db/query/fs/File.hpp"
+#include "db/query/identities/Group.hpp"
+#include "db/query/identities/User.hpp"
+#include "db/query/rbac/role/Admin.hpp"
+#include "fs/model/File.hpp"
+#include "identities/Group.hpp"
+#include "identities/User.hpp"
+#include "rbac/role/Admin.hpp"
+#include "seed/include/init_db_tables.hpp"
+#include "seed/include/seed_db.hpp"
+
+#include <paths.h>
+#include <gtest/gtest.h>
+
+using namespace vh;
+
+class PipelineTest : public ::testing::Test {
+protected:
+    inline static bool skipTests = false;
+    inline static uint32_t userId = 0;
+    inline static uint32_t vaultId = 0;
+    inline static std::vector<uint32_t> dirChain;   // root, /a, /a/b
+
+    static bool hasDbEnv() {
+        return std::getenv("VH_TEST_DB_USER") &&
+               std::getenv("VH_TEST_DB_PASS") &&
+               std::getenv("VH_TEST_DB_HOST") &&
+               std::getenv("VH_TEST_DB_PORT") &&
+               std::getenv("VH_TEST_DB_NAME");
+    }
+
+    static void SetUpTestSuite() {
+        if (!hasDbEnv()) {
+            skipTests = true;
+            std::cout << "[test_db_pipeline] Skipping db tests due to missing environment variables." << std::endl;
+            return;
+        }
+
+        paths::enableTestMode();
+        db::Transactions::init();
+        db::seed::nuke_and_recreate_schema_public();
+        db::Transactions::dbPool_->initPreparedStatements();
+        seed::initPermissions();
+        seed::initRoles();
+
+        const auto user = std::make_shared<identities::User>();
+        user->name = "pipeline_user";
+        user->email = "pipeline@vaulthalla.test";
+        user->setPasswordHash("hash");
+        user->roles.admin = db::query::rbac::role::Admin::get("super_admin");
+        userId = db::query::identities::User::createUser(user);
+
+        for (const auto name : {"pipeline_a", "pipeline_b"}) {
+            const auto group = std::make_shared<identities::Group>();
+            group->name = name;
+            group->description = "pipeline test group";
+            db::query::identities::Group::addMemberToGroup(db::query::identities::Group::createGroup(group), userId);
+        }
+
+        db::Transactions::exec("PipelineTest::seed", [&](pqxx::work& txn) {
+            vaultId = txn.exec(
+                "INSERT INTO vault (type, name, owner_id, mount_point) VALUES ($1, $2, $3, $4) RETURNING id",
+                pqxx::params{"local", "Pipeline Vault", userId, "PIPE456789ABCDEFGHJKMNPQRSTVWXYZ"}
+            ).one_field().as<uint32_t>();
+
+            std::optional<uint32_t> parent;
+            for (const std::string path : {"/", "/a", "/a/b"}) {
+                const auto name = path == "/" ? path : path.substr(path.rfind('/') + 1);
+                const auto id = txn.exec(
+                    "INSERT INTO fs_entry (vault_id, parent_id, name, created_by, path) VALUES ($1, $2, $3, $4, $5) RETURNING id",
+                    pqxx::params{vaultId, parent, name, userId, path}
+                ).one_field().as<uint32_t>();
+                txn.exec("INSERT INTO directories (fs_entry_id) VALUES ($1)", pqxx::params{id});
+                dirChain.push_back(id);
+                parent = id;
+            }
+        });
+    }
+
+    void SetUp() override {
+        if (skipTests) GTEST_SKIP() << "Skipping db tests due to missing environment variables.";
+    }
+
+    void TearDown() override {
+        db::Pipeline::setDefaultMode(db::Pipeline::Mode::Batched);
+    }
+};
+
+TEST_F(PipelineTest, BatchesStatementsIntoOneRoundTripAndKeepsOrder) {
+    db::Transactions::exec("PipelineTest::batch", [&](pqxx::work& txn) {
+        db::Pipeline pipe(txn);
+        const auto missing = pipe.prepped("fs_entry_exists_by_inode", 987654321);
+        const auto groups = pipe.prepped("list_groups_for_user", userId);
+        const auto root = pipe.prepped("get_fs_entry_by_id", dirChain.front());
+
+        EXPECT_FALSE(pipe.retrieve(missing).one_field().as<bool>());
+        EXPECT_EQ(pipe.retrieve(groups).size(), 2u);
+        EXPECT_EQ(pipe.retrieve(root).one_row()["path"].as<std::string>(), "/");
+        pipe.complete();
+
+        EXPECT_EQ(pipe.statements(), 3u);
+        EXPECT_EQ(pipe.roundTrips(), 1u);
+    });
+}
+
+TEST_F(PipelineTest, UnretrievedFailureSurfacesOnComplete) {
+    EXPECT_THROW(db::Transactions::exec("PipelineTest::failure", [&](pqxx::work& txn) {
+        db::Pipeline pipe(txn);
+        (void)pipe.prepped("list_groups_for_user", userId);
+        (void)pipe.prepped("no_such_statement", 1);
+        pipe.complete();
+    }), pqxx::sql_error);
+}
+
+TEST_F(PipelineTest, HydratedUserMatchesSerialExecution) {
+    const auto batched = db::query::identities::User::getUserById(userId);
+    db::Pipeline::setDefaultMode(db::Pipeline::Mode::Serial);
+    const auto serial = db::query::identities::User::getUserById(userId);
+
+    ASSERT_TRUE(batched && serial);
+    EXPECT_EQ(batched->roles.admin->id, serial->roles.admin->id);
+    ASSERT_EQ(batched->groups.size(), 2u);
+    ASSERT_EQ(serial->groups.size(), 2u);
+    for (size_t i = 0; i < batched->groups.size(); ++i) {
+        EXPECT_EQ(batched->groups[i]->name, serial->groups[i]->name);
+        EXPECT_EQ(batched->groups[i]->members.size(), serial->groups[i]->members.size());
+    }
+}
+
+TEST_F(PipelineTest, FileCreateRollsSizeUpEveryAncestor) {
+    const auto file = std::make_shared<fs::model::File>();
+    file->vault_id = static_cast<int32_t>(vaultId);
+    file->parent_id = static_cast<int32_t>(dirChain.back());
+    file->name = "leaf.bin";
+    file->base32_alias = "PIPELEAF0123456789ABCDEFGHJKMNPQR";
+    file->created_by = file->last_modified_by = static_cast<int32_t>(userId);
+    file->setPath("/a/b/leaf.bin");
+    file->inode = 424242;
+    file->size_bytes = 4096;
+
+    EXPECT_GT(db::query::fs::File::upsertFile(file), 0u);
+
+    db::Transactions::exec("PipelineTest::verify", [&](pqxx::work& txn) {
+        for (const auto dirId : dirChain) {
+            const auto row = txn.exec(
+                "SELECT size_bytes, file_count FROM directories WHERE fs_entry_id = $1", pqxx::params{dirId}
+            ).one_row();
+            EXPECT_EQ(row["size_bytes"].as<int64_t>(), 4096);
+            EXPECT_EQ(row["file_count"].as<int>(), 1);
+        }
+    });
+
+    // Re-upserting with a new size only moves the totals by the difference
+    file->size_bytes = 1024;
+    db::query::fs::File::upsertFile(file);
+    db::Transactions::exec("PipelineTest::verifyDelta", [&](pqxx::work& txn) {
+        const auto row = txn.exec(
+            "SELECT size_bytes, file_count FROM directories WHERE fs_entry_id = $1", pqxx::params{dirChain.front()}
+        ).one_row();
+        EXPECT_EQ(row["size_bytes"].as<int64_t>(), 1024);
+        EXPECT_EQ(row["file_count"].as<int>(), 1);
+    });
+}
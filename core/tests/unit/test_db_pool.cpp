@@ -0,0 +1,132 @@
+#include "db/DBPool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <thread>
+
+using namespace vh::db;
+
+namespace {
+
+// The pool never dereferences connections itself, so null handles stand in for real ones
+struct FakeBackend {
+    std::atomic<int> opened{0}, prepared{0}, validated{0};
+    std::atomic<bool> healthy{true};
+
+    DBPool::Hooks hooks() {
+        return {
+            .open = [this] { ++opened; return std::unique_ptr<Connection>{}; },
+            .prepare = [this](Connection*) { ++prepared; },
+            .validate = [this](Connection*) { ++validated; return healthy.load(); }
+        };
+    }
+};
+
+PoolOptions options(const size_t min, const size_t max) {
+    PoolOptions o;
+    o.minSize = min;
+    o.maxSize = max;
+    o.acquireTimeout = std::chrono::milliseconds{50};
+    return o;
+}
+
+}
+
+TEST(DBPoolTest, StartsAtMinimumAndGrowsToMaximumOnDemand) {
+    FakeBackend backend;
+    DBPool pool(options(1, 3), backend.hooks());
+    EXPECT_EQ(backend.opened, 1);
+
+    auto a = pool.lease();
+    auto b = pool.lease();
+    auto c = pool.lease();
+    EXPECT_EQ(backend.opened, 3);
+
+    const auto stats = pool.stats();
+    EXPECT_EQ(stats.open, 3u);
+    EXPECT_EQ(stats.inUse, 3u);
+    EXPECT_EQ(stats.wait.count, 3u);
+}
+
+TEST(DBPoolTest, AcquireTimesOutWithAClearErrorWhenExhausted) {
+    FakeBackend backend;
+    DBPool pool(options(0, 1), backend.hooks());
+
+    auto held = pool.lease();
+    EXPECT_THROW((void)pool.lease(), AcquireTimeout);
+    EXPECT_EQ(pool.stats().timeouts, 1u);
+}
+
+TEST(DBPoolTest, WaiterGetsTheConnectionReleasedByAnotherThread) {
+    FakeBackend backend;
+    auto o = options(1, 1);
+    o.acquireTimeout = std::chrono::seconds{5};
+    DBPool pool(o, backend.hooks());
+
+    std::optional<DBPool::Lease> held(pool.lease());
+    std::thread releaser([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds{20});
+        held.reset();
+    });
+
+    auto next = pool.lease();
+    releaser.join();
+    EXPECT_EQ(backend.opened, 1);
+    EXPECT_GE(pool.stats().wait.max_us, 10'000u);
+}
+
+TEST(DBPoolTest, BrokenConnectionsAreReplacedAndPrepared) {
+    FakeBackend backend;
+    DBPool pool(options(1, 1), backend.hooks());
+    pool.initPreparedStatements();
+    EXPECT_EQ(backend.prepared, 1);
+
+    {
+        auto lease = pool.lease();
+        lease.markBroken();
+    }
+    EXPECT_EQ(pool.stats().open, 0u);
+
+    auto fresh = pool.lease();
+    EXPECT_EQ(backend.opened, 2);
+    EXPECT_EQ(backend.prepared, 2);
+}
+
+TEST(DBPoolTest, StaleIdleConnectionsAreValidatedAndReconnectedWhenDead) {
+    FakeBackend backend;
+    auto o = options(1, 2);
+    o.validateIdleAfter = std::chrono::seconds{0};
+    DBPool pool(o, backend.hooks());
+    pool.initPreparedStatements();
+
+    { auto lease = pool.lease(); }
+    EXPECT_EQ(backend.validated, 1);
+    EXPECT_EQ(backend.opened, 1);
+
+    backend.healthy = false;
+    { auto lease = pool.lease(); }
+    EXPECT_EQ(backend.opened, 2);
+    EXPECT_EQ(backend.prepared, 2);
+    EXPECT_EQ(pool.stats().reconnects, 1u);
+}
+
+TEST(DBPoolTest, TrimsIdleSurplusDownToMinimum) {
+    FakeBackend backend;
+    auto o = options(1, 3);
+    o.idleTimeout = std::chrono::seconds{0};
+    DBPool pool(o, backend.hooks());
+
+    {
+        auto a = pool.lease();
+        auto b = pool.lease();
+        auto c = pool.lease();
+    }
+
+    const auto stats = pool.stats();
+    EXPECT_EQ(stats.open, 1u);
+    EXPECT_EQ(stats.idle, 1u);
+    EXPECT_EQ(stats.held.count, 3u);
+}
@@ -0,0 +1,156 @@
+#include "protocols/http/model/download/Archive.hpp"
+
+#include <gtest/gtest.h>
+#include <zlib.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+using namespace vh::protocols::http::model::download;
+
+namespace {
+
+uint16_t u16(const std::vector<uint8_t>& b, const size_t at) {
+    return static_cast<uint16_t>(b[at] | (b[at + 1] << 8));
+}
+
+uint32_t u32(const std::vector<uint8_t>& b, const size_t at) {
+    return static_cast<uint32_t>(u16(b, at)) | (static_cast<uint32_t>(u16(b, at + 2)) << 16);
+}
+
+std::vector<uint8_t> drain(Archive& archive) {
+    std::vector<uint8_t> out;
+    boost::system::error_code ec;
+    while (!archive.done()) {
+        const auto chunk = archive.next(ec);
+        EXPECT_FALSE(ec) << ec.message();
+        if (ec) break;
+        out.insert(out.end(), chunk.begin(), chunk.end());
+    }
+    return out;
+}
+
+std::vector<uint8_t> inflateRaw(const uint8_t* data, const size_t size, const size_t expected) {
+    std::vector<uint8_t> out(expected);
+    z_stream z{};
+    inflateInit2(&z, -MAX_WBITS);
+    z.next_in = const_cast<Bytef*>(data);
+    z.avail_in = static_cast<uInt>(size);
+    z.next_out = out.data();
+    z.avail_out = static_cast<uInt>(out.size());
+    EXPECT_EQ(Z_STREAM_END, inflate(&z, Z_FINISH));
+    inflateEnd(&z);
+    return out;
+}
+
+}
+
+TEST(DownloadArchiveTest, StreamsEntriesWithMatchingCentralDirectory) {
+    std::vector<uint8_t> text;
+    for (size_t i = 0; i < 3 * Archive::CHUNK_BYTES; ++i) text.push_back(static_cast<uint8_t>("vaulthalla\n"[i % 11]));
+    const std::vector<uint8_t> raw{1, 2, 3, 4, 5};
+
+    bool opened = false;
+    Archive archive({
+        { .name = "docs/" },
+        { .name = "docs/notes.txt", .open = [&] { return Source(text); }, .deflate = true },
+        { .name = "docs/raw.bin", .open = [&] { opened = true; return Source(raw); } },
+    });
+
+    const auto zip = drain(archive);
+    EXPECT_TRUE(opened);
+    EXPECT_EQ(zip.size(), archive.bytesWritten());
+    ASSERT_GT(zip.size(), 22u);
+
+    const auto eocd = zip.size() - 22;
+    ASSERT_EQ(0x06054b50u, u32(zip, eocd));
+    ASSERT_EQ(3u, u16(zip, eocd + 10));
+
+    size_t cd = u32(zip, eocd + 16);
+    std::vector<std::string> names;
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_EQ(0x02014b50u, u32(zip, cd));
+        const auto method = u16(zip, cd + 10);
+        const auto crc = u32(zip, cd + 16);
+        const auto compressed = u32(zip, cd + 20);
+        const auto size = u32(zip, cd + 24);
+        const auto nameLen = u16(zip, cd + 28);
+        const auto extraLen = u16(zip, cd + 30);
+        const auto madeBy = u16(zip, cd + 4);
+        const auto external = u32(zip, cd + 38);
+        const auto local = u32(zip, cd + 42);
+        names.emplace_back(reinterpret_cast<const char*>(zip.data() + cd + 46), nameLen);
+
+        // MS-DOS host, so directories carry FILE_ATTRIBUTE_DIRECTORY and files nothing
+        EXPECT_EQ(0u, madeBy >> 8);
+        EXPECT_EQ(names.back().ends_with('/') ? 0x10u : 0u, external);
+
+        ASSERT_EQ(0x04034b50u, u32(zip, local));
+        const auto data = local + 30 + u16(zip, local + 26) + u16(zip, local + 28);
+
+        if (names.back() == "docs/notes.txt") {
+            EXPECT_EQ(8u, method);
+            EXPECT_LT(compressed, size);
+            EXPECT_EQ(text, inflateRaw(zip.data() + data, compressed, size));
+            EXPECT_EQ(crc32(0, text.data(), static_cast<uInt>(text.size())), crc);
+        } else if (names.back() == "docs/raw.bin") {
+            EXPECT_EQ(0u, method);
+            EXPECT_EQ(raw.size(), size);
+            EXPECT_EQ(0, std::memcmp(zip.data() + data, raw.data(), raw.size()));
+        }
+
+        // Every file entry is followed by a ZIP64 data descriptor
+        if (method == 8 || size > 0) EXPECT_EQ(0x08074b50u, u32(zip, data + compressed));
+        cd += 46 + nameLen + extraLen;
+    }
+
+    EXPECT_EQ((std::vector<std::string>{"docs/", "docs/notes.txt", "docs/raw.bin"}), names);
+}
+
+TEST(DownloadArchiveTest, FailedEntryTruncatesTheStream) {
+    Archive archive({
+        { .name = "missing.bin", .open = []() -> Source { throw std::runtime_error("gone"); } },
+    });
+
+    boost::system::error_code ec;
+    const auto chunk = archive.next(ec);
+    EXPECT_TRUE(ec);
+    EXPECT_TRUE(chunk.empty());
+    EXPECT_FALSE(archive.done());
+}
+
+TEST(DownloadArchiveTest, FileBackedBodyOnlyDrainsFilledChunks) {
+    const auto path = std::filesystem::temp_directory_path() / ("vh_download_body_" + std::to_string(::getpid()));
+    std::vector<uint8_t> data(Source::CHUNK_BYTES + 100);
+    for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<uint8_t>(i * 7);
+    std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+
+    Response res{boost::beast::http::status::ok, 11};
+    res.body() = Source(path, 0, data.size());
+    Body::writer writer(res, res.body());
+
+    std::vector<uint8_t> out;
+    size_t fills = 0;
+    boost::system::error_code ec;
+    while (true) {
+        const auto got = writer.get(ec);
+        if (ec == boost::beast::http::error::need_buffer) {
+            res.body().fill();
+            ++fills;
+            continue;
+        }
+        ASSERT_FALSE(ec) << ec.message();
+        if (!got) break;
+        const auto* p = static_cast<const uint8_t*>(got->first.data());
+        out.insert(out.end(), p, p + got->first.size());
+        if (!got->second) break;
+    }
+    std::filesystem::remove(path);
+
+    EXPECT_EQ(fills, 2u);
+    EXPECT_EQ(out, data);
+}
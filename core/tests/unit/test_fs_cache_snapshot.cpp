@@ -0,0 +1,142 @@
+#include "fs/cache/Snapshot.hpp"
+#include "fs/model/File.hpp"
+#include "fs/model/Directory.hpp"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+using namespace vh::fs::cache;
+using namespace vh::fs::model;
+
+namespace {
+
+class FsCacheSnapshotTest : public ::testing::Test {
+protected:
+    std::filesystem::path file;
+
+    void SetUp() override {
+        file = std::filesystem::temp_directory_path() /
+               ("vh_fs_snapshot_" + std::to_string(::getpid()) + "_" +
+                ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove(file);
+    }
+
+    void TearDown() override { std::filesystem::remove(file); }
+
+    static Snapshot::Stamp at(const uint64_t generation) {
+        return {.epoch = "5c0e3d2a-4b7f-4f0e-9a61-2f1c8d7e6b40:731", .generation = generation};
+    }
+
+    static std::vector<std::shared_ptr<Entry>> sample() {
+        auto dir = std::make_shared<Directory>();
+        dir->id = 7;
+        dir->name = "docs";
+        dir->base32_alias = "MRXWG4Y";
+        dir->parent_id = 1;
+        dir->vault_id = 3;
+        dir->inode = 12;
+        dir->path = "/docs";
+        dir->fuse_path = "/vault/docs";
+        dir->backing_path = "/var/lib/vaulthalla/MRXWG4Y";
+        dir->size_bytes = 4096;
+        dir->file_count = 1;
+        dir->subdirectory_count = 0;
+
+        auto file = std::make_shared<File>();
+        file->id = 8;
+        file->name = "report.pdf";
+        file->base32_alias = "OJSXA33SOQ";
+        file->parent_id = 7;
+        file->vault_id = 3;
+        file->owner_uid = 1000;
+        file->inode = 13;
+        file->mode = 0100644;
+        file->path = "/docs/report.pdf";
+        file->fuse_path = "/vault/docs/report.pdf";
+        file->backing_path = "/var/lib/vaulthalla/MRXWG4Y/OJSXA33SOQ";
+        file->size_bytes = 4096;
+        file->is_hidden = true;
+        file->created_at = 1700000000;
+        file->updated_at = 1700000500;
+        file->encryption_iv = std::string("iv\0bytes", 8);
+        file->encrypted_with_key_version = 2;
+        file->mime_type = "application/pdf";
+
+        return {dir, file};
+    }
+};
+
+}
+
+TEST_F(FsCacheSnapshotTest, RoundTripsEntriesAndLoadedDirs) {
+    Snapshot::write(file, at(42), sample(), {1, 7, 9});
+
+    const auto snap = Snapshot::read(file, at(42));
+    ASSERT_TRUE(snap);
+    EXPECT_EQ(snap->stamp, at(42));
+    EXPECT_EQ(snap->loadedDirs, (std::vector<unsigned int>{1, 7, 9}));
+    ASSERT_EQ(snap->entries.size(), 2u);
+
+    const auto dir = std::dynamic_pointer_cast<Directory>(snap->entries[0]);
+    ASSERT_TRUE(dir);
+    EXPECT_EQ(dir->id, 7u);
+    EXPECT_EQ(dir->fuse_path, "/vault/docs");
+    EXPECT_EQ(dir->file_count, 1u);
+    EXPECT_FALSE(dir->owner_uid);
+
+    const auto f = std::dynamic_pointer_cast<File>(snap->entries[1]);
+    ASSERT_TRUE(f);
+    EXPECT_EQ(f->name, "report.pdf");
+    EXPECT_EQ(f->backing_path, "/var/lib/vaulthalla/MRXWG4Y/OJSXA33SOQ");
+    EXPECT_EQ(f->parent_id, 7);
+    EXPECT_EQ(f->owner_uid, 1000);
+    EXPECT_EQ(f->inode, 13u);
+    EXPECT_EQ(f->mode, 0100644u);
+    EXPECT_TRUE(f->is_hidden);
+    EXPECT_EQ(f->updated_at, 1700000500);
+    EXPECT_EQ(f->encryption_iv, std::string("iv\0bytes", 8));
+    EXPECT_EQ(f->encrypted_with_key_version, 2u);
+    EXPECT_EQ(f->mime_type, "application/pdf");
+    EXPECT_FALSE(f->content_hash);
+}
+
+TEST_F(FsCacheSnapshotTest, RejectsStaleGenerationAndMissingFile) {
+    EXPECT_FALSE(Snapshot::read(file, at(0)));
+
+    Snapshot::write(file, at(42), sample(), {});
+    EXPECT_FALSE(Snapshot::read(file, at(43)));
+    EXPECT_TRUE(Snapshot::read(file, at(42)));
+}
+
+TEST_F(FsCacheSnapshotTest, RejectsImageFromAnotherEpoch) {
+    Snapshot::write(file, at(42), sample(), {});
+
+    // A restored or reset database can count back up to the same generation
+    EXPECT_FALSE(Snapshot::read(file, {.epoch = "0b9a6f1e-restored:812", .generation = 42}));
+    EXPECT_FALSE(Snapshot::read(file, {.epoch = "", .generation = 42}));
+    EXPECT_THROW(Snapshot::write(file, {.epoch = std::string(Snapshot::kMaxEpochBytes, 'e'), .generation = 1}, sample(), {}),
+                 std::invalid_argument);
+    EXPECT_TRUE(Snapshot::read(file, at(42)));
+}
+
+TEST_F(FsCacheSnapshotTest, RejectsCorruptionAndTruncation) {
+    Snapshot::write(file, at(5), sample(), {7});
+    const auto size = std::filesystem::file_size(file);
+
+    {
+        std::fstream io(file, std::ios::in | std::ios::out | std::ios::binary);
+        io.seekp(static_cast<std::streamoff>(size - 3));
+        io.put('X');
+    }
+    EXPECT_FALSE(Snapshot::read(file, at(5)));
+
+    Snapshot::write(file, at(5), sample(), {7});
+    std::filesystem::resize_file(file, size - 1);
+    EXPECT_FALSE(Snapshot::read(file, at(5)));
+}
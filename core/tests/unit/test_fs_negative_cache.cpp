@@ -0,0 +1,63 @@
+#include "fs/cache/NegativeCache.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+using namespace vh::fs::cache;
+using namespace std::chrono_literals;
+
+TEST(FsNegativeCacheTest, RemembersUntilTtlExpires) {
+    NegativeCache cache(64, 30ms);
+    EXPECT_TRUE(cache.enabled());
+
+    cache.insert("/vault/.git/HEAD");
+    cache.insertId(41);
+    EXPECT_TRUE(cache.contains("/vault/.git/HEAD"));
+    EXPECT_TRUE(cache.containsId(41));
+    EXPECT_FALSE(cache.contains("/vault/.git"));
+    EXPECT_FALSE(cache.containsId(42));
+
+    std::this_thread::sleep_for(50ms);
+    EXPECT_FALSE(cache.contains("/vault/.git/HEAD"));
+    EXPECT_FALSE(cache.containsId(41));
+    EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST(FsNegativeCacheTest, EraseUnderDropsTheSubtreeOnly) {
+    NegativeCache cache(64, 10s);
+    cache.insert("/vault/build");
+    cache.insert("/vault/build/__pycache__");
+    cache.insert("/vault/build/obj/a.o");
+    cache.insert("/vault/builder");
+    cache.insertId(7);
+
+    cache.eraseUnder("/vault/build");
+    EXPECT_FALSE(cache.contains("/vault/build"));
+    EXPECT_FALSE(cache.contains("/vault/build/__pycache__"));
+    EXPECT_FALSE(cache.contains("/vault/build/obj/a.o"));
+    EXPECT_TRUE(cache.contains("/vault/builder"));
+    EXPECT_TRUE(cache.containsId(7));
+
+    cache.erase("/vault/builder");
+    cache.eraseId(7);
+    EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST(FsNegativeCacheTest, CapacityBoundsEachShard) {
+    NegativeCache cache(32, 10s);
+    for (int i = 0; i < 1000; ++i) cache.insert("/vault/probe-" + std::to_string(i));
+
+    EXPECT_LE(cache.size(), 32u);
+    EXPECT_TRUE(cache.contains("/vault/probe-999"));
+}
+
+TEST(FsNegativeCacheTest, DisabledCacheRemembersNothing) {
+    NegativeCache noTtl(64, 0ms), noRoom(0, 10s);
+    noTtl.insert("/vault/x.lock");
+    noRoom.insert("/vault/x.lock");
+    EXPECT_FALSE(noTtl.contains("/vault/x.lock"));
+    EXPECT_FALSE(noRoom.contains("/vault/x.lock"));
+}
@@ -318,4 +318,16 @@ namespace vh::rbac::fs::glob::test {
         EXPECT_TRUE(Matcher::requiresTraversalThrough("/**/*.pdf", p("/")));
         EXPECT_FALSE(Matcher::requiresTraversalThrough("/**/*.pdf", p("/report.pdf")));
     }
+
+    TEST_F(GlobPathMatchingTest, Matcher_StackedWildcardsDoNotBacktrack) {
+        std::string pattern;
+        for (int i = 0; i < 16; ++i) pattern += "/**";
+        pattern += "/*a*a*a*a*a*a*a*b";
+
+        std::string path;
+        for (int i = 0; i < 64; ++i) path += "/aaaaaaaaaaaaaaaaaaaaaaaaaaaaaa";
+
+        expectNoMatch(pattern, path);
+        expectMatch(pattern, path + "b");
+    }
 }
@@ -369,15 +369,31 @@ std::string stringBody(const vh::protocols::http::model::preview::Response& resp
     return {};
 }
 
-std::string vectorBody(const vh::protocols::http::model::preview::Response& response) {
+std::string vectorBody(vh::protocols::http::model::preview::Response& response) {
+    if (auto* archive = std::get_if<vh::protocols::http::model::download::ArchiveResponse>(&response)) {
+        std::string out;
+        boost::system::error_code ec;
+        while (!archive->body().done()) {
+            const auto chunk = archive->body().next(ec);
+            if (ec) return {};
+            out.append(chunk.begin(), chunk.end());
+        }
+        return out;
+    }
+
+    if (const auto* shared = std::get_if<shared_response>(&response))
+        return shared->body() ? std::string(shared->body()->begin(), shared->body()->end()) : std::string{};
+
     const auto* res = std::get_if<vector_response>(&response);
     if (!res) return {};
     return {res->body().begin(), res->body().end()};
 }
 
+// Takes a field or, for headers Beast has no enumerator for, the header name
+template<class Name>
 std::string responseHeader(
     const vh::protocols::http::model::preview::Response& response,
-    const field header
+    const Name header
 ) {
     return std::visit([header](const auto& res) -> std::string {
         const auto it = res.find(header);
@@ -537,6 +553,45 @@ TEST_F(HttpSharePreviewTest, SharePreviewRendersFallbackWhenThumbnailCacheIsMiss
     EXPECT_NE("cached-thumbnail", vectorBody(response));
 }
 
+TEST_F(HttpSharePreviewTest, FullSizeSharePreviewServesRasterAsStoredWithoutSniffing) {
+    auto session = readySession(vh::share::bit(vh::share::Operation::Preview));
+    installSharePreviewHooks(session);
+
+    file->mime_type = "image/png";
+    file->backing_path = testRoot / "backing" / "uploaded-image";
+    std::filesystem::create_directories(file->backing_path.parent_path());
+    const auto bytes = tinyPng();
+    std::ofstream(file->backing_path, std::ios::binary)
+        .write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+
+    auto response = Router::handlePreview(previewRequest("/preview?share=1&path=%2Freport.jpg"));
+
+    EXPECT_EQ(status::ok, responseStatus(response));
+    EXPECT_EQ("image/png", responseHeader(response, field::content_type));
+    EXPECT_EQ(std::string(bytes.begin(), bytes.end()), vectorBody(response));
+    EXPECT_EQ("nosniff", responseHeader(response, "X-Content-Type-Options"));
+    EXPECT_EQ("sandbox", responseHeader(response, "Content-Security-Policy"));
+}
+
+TEST_F(HttpSharePreviewTest, FullSizeSharePreviewNeverServesSvgAsStored) {
+    auto session = readySession(vh::share::bit(vh::share::Operation::Preview));
+    installSharePreviewHooks(session);
+
+    file->mime_type = "image/svg+xml";
+    file->backing_path = testRoot / "backing" / "uploaded-svg";
+    std::filesystem::create_directories(file->backing_path.parent_path());
+    std::ofstream(file->backing_path, std::ios::binary)
+        << R"(<svg xmlns="http://www.w3.org/2000/svg"><script>alert(document.cookie)</script></svg>)";
+
+    auto response = Router::handlePreview(previewRequest("/preview?share=1&path=%2Freport.jpg"));
+
+    EXPECT_EQ(status::unsupported_media_type, responseStatus(response));
+    EXPECT_NE("image/svg+xml", responseHeader(response, field::content_type));
+    EXPECT_EQ(std::string::npos, vectorBody(response).find("<script>"));
+    EXPECT_EQ("nosniff", responseHeader(response, "X-Content-Type-Options"));
+    EXPECT_EQ("sandbox", responseHeader(response, "Content-Security-Policy"));
+}
+
 TEST_F(HttpSharePreviewTest, DeniesReadyShareSessionWithoutPreviewGrant) {
     auto session = readySession(vh::share::bit(vh::share::Operation::Metadata));
     installSharePreviewHooks(session);
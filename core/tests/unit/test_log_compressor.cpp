@@ -0,0 +1,162 @@
+#include "log/Compressor.hpp"
+#include "log/Rotator.hpp"
+
+#include <gtest/gtest.h>
+
+#include <zlib.h>
+#include <zstd.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace vh::log;
+namespace fs = std::filesystem;
+
+namespace {
+
+fs::path scratchDir(const std::string& name) {
+    const auto dir = fs::temp_directory_path() / ("vh_log_compressor_" + name);
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    return dir;
+}
+
+// Mostly repetitive log text with some noise, larger than one buffer so streaming is exercised
+std::string sampleLog(const std::size_t lines) {
+    std::mt19937 rng(7);
+    std::string out;
+    for (std::size_t i = 0; i < lines; ++i)
+        out += "[2026-01-01 00:00:00.000] [info] [fuse] op=" + std::to_string(rng()) + " line " + std::to_string(i) + "\n";
+    return out;
+}
+
+void writeFile(const fs::path& p, const std::string& data) {
+    std::ofstream(p, std::ios::binary) << data;
+}
+
+std::string readFile(const fs::path& p) {
+    std::ifstream in(p, std::ios::binary);
+    return {std::istreambuf_iterator<char>(in), {}};
+}
+
+std::string gunzip(const std::string& data) {
+    z_stream zs{};
+    EXPECT_EQ(inflateInit2(&zs, 15 + 16), Z_OK);
+    zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    zs.avail_in = static_cast<uInt>(data.size());
+    std::string out;
+    std::vector<char> buf(64 * 1024);
+    int rc;
+    do {
+        zs.next_out = reinterpret_cast<Bytef*>(buf.data());
+        zs.avail_out = static_cast<uInt>(buf.size());
+        rc = inflate(&zs, Z_NO_FLUSH);
+        out.append(buf.data(), buf.size() - zs.avail_out);
+    } while (rc == Z_OK);
+    inflateEnd(&zs);
+    EXPECT_EQ(rc, Z_STREAM_END);
+    return out;
+}
+
+std::string unzstd(const std::string& data) {
+    ZSTD_DCtx* dctx = ZSTD_createDCtx();
+    ZSTD_inBuffer in{data.data(), data.size(), 0};
+    std::vector<char> buf(ZSTD_DStreamOutSize());
+    std::string out;
+    std::size_t rc = 1;
+    while (in.pos < in.size) {
+        ZSTD_outBuffer o{buf.data(), buf.size(), 0};
+        rc = ZSTD_decompressStream(dctx, &o, &in);
+        if (ZSTD_isError(rc)) break;
+        out.append(buf.data(), o.pos);
+    }
+    ZSTD_freeDCtx(dctx);
+    EXPECT_EQ(rc, 0u);
+    return out;
+}
+
+}
+
+TEST(LogCompressorTest, ZstdRoundTripsAndRemovesTheOriginal) {
+    const auto dir = scratchDir("zstd");
+    const auto src = dir / "vaulthalla.20260101-000000.log";
+    const auto payload = sampleLog(20000);
+    writeFile(src, payload);
+
+    const Compressor c({.compression = Rotator::Compression::Zstd, .buffer_bytes = 16_KiB, .low_priority = false});
+    ASSERT_TRUE(c.compress(src));
+
+    EXPECT_FALSE(fs::exists(src));
+    EXPECT_FALSE(fs::exists(dir / "vaulthalla.20260101-000000.log.zst.part"));
+    const auto packed = readFile(dir / "vaulthalla.20260101-000000.log.zst");
+    EXPECT_LT(packed.size(), payload.size());
+    EXPECT_EQ(unzstd(packed), payload);
+}
+
+TEST(LogCompressorTest, GzipRoundTripsIncludingEmptyFiles) {
+    const auto dir = scratchDir("gzip");
+    const auto src = dir / "audit.20260101-000000.log";
+    const auto empty = dir / "audit.20260102-000000.log";
+    const auto payload = sampleLog(5000);
+    writeFile(src, payload);
+    writeFile(empty, "");
+
+    const Compressor c({.compression = Rotator::Compression::Gzip, .level = 9, .buffer_bytes = 8_KiB, .low_priority = false});
+    ASSERT_TRUE(c.compress(src));
+    ASSERT_TRUE(c.compress(empty));
+
+    EXPECT_FALSE(fs::exists(src));
+    EXPECT_EQ(gunzip(readFile(dir / "audit.20260101-000000.log.gz")), payload);
+    EXPECT_EQ(gunzip(readFile(dir / "audit.20260102-000000.log.gz")), "");
+}
+
+TEST(LogCompressorTest, MissingSourceLeavesNothingBehind) {
+    const auto dir = scratchDir("missing");
+    const Compressor c({.compression = Rotator::Compression::Zstd, .low_priority = false});
+    EXPECT_FALSE(c.compress(dir / "gone.20260101-000000.log"));
+    EXPECT_TRUE(fs::is_empty(dir));
+}
+
+TEST(LogCompressorTest, RotatorCompressesInTheBackground) {
+    const auto dir = scratchDir("rotator");
+    const auto active = dir / "vaulthalla.log";
+    const auto payload = sampleLog(1000);
+    writeFile(active, payload);
+
+    // A plain rotation left over from an earlier run is picked up as well
+    const auto leftover = dir / "vaulthalla.20250101-000000.log";
+    writeFile(leftover, payload);
+
+    Rotator rot({
+        .active_path = active,
+        .max_bytes = 1_KiB,
+        .max_interval = std::nullopt,
+        .max_retained_size = std::nullopt,
+        .compression = Rotator::Compression::Zstd
+    });
+    rot.maybeRotate();
+    rot.maybeRotate(); // nothing new to rotate; must not queue the file twice
+
+    // The destructor abandons queued work, so poll until both plain rotations are gone
+    std::vector<fs::path> packed, plain;
+    for (int i = 0; i < 500; ++i) {
+        packed.clear();
+        plain.clear();
+        for (const auto& de : fs::directory_iterator(dir)) {
+            if (de.path().extension() == ".zst") packed.push_back(de.path());
+            else if (de.path().extension() == ".log" && de.path() != active) plain.push_back(de.path());
+        }
+        if (packed.size() == 2 && plain.empty()) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    ASSERT_EQ(packed.size(), 2u);
+    for (const auto& p : packed) EXPECT_EQ(unzstd(readFile(p)), payload);
+    EXPECT_TRUE(plain.empty());
+    EXPECT_TRUE(fs::exists(active));
+}
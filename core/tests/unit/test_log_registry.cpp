@@ -0,0 +1,41 @@
+#include "log/Lazy.hpp"
+#include "log/Registry.hpp"
+
+#include <gtest/gtest.h>
+
+#include <spdlog/sinks/ostream_sink.h>
+
+#include <sstream>
+#include <string>
+
+using namespace vh;
+
+TEST(LogRegistryTest, ShorthandsReturnTheRegisteredLoggers) {
+    ASSERT_TRUE(log::Registry::isInitialized());
+
+    EXPECT_EQ(log::Registry::fuse(), spdlog::get("fuse"));
+    EXPECT_EQ(log::Registry::ws(), spdlog::get("ws"));
+    EXPECT_EQ(log::Registry::audit(), spdlog::get("audit"));
+
+    // Same handle every call, no registry lookup in between
+    EXPECT_EQ(&log::Registry::storage(), &log::Registry::storage());
+    EXPECT_THROW(log::Registry::get("no-such-subsystem"), std::runtime_error);
+}
+
+TEST(LogRegistryTest, LazyArgumentsOnlyRunWhenTheLevelIsEnabled) {
+    std::ostringstream out;
+    spdlog::logger logger("lazy_test", std::make_shared<spdlog::sinks::ostream_sink_mt>(out));
+    logger.set_pattern("%v");
+    logger.set_level(spdlog::level::info);
+
+    int calls = 0;
+    const auto expensive = [&] { ++calls; return std::string("payload"); };
+
+    logger.debug("skipped {}", log::lazy(expensive));
+    EXPECT_EQ(calls, 0);
+    EXPECT_TRUE(out.str().empty());
+
+    logger.info("kept {:>8}", log::lazy(expensive));
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(out.str(), "kept  payload\n");
+}
@@ -0,0 +1,54 @@
+#include "fs/metadata/Magic.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string_view>
+#include <vector>
+
+using namespace vh::fs::metadata;
+
+namespace {
+
+std::span<const uint8_t> bytes(const std::string_view s) {
+    return {reinterpret_cast<const uint8_t*>(s.data()), s.size()};
+}
+
+}
+
+TEST(MagicSniffTest, RecognizesCommonBinarySignatures) {
+    using namespace std::string_view_literals;
+    EXPECT_EQ(Magic::sniff(bytes("\xFF\xD8\xFF\xE0\x00\x10JFIF"sv)), "image/jpeg");
+    EXPECT_EQ(Magic::sniff(bytes("\x89PNG\r\n\x1A\n\x00\x00\x00\x0DIHDR"sv)), "image/png");
+    EXPECT_EQ(Magic::sniff(bytes("GIF89a\x01\x00"sv)), "image/gif");
+    EXPECT_EQ(Magic::sniff(bytes("%PDF-1.7\n"sv)), "application/pdf");
+    EXPECT_EQ(Magic::sniff(bytes("RIFF\x24\x00\x00\x00WEBPVP8 "sv)), "image/webp");
+}
+
+TEST(MagicSniffTest, LeavesAmbiguousContentToLibmagic) {
+    using namespace std::string_view_literals;
+    EXPECT_FALSE(Magic::sniff(bytes("RIFF\x24\x00\x00\x00WAVEfmt "sv)).has_value());
+    EXPECT_FALSE(Magic::sniff(bytes("PK\x03\x04"sv)).has_value());
+    EXPECT_FALSE(Magic::sniff(bytes("\xFF\xD8"sv)).has_value());
+    EXPECT_FALSE(Magic::sniff(bytes("hello world\n"sv)).has_value());
+}
+
+TEST(MagicSniffTest, UsesExtensionOnlyForTextContent) {
+    using namespace std::string_view_literals;
+    EXPECT_EQ(Magic::sniff(bytes("a,b,c\n1,2,3\n"sv), "report.CSV"), "text/csv");
+    EXPECT_EQ(Magic::sniff(bytes("# Notes\n\tindented\n"sv), "README.md"), "text/plain");
+    EXPECT_FALSE(Magic::sniff(bytes("bin\x00\x01\x02"sv), "notes.txt").has_value());
+    EXPECT_FALSE(Magic::sniff(bytes("{\"a\": 1}"sv), "data.json").has_value());
+    EXPECT_EQ(Magic::sniff(bytes("plain\n"sv), "r\xC3\xA9sum\xC3\xA9.TXT"), "text/plain");
+    EXPECT_FALSE(Magic::sniff(bytes("plain\n"sv), "notes.t\xC3\xABxt").has_value());
+}
+
+TEST(MagicSniffTest, LibmagicSeesNoMoreThanTheSniffCap) {
+    // Text up to the cap, then a binary tail libmagic must never reach
+    std::vector<uint8_t> buffer(Magic::SNIFF_BYTES, 'a');
+    buffer.insert(buffer.end(), 4096, 0x00);
+
+    const auto whole = Magic::get_mime_type_from_buffer(buffer);
+    const auto head = Magic::get_mime_type_from_buffer(std::span<const uint8_t>(buffer).first(Magic::SNIFF_BYTES));
+    EXPECT_EQ(whole, head);
+    EXPECT_EQ(whole, "text/plain");
+}
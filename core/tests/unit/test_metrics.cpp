@@ -0,0 +1,76 @@
+#include "stats/Metrics.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace vh::stats;
+using namespace vh::stats::model;
+
+TEST(MetricsTest, BucketBoundsRoundTrip) {
+    for (uint64_t us : {0ull, 1ull, 3ull, 4ull, 5ull, 7ull, 8ull, 99ull, 1000ull, 65535ull, 1000000ull, 33554431ull}) {
+        const auto i = HistogramSnapshot::bucket_for(us);
+        EXPECT_LE(us, HistogramSnapshot::upper_bound_us(i)) << us;
+        if (i > 0) EXPECT_GT(us, HistogramSnapshot::upper_bound_us(i - 1)) << us;
+    }
+
+    EXPECT_EQ(HistogramSnapshot::bucket_for(uint64_t{1} << kHistogramOctaves), kHistogramBuckets - 1);
+    EXPECT_EQ(HistogramSnapshot::bucket_for(UINT64_MAX), kHistogramBuckets - 1);
+
+    // Octave boundaries land exactly on 2^k - 1
+    for (std::size_t i = 0; i + 1 < kHistogramBuckets; ++i) {
+        if (!HistogramSnapshot::is_octave_boundary(i)) continue;
+        const auto ub = HistogramSnapshot::upper_bound_us(i) + 1;
+        EXPECT_EQ(ub & (ub - 1), 0u) << i;
+    }
+}
+
+TEST(MetricsTest, ShardsMergeAcrossThreads) {
+    Histogram h;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 16; ++t)
+        threads.emplace_back([&h, t] {
+            for (int i = 0; i < 1000; ++i) h.observe_us(static_cast<uint64_t>(t * 100 + i % 10));
+        });
+    for (auto& t : threads) t.join();
+
+    const auto s = h.snapshot();
+    EXPECT_EQ(s.count, 16000u);
+    EXPECT_EQ(s.max_us, 1509u);
+
+    uint64_t total = 0;
+    for (const auto n : s.buckets) total += n;
+    EXPECT_EQ(total, s.count);
+    EXPECT_LE(s.quantile_us(1.0), s.max_us);
+}
+
+TEST(MetricsTest, PrometheusExposition) {
+    auto& h = Metrics::instance().histogram(Metric::FuseOp, "look\"up");
+    h.observe_us(3);
+    h.observe_us(1500);
+
+    Metrics::instance().bind(Metric::DbAcquire, "", [] {
+        HistogramSnapshot s;
+        s.buckets[HistogramSnapshot::bucket_for(10)] = 2;
+        s.count = 2;
+        s.sum_us = 20;
+        s.max_us = 10;
+        return s;
+    });
+
+    const auto text = Metrics::instance().prometheus();
+    EXPECT_NE(text.find("# TYPE vh_fuse_op_duration_seconds histogram\n"), std::string::npos);
+    EXPECT_NE(text.find("vh_fuse_op_duration_seconds_bucket{op=\"look\\\"up\",le=\"+Inf\"} 2\n"), std::string::npos);
+    EXPECT_NE(text.find("vh_fuse_op_duration_seconds_bucket{op=\"look\\\"up\",le=\"0.000127\"} 1\n"), std::string::npos);
+    EXPECT_NE(text.find("vh_fuse_op_duration_seconds_count{op=\"look\\\"up\"} 2\n"), std::string::npos);
+    EXPECT_NE(text.find("vh_fuse_op_duration_seconds_sum{op=\"look\\\"up\"} 0.001503\n"), std::string::npos);
+
+    EXPECT_NE(text.find("vh_db_acquire_wait_seconds_bucket{le=\"+Inf\"} 2\n"), std::string::npos);
+    EXPECT_NE(text.find("vh_db_acquire_wait_seconds_bucket{le=\"1.5e-05\"} 2\n"), std::string::npos);
+    EXPECT_NE(text.find("vh_db_acquire_wait_seconds_count 2\n"), std::string::npos);
+
+    // Same label resolves to the same histogram
+    EXPECT_EQ(&Metrics::instance().histogram(Metric::FuseOp, "look\"up"), &h);
+}
@@ -0,0 +1,205 @@
+#include "rbac/fs/policy/DecisionCache.hpp"
+#include "rbac/fs/policy/Evaluator.hpp"
+#include "rbac/fs/policy/OverrideIndex.hpp"
+#include "rbac/fs/glob/Matcher.hpp"
+#include "rbac/permission/OverrideList.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace vh::rbac;
+using fs::policy::DecisionCache;
+using fs::policy::Evaluator;
+using fs::policy::OverrideIndex;
+using permission::Override;
+using permission::OverrideList;
+using permission::OverrideOpt;
+using Action = permission::vault::FilesystemAction;
+
+namespace {
+
+Override makeOverride(const std::string& pattern, const OverrideOpt effect, const std::string& qualifiedName, const bool enabled = true) {
+    Override o;
+    o.permission.qualified_name = qualifiedName;
+    o.effect = effect;
+    o.enabled = enabled;
+    o.pattern = fs::glob::model::Pattern::make(pattern);
+    return o;
+}
+
+// What Evaluator did before overrides were indexed: scan all of them, keep the first best score
+const Override* linearBest(const std::vector<Override>& overrides, const std::string& path, const Action action) {
+    const Override* best = nullptr;
+    std::size_t bestScore = 0;
+
+    for (const auto& o : overrides) {
+        if (!o.enabled) continue;
+
+        if (const auto f = permission::vault::fs::Files::resolveFromQualifiedName(o.permission.qualified_name)) {
+            const auto req = Evaluator::filePermissionForAction(action);
+            if (!req || *f != *req) continue;
+        }
+
+        if (const auto d = permission::vault::fs::Directories::resolveFromQualifiedName(o.permission.qualified_name)) {
+            const auto req = Evaluator::directoryPermissionForAction(action);
+            if (!req || *d != *req) continue;
+        }
+
+        if (!fs::glob::Matcher::matches(o.pattern, path)) continue;
+
+        if (const auto score = OverrideIndex::score(o.pattern); !best || score > bestScore) {
+            best = &o;
+            bestScore = score;
+        }
+    }
+
+    return best;
+}
+
+bool linearTraversal(const std::vector<Override>& overrides, const std::string& dir) {
+    for (const auto& o : overrides)
+        if (o.enabled && o.effect == OverrideOpt::ALLOW && fs::glob::Matcher::requiresTraversalThrough(o.pattern, dir))
+            return true;
+    return false;
+}
+
+}
+
+TEST(OverrideIndexTest, AgreesWithLinearScanOverRandomPolicies) {
+    const std::vector<std::string> segments{"docs", "images", "private", "a", "b", "report.pdf", "x.txt"};
+    const std::vector<std::string> wild{"*", "**", "*.pdf", "?", "r*", "**"};
+    const std::vector<std::string> perms{
+        "vault.fs.files.download", "vault.fs.files.preview", "vault.fs.files.upload",
+        "vault.fs.directories.list", "vault.fs.directories.download", "vault.other"
+    };
+    const std::vector actions{Action::Read, Action::Preview, Action::Write, Action::List, Action::Lookup, Action::Delete};
+
+    std::mt19937 rng(43);
+    const auto pick = [&](const auto& v) -> const auto& { return v[rng() % v.size()]; };
+
+    for (int round = 0; round < 40; ++round) {
+        std::vector<Override> overrides;
+        for (int i = 0; i < 30; ++i) {
+            std::string pattern;
+            const int depth = 1 + static_cast<int>(rng() % 4);
+            for (int d = 0; d < depth; ++d) pattern += "/" + (rng() % 3 == 0 ? pick(wild) : pick(segments));
+            overrides.push_back(makeOverride(pattern, rng() % 2 ? OverrideOpt::ALLOW : OverrideOpt::DENY,
+                                             pick(perms), rng() % 8 != 0));
+        }
+
+        const OverrideList list(overrides);
+        const auto index = list.index();
+
+        for (int q = 0; q < 60; ++q) {
+            std::string path;
+            const int depth = static_cast<int>(rng() % 5);
+            for (int d = 0; d < depth; ++d) path += "/" + pick(segments);
+            if (path.empty()) path = "/";
+
+            for (const auto action : actions) {
+                const auto* expected = linearBest(overrides, path, action);
+                const auto actual = index->best(path, action);
+                ASSERT_EQ(expected != nullptr, actual.has_value()) << path;
+                if (expected) {
+                    EXPECT_EQ(expected->pattern.source, actual->pattern) << path;
+                    EXPECT_EQ(expected->effect, actual->effect) << path;
+                }
+            }
+
+            EXPECT_EQ(linearTraversal(overrides, path), index->requiresTraversalThrough(path)) << path;
+        }
+    }
+}
+
+TEST(OverrideIndexTest, EarlierOverrideWinsTiesAndDisabledOnesAreSkipped) {
+    const OverrideList list{
+        makeOverride("/docs/*.pdf", OverrideOpt::ALLOW, "vault.fs.files.download", false),
+        makeOverride("/docs/*.pdf", OverrideOpt::DENY, "vault.fs.files.download"),
+        makeOverride("/docs/?.pdf", OverrideOpt::ALLOW, "vault.fs.files.preview"),
+        makeOverride("/docs/*.pdf", OverrideOpt::ALLOW, "vault.fs.files.download"),
+    };
+
+    const auto index = list.index();
+    EXPECT_EQ(index->size(), 3u);
+
+    const auto read = index->best("/docs/a.pdf", Action::Read);
+    ASSERT_TRUE(read.has_value());
+    EXPECT_EQ(read->effect, OverrideOpt::DENY);
+
+    const auto preview = index->best("/docs/a.pdf", Action::Preview);
+    ASSERT_TRUE(preview.has_value());
+    EXPECT_EQ(preview->pattern, "/docs/?.pdf");
+
+    EXPECT_FALSE(index->best("/docs/a.pdf", Action::Delete).has_value());
+    EXPECT_FALSE(index->best("/images/a.pdf", Action::Read).has_value());
+}
+
+TEST(OverrideIndexTest, RecompilesOnlyWhenOverridesChange) {
+    OverrideList list{makeOverride("/docs/**", OverrideOpt::DENY, "vault.fs.files.download")};
+
+    const auto first = list.index();
+    EXPECT_EQ(list.index(), first);
+
+    // Copies share the compiled index until one side changes
+    OverrideList copy = list;
+    EXPECT_EQ(copy.index(), first);
+
+    ASSERT_TRUE(first->best("/docs/a.txt", Action::Read).has_value());
+
+    list.push_back(makeOverride("/docs/a.txt", OverrideOpt::ALLOW, "vault.fs.files.download"));
+    const auto second = list.index();
+    EXPECT_NE(second, first);
+    EXPECT_NE(second->generation(), first->generation());
+
+    // Stale cached decisions belong to the old generation and are never consulted
+    const auto best = second->best("/docs/a.txt", Action::Read);
+    ASSERT_TRUE(best.has_value());
+    EXPECT_EQ(best->effect, OverrideOpt::ALLOW);
+
+    list[1].enabled = false;
+    EXPECT_EQ(list.index()->best("/docs/a.txt", Action::Read)->effect, OverrideOpt::DENY);
+
+    EXPECT_EQ(copy.index(), first);
+}
+
+TEST(OverrideIndexTest, PathologicalPatternsStayLinear) {
+    std::string pattern;
+    for (int i = 0; i < 12; ++i) pattern += "/**";
+    pattern += "/*a*a*a*a*a*a*b";
+
+    const OverrideList list{makeOverride(pattern, OverrideOpt::DENY, "vault.fs.files.download")};
+
+    std::string path;
+    for (int i = 0; i < 40; ++i) path += "/aaaaaaaaaaaaaaaaaaaa";
+
+    EXPECT_FALSE(list.index()->best(path, Action::Read).has_value());
+    EXPECT_TRUE(list.index()->best(path + "b", Action::Read).has_value());
+}
+
+TEST(DecisionCacheTest, KeysOnGenerationQuestionAndPath) {
+    DecisionCache cache(64);
+
+    cache.put(1, 3, "/docs/a.txt", 7);
+    EXPECT_EQ(cache.get(1, 3, "/docs/a.txt"), 7);
+    EXPECT_FALSE(cache.get(2, 3, "/docs/a.txt").has_value());
+    EXPECT_FALSE(cache.get(1, 4, "/docs/a.txt").has_value());
+    EXPECT_FALSE(cache.get(1, 3, "/docs/b.txt").has_value());
+
+    cache.put(1, 3, "/docs/a.txt", -1);
+    EXPECT_EQ(cache.get(1, 3, "/docs/a.txt"), -1);
+}
+
+TEST(DecisionCacheTest, StaysWithinCapacityAndCanBeDisabled) {
+    DecisionCache cache(64);
+    for (uint64_t i = 0; i < 5000; ++i) cache.put(i, 0, "/p", 1);
+    EXPECT_LE(cache.size(), 64u);
+    EXPECT_TRUE(cache.get(4999, 0, "/p").has_value());
+
+    DecisionCache disabled(0);
+    disabled.put(1, 0, "/p", 1);
+    EXPECT_FALSE(disabled.get(1, 0, "/p").has_value());
+    EXPECT_EQ(disabled.size(), 0u);
+}
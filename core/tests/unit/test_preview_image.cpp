@@ -0,0 +1,56 @@
+#include "preview/image.hpp"
+
+#include <gtest/gtest.h>
+#include <turbojpeg.h>
+
+#include <utility>
+#include <vector>
+
+using namespace vh::preview;
+
+namespace {
+
+std::vector<uint8_t> gradientJpeg(const int width, const int height) {
+    std::vector<uint8_t> rgb(static_cast<size_t>(width) * height * 3);
+    for (int y = 0; y < height; ++y)
+        for (int x = 0; x < width; ++x) {
+            auto* px = &rgb[(static_cast<size_t>(y) * width + x) * 3];
+            px[0] = static_cast<uint8_t>(x);
+            px[1] = static_cast<uint8_t>(y);
+            px[2] = static_cast<uint8_t>(x ^ y);
+        }
+
+    std::vector<uint8_t> jpeg;
+    image::compress_to_jpeg(rgb.data(), width, height, jpeg);
+    return jpeg;
+}
+
+std::pair<int, int> dimensions(const std::vector<uint8_t>& jpeg) {
+    const tjhandle tj = tjInitDecompress();
+    int width = 0, height = 0, subsamp = 0, colorspace = 0;
+    EXPECT_EQ(0, tjDecompressHeader3(tj, jpeg.data(), static_cast<unsigned long>(jpeg.size()),
+                                     &width, &height, &subsamp, &colorspace));
+    tjDestroy(tj);
+    return {width, height};
+}
+
+}
+
+TEST(PreviewImageTest, ScaledJpegKeepsTheRequestedFractionOfTheOriginal) {
+    const auto jpeg = gradientJpeg(1024, 512);
+
+    EXPECT_EQ(std::make_pair(512, 256), dimensions(image::resize_and_compress_buffer(jpeg.data(), jpeg.size(), "0.5", std::nullopt)));
+    EXPECT_EQ(std::make_pair(256, 128), dimensions(image::resize_and_compress_buffer(jpeg.data(), jpeg.size(), "0.25", std::nullopt)));
+    EXPECT_EQ(std::make_pair(1024, 512), dimensions(image::resize_and_compress_buffer(jpeg.data(), jpeg.size(), std::nullopt, std::nullopt)));
+}
+
+TEST(PreviewImageTest, BoundedJpegFitsTheBox) {
+    const auto jpeg = gradientJpeg(1024, 512);
+
+    EXPECT_EQ(std::make_pair(128, 64), dimensions(image::resize_and_compress_buffer(jpeg.data(), jpeg.size(), std::nullopt, "128")));
+
+    const auto thumbs = image::thumbnails_from_buffer(jpeg.data(), jpeg.size(), {256, 64});
+    ASSERT_EQ(2u, thumbs.size());
+    EXPECT_EQ(std::make_pair(256, 128), dimensions(thumbs[0]));
+    EXPECT_EQ(std::make_pair(64, 32), dimensions(thumbs[1]));
+}
@@ -0,0 +1,99 @@
+#include "preview/RenderCache.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+using namespace vh::preview;
+
+namespace {
+
+RenderCache::Key key(const std::string& hash, const unsigned int page = 0, const std::string& geometry = "s256") {
+    return { .contentHash = hash, .page = page, .geometry = geometry };
+}
+
+std::function<std::vector<uint8_t>()> rendering(const size_t bytes, std::atomic<int>& calls) {
+    return [bytes, &calls] {
+        ++calls;
+        return std::vector<uint8_t>(bytes, 0xAB);
+    };
+}
+
+}
+
+TEST(RenderCacheTest, ServesRepeatRendersFromMemoryAndKeysOnGeometry) {
+    RenderCache cache(1024);
+    std::atomic calls{0};
+
+    const auto first = cache.getOrRender(key("abc"), rendering(100, calls));
+    const auto second = cache.getOrRender(key("abc"), rendering(100, calls));
+    EXPECT_FALSE(first.hit);
+    EXPECT_TRUE(second.hit);
+    EXPECT_EQ(first.bytes, second.bytes);
+    EXPECT_EQ(calls, 1);
+
+    cache.getOrRender(key("abc", 1), rendering(100, calls));
+    cache.getOrRender(key("abc", 0, "x0.5"), rendering(100, calls));
+    EXPECT_EQ(calls, 3);
+    EXPECT_NE(key("abc", 1).etag(), key("abc").etag());
+}
+
+TEST(RenderCacheTest, EvictsLeastRecentlyUsedRendersOverBudget) {
+    RenderCache cache(1000);
+    std::atomic calls{0};
+
+    cache.getOrRender(key("a"), rendering(250, calls));
+    cache.getOrRender(key("b"), rendering(250, calls));
+    cache.getOrRender(key("c"), rendering(250, calls));
+    cache.getOrRender(key("a"), rendering(250, calls));       // refresh a
+    cache.getOrRender(key("d"), rendering(250, calls));
+    cache.getOrRender(key("e"), rendering(250, calls));       // evicts b
+    EXPECT_EQ(calls, 5);
+    EXPECT_LE(cache.sizeBytes(), 1000u);
+
+    EXPECT_TRUE(cache.getOrRender(key("a"), rendering(250, calls)).hit);
+    EXPECT_FALSE(cache.getOrRender(key("b"), rendering(250, calls)).hit);
+
+    // Renders too large to share the budget are served but never retained
+    EXPECT_FALSE(cache.getOrRender(key("huge"), rendering(600, calls)).hit);
+    EXPECT_FALSE(cache.getOrRender(key("huge"), rendering(600, calls)).hit);
+}
+
+TEST(RenderCacheTest, ConcurrentRequestsShareOneRender) {
+    RenderCache cache(1 << 20);
+    std::atomic calls{0};
+
+    const auto slow = [&] {
+        ++calls;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        return std::vector<uint8_t>(64, 1);
+    };
+
+    std::vector<std::thread> threads;
+    std::atomic hits{0};
+    for (int i = 0; i < 8; ++i)
+        threads.emplace_back([&] {
+            if (cache.getOrRender(key("same"), slow).hit) ++hits;
+        });
+    for (auto& t : threads) t.join();
+
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(hits, 7);
+}
+
+TEST(RenderCacheTest, FailedRendersReachEveryCallerAndAreNotCached) {
+    RenderCache cache(1 << 20);
+    std::atomic calls{0};
+
+    EXPECT_THROW(cache.getOrRender(key("bad"), [&]() -> std::vector<uint8_t> {
+        ++calls;
+        throw std::runtime_error("corrupt source");
+    }), std::runtime_error);
+
+    EXPECT_FALSE(cache.getOrRender(key("bad"), rendering(10, calls)).hit);
+    EXPECT_EQ(calls, 2);
+    EXPECT_EQ(cache.entries(), 1u);
+}
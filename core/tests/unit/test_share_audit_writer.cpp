@@ -0,0 +1,137 @@
+#include "share/AuditWriter.hpp"
+#include "share/AuditEvent.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+using vh::share::AuditEvent;
+using vh::share::AuditWriter;
+
+namespace {
+
+struct RecordingSink {
+    std::mutex mutex;
+    std::vector<size_t> batches;
+    std::vector<std::string> singles;
+    std::unordered_map<std::string, AuditWriter::Counters> counters;
+    size_t counterFlushes = 0;
+    bool rejectBatches = false;
+
+    AuditWriter::Sink sink() {
+        return {
+            .events = [this](const auto& events) {
+                std::lock_guard lock(mutex);
+                if (rejectBatches) throw std::runtime_error("batch rejected");
+                batches.push_back(events.size());
+            },
+            .counters = [this](const auto& deltas) {
+                std::lock_guard lock(mutex);
+                ++counterFlushes;
+                for (const auto& [id, c] : deltas) {
+                    counters[id].accesses += c.accesses;
+                    counters[id].downloads += c.downloads;
+                    counters[id].uploads += c.uploads;
+                }
+            },
+            .event = [this](const auto& event) {
+                std::lock_guard lock(mutex);
+                if (event->event_type == "poison") throw std::runtime_error("bad row");
+                singles.push_back(event->event_type);
+            }
+        };
+    }
+};
+
+std::shared_ptr<AuditEvent> event(const std::string& type = "share.session.open") {
+    auto e = std::make_shared<AuditEvent>();
+    e->event_type = type;
+    return e;
+}
+
+}
+
+TEST(ShareAuditWriterTest, FlushesFullBatchesWithoutWaitingForAge) {
+    RecordingSink rec;
+    AuditWriter writer({ .batchSize = 4, .maxAge = std::chrono::hours{1}, .maxQueued = 100 }, rec.sink());
+
+    for (int i = 0; i < 4; ++i) writer.append(event());
+    writer.flush();
+
+    std::lock_guard lock(rec.mutex);
+    ASSERT_EQ(rec.batches.size(), 1u);
+    EXPECT_EQ(rec.batches.front(), 4u);
+}
+
+TEST(ShareAuditWriterTest, CoalescesCountersPerLinkIntoOneFlush) {
+    RecordingSink rec;
+    AuditWriter writer({ .batchSize = 100, .maxAge = std::chrono::hours{1}, .maxQueued = 100 }, rec.sink());
+
+    for (int i = 0; i < 5; ++i) writer.touchAccess("a");
+    writer.incrementDownload("a");
+    writer.incrementDownload("a");
+    writer.incrementUpload("b");
+    EXPECT_EQ(writer.pending(), 2u);
+    writer.flush();
+
+    std::lock_guard lock(rec.mutex);
+    EXPECT_EQ(rec.counterFlushes, 1u);
+    EXPECT_EQ(rec.counters["a"].accesses, 5u);
+    EXPECT_EQ(rec.counters["a"].downloads, 2u);
+    EXPECT_EQ(rec.counters["b"].uploads, 1u);
+}
+
+TEST(ShareAuditWriterTest, WritesAgedEventsOnItsOwn) {
+    RecordingSink rec;
+    AuditWriter writer({ .batchSize = 100, .maxAge = std::chrono::milliseconds{10}, .maxQueued = 100 }, rec.sink());
+
+    writer.append(event());
+    for (int i = 0; i < 200 && writer.pending() > 0; ++i) std::this_thread::sleep_for(std::chrono::milliseconds{5});
+
+    EXPECT_EQ(writer.pending(), 0u);
+}
+
+TEST(ShareAuditWriterTest, RejectedBatchFallsBackToSingleRowsAndDropsOnlyTheBadOne) {
+    RecordingSink rec;
+    rec.rejectBatches = true;
+    AuditWriter writer({ .batchSize = 100, .maxAge = std::chrono::hours{1}, .maxQueued = 100 }, rec.sink());
+
+    writer.append(event("share.download"));
+    writer.append(event("poison"));
+    writer.append(event("share.preview"));
+    writer.flush();
+
+    std::lock_guard lock(rec.mutex);
+    EXPECT_EQ(rec.singles, (std::vector<std::string>{"share.download", "share.preview"}));
+}
+
+TEST(ShareAuditWriterTest, StopDrainsPendingWorkAndLaterWritesGoThroughDirectly) {
+    RecordingSink rec;
+    AuditWriter writer({ .batchSize = 100, .maxAge = std::chrono::hours{1}, .maxQueued = 100 }, rec.sink());
+
+    writer.append(event());
+    writer.append(event());
+    writer.incrementDownload("a");
+    writer.stop();
+
+    {
+        std::lock_guard lock(rec.mutex);
+        ASSERT_EQ(rec.batches.size(), 1u);
+        EXPECT_EQ(rec.batches.front(), 2u);
+        EXPECT_EQ(rec.counters["a"].downloads, 1u);
+    }
+
+    writer.append(event());
+    std::lock_guard lock(rec.mutex);
+    EXPECT_EQ(rec.batches.size(), 2u);
+}
+
+TEST(ShareAuditWriterTest, RejectsEventsWithoutAType) {
+    RecordingSink rec;
+    AuditWriter writer({}, rec.sink());
+    EXPECT_THROW(writer.append(nullptr), std::invalid_argument);
+    EXPECT_THROW(writer.append(event("")), std::invalid_argument);
+}
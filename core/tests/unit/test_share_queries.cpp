@@ -162,6 +162,13 @@ TEST_F(ShareQueryTest, ShareLinkRoundTripAndCounters) {
     EXPECT_EQ(counted->download_count, afterRotate->download_count + 1);
     EXPECT_EQ(counted->upload_count, afterRotate->upload_count + 1);
 
+    db::query::share::Link::addCounters({{ .id = created->id, .accesses = 3, .downloads = 2, .uploads = 0 }});
+    auto batched = db::query::share::Link::get(created->id);
+    ASSERT_NE(batched, nullptr);
+    EXPECT_EQ(batched->access_count, counted->access_count + 3);
+    EXPECT_EQ(batched->download_count, counted->download_count + 2);
+    EXPECT_EQ(batched->upload_count, counted->upload_count);
+
     db::query::share::Link::revoke(created->id, userId);
     auto revoked = db::query::share::Link::get(created->id);
     ASSERT_NE(revoked, nullptr);
@@ -352,6 +359,12 @@ TEST_F(ShareQueryTest, SessionChallengeUploadAndAuditRoundTrips) {
     event->status = share::AuditStatus::Success;
     db::query::share::AuditEvent::append(event);
     EXPECT_FALSE(db::query::share::AuditEvent::listForShare(link->id, params).empty());
+
+    auto download = std::make_shared<share::AuditEvent>(*event);
+    download->event_type = "share.download";
+    download->bytes_transferred = 42;
+    db::query::share::AuditEvent::appendBatch({event, download});
+    EXPECT_EQ(db::query::share::AuditEvent::listForShare(link->id, params).size(), 3u);
     EXPECT_FALSE(db::query::share::AuditEvent::listForVault(vaultId, params).empty());
 
     db::query::share::Session::revoke(session->id);
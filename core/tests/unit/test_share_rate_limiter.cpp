@@ -1,3 +1,4 @@
+#include "identities/User.hpp"
 #include "protocols/ws/Router.hpp"
 #include "protocols/ws/Session.hpp"
 #include "protocols/ws/ShareRateLimit.hpp"
@@ -107,3 +108,39 @@ TEST(ShareRateLimiterTest, CoversPublicAndTransferCommandsButNotCleanupCommands)
     EXPECT_FALSE(ShareRateLimit::isLimitedCommand("fs.upload.cancel"));
     EXPECT_FALSE(ShareRateLimit::isLimitedCommand("share.link.create"));
 }
+
+TEST(ShareRateLimiterTest, LoginAttemptsAreLimitedPerIpAndUserBeforeHashing) {
+    ShareRateLimit limiter;
+    const auto session = rateLimitedPublicSession();
+    const auto now = ShareRateLimit::Clock::time_point{} + std::chrono::seconds{3000};
+
+    const nlohmann::json admin = {{"payload", {{"name", "admin"}, {"password", "guess"}}}};
+    const nlohmann::json other = {{"payload", {{"name", "alice"}, {"password", "guess"}}}};
+
+    for (int i = 0; i < 10; ++i)
+        EXPECT_TRUE(limiter.check("auth.login", admin, *session, now + std::chrono::seconds{i}).allowed);
+
+    EXPECT_FALSE(limiter.check("auth.login", admin, *session, now + std::chrono::seconds{10}).allowed);
+    EXPECT_TRUE(limiter.check("auth.login", other, *session, now + std::chrono::seconds{10}).allowed);
+    EXPECT_TRUE(ShareRateLimit::isLimitedCommand("auth.user.change_password"));
+}
+
+TEST(ShareRateLimiterTest, PasswordChangesAreLimitedPerIpAndAuthenticatedUser) {
+    ShareRateLimit limiter;
+    const auto admin = rateLimitedPublicSession();
+    admin->user = std::make_shared<vh::identities::User>();
+    admin->user->id = 1;
+    const auto alice = rateLimitedPublicSession();
+    alice->user = std::make_shared<vh::identities::User>();
+    alice->user->id = 2;
+    const auto now = ShareRateLimit::Clock::time_point{} + std::chrono::seconds{4000};
+
+    // The payload names no account; the key must come from the session, not the message
+    const nlohmann::json change = {{"payload", {{"old_password", "guess"}, {"new_password", "next"}}}};
+
+    for (int i = 0; i < 10; ++i)
+        EXPECT_TRUE(limiter.check("auth.user.change_password", change, *admin, now + std::chrono::seconds{i}).allowed);
+
+    EXPECT_FALSE(limiter.check("auth.user.change_password", change, *admin, now + std::chrono::seconds{10}).allowed);
+    EXPECT_TRUE(limiter.check("auth.user.change_password", change, *alice, now + std::chrono::seconds{10}).allowed);
+}
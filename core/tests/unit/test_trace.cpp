@@ -0,0 +1,123 @@
+#include "stats/Trace.hpp"
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+using namespace vh::stats::trace;
+using namespace std::chrono_literals;
+
+namespace {
+
+class TraceTest : public ::testing::Test {
+protected:
+    void SetUp() override { configure({.sample_rate = 1.0, .slow_threshold = 0ms}); }
+    void TearDown() override { configure({}); }
+
+    static void configure(const Tracer::Options& opts) { Tracer::instance().configure(opts); }
+};
+
+}
+
+TEST_F(TraceTest, NestedSpansAttachToTheRoot) {
+    {
+        const Span root("fuse.open");
+        {
+            const Span resolve("fuse.resolve");
+            const Span db("db.tx", "[User::getUserByLinuxUID]");
+        }
+        const Span read("disk.read", "/vault/a.txt");
+    }
+
+    const auto traces = Tracer::instance().recent();
+    ASSERT_EQ(traces.size(), 1u);
+
+    const auto& spans = traces.front().spans;
+    ASSERT_EQ(spans.size(), 4u);
+    EXPECT_STREQ(spans[0].name, "fuse.open");
+    EXPECT_EQ(spans[0].depth, 0);
+    EXPECT_STREQ(spans[1].name, "fuse.resolve");
+    EXPECT_EQ(spans[1].depth, 1);
+    EXPECT_STREQ(spans[2].name, "db.tx");
+    EXPECT_EQ(spans[2].depth, 2);
+    EXPECT_EQ(spans[2].detail, "[User::getUserByLinuxUID]");
+    EXPECT_EQ(spans[3].depth, 1);
+
+    // Children sit inside their parent
+    for (std::size_t i = 1; i < spans.size(); ++i) {
+        EXPECT_GE(spans[i].start_ns, spans[0].start_ns);
+        EXPECT_LE(spans[i].start_ns + spans[i].dur_ns, spans[0].start_ns + spans[0].dur_ns);
+    }
+}
+
+TEST_F(TraceTest, UnsampledTracesAreKeptOnlyWhenSlow) {
+    configure({.sample_rate = 0.0, .slow_threshold = 5ms});
+
+    { const Span fast("fuse.getattr"); }
+    {
+        const Span slow("fuse.write");
+        std::this_thread::sleep_for(10ms);
+    }
+
+    const auto traces = Tracer::instance().recent();
+    ASSERT_EQ(traces.size(), 1u);
+    EXPECT_STREQ(traces.front().spans.front().name, "fuse.write");
+    EXPECT_TRUE(traces.front().slow);
+    EXPECT_EQ(Tracer::instance().recent(true).size(), 1u);
+}
+
+TEST_F(TraceTest, RingKeepsTheNewestAndCapsSpans) {
+    configure({.sample_rate = 1.0, .slow_threshold = 0ms, .capacity = 3, .max_spans = 2});
+
+    for (int i = 0; i < 5; ++i) {
+        const Span root("sync.upload", std::to_string(i));
+        const Span a("s3.request");
+        const Span b("s3.request");
+    }
+
+    const auto traces = Tracer::instance().recent();
+    ASSERT_EQ(traces.size(), 3u);
+    EXPECT_EQ(traces[0].spans.front().detail, "4");
+    EXPECT_EQ(traces[2].spans.front().detail, "2");
+    EXPECT_EQ(traces[0].spans.size(), 2u);
+    EXPECT_EQ(traces[0].dropped, 1u);
+    EXPECT_EQ(Tracer::instance().recent(false, 1).size(), 1u);
+}
+
+TEST_F(TraceTest, ChromeJsonHasCompleteEvents) {
+    {
+        const Span root("ws.handler", "fs.upload.start");
+        const Span child("crypto.encrypt");
+    }
+    std::thread([] { const Span other("http.request", "/preview"); }).join();
+
+    const auto j = Tracer::instance().chromeJson();
+    ASSERT_TRUE(j.contains("traceEvents"));
+    const auto& events = j["traceEvents"];
+    ASSERT_EQ(events.size(), 3u);
+
+    for (const auto& e : events) {
+        EXPECT_EQ(e["ph"], "X");
+        EXPECT_TRUE(e.contains("ts"));
+        EXPECT_TRUE(e.contains("dur"));
+        EXPECT_TRUE(e.contains("tid"));
+    }
+
+    // Newest trace first; the other thread reports its own tid
+    EXPECT_EQ(events[0]["name"], "http.request");
+    EXPECT_EQ(events[0]["args"]["detail"], "/preview");
+    EXPECT_NE(events[0]["tid"], events[1]["tid"]);
+    EXPECT_EQ(events[1]["args"]["trace_id"], events[2]["args"]["trace_id"]);
+}
+
+TEST_F(TraceTest, DisabledTracerRecordsNothing) {
+    configure({.enabled = false, .sample_rate = 1.0});
+    {
+        const Span root("fuse.read");
+        const Span child("disk.read");
+    }
+    EXPECT_TRUE(Tracer::instance().recent().empty());
+}
@@ -0,0 +1,59 @@
+#include "auth/session/VerifiedTokenCache.hpp"
+#include "auth/model/Token.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace vh::auth::session;
+using namespace vh::auth::model;
+using namespace std::chrono_literals;
+
+namespace {
+
+std::shared_ptr<Token> accessToken(const std::string& raw, const std::chrono::minutes ttl = 30min) {
+    auto t = std::make_shared<Token>();
+    t->rawToken = raw;
+    t->expiresAt = std::chrono::system_clock::now() + ttl;
+    return t;
+}
+
+}
+
+TEST(VerifiedTokenCacheTest, HitsOnlyForRememberedCurrentToken) {
+    VerifiedTokenCache cache;
+    const auto token = accessToken("raw-access");
+
+    EXPECT_FALSE(cache.verified("raw-access", token));
+
+    cache.remember("raw-access", token, 5min);
+    EXPECT_TRUE(cache.verified("raw-access", token));
+    EXPECT_FALSE(cache.verified("raw-other", token));
+    EXPECT_FALSE(cache.verified("raw-access", accessToken("raw-access")));
+}
+
+TEST(VerifiedTokenCacheTest, RevocationAndClearTakeEffectImmediately) {
+    VerifiedTokenCache cache;
+    const auto token = accessToken("raw-access");
+
+    cache.remember("raw-access", token, 5min);
+    token->revoke();
+    EXPECT_FALSE(cache.verified("raw-access", token));
+
+    const auto fresh = accessToken("raw-fresh");
+    cache.remember("raw-fresh", fresh, 5min);
+    cache.clear();
+    EXPECT_FALSE(cache.verified("raw-fresh", fresh));
+}
+
+TEST(VerifiedTokenCacheTest, ExpiresAtTtlOrRenewWindow) {
+    VerifiedTokenCache cache;
+    const auto now = std::chrono::system_clock::now();
+    const auto token = accessToken("raw-access");
+
+    cache.remember("raw-access", token, 5min, now);
+    EXPECT_TRUE(cache.verified("raw-access", token, now + VerifiedTokenCache::MAX_TTL - 1s));
+    EXPECT_FALSE(cache.verified("raw-access", token, now + VerifiedTokenCache::MAX_TTL));
+
+    const auto nearExpiry = accessToken("raw-near", 5min);
+    cache.remember("raw-near", nearExpiry, 5min, now);
+    EXPECT_FALSE(cache.verified("raw-near", nearExpiry, now));
+}
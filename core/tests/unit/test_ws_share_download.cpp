@@ -4,6 +4,7 @@
 #include "protocols/ws/Router.hpp"
 #include "protocols/ws/Session.hpp"
 #include "protocols/ws/handler/share/Download.hpp"
+#include "protocols/ws/model/TransferFrame.hpp"
 #include "rbac/role/Vault.hpp"
 #include "share/AuditEvent.hpp"
 #include "share/EmailChallenge.hpp"
@@ -436,6 +437,7 @@ protected:
         Download::resetManagerFactoryForTesting();
         Download::resetResolverFactoryForTesting();
         Download::resetReaderFactoryForTesting();
+        Download::resetFrameSinkForTesting();
         vh::share::Token::clearPepperForTesting();
     }
 
@@ -526,6 +528,63 @@ TEST_F(WsShareDownloadTest, StartAndChunksCompleteDownloadWithGrant) {
     }, session); }, std::runtime_error);
 }
 
+TEST_F(WsShareDownloadTest, BinaryEncodingKeepsPayloadOutOfTheJsonAck) {
+    const auto session = readySession();
+    std::vector<std::pair<std::shared_ptr<Session>, std::string>> frames;
+    Download::setFrameSinkForTesting([&](const std::shared_ptr<Session>& to, std::string frame) {
+        frames.emplace_back(to, std::move(frame));
+    });
+    const auto start = Download::start({{"path", "/reports/q1.txt"}}, session);
+
+    const auto chunk = Download::chunk({
+        {"transfer_id", start.at("transfer_id").get<std::string>()},
+        {"offset", 0},
+        {"length", 11},
+        {"encoding", "binary"}
+    }, session);
+    EXPECT_EQ(chunk.at("encoding"), "binary");
+    EXPECT_EQ(chunk.at("bytes"), 11u);
+    EXPECT_TRUE(chunk.at("complete").get<bool>());
+    EXPECT_FALSE(chunk.contains("data_base64"));
+
+    ASSERT_EQ(frames.size(), 1u);
+    EXPECT_EQ(frames[0].first, session);
+    const auto& raw = frames[0].second;
+    const auto frame = model::TransferFrame::decode({reinterpret_cast<const uint8_t*>(raw.data()), raw.size()});
+    EXPECT_EQ(frame.transferIdString(), start.at("transfer_id").get<std::string>());
+    EXPECT_EQ(frame.offset, 0u);
+    EXPECT_TRUE(frame.final());
+    EXPECT_EQ(std::string(frame.payload.begin(), frame.payload.end()), "hello world");
+
+    const auto again = Download::start({{"path", "/reports/q1.txt"}}, session);
+    EXPECT_THROW({ (void)Download::chunk({
+        {"transfer_id", again.at("transfer_id").get<std::string>()},
+        {"offset", 0},
+        {"encoding", "hex"}
+    }, session); }, std::invalid_argument);
+}
+
+TEST(WsTransferFrameTest, RoundTripsHeaderAndPayload) {
+    using model::TransferFrame;
+    const std::string id = "2f1c6d1e-8b7a-4c1e-9a53-0d6a1b2c3d4e";
+    const std::vector<uint8_t> payload{'h', 'e', 'l', 'l', 'o'};
+
+    const auto encoded = TransferFrame::encode(id, 0x0102030405060708ull, TransferFrame::Final, payload);
+    ASSERT_EQ(encoded.size(), TransferFrame::HEADER_BYTES + payload.size());
+    EXPECT_EQ(static_cast<uint8_t>(encoded[20]), 0x01);
+    EXPECT_EQ(static_cast<uint8_t>(encoded[27]), 0x08);
+
+    const auto bytes = std::span(reinterpret_cast<const uint8_t*>(encoded.data()), encoded.size());
+    const auto frame = TransferFrame::decode(bytes);
+    EXPECT_EQ(frame.transferIdString(), id);
+    EXPECT_EQ(frame.offset, 0x0102030405060708ull);
+    EXPECT_TRUE(frame.final());
+    EXPECT_EQ(std::vector<uint8_t>(frame.payload.begin(), frame.payload.end()), payload);
+
+    EXPECT_THROW((void)TransferFrame::decode(bytes.first(TransferFrame::HEADER_BYTES - 1)), std::invalid_argument);
+    EXPECT_THROW((void)TransferFrame::encode("not-a-uuid", 0, 0, payload), std::invalid_argument);
+}
+
 TEST_F(WsShareDownloadTest, NativeStartUsesShareActorAndDurableScopedRole) {
     const auto session = readySession();
     ASSERT_EQ(session->user, nullptr);
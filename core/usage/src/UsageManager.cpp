@@ -33,6 +33,8 @@ UsageManager::UsageManager() {
     registerBook(setup::get(root_->weak_from_this()));
     registerBook(teardown::get(root_->weak_from_this()));
     registerBook(status::get(root_->weak_from_this()));
+    registerBook(metrics::get(root_->weak_from_this()));
+    registerBook(tracing::get(root_->weak_from_this()));
     registerBook(help::get(root_->weak_from_this()));
     registerBook(version::get(root_->weak_from_this()));
 }
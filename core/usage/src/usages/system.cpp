@@ -4,6 +4,10 @@ using namespace vh::protocols::shell;
 
 namespace vh::protocols::shell {
 
+static const auto traceLimitOpt = Optional::ManyToOne("limit", "Only dump the newest N traces", {"limit", "n"}, "count");
+static const auto slowFlag = Flag::WithAliases("slow", "Only traces that ran past tracing.slow_threshold_ms", {"slow", "s"});
+static const auto clearFlag = Flag::WithAliases("clear", "Drop every buffered trace instead of dumping", {"clear"});
+
 static std::shared_ptr<CommandUsage> help_base(const std::weak_ptr<CommandUsage>& parent) {
     const auto cmd = std::make_shared<CommandUsage>();
     cmd->parent = parent;
@@ -37,6 +41,34 @@ static std::shared_ptr<CommandUsage> status_base(const std::weak_ptr<CommandUsag
     return cmd;
 }
 
+static std::shared_ptr<CommandUsage> stats_base(const std::weak_ptr<CommandUsage>& parent) {
+    const auto cmd = std::make_shared<CommandUsage>();
+    cmd->parent = parent;
+    cmd->aliases = {"stats"};
+    cmd->description = "Show latency percentiles for FUSE ops, DB, thread pools, S3 and WebSocket handlers (admin only).";
+    cmd->optional_flags = { jsonFlag };
+    cmd->examples = {
+        {"vh stats", "Show count, p50/p95/p99, max and average latency for every series with samples."},
+        {"vh stats --json", "Dump the same series as JSON."}
+    };
+    return cmd;
+}
+
+static std::shared_ptr<CommandUsage> trace_base(const std::weak_ptr<CommandUsage>& parent) {
+    const auto cmd = std::make_shared<CommandUsage>();
+    cmd->parent = parent;
+    cmd->aliases = {"trace"};
+    cmd->description = "Dump recent request traces as Chrome trace JSON, for chrome://tracing or Perfetto (admin only).";
+    cmd->optional = { traceLimitOpt };
+    cmd->optional_flags = { slowFlag, clearFlag };
+    cmd->examples = {
+        {"vh trace > trace.json", "Dump every buffered trace."},
+        {"vh trace --slow --limit 20", "Dump the 20 newest slow traces."},
+        {"vh trace --clear", "Empty the trace buffer."}
+    };
+    return cmd;
+}
+
 std::shared_ptr<CommandBook> help::get(const std::weak_ptr<CommandUsage>& parent) {
     const auto book = std::make_shared<CommandBook>();
     book->title = "Help Command";
@@ -58,4 +90,18 @@ std::shared_ptr<CommandBook> status::get(const std::weak_ptr<CommandUsage>& pare
     return book;
 }
 
+std::shared_ptr<CommandBook> metrics::get(const std::weak_ptr<CommandUsage>& parent) {
+    const auto book = std::make_shared<CommandBook>();
+    book->title = "Stats Command";
+    book->root = stats_base(parent);
+    return book;
+}
+
+std::shared_ptr<CommandBook> tracing::get(const std::weak_ptr<CommandUsage>& parent) {
+    const auto book = std::make_shared<CommandBook>();
+    book->title = "Trace Command";
+    book->root = trace_base(parent);
+    return book;
+}
+
 }
@@ -0,0 +1,43 @@
+-- ##################################
+-- Filesystem Generation Counter
+-- ##################################
+
+-- Advances on every statement that changes the file index. The in-memory cache snapshot records
+-- the value it was written at and is only trusted at startup if nothing has moved since.
+-- A sequence rather than a counter row, so concurrent writers never queue on the same lock.
+CREATE SEQUENCE IF NOT EXISTS fs_generation;
+
+CREATE OR REPLACE FUNCTION bump_fs_generation()
+RETURNS TRIGGER AS $$
+BEGIN
+    PERFORM nextval('fs_generation');
+    RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
+
+DO $$ BEGIN
+CREATE TRIGGER bump_fs_generation_fs_entry
+    AFTER INSERT OR UPDATE OR DELETE OR TRUNCATE ON fs_entry
+    FOR EACH STATEMENT
+    EXECUTE FUNCTION bump_fs_generation();
+EXCEPTION
+    WHEN duplicate_object THEN NULL;
+END $$;
+
+DO $$ BEGIN
+CREATE TRIGGER bump_fs_generation_files
+    AFTER INSERT OR UPDATE OR DELETE OR TRUNCATE ON files
+    FOR EACH STATEMENT
+    EXECUTE FUNCTION bump_fs_generation();
+EXCEPTION
+    WHEN duplicate_object THEN NULL;
+END $$;
+
+DO $$ BEGIN
+CREATE TRIGGER bump_fs_generation_directories
+    AFTER INSERT OR UPDATE OR DELETE OR TRUNCATE ON directories
+    FOR EACH STATEMENT
+    EXECUTE FUNCTION bump_fs_generation();
+EXCEPTION
+    WHEN duplicate_object THEN NULL;
+END $$;
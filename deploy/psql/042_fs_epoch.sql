@@ -0,0 +1,26 @@
+-- ##################################
+-- Filesystem Epoch
+-- ##################################
+
+-- fs_generation only orders writes within one history of the database. Recreating the database
+-- or restoring a dump rewinds it, so a leftover cache snapshot could match a later generation of
+-- a different tree. current_fs_epoch() names the history a snapshot was taken in: a random id
+-- minted whenever the row is created (a fresh deploy, or after the table was emptied), suffixed
+-- with the row's xmin, which a restore changes because it re-inserts the row.
+CREATE TABLE IF NOT EXISTS fs_epoch (
+    singleton BOOLEAN PRIMARY KEY DEFAULT TRUE CHECK (singleton),
+    epoch     UUID NOT NULL DEFAULT gen_random_uuid()
+);
+
+INSERT INTO fs_epoch DEFAULT VALUES ON CONFLICT (singleton) DO NOTHING;
+
+CREATE OR REPLACE FUNCTION current_fs_epoch()
+RETURNS TEXT AS $$
+DECLARE
+    _epoch TEXT;
+BEGIN
+    INSERT INTO fs_epoch DEFAULT VALUES ON CONFLICT (singleton) DO NOTHING;
+    SELECT epoch::TEXT || ':' || xmin::TEXT INTO _epoch FROM fs_epoch;
+    RETURN _epoch;
+END;
+$$ LANGUAGE plpgsql;
@@ -189,7 +189,9 @@ export interface ShareDownloadChunkResponse {
   transfer_id: string
   offset: number
   bytes: number
-  data_base64: string
+  encoding: 'base64' | 'binary'
+  // absent for binary chunks, which arrive as a separate binary frame ahead of this ack
+  data_base64?: string
   next_offset: number
   complete: boolean
 }
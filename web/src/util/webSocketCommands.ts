@@ -184,7 +184,7 @@ export interface WebSocketCommandMap {
   'fs.download.start': { payload: { path?: string; vault_id?: number | null }; response: ShareDownloadStartResponse }
 
   'fs.download.chunk': {
-    payload: { transfer_id: string; offset: number; length?: number }
+    payload: { transfer_id: string; offset: number; length?: number; encoding?: 'base64' | 'binary' }
     response: ShareDownloadChunkResponse
   }
 
@@ -249,7 +249,7 @@ export interface WebSocketCommandMap {
   'share.download.start': { payload: { path?: string }; response: ShareDownloadStartResponse }
 
   'share.download.chunk': {
-    payload: { transfer_id: string; offset: number; length?: number }
+    payload: { transfer_id: string; offset: number; length?: number; encoding?: 'base64' | 'binary' }
     response: ShareDownloadChunkResponse
   }
 